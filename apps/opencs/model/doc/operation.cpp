@@ -1,8 +1,12 @@
 #include "operation.hpp"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QTimer>
 
 #include "../world/universalid.hpp"
@@ -10,6 +14,85 @@
 #include "state.hpp"
 #include "stage.hpp"
 
+namespace
+{
+    /// Number of parallel steps performed per call of executeStage, per thread
+    const int sStepsPerThread = 16;
+
+    typedef std::vector<std::pair<CSMDoc::Stage *, int> > Steps; // stage, step
+
+    struct StepResult
+    {
+        CSMDoc::Messages mMessages;
+        std::string mError;
+        bool mFailed;
+
+        StepResult (CSMDoc::Message::Severity defaultSeverity)
+        : mMessages (defaultSeverity), mFailed (false)
+        {}
+    };
+
+    void performStep (const std::pair<CSMDoc::Stage *, int>& step, StepResult& result)
+    {
+        try
+        {
+            step.first->perform (step.second, result.mMessages);
+        }
+        catch (const std::exception& e)
+        {
+            result.mError = e.what();
+            result.mFailed = true;
+        }
+    }
+
+    class StepTask : public QRunnable
+    {
+            const Steps& mSteps;
+            std::vector<StepResult>& mResults;
+            int mBegin;
+            int mEnd;
+            QSemaphore& mDone;
+
+        public:
+
+            StepTask (const Steps& steps, std::vector<StepResult>& results, int begin, int end,
+                QSemaphore& done)
+            : mSteps (steps), mResults (results), mBegin (begin), mEnd (end), mDone (done)
+            {}
+
+            virtual void run()
+            {
+                for (int i=mBegin; i<mEnd; ++i)
+                    performStep (mSteps[i], mResults[i]);
+
+                mDone.release();
+            }
+    };
+
+    /// Perform \a steps, spread over the global thread pool if there is more than one.
+    void performSteps (const Steps& steps, std::vector<StepResult>& results)
+    {
+        int size = static_cast<int> (steps.size());
+
+        QThreadPool *pool = QThreadPool::globalInstance();
+
+        int threads = std::max (1, std::min (pool->maxThreadCount(), size));
+        int chunk = (size + threads - 1) / threads;
+
+        // the first chunk is handled by the calling thread
+        QSemaphore done;
+        int tasks = 0;
+
+        for (int begin=chunk; begin<size; begin+=chunk, ++tasks)
+            pool->start (new StepTask (steps, results, begin, std::min (size, begin+chunk), done));
+
+        for (int i=0; i<std::min (size, chunk); ++i)
+            performStep (steps[i], results[i]);
+
+        done.acquire (tasks);
+    }
+}
+
 void CSMDoc::Operation::prepareStages()
 {
     mCurrentStage = mStages.begin();
@@ -97,36 +180,57 @@ void CSMDoc::Operation::executeStage()
         mPrepared = true;
     }
 
-    Messages messages (mDefaultSeverity);
+    // Collect a run of parallel steps, or a single other step
+    Steps steps;
+
+    int maxSteps = mOrdered ? 1 : std::max (1, QThreadPool::globalInstance()->maxThreadCount()) * sStepsPerThread;
 
-    while (mCurrentStage!=mStages.end())
+    while (mCurrentStage!=mStages.end() && static_cast<int> (steps.size())<maxSteps)
     {
         if (mCurrentStep>=mCurrentStage->second)
         {
             mCurrentStep = 0;
             ++mCurrentStage;
         }
+        else if (!mOrdered && mCurrentStage->first->isParallel (mCurrentStep))
+        {
+            steps.push_back (std::make_pair (mCurrentStage->first, mCurrentStep++));
+        }
         else
         {
-            try
-            {
-                mCurrentStage->first->perform (mCurrentStep++, messages);
-            }
-            catch (const std::exception& e)
-            {
-                emit reportMessage (Message (CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError), mType);
-                abort();
-            }
+            if (steps.empty())
+                steps.push_back (std::make_pair (mCurrentStage->first, mCurrentStep++));
 
-            ++mCurrentStepTotal;
             break;
         }
     }
 
-    emit progress (mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
+    std::vector<StepResult> results (steps.size(), StepResult (mDefaultSeverity));
+
+    if (steps.size()==1)
+        performStep (steps.front(), results.front());
+    else if (!steps.empty())
+        performSteps (steps, results);
+
+    mCurrentStepTotal += static_cast<int> (steps.size());
+
+    // Report in the order of the steps, as if they had been performed one after the other
+    for (std::vector<StepResult>::const_iterator result (results.begin()); result!=results.end(); ++result)
+    {
+        if (result->mFailed)
+            emit reportMessage (Message (CSMWorld::UniversalId(), result->mError, "", Message::Severity_SeriousError), mType);
+
+        for (Messages::Iterator iter (result->mMessages.begin()); iter!=result->mMessages.end(); ++iter)
+            emit reportMessage (*iter, mType);
 
-    for (Messages::Iterator iter (messages.begin()); iter!=messages.end(); ++iter)
-        emit reportMessage (*iter, mType);
+        if (result->mFailed)
+        {
+            abort();
+            break;
+        }
+    }
+
+    emit progress (mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
 
     if (mCurrentStage==mStages.end())
         operationDone();
@@ -42,7 +42,9 @@ namespace CSMDoc
         public:
 
             Operation (int type, bool ordered, bool finalAlways = false);
-            ///< \param ordered Stages must be executed in the given order.
+            ///< \param ordered Stages must be executed in the given order. If not, steps that are
+            /// flagged as parallel by their stage are spread over the threads of the global
+            /// QThreadPool. Messages are still reported in the order of the stages and steps.
             /// \param finalAlways Execute last stage even if an error occurred during earlier stages.
 
             virtual ~Operation();
@@ -1,3 +1,8 @@
 #include "stage.hpp"
 
 CSMDoc::Stage::~Stage() {}
+
+bool CSMDoc::Stage::isParallel (int stage) const
+{
+    return false;
+}
@@ -23,6 +23,15 @@ namespace CSMDoc
 
             virtual void perform (int stage, Messages& messages) = 0;
             ///< Messages resulting from this stage will be appended to \a messages.
+
+            virtual bool isParallel (int stage) const;
+            ///< May \a stage be performed concurrently with other parallel steps of this and other
+            /// stages? Such steps must only read the document and must not modify the stage itself
+            /// (other than through atomics). A step for which false is returned is only performed
+            /// after all preceding steps are done and before any of the following steps is started.
+            ///
+            /// \note Only used by operations that are not ordered. The default implementation
+            /// returns false.
     };
 }
 
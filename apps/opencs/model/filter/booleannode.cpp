@@ -2,6 +2,11 @@
 
 CSMFilter::BooleanNode::BooleanNode (bool true_) : mTrue (true_) {}
 
+bool CSMFilter::BooleanNode::isTrue() const
+{
+    return mTrue;
+}
+
 bool CSMFilter::BooleanNode::test (const CSMWorld::IdTableBase& table, int row,
     const std::map<int, int>& columns) const
 {
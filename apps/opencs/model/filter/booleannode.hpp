@@ -13,6 +13,8 @@ namespace CSMFilter
 
             BooleanNode (bool true_);
 
+            bool isTrue() const;
+
             virtual bool test (const CSMWorld::IdTableBase& table, int row,
                 const std::map<int, int>& columns) const;
             ///< \return Can the specified table row pass through to filter?
@@ -0,0 +1,343 @@
+#include "compiledfilter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <QRegExp>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QVariant>
+
+#include "../world/collectionbase.hpp"
+#include "../world/columns.hpp"
+
+#include "andnode.hpp"
+#include "booleannode.hpp"
+#include "notnode.hpp"
+#include "ornode.hpp"
+#include "textnode.hpp"
+#include "valuenode.hpp"
+
+namespace
+{
+    /// Below this number of records the overhead of splitting the work outweighs the gain.
+    const int sMinRowsPerThread = 2048;
+
+    int getColumnIndex (int columnId, const std::map<int, int>& columns)
+    {
+        const std::map<int, int>::const_iterator iter = columns.find (columnId);
+
+        if (iter==columns.end())
+            throw std::logic_error ("invalid column in compiled filter");
+
+        return iter->second;
+    }
+
+    class BooleanPredicate : public CSMFilter::CompiledNode
+    {
+            bool mTrue;
+
+        public:
+
+            BooleanPredicate (bool true_) : mTrue (true_) {}
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                return mTrue;
+            }
+    };
+
+    class NotPredicate : public CSMFilter::CompiledNode
+    {
+            std::shared_ptr<CSMFilter::CompiledNode> mChild;
+
+        public:
+
+            NotPredicate (std::shared_ptr<CSMFilter::CompiledNode> child) : mChild (child) {}
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                return !mChild->test (collection, row);
+            }
+    };
+
+    class AndPredicate : public CSMFilter::CompiledNode
+    {
+            std::vector<std::shared_ptr<CSMFilter::CompiledNode> > mChildren;
+
+        public:
+
+            AndPredicate (const std::vector<std::shared_ptr<CSMFilter::CompiledNode> >& children)
+            : mChildren (children) {}
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                for (std::vector<std::shared_ptr<CSMFilter::CompiledNode> >::const_iterator iter (
+                    mChildren.begin()); iter!=mChildren.end(); ++iter)
+                    if (!(*iter)->test (collection, row))
+                        return false;
+
+                return true;
+            }
+    };
+
+    class OrPredicate : public CSMFilter::CompiledNode
+    {
+            std::vector<std::shared_ptr<CSMFilter::CompiledNode> > mChildren;
+
+        public:
+
+            OrPredicate (const std::vector<std::shared_ptr<CSMFilter::CompiledNode> >& children)
+            : mChildren (children) {}
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                for (std::vector<std::shared_ptr<CSMFilter::CompiledNode> >::const_iterator iter (
+                    mChildren.begin()); iter!=mChildren.end(); ++iter)
+                    if ((*iter)->test (collection, row))
+                        return true;
+
+                return false;
+            }
+    };
+
+    /// Same semantics as TextNode::test
+    class TextPredicate : public CSMFilter::CompiledNode
+    {
+            int mColumn;
+            QString mText;
+            QRegExp mRegExp;
+            bool mLiteral; ///< mText does not contain any special characters, i.e. can be compared directly
+            bool mMatchesEmpty;
+            bool mMatchesTrue;
+            bool mMatchesFalse;
+            std::vector<char> mEnumMatches; ///< empty if the column does not have enums
+
+            bool match (const QString& string) const
+            {
+                if (mLiteral)
+                    return string.compare (mText, Qt::CaseInsensitive)==0;
+
+                // exactMatch stores the captured texts, so every call needs its own copy
+                QRegExp regExp (mRegExp);
+                return regExp.exactMatch (string);
+            }
+
+        public:
+
+            TextPredicate (int columnId, int column, const std::string& text)
+            : mColumn (column), mText (QString::fromUtf8 (text.c_str())),
+              mRegExp (mText, Qt::CaseInsensitive), mLiteral (false)
+            {
+                static const QString specialCharacters ("\\^$.[]()*+?{}|");
+
+                mLiteral = true;
+                for (int i=0; i<specialCharacters.size() && mLiteral; ++i)
+                    if (mText.contains (specialCharacters[i]))
+                        mLiteral = false;
+
+                mMatchesEmpty = match (QString());
+                mMatchesTrue = match ("true");
+                mMatchesFalse = match ("false");
+
+                CSMWorld::Columns::ColumnId id = static_cast<CSMWorld::Columns::ColumnId> (columnId);
+
+                if (CSMWorld::Columns::hasEnums (id))
+                {
+                    std::vector<std::string> enums = CSMWorld::Columns::getEnums (id);
+
+                    for (std::vector<std::string>::const_iterator iter (enums.begin()); iter!=enums.end();
+                        ++iter)
+                        mEnumMatches.push_back (match (QString::fromUtf8 (iter->c_str())));
+                }
+            }
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                QVariant data = collection.getData (row, mColumn);
+
+                switch (data.type())
+                {
+                    case QVariant::String:
+
+                        return match (data.toString());
+
+                    case QVariant::Int:
+                    case QVariant::UInt:
+                    {
+                        if (mEnumMatches.empty())
+                            return false;
+
+                        int value = data.toInt();
+
+                        if (value>=0 && value<static_cast<int> (mEnumMatches.size()))
+                            return mEnumMatches[value]!=0;
+
+                        return mMatchesEmpty;
+                    }
+
+                    case QVariant::Bool:
+
+                        return data.toBool() ? mMatchesTrue : mMatchesFalse;
+
+                    default:
+
+                        return mText.isEmpty() && !data.isValid();
+                }
+            }
+    };
+
+    /// Same semantics as ValueNode::test
+    class ValuePredicate : public CSMFilter::CompiledNode
+    {
+            int mColumn;
+            double mLower;
+            double mUpper;
+            CSMFilter::ValueNode::Type mLowerType;
+            CSMFilter::ValueNode::Type mUpperType;
+
+        public:
+
+            ValuePredicate (int column, const CSMFilter::ValueNode& node)
+            : mColumn (column), mLower (node.getLower()), mUpper (node.getUpper()),
+              mLowerType (node.getLowerType()), mUpperType (node.getUpperType())
+            {}
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const
+            {
+                QVariant data = collection.getData (row, mColumn);
+
+                if (data.type()!=QVariant::Double && data.type()!=QVariant::Bool && data.type()!=QVariant::Int &&
+                    data.type()!=QVariant::UInt && data.type()!=static_cast<QVariant::Type> (QMetaType::Float))
+                    return false;
+
+                double value = data.toDouble();
+
+                switch (mLowerType)
+                {
+                    case CSMFilter::ValueNode::Type_Closed: if (value<mLower) return false; break;
+                    case CSMFilter::ValueNode::Type_Open: if (value<=mLower) return false; break;
+                    case CSMFilter::ValueNode::Type_Infinite: break;
+                }
+
+                switch (mUpperType)
+                {
+                    case CSMFilter::ValueNode::Type_Closed: if (value>mUpper) return false; break;
+                    case CSMFilter::ValueNode::Type_Open: if (value>=mUpper) return false; break;
+                    case CSMFilter::ValueNode::Type_Infinite: break;
+                }
+
+                return true;
+            }
+    };
+
+    std::shared_ptr<CSMFilter::CompiledNode> compile (const CSMFilter::Node& node,
+        const std::map<int, int>& columns)
+    {
+        typedef std::shared_ptr<CSMFilter::CompiledNode> Ptr;
+
+        if (const CSMFilter::BooleanNode *boolean = dynamic_cast<const CSMFilter::BooleanNode *> (&node))
+            return Ptr (new BooleanPredicate (boolean->isTrue()));
+
+        if (const CSMFilter::NotNode *not_ = dynamic_cast<const CSMFilter::NotNode *> (&node))
+            return Ptr (new NotPredicate (compile (not_->getChild(), columns)));
+
+        if (const CSMFilter::NAryNode *nary = dynamic_cast<const CSMFilter::NAryNode *> (&node))
+        {
+            std::vector<Ptr> children;
+
+            for (int i=0; i<nary->getSize(); ++i)
+                children.push_back (compile ((*nary)[i], columns));
+
+            if (dynamic_cast<const CSMFilter::AndNode *> (&node))
+                return Ptr (new AndPredicate (children));
+
+            if (dynamic_cast<const CSMFilter::OrNode *> (&node))
+                return Ptr (new OrPredicate (children));
+        }
+
+        if (const CSMFilter::TextNode *text = dynamic_cast<const CSMFilter::TextNode *> (&node))
+        {
+            int column = getColumnIndex (text->getColumnId(), columns);
+
+            // columns that do not exist in this table do not filter anything
+            if (column==-1)
+                return Ptr (new BooleanPredicate (true));
+
+            return Ptr (new TextPredicate (text->getColumnId(), column, text->getText()));
+        }
+
+        if (const CSMFilter::ValueNode *value = dynamic_cast<const CSMFilter::ValueNode *> (&node))
+        {
+            int column = getColumnIndex (value->getColumnId(), columns);
+
+            if (column==-1)
+                return Ptr (new BooleanPredicate (true));
+
+            return Ptr (new ValuePredicate (column, *value));
+        }
+
+        throw std::logic_error ("unsupported node in compiled filter: " + node.toString (false));
+    }
+
+    class FilterTask : public QRunnable
+    {
+            const CSMFilter::CompiledFilter& mFilter;
+            std::vector<char>& mResults;
+            int mBegin;
+            int mEnd;
+            QSemaphore& mDone;
+
+        public:
+
+            FilterTask (const CSMFilter::CompiledFilter& filter, std::vector<char>& results, int begin,
+                int end, QSemaphore& done)
+            : mFilter (filter), mResults (results), mBegin (begin), mEnd (end), mDone (done)
+            {}
+
+            virtual void run()
+            {
+                for (int i=mBegin; i<mEnd; ++i)
+                    mResults[i] = mFilter.test (i);
+
+                mDone.release();
+            }
+    };
+}
+
+CSMFilter::CompiledNode::~CompiledNode() {}
+
+CSMFilter::CompiledFilter::CompiledFilter (const Node& filter, const CSMWorld::CollectionBase& collection,
+    const std::map<int, int>& columns)
+: mCollection (collection), mRoot (compile (filter, columns))
+{}
+
+bool CSMFilter::CompiledFilter::test (int row) const
+{
+    return mRoot->test (mCollection, row);
+}
+
+void CSMFilter::CompiledFilter::test (std::vector<char>& results) const
+{
+    int size = mCollection.getSize();
+
+    results.resize (size);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+
+    int threads = std::max (1, std::min (pool->maxThreadCount(), size / sMinRowsPerThread));
+
+    int chunk = (size + threads - 1) / threads;
+
+    // the first chunk is handled by the calling thread
+    QSemaphore done;
+
+    for (int i=1; i<threads; ++i)
+        pool->start (new FilterTask (*this, results, i * chunk, std::min (size, (i+1) * chunk), done));
+
+    for (int i=0; i<std::min (size, chunk); ++i)
+        results[i] = test (i);
+
+    done.acquire (threads-1);
+}
@@ -0,0 +1,58 @@
+#ifndef CSM_FILTER_COMPILEDFILTER_H
+#define CSM_FILTER_COMPILEDFILTER_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace CSMWorld
+{
+    class CollectionBase;
+}
+
+namespace CSMFilter
+{
+    class Node;
+
+    /// \brief Node of a compiled filter
+    class CompiledNode
+    {
+        public:
+
+            virtual ~CompiledNode();
+
+            virtual bool test (const CSMWorld::CollectionBase& collection, int row) const = 0;
+            ///< \return Can the specified record pass through to filter?
+            ///
+            /// \note Must be safe to call from several threads at once.
+    };
+
+    /// \brief Filter tree compiled for a specific collection
+    ///
+    /// Instead of going through the table model for every cell, the compiled filter reads the
+    /// column data straight from the collection. Everything that only depends on the filter
+    /// (regular expressions, enum names and which of them match) is prepared once.
+    class CompiledFilter
+    {
+            const CSMWorld::CollectionBase& mCollection;
+            std::shared_ptr<CompiledNode> mRoot;
+
+            // not implemented
+            CompiledFilter (const CompiledFilter&);
+            CompiledFilter& operator= (const CompiledFilter&);
+
+        public:
+
+            CompiledFilter (const Node& filter, const CSMWorld::CollectionBase& collection,
+                const std::map<int, int>& columns);
+            ///< \param columns column ID to column index mapping, see Node::test
+
+            bool test (int row) const;
+
+            void test (std::vector<char>& results) const;
+            ///< Test all records of the collection. Large collections are split between the
+            /// threads of the global thread pool.
+    };
+}
+
+#endif
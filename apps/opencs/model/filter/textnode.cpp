@@ -12,6 +12,16 @@ CSMFilter::TextNode::TextNode (int columnId, const std::string& text)
 : mColumnId (columnId), mText (text)
 {}
 
+int CSMFilter::TextNode::getColumnId() const
+{
+    return mColumnId;
+}
+
+const std::string& CSMFilter::TextNode::getText() const
+{
+    return mText;
+}
+
 bool CSMFilter::TextNode::test (const CSMWorld::IdTableBase& table, int row,
     const std::map<int, int>& columns) const
 {
@@ -14,6 +14,10 @@ namespace CSMFilter
 
             TextNode (int columnId, const std::string& text);
 
+            int getColumnId() const;
+
+            const std::string& getText() const;
+
             virtual bool test (const CSMWorld::IdTableBase& table, int row,
                 const std::map<int, int>& columns) const;
             ///< \return Can the specified table row pass through to filter?
@@ -10,6 +10,31 @@ CSMFilter::ValueNode::ValueNode (int columnId, Type lowerType, Type upperType,
     double lower, double upper)
 : mColumnId (columnId), mLower (lower), mUpper (upper), mLowerType (lowerType), mUpperType (upperType){}
 
+int CSMFilter::ValueNode::getColumnId() const
+{
+    return mColumnId;
+}
+
+double CSMFilter::ValueNode::getLower() const
+{
+    return mLower;
+}
+
+double CSMFilter::ValueNode::getUpper() const
+{
+    return mUpper;
+}
+
+CSMFilter::ValueNode::Type CSMFilter::ValueNode::getLowerType() const
+{
+    return mLowerType;
+}
+
+CSMFilter::ValueNode::Type CSMFilter::ValueNode::getUpperType() const
+{
+    return mUpperType;
+}
+
 bool CSMFilter::ValueNode::test (const CSMWorld::IdTableBase& table, int row,
     const std::map<int, int>& columns) const
 {
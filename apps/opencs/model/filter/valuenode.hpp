@@ -27,6 +27,16 @@ namespace CSMFilter
 
             ValueNode (int columnId, Type lowerType, Type upperType, double lower, double upper);
 
+            int getColumnId() const;
+
+            double getLower() const;
+
+            double getUpper() const;
+
+            Type getLowerType() const;
+
+            Type getUpperType() const;
+
             virtual bool test (const CSMWorld::IdTableBase& table, int row,
                 const std::map<int, int>& columns) const;
             ///< \return Can the specified table row pass through to filter?
@@ -121,3 +121,8 @@ std::string CSMTools::GmstCheckStage::varTypeToString(ESM::VarType type)
         default: return "unhandled";
     }
 }
+
+bool CSMTools::GmstCheckStage::isParallel (int stage) const
+{
+    return true;
+}
@@ -77,3 +77,8 @@ void CSMTools::JournalCheckStage::perform(int stage, CSMDoc::Messages& messages)
         messages.add(id, "Journal: multiple infos with quest status \"Named\"", "", CSMDoc::Message::Severity_Error);
     }
 }
+
+bool CSMTools::JournalCheckStage::isParallel (int stage) const
+{
+    return true;
+}
@@ -20,3 +20,8 @@ void CSMTools::MandatoryIdStage::perform (int stage, CSMDoc::Messages& messages)
         mIdCollection.getRecord (mIds.at (stage)).isDeleted())
         messages.add (mCollectionId, "Missing mandatory record: " + mIds.at (stage));
 }
+
+bool CSMTools::MandatoryIdStage::isParallel (int stage) const
+{
+    return true;
+}
@@ -70,3 +70,9 @@ void CSMTools::RaceCheckStage::perform (int stage, CSMDoc::Messages& messages)
     else
         performPerRecord (stage, messages);
 }
+
+bool CSMTools::RaceCheckStage::isParallel (int stage) const
+{
+    // the final step evaluates the playable flag collected by the others
+    return stage<mRaces.getSize();
+}
@@ -1,6 +1,8 @@
 #ifndef CSM_TOOLS_RACECHECK_H
 #define CSM_TOOLS_RACECHECK_H
 
+#include <atomic>
+
 #include <components/esm/loadrace.hpp>
 
 #include "../world/idcollection.hpp"
@@ -13,7 +15,7 @@ namespace CSMTools
     class RaceCheckStage : public CSMDoc::Stage
     {
             const CSMWorld::IdCollection<ESM::Race>& mRaces;
-            bool mPlayable;
+            std::atomic<bool> mPlayable; // set by parallel steps
 
             void performPerRecord (int stage, CSMDoc::Messages& messages);
 
@@ -28,6 +30,8 @@ namespace CSMTools
 
             virtual void perform (int stage, CSMDoc::Messages& messages);
             ///< Messages resulting from this tage will be appended to \a messages.
+
+            virtual bool isParallel (int stage) const;
     };
 }
 
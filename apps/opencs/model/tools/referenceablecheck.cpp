@@ -1033,3 +1033,9 @@ template<typename Tool> void CSMTools::ReferenceableCheckStage::scriptCheck (
             messages.push_back (std::make_pair (someID, someTool.mId + " refers to an unknown script \""+someTool.mScript+"\""));
     }
 }
+
+bool CSMTools::ReferenceableCheckStage::isParallel (int stage) const
+{
+    // the final step evaluates the player flag collected by the others
+    return stage<mReferencables.getSize();
+}
@@ -1,6 +1,8 @@
 #ifndef REFERENCEABLECHECKSTAGE_H
 #define REFERENCEABLECHECKSTAGE_H
 
+#include <atomic>
+
 #include "../world/universalid.hpp"
 #include "../doc/stage.hpp"
 #include "../world/data.hpp"
@@ -19,6 +21,8 @@ namespace CSMTools
                 const CSMWorld::IdCollection<ESM::Script>& scripts);
 
             virtual void perform(int stage, CSMDoc::Messages& messages);
+
+            virtual bool isParallel (int stage) const;
             virtual int setup();
 
         private:
@@ -81,7 +85,7 @@ namespace CSMTools
             const CSMWorld::IdCollection<ESM::Class>& mClasses;
             const CSMWorld::IdCollection<ESM::Faction>& mFactions;
             const CSMWorld::IdCollection<ESM::Script>& mScripts;
-            bool mPlayerPresent;
+            std::atomic<bool> mPlayerPresent; // set by parallel steps
     };
 }
 #endif // REFERENCEABLECHECKSTAGE_H
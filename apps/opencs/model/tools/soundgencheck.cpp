@@ -51,3 +51,8 @@ void CSMTools::SoundGenCheckStage::perform(int stage, CSMDoc::Messages &messages
         messages.push_back(std::make_pair(id, "No such sound '" + soundGen.mSound + "'"));
     }
 }
+
+bool CSMTools::SoundGenCheckStage::isParallel (int stage) const
+{
+    return true;
+}
@@ -28,3 +28,8 @@ int CSMTools::StartScriptCheckStage::setup()
 {
     return mStartScripts.getSize();
 }
+
+bool CSMTools::StartScriptCheckStage::isParallel (int stage) const
+{
+    return true;
+}
@@ -21,6 +21,8 @@ namespace CSMTools
                 const CSMWorld::IdCollection<ESM::Script>& scripts);
 
             virtual void perform(int stage, CSMDoc::Messages& messages);
+
+            virtual bool isParallel (int stage) const;
             virtual int setup();
     };
 }
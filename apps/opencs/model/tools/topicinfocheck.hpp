@@ -46,6 +46,8 @@ namespace CSMTools
         virtual void perform(int step, CSMDoc::Messages& messages);
         ///< Messages resulting from this stage will be appended to \a messages
 
+        virtual bool isParallel (int stage) const;
+
     private:
 
         const CSMWorld::InfoCollection& mTopicInfos;
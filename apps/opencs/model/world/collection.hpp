@@ -4,6 +4,8 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <cctype>
 #include <stdexcept>
 #include <functional>
@@ -53,10 +55,24 @@ namespace CSMWorld
             std::map<std::string, int> mIndex;
             std::vector<Column<ESXRecordT> *> mColumns;
 
+            // mIndex entry of each record, in the same order as mRecords. Moving records only moves
+            // these entries. The indices stored in mIndex are updated when they are needed next.
+            std::vector<std::map<std::string, int>::iterator> mIndexEntries;
+
+            // Entries of mIndex with an index below this value are up to date. Updating the index
+            // is locked, because const functions may be called from several threads at once.
+            mutable std::atomic<int> mFirstOutdatedIndex;
+            mutable std::mutex mIndexMutex;
+
             // not implemented
             Collection (const Collection&);
             Collection& operator= (const Collection&);
 
+            void updateIndex() const;
+
+            void invalidateIndex (int index);
+            ///< Flag the indices of the records starting at \a index as outdated.
+
         protected:
 
             const std::map<std::string, int>& getIdMap() const;
@@ -158,9 +174,33 @@ namespace CSMWorld
             NestableColumn *getNestableColumn (int column) const;
     };
 
+    template<typename ESXRecordT, typename IdAccessorT>
+    void Collection<ESXRecordT, IdAccessorT>::updateIndex() const
+    {
+        int size = static_cast<int> (mIndexEntries.size());
+
+        if (mFirstOutdatedIndex.load (std::memory_order_acquire)>=size)
+            return;
+
+        std::lock_guard<std::mutex> lock (mIndexMutex);
+
+        for (int i=mFirstOutdatedIndex.load (std::memory_order_relaxed); i<size; ++i)
+            mIndexEntries[i]->second = i;
+
+        mFirstOutdatedIndex.store (size, std::memory_order_release);
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT>
+    void Collection<ESXRecordT, IdAccessorT>::invalidateIndex (int index)
+    {
+        if (index<mFirstOutdatedIndex)
+            mFirstOutdatedIndex = index;
+    }
+
     template<typename ESXRecordT, typename IdAccessorT>
     const std::map<std::string, int>& Collection<ESXRecordT, IdAccessorT>::getIdMap() const
     {
+        updateIndex();
         return mIndex;
     }
 
@@ -196,10 +236,14 @@ namespace CSMWorld
             std::copy (buffer.begin(), buffer.end(), mRecords.begin()+baseIndex);
 
             // adjust index
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                 ++iter)
-                if (iter->second>=baseIndex && iter->second<baseIndex+size)
-                    iter->second = newOrder.at (iter->second-baseIndex)+baseIndex;
+            std::vector<std::map<std::string, int>::iterator> entries (size);
+
+            for (int i=0; i<size; ++i)
+                entries[newOrder[i]] = mIndexEntries[baseIndex+i];
+
+            std::copy (entries.begin(), entries.end(), mIndexEntries.begin()+baseIndex);
+
+            invalidateIndex (baseIndex);
         }
 
         return true;
@@ -220,6 +264,7 @@ namespace CSMWorld
 
     template<typename ESXRecordT, typename IdAccessorT>
     Collection<ESXRecordT, IdAccessorT>::Collection()
+    : mFirstOutdatedIndex (0)
     {}
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -234,9 +279,9 @@ namespace CSMWorld
     {
         std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record));
 
-        std::map<std::string, int>::iterator iter = mIndex.find (id);
+        int index = searchId (id);
 
-        if (iter==mIndex.end())
+        if (index==-1)
         {
             Record<ESXRecordT> record2;
             record2.mState = Record<ESXRecordT>::State_ModifiedOnly;
@@ -246,7 +291,7 @@ namespace CSMWorld
         }
         else
         {
-            mRecords[iter->second].setModified (record);
+            mRecords[index].setModified (record);
         }
     }
 
@@ -324,41 +369,48 @@ namespace CSMWorld
     template<typename ESXRecordT, typename IdAccessorT>
     void  Collection<ESXRecordT, IdAccessorT>::purge()
     {
-        int i = 0;
+        // remove all erased records in a single pass
+        int size = static_cast<int> (mRecords.size());
+        int kept = 0;
 
-        while (i<static_cast<int> (mRecords.size()))
+        for (int i=0; i<size; ++i)
         {
             if (mRecords[i].isErased())
-                removeRows (i, 1);
-            else
-                ++i;
+            {
+                mIndex.erase (mIndexEntries[i]);
+                continue;
+            }
+
+            if (kept!=i)
+            {
+                mRecords[kept] = mRecords[i];
+                mIndexEntries[kept] = mIndexEntries[i];
+            }
+
+            ++kept;
+        }
+
+        if (kept<size)
+        {
+            mRecords.erase (mRecords.begin()+kept, mRecords.end());
+            mIndexEntries.erase (mIndexEntries.begin()+kept, mIndexEntries.end());
+            invalidateIndex (0);
         }
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
     void Collection<ESXRecordT, IdAccessorT>::removeRows (int index, int count)
     {
-        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
+        if (index<0 || count<0 || index+count>static_cast<int> (mRecords.size()))
+            throw std::runtime_error ("index out of range");
 
-        typename std::map<std::string, int>::iterator iter = mIndex.begin();
+        for (int i=index; i<index+count; ++i)
+            mIndex.erase (mIndexEntries[i]);
 
-        while (iter!=mIndex.end())
-        {
-            if (iter->second>=index)
-            {
-                if (iter->second>=index+count)
-                {
-                    iter->second -= count;
-                    ++iter;
-                }
-                else
-                {
-                    mIndex.erase (iter++);
-                }
-            }
-            else
-                ++iter;
-        }
+        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
+        mIndexEntries.erase (mIndexEntries.begin()+index, mIndexEntries.begin()+index+count);
+
+        invalidateIndex (index);
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -386,6 +438,8 @@ namespace CSMWorld
         if (iter==mIndex.end())
             return -1;
 
+        updateIndex();
+
         return iter->second;
     }
 
@@ -416,6 +470,8 @@ namespace CSMWorld
     {
         std::vector<std::string> ids;
 
+        updateIndex();
+
         for (typename std::map<std::string, int>::const_iterator iter = mIndex.begin();
             iter!=mIndex.end(); ++iter)
         {
@@ -448,18 +504,21 @@ namespace CSMWorld
 
         const Record<ESXRecordT>& record2 = dynamic_cast<const Record<ESXRecordT>&> (record);
 
+        std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record2.get()));
+
+        if (mIndex.find (id)!=mIndex.end())
+            throw std::runtime_error ("duplicate ID: " + id);
+
         mRecords.insert (mRecords.begin()+index, record2);
 
-        if (index<static_cast<int> (mRecords.size())-1)
-        {
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                ++iter)
-                 if (iter->second>=index)
-                     ++(iter->second);
-        }
+        std::map<std::string, int>::iterator entry = mIndex.insert (std::make_pair (id, index)).first;
+        mIndexEntries.insert (mIndexEntries.begin()+index, entry);
 
-        mIndex.insert (std::make_pair (Misc::StringUtils::lowerCase (IdAccessorT().getId (
-            record2.get())), index));
+        // appending does not move any other record
+        if (index==static_cast<int> (mRecords.size())-1 && index==mFirstOutdatedIndex)
+            ++mFirstOutdatedIndex;
+        else
+            invalidateIndex (index);
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
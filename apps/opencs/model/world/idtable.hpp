@@ -89,6 +89,10 @@ namespace CSMWorld
 
             virtual int getColumnId(int column) const;
 
+            const CollectionBase& getCollection() const;
+            ///< For read access that bypasses the model interface (e.g. filtering). Row and column
+            /// indices of the collection and the table are the same.
+
         protected:
 
             virtual CollectionBase *idCollection() const;
@@ -2,7 +2,7 @@
 
 #include <vector>
 
-#include "idtablebase.hpp"
+#include "idtable.hpp"
 
 namespace
 {
@@ -21,15 +21,34 @@ void CSMWorld::IdTableProxyModel::updateColumnMap()
     Q_ASSERT(mSourceModel != NULL);
 
     mColumnMap.clear();
+    mCompiledFilter.reset();
     if (mFilter)
     {
         std::vector<int> columns = mFilter->getReferencedColumns();
         for (std::vector<int>::const_iterator iter (columns.begin()); iter!=columns.end(); ++iter)
             mColumnMap.insert (std::make_pair (*iter, 
                 mSourceModel->searchColumnIndex (static_cast<CSMWorld::Columns::ColumnId> (*iter))));
+
+        // Other source models go through the table interface
+        if (const IdTable *table = dynamic_cast<const IdTable *> (mSourceModel))
+            mCompiledFilter.reset (
+                new CSMFilter::CompiledFilter (*mFilter, table->getCollection(), mColumnMap));
     }
 }
 
+void CSMWorld::IdTableProxyModel::evaluateFilter()
+{
+    mFilterResults.clear();
+
+    if (mCompiledFilter)
+        mCompiledFilter->test (mFilterResults);
+}
+
+void CSMWorld::IdTableProxyModel::clearFilterResults()
+{
+    mFilterResults.clear();
+}
+
 bool CSMWorld::IdTableProxyModel::filterAcceptsRow (int sourceRow, const QModelIndex& sourceParent)
     const
 {
@@ -46,6 +65,12 @@ bool CSMWorld::IdTableProxyModel::filterAcceptsRow (int sourceRow, const QModelI
     if (!mFilter)
         return true;
 
+    if (sourceRow < static_cast<int> (mFilterResults.size()))
+        return mFilterResults[sourceRow]!=0;
+
+    if (mCompiledFilter)
+        return mCompiledFilter->test (sourceRow);
+
     return mFilter->test (*mSourceModel, sourceRow, mColumnMap);
 }
 
@@ -65,6 +90,19 @@ QModelIndex CSMWorld::IdTableProxyModel::getModelIndex (const std::string& id, i
 
 void CSMWorld::IdTableProxyModel::setSourceModel(QAbstractItemModel *model)
 {
+    // Connected before QSortFilterProxyModel connects its own slots, so that outdated filter
+    // results are dropped before the proxy re-filters the affected rows
+    connect(model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+            this, SLOT(clearFilterResults()));
+    connect(model, SIGNAL(rowsAboutToBeInserted(const QModelIndex &, int, int)),
+            this, SLOT(clearFilterResults()));
+    connect(model, SIGNAL(rowsAboutToBeRemoved(const QModelIndex &, int, int)),
+            this, SLOT(clearFilterResults()));
+    connect(model, SIGNAL(rowsAboutToBeMoved(const QModelIndex &, int, int, const QModelIndex &, int)),
+            this, SLOT(clearFilterResults()));
+    connect(model, SIGNAL(modelAboutToBeReset()), this, SLOT(clearFilterResults()));
+    connect(model, SIGNAL(layoutAboutToBeChanged()), this, SLOT(clearFilterResults()));
+
     QSortFilterProxyModel::setSourceModel(model);
 
     mSourceModel = dynamic_cast<IdTableBase *>(sourceModel());
@@ -87,6 +125,7 @@ void CSMWorld::IdTableProxyModel::setFilter (const std::shared_ptr<CSMFilter::No
     beginResetModel();
     mFilter = filter;
     updateColumnMap();
+    evaluateFilter();
     endResetModel();
 }
 
@@ -122,6 +161,7 @@ QString CSMWorld::IdTableProxyModel::getRecordId(int sourceRow) const
 void CSMWorld::IdTableProxyModel::refreshFilter()
 {
     updateColumnMap();
+    evaluateFilter();
     invalidateFilter();
 }
 
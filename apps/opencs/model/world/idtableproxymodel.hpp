@@ -8,6 +8,7 @@
 #include <QSortFilterProxyModel>
 
 #include "../filter/node.hpp"
+#include "../filter/compiledfilter.hpp"
 
 #include "columns.hpp"
 
@@ -20,6 +21,13 @@ namespace CSMWorld
             std::shared_ptr<CSMFilter::Node> mFilter;
             std::map<int, int> mColumnMap; // column ID, column index in this model (or -1)
 
+            // mFilter compiled against the collection of the source model, if it has one
+            std::shared_ptr<CSMFilter::CompiledFilter> mCompiledFilter;
+
+            // Results of mCompiledFilter for all source rows, evaluated in one go before the proxy
+            // re-filters. Dropped as soon as the source model changes.
+            std::vector<char> mFilterResults;
+
             // Cache of enum values for enum columns (e.g. Modified, Record Type).
             // Used to speed up comparisons during the sort by such columns.
             typedef std::map<Columns::ColumnId, std::vector<std::string> > EnumColumnCache;
@@ -33,6 +41,8 @@ namespace CSMWorld
 
             void updateColumnMap();
 
+            void evaluateFilter();
+
         public:
 
             IdTableProxyModel (QObject *parent = 0);
@@ -53,6 +63,10 @@ namespace CSMWorld
 
             QString getRecordId(int sourceRow) const;
 
+        private slots:
+
+            void clearFilterResults();
+
         protected slots:
 
             virtual void sourceRowsInserted(const QModelIndex &parent, int start, int end);
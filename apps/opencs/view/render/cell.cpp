@@ -5,16 +5,22 @@
 #include <osg/Geometry>
 #include <osg/Group>
 
+#include <set>
+
 #include <components/misc/stringops.hpp>
 #include <components/esm/loadcell.hpp>
 #include <components/esm/loadland.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/pathgridutil.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/terrain/terraingrid.hpp>
 
 #include "../../model/world/idtable.hpp"
 #include "../../model/world/columns.hpp"
 #include "../../model/world/data.hpp"
 #include "../../model/world/refcollection.hpp"
+#include "../../model/world/refidcollection.hpp"
 #include "../../model/world/cellcoordinates.hpp"
 
 #include "cellwater.hpp"
@@ -26,6 +32,62 @@
 #include "terrainstorage.hpp"
 #include "object.hpp"
 
+namespace CSVRender
+{
+    /// \brief Loads the models of a cell into the resource cache
+    ///
+    /// The loaded models are kept alive until the item is destroyed, so that building the
+    /// objects of the cell afterwards on the main thread only has to copy cached data.
+    ///
+    /// \note Only the resource system is touched, which is thread-safe. The terrain reads the
+    /// land records of the document, which may be modified by the main thread at any time, so
+    /// it is built by the main thread.
+    class CellLoadItem : public SceneUtil::WorkItem
+    {
+            std::vector<std::string> mModels;
+            Resource::SceneManager *mSceneManager;
+            volatile bool mAbort;
+            std::vector<osg::ref_ptr<const osg::Object> > mLoaded;
+
+        public:
+
+            CellLoadItem (const std::vector<std::string>& models,
+                Resource::SceneManager *sceneManager);
+
+            virtual void abort();
+
+            virtual const char* getName() const { return "CellLoadItem"; }
+
+            virtual void doWork();
+    };
+}
+
+CSVRender::CellLoadItem::CellLoadItem (const std::vector<std::string>& models,
+    Resource::SceneManager *sceneManager)
+: mModels (models), mSceneManager (sceneManager), mAbort (false)
+{}
+
+void CSVRender::CellLoadItem::abort()
+{
+    mAbort = true;
+}
+
+void CSVRender::CellLoadItem::doWork()
+{
+    for (std::vector<std::string>::const_iterator iter (mModels.begin());
+        iter!=mModels.end() && !mAbort; ++iter)
+    {
+        try
+        {
+            mLoaded.push_back (mSceneManager->getTemplate (*iter));
+        }
+        catch (std::exception&)
+        {
+            // loading the model again on the main thread will report the error
+        }
+    }
+}
+
 bool CSVRender::Cell::removeObject (const std::string& id)
 {
     std::map<std::string, Object *>::iterator iter =
@@ -75,8 +137,39 @@ bool CSVRender::Cell::addObjects (int start, int end)
     return modified;
 }
 
+void CSVRender::Cell::listModels (std::vector<std::string>& models) const
+{
+    const CSMWorld::RefCollection& collection = mData.getReferences();
+    const CSMWorld::RefIdCollection& referenceables = mData.getReferenceables();
+
+    int modelColumn = referenceables.findColumnIndex (CSMWorld::Columns::ColumnId_Model);
+
+    std::set<std::string> listed;
+
+    for (int i=0; i<collection.getSize(); ++i)
+    {
+        const CSMWorld::Record<CSMWorld::CellRef>& record = collection.getRecord (i);
+
+        if (record.mState==CSMWorld::RecordBase::State_Deleted ||
+            Misc::StringUtils::lowerCase (record.get().mCell)!=mId)
+            continue;
+
+        int index = referenceables.searchId (record.get().mRefID);
+
+        if (index==-1)
+            continue;
+
+        std::string model =
+            referenceables.getData (index, modelColumn).toString().toUtf8().constData();
+
+        // same path as used by Object
+        if (!model.empty() && listed.insert (Misc::StringUtils::lowerCase (model)).second)
+            models.push_back ("meshes\\" + model);
+    }
+}
+
 CSVRender::Cell::Cell (CSMWorld::Data& data, osg::Group* rootNode, const std::string& id,
-    bool deleted)
+    bool deleted, SceneUtil::WorkQueue *workQueue)
 : mData (data), mId (Misc::StringUtils::lowerCase (id)), mDeleted (deleted), mSubMode (0),
   mSubModeElementMask (0)
 {
@@ -92,13 +185,6 @@ CSVRender::Cell::Cell (CSMWorld::Data& data, osg::Group* rootNode, const std::st
 
     if (!mDeleted)
     {
-        CSMWorld::IdTable& references = dynamic_cast<CSMWorld::IdTable&> (
-            *mData.getTableModel (CSMWorld::UniversalId::Type_References));
-
-        int rows = references.rowCount();
-
-        addObjects (0, rows-1);
-
         const CSMWorld::IdCollection<CSMWorld::Land>& land = mData.getLand();
         int landIndex = land.searchId(mId);
         if (landIndex != -1)
@@ -108,8 +194,6 @@ CSVRender::Cell::Cell (CSMWorld::Data& data, osg::Group* rootNode, const std::st
             if (esmLand.getLandData (ESM::Land::DATA_VHGT))
             {
                 mTerrain.reset(new Terrain::TerrainGrid(mCellNode, mCellNode, data.getResourceSystem().get(), new TerrainStorage(mData), Mask_Terrain));
-                mTerrain->loadCell(esmLand.mX,
-                                   esmLand.mY);
 
                 mCellBorder.reset(new CellBorder(mCellNode, mCoordinates));
                 mCellBorder->buildShape(esmLand);
@@ -118,11 +202,32 @@ CSVRender::Cell::Cell (CSMWorld::Data& data, osg::Group* rootNode, const std::st
 
         mPathgrid.reset(new Pathgrid(mData, mCellNode, mId, mCoordinates));
         mCellWater.reset(new CellWater(mData, mCellNode, mId, mCoordinates));
+
+        if (workQueue)
+        {
+            std::vector<std::string> models;
+            listModels (models);
+
+            mLoadItem = new CellLoadItem (models, data.getResourceSystem()->getSceneManager());
+
+            workQueue->addWorkItem (mLoadItem);
+        }
+        else
+        {
+            addObjects (0, mData.getReferences().getSize()-1);
+
+            if (mTerrain)
+                mTerrain->loadCell (mCoordinates.getX(), mCoordinates.getY());
+        }
     }
 }
 
 CSVRender::Cell::~Cell()
 {
+    // the item only refers to the resource system, so it may finish on its own
+    if (mLoadItem)
+        mLoadItem->abort();
+
     for (std::map<std::string, Object *>::iterator iter (mObjects.begin());
         iter!=mObjects.end(); ++iter)
         delete iter->second;
@@ -130,6 +235,27 @@ CSVRender::Cell::~Cell()
     mCellNode->getParent(0)->removeChild(mCellNode);
 }
 
+bool CSVRender::Cell::isLoading() const
+{
+    return mLoadItem.valid();
+}
+
+bool CSVRender::Cell::updateLoading()
+{
+    if (!mLoadItem || !mLoadItem->isDone())
+        return false;
+
+    addObjects (0, mData.getReferences().getSize()-1);
+
+    if (mTerrain)
+        mTerrain->loadCell (mCoordinates.getX(), mCoordinates.getY());
+
+    // releases the cached data only after it has been used
+    mLoadItem = 0;
+
+    return true;
+}
+
 CSVRender::Pathgrid* CSVRender::Cell::getPathgrid() const
 {
     return mPathgrid.get();
@@ -167,7 +293,8 @@ bool CSVRender::Cell::referenceableAboutToBeRemoved (const QModelIndex& parent,
 bool CSVRender::Cell::referenceDataChanged (const QModelIndex& topLeft,
     const QModelIndex& bottomRight)
 {
-    if (mDeleted)
+    // objects are created from the current state of the references once loading has finished
+    if (mDeleted || mLoadItem)
         return false;
 
     CSMWorld::IdTable& references = dynamic_cast<CSMWorld::IdTable&> (
@@ -244,7 +371,7 @@ bool CSVRender::Cell::referenceAboutToBeRemoved (const QModelIndex& parent, int
     if (parent.isValid())
         return false;
 
-    if (mDeleted)
+    if (mDeleted || mLoadItem)
         return false;
 
     CSMWorld::IdTable& references = dynamic_cast<CSMWorld::IdTable&> (
@@ -267,7 +394,7 @@ bool CSVRender::Cell::referenceAdded (const QModelIndex& parent, int start, int
     if (parent.isValid())
         return false;
 
-    if (mDeleted)
+    if (mDeleted || mLoadItem)
         return false;
 
     return addObjects (start, end);
@@ -29,8 +29,14 @@ namespace Terrain
     class TerrainGrid;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace CSVRender
 {
+    class CellLoadItem;
     class CellWater;
     class Pathgrid;
     class TagBase;
@@ -57,6 +63,7 @@ namespace CSVRender
             bool mDeleted;
             int mSubMode;
             unsigned int mSubModeElementMask;
+            osg::ref_ptr<CellLoadItem> mLoadItem;
 
             /// Ignored if cell does not have an object with the given ID.
             ///
@@ -72,6 +79,9 @@ namespace CSVRender
             /// \return Have any objects been added?
             bool addObjects (int start, int end);
 
+            /// Models of the objects that addObjects would add for the whole reference table.
+            void listModels (std::vector<std::string>& models) const;
+
         public:
 
             enum Selection
@@ -85,11 +95,25 @@ namespace CSVRender
 
             /// \note Deleted covers both cells that are deleted and cells that don't exist in
             /// the first place.
+            ///
+            /// \param workQueue If not 0, the models of the cell are read into the resource cache on
+            /// the threads of the queue. Objects and terrain are only added to the cell by
+            /// updateLoading, once the models are ready.
             Cell (CSMWorld::Data& data, osg::Group* rootNode, const std::string& id,
-                bool deleted = false);
+                bool deleted = false, SceneUtil::WorkQueue *workQueue = 0);
 
+            /// \note Aborts a background load without waiting for it.
             ~Cell();
 
+            /// Are the models of the cell still being loaded in the background?
+            bool isLoading() const;
+
+            /// Add objects and terrain to the cell, if the background load of their models has
+            /// finished.
+            ///
+            /// \return Has the cell finished loading with this call?
+            bool updateLoading();
+
             /// \note Returns the pathgrid representation which will exist as long as the cell exists
             Pathgrid* getPathgrid() const;
 
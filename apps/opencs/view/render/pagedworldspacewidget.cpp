@@ -1,12 +1,15 @@
 #include "pagedworldspacewidget.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
 #include <QMouseEvent>
 #include <QApplication>
+#include <QThread>
 
 #include <components/esm/loadland.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../../model/prefs/shortcut.hpp"
 
@@ -22,6 +25,32 @@
 #include "cameracontroller.hpp"
 #include "cellarrow.hpp"
 
+namespace
+{
+    /// Milliseconds between checks for cells that have finished loading
+    const int sLoadInterval = 10;
+
+    class CompareDistance
+    {
+            osg::Vec2f mCentre;
+
+            float getDistance2 (const CSMWorld::CellCoordinates& coordinates) const
+            {
+                return (osg::Vec2f (coordinates.getX()+0.5f, coordinates.getY()+0.5f) - mCentre).length2();
+            }
+
+        public:
+
+            CompareDistance (const osg::Vec2f& centre) : mCentre (centre) {}
+
+            bool operator() (const CSMWorld::CellCoordinates& left,
+                const CSMWorld::CellCoordinates& right) const
+            {
+                return getDistance2 (left)<getDistance2 (right);
+            }
+    };
+}
+
 bool CSVRender::PagedWorldspaceWidget::adjustCells()
 {
     bool modified = false;
@@ -55,10 +84,13 @@ bool CSVRender::PagedWorldspaceWidget::adjustCells()
                     modified = true;
 
                     std::unique_ptr<Cell> cell (new Cell (mDocument.getData(), mRootNode,
-                        iter->first.getId (mWorldspace), deleted));
+                        iter->first.getId (mWorldspace), deleted, mWorkQueue.get()));
 
                     delete iter->second;
                     iter->second = cell.release();
+
+                    if (iter->second->isLoading() && !mLoadTimer.isActive())
+                        mLoadTimer.start();
                 }
                 else if (!deleted)
                 {
@@ -78,16 +110,20 @@ bool CSVRender::PagedWorldspaceWidget::adjustCells()
     }
 
     // add
+    std::vector<CSMWorld::CellCoordinates> added;
+
     for (CSMWorld::CellSelection::Iterator iter (mSelection.begin()); iter!=mSelection.end();
         ++iter)
     {
         if (mCells.find (*iter)==mCells.end())
         {
-            addCellToScene (*iter);
+            added.push_back (*iter);
             modified = true;
         }
     }
 
+    addCellsToScene (added);
+
     if (modified)
     {
         for (std::map<CSMWorld::CellCoordinates, Cell *>::const_iterator iter (mCells.begin());
@@ -380,13 +416,44 @@ void CSVRender::PagedWorldspaceWidget::addCellToScene (
 
     std::unique_ptr<Cell> cell (
         new Cell (mDocument.getData(), mRootNode, coordinates.getId (mWorldspace),
-        deleted));
+        deleted, mWorkQueue.get()));
     EditMode *editMode = getEditMode();
     cell->setSubMode (editMode->getSubMode(), editMode->getInteractionMask());
 
+    if (cell->isLoading() && !mLoadTimer.isActive())
+        mLoadTimer.start();
+
     mCells.insert (std::make_pair (coordinates, cell.release()));
 }
 
+void CSVRender::PagedWorldspaceWidget::addCellsToScene (
+    std::vector<CSMWorld::CellCoordinates> coordinates)
+{
+    // the work queue processes the cells in the order they are added
+    std::sort (coordinates.begin(), coordinates.end(), CompareDistance (getLoadingCentre()));
+
+    for (std::vector<CSMWorld::CellCoordinates>::const_iterator iter (coordinates.begin());
+        iter!=coordinates.end(); ++iter)
+        addCellToScene (*iter);
+}
+
+osg::Vec2f CSVRender::PagedWorldspaceWidget::getLoadingCentre() const
+{
+    const int cellSize = 8192;
+
+    // the camera has not been placed yet
+    if ((!mCamPositionSet || mCameraSetupPending) && mSelection.getSize()>0)
+    {
+        CSMWorld::CellCoordinates centre = mSelection.getCentre();
+        return osg::Vec2f (centre.getX()+0.5f, centre.getY()+0.5f);
+    }
+
+    osg::Vec3d eye, center, up;
+    mView->getCamera()->getViewMatrixAsLookAt (eye, center, up);
+
+    return osg::Vec2f (center.x()/cellSize, center.y()/cellSize);
+}
+
 void CSVRender::PagedWorldspaceWidget::removeCellFromScene (
     const CSMWorld::CellCoordinates& coordinates)
 {
@@ -404,15 +471,19 @@ void CSVRender::PagedWorldspaceWidget::addCellSelection (int x, int y)
     CSMWorld::CellSelection newSelection = mSelection;
     newSelection.move (x, y);
 
+    std::vector<CSMWorld::CellCoordinates> added;
+
     for (CSMWorld::CellSelection::Iterator iter (newSelection.begin()); iter!=newSelection.end();
         ++iter)
     {
         if (mCells.find (*iter)==mCells.end())
         {
-            addCellToScene (*iter);
+            added.push_back (*iter);
             mSelection.add (*iter);
         }
     }
+
+    addCellsToScene (added);
 }
 
 void CSVRender::PagedWorldspaceWidget::moveCellSelection (int x, int y)
@@ -427,14 +498,18 @@ void CSVRender::PagedWorldspaceWidget::moveCellSelection (int x, int y)
             removeCellFromScene (*iter);
     }
 
+    std::vector<CSMWorld::CellCoordinates> added;
+
     for (CSMWorld::CellSelection::Iterator iter (newSelection.begin()); iter!=newSelection.end();
         ++iter)
     {
         if (!mSelection.has (*iter))
-            addCellToScene (*iter);
+            added.push_back (*iter);
     }
 
     mSelection = newSelection;
+
+    addCellsToScene (added);
 }
 
 void CSVRender::PagedWorldspaceWidget::addCellToSceneFromCamera (int offsetX, int offsetY)
@@ -460,8 +535,13 @@ void CSVRender::PagedWorldspaceWidget::addCellToSceneFromCamera (int offsetX, in
 
 CSVRender::PagedWorldspaceWidget::PagedWorldspaceWidget (QWidget* parent, CSMDoc::Document& document)
 : WorldspaceWidget (document, parent), mDocument (document), mWorldspace ("std::default"),
-  mControlElements(NULL), mDisplayCellCoord(true)
+  mControlElements(NULL), mDisplayCellCoord(true),
+  mWorkQueue (new SceneUtil::WorkQueue (std::max (1, QThread::idealThreadCount()-1))),
+  mCameraSetupPending (false)
 {
+    mLoadTimer.setInterval (sLoadInterval);
+    connect (&mLoadTimer, SIGNAL (timeout()), this, SLOT (finishLoadingCell()));
+
     QAbstractItemModel *cells =
         document.getData().getTableModel (CSMWorld::UniversalId::Type_Cells);
 
@@ -531,6 +611,13 @@ void CSVRender::PagedWorldspaceWidget::useViewHint (const std::string& hint)
         }
 
         setCellSelection (selection);
+
+        // place the camera once there is something to look at
+        if (!mCamPositionSet && mLoadTimer.isActive())
+        {
+            mCamPositionSet = true;
+            mCameraSetupPending = true;
+        }
     }
 }
 
@@ -763,6 +850,41 @@ void CSVRender::PagedWorldspaceWidget::cellAdded (const QModelIndex& index, int
         flagAsModified();
 }
 
+void CSVRender::PagedWorldspaceWidget::finishLoadingCell()
+{
+    std::vector<CSMWorld::CellCoordinates> loading;
+
+    for (std::map<CSMWorld::CellCoordinates, Cell *>::const_iterator iter (mCells.begin());
+        iter!=mCells.end(); ++iter)
+        if (iter->second->isLoading())
+            loading.push_back (iter->first);
+
+    std::sort (loading.begin(), loading.end(), CompareDistance (getLoadingCentre()));
+
+    // one cell at a time, to keep the UI responsive
+    for (std::vector<CSMWorld::CellCoordinates>::iterator iter (loading.begin());
+        iter!=loading.end(); ++iter)
+    {
+        if (mCells[*iter]->updateLoading())
+        {
+            loading.erase (iter);
+            flagAsModified();
+            break;
+        }
+    }
+
+    if (loading.empty())
+    {
+        mLoadTimer.stop();
+
+        if (mCameraSetupPending)
+        {
+            mCameraSetupPending = false;
+            mCamPositionSet = false;
+        }
+    }
+}
+
 void CSVRender::PagedWorldspaceWidget::loadCameraCell()
 {
     addCellToSceneFromCamera(0, 0);
@@ -2,6 +2,12 @@
 #define OPENCS_VIEW_PAGEDWORLDSPACEWIDGET_H
 
 #include <map>
+#include <vector>
+
+#include <QTimer>
+
+#include <osg/ref_ptr>
+#include <osg/Vec2f>
 
 #include "../../model/world/cellselection.hpp"
 
@@ -14,6 +20,11 @@ namespace CSVWidget
    class SceneToolToggle2;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace CSVRender
 {
     class TextOverlay;
@@ -29,6 +40,9 @@ namespace CSVRender
             std::string mWorldspace;
             CSVWidget::SceneToolToggle2 *mControlElements;
             bool mDisplayCellCoord;
+            osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            QTimer mLoadTimer;
+            bool mCameraSetupPending;
 
         private:
 
@@ -63,6 +77,15 @@ namespace CSVRender
             /// \note Does not update the view or any cell marker
             void addCellToScene (const CSMWorld::CellCoordinates& coordinates);
 
+            /// Add cells in the order they should be loaded in, i.e. nearest to the camera
+            /// first.
+            ///
+            /// \note Does not update the view or any cell marker
+            void addCellsToScene (std::vector<CSMWorld::CellCoordinates> coordinates);
+
+            /// Cell coordinates (in cell units) around which cells are loaded first.
+            osg::Vec2f getLoadingCentre() const;
+
             /// \note Does not update the view or any cell marker
             ///
             /// \note Calling this function for a cell that is not in the selection is a no-op.
@@ -155,6 +178,9 @@ namespace CSVRender
 
             virtual void cellAdded (const QModelIndex& index, int start, int end);
 
+            /// Add the next cell whose background load has finished to the scene.
+            void finishLoadingCell();
+
             void loadCameraCell();
 
             void loadEastCell();
@@ -20,8 +20,10 @@ namespace CSVRender
         if (index == -1)
             return NULL;
 
+        // The editor keeps all land data loaded (see CSMWorld::Data::continueLoading), so share it instead of copying
         const ESM::Land& land = mData.getLand().getRecord(index).get();
-        return new ESMTerrain::LandObject(&land, ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX);
+        return new ESMTerrain::LandObject(&land, ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX,
+                                          ESMTerrain::LandObject::Data_Shared);
     }
 
     const ESM::LandTexture* TerrainStorage::getLandTexture(int index, short plugin)
@@ -11,6 +11,7 @@
 #include <SDL.h>
 
 #include <components/misc/rng.hpp>
+#include <components/misc/trace.hpp>
 
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
@@ -20,6 +21,7 @@
 
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/resource/imagemanager.hpp>
 #include <components/resource/stats.hpp>
 
 #include <components/compiler/extensions0.hpp>
@@ -87,7 +89,10 @@ void OMW::Engine::frame(float frametime)
         mEnvironment.setFrameDuration (frametime);
 
         // update input
-        mEnvironment.getInputManager()->update(frametime, false);
+        {
+            Misc::ScopedTrace trace("Input");
+            mEnvironment.getInputManager()->update(frametime, false);
+        }
 
         // When the window is minimized, pause the game. Currently this *has* to be here to work around a MyGUI bug.
         // If we are not currently rendering, then RenderItems will not be reused resulting in a memory leak upon changing widget textures (fixed in MyGUI 3.3.2),
@@ -97,7 +102,10 @@ void OMW::Engine::frame(float frametime)
 
         // sound
         if (mUseSound)
+        {
+            Misc::ScopedTrace trace("Sound");
             mEnvironment.getSoundManager()->update(frametime);
+        }
 
         // Main menu opened? Then scripts are also paused.
         bool paused = mEnvironment.getWindowManager()->containsMode(MWGui::GM_MainMenu);
@@ -115,6 +123,8 @@ void OMW::Engine::frame(float frametime)
             {
                 if (mEnvironment.getWorld()->getScriptsEnabled())
                 {
+                    Misc::ScopedTrace trace("Scripts");
+
                     // local scripts
                     executeLocalScripts();
 
@@ -138,6 +148,7 @@ void OMW::Engine::frame(float frametime)
         if (mEnvironment.getStateManager()->getState()!=
             MWBase::StateManager::State_NoGame)
         {
+            Misc::ScopedTrace trace("Mechanics");
             mEnvironment.getMechanicsManager()->update(frametime,
                 guiActive);
         }
@@ -156,16 +167,20 @@ void OMW::Engine::frame(float frametime)
         if (mEnvironment.getStateManager()->getState()!=
             MWBase::StateManager::State_NoGame)
         {
+            Misc::ScopedTrace trace("World");
             mEnvironment.getWorld()->update(frametime, guiActive);
         }
         osg::Timer_t afterPhysicsTick = osg::Timer::instance()->tick();
 
         // update GUI
-        mEnvironment.getWindowManager()->onFrame(frametime);
-        if (mEnvironment.getStateManager()->getState()!=
-            MWBase::StateManager::State_NoGame)
         {
-            mEnvironment.getWindowManager()->update();
+            Misc::ScopedTrace trace("GUI");
+            mEnvironment.getWindowManager()->onFrame(frametime);
+            if (mEnvironment.getStateManager()->getState()!=
+                MWBase::StateManager::State_NoGame)
+            {
+                mEnvironment.getWindowManager()->update();
+            }
         }
 
         unsigned int frameNumber = mViewer->getFrameStamp()->getFrameNumber();
@@ -239,6 +254,9 @@ OMW::Engine::~Engine()
     delete mScriptContext;
     mScriptContext = NULL;
 
+    // Join the worker threads while the resource managers that their work items use still exist
+    if (mResourceSystem)
+        mResourceSystem->getImageManager()->setWorkQueue(NULL);
     mWorkQueue = NULL;
 
     mResourceSystem.reset();
@@ -460,10 +478,15 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
         Settings::Manager::getInt("anisotropy", "General")
     );
 
+    int textureCacheSize = std::max(0, Settings::Manager::getInt("texture cache size", "General"));
+    mResourceSystem->getImageManager()->setFileCache((mCfgMgr.getCachePath() / "textures").string(),
+        static_cast<std::uint64_t>(textureCacheSize) * 1024 * 1024);
+
     int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
     mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    mResourceSystem->getImageManager()->setWorkQueue(mWorkQueue.get());
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -517,7 +540,8 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     // Create the world
     mEnvironment.setWorld( new MWWorld::World (mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(),
         mFileCollections, mContentFiles, mEncoder, mFallbackMap,
-        mActivationDistanceOverride, mCellName, mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string()));
+        mActivationDistanceOverride, mCellName, mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string(),
+        mCfgMgr.getCachePath().string()));
     mEnvironment.getWorld()->setupPlayer();
     input->setPlayer(&mEnvironment.getWorld()->getPlayer());
 
@@ -697,6 +721,8 @@ void OMW::Engine::go()
 
         mViewer->advance(simulationTime);
 
+        Misc::Trace::frame(mViewer->getFrameStamp()->getFrameNumber());
+
         frame(dt);
 
         if (!mEnvironment.getInputManager()->isWindowVisible())
@@ -706,12 +732,20 @@ void OMW::Engine::go()
         }
         else
         {
-            mViewer->eventTraversal();
-            mViewer->updateTraversal();
-
-            mEnvironment.getWorld()->updateWindowManager();
+            {
+                Misc::ScopedTrace trace("EventTraversal");
+                mViewer->eventTraversal();
+            }
+            {
+                Misc::ScopedTrace trace("UpdateTraversal");
+                mViewer->updateTraversal();
 
-            mViewer->renderingTraversals();
+                mEnvironment.getWorld()->updateWindowManager();
+            }
+            {
+                Misc::ScopedTrace trace("RenderingTraversals");
+                mViewer->renderingTraversals();
+            }
         }
 
         if (framerateLimit > 0.f)
@@ -791,6 +825,11 @@ void OMW::Engine::enableFontExport(bool exportFonts)
     mExportFonts = exportFonts;
 }
 
+void OMW::Engine::setTrace(unsigned int firstFrame, unsigned int frameCount, const std::string& file)
+{
+    Misc::Trace::setFrameRange(firstFrame, frameCount, file);
+}
+
 void OMW::Engine::setSaveGameFile(const std::string &savegame)
 {
     mSaveGameFile = savegame;
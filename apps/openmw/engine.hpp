@@ -202,6 +202,10 @@ namespace OMW
             /// Set the save game file to load after initialising the engine.
             void setSaveGameFile(const std::string& savegame);
 
+            /// Record \a frameCount frames starting at \a firstFrame and write them to \a file in the
+            /// Chrome trace event format. A \a frameCount of 0 disables tracing.
+            void setTrace(unsigned int firstFrame, unsigned int frameCount, const std::string& file);
+
         private:
             Files::ConfigurationManager& mCfgMgr;
     };
@@ -148,7 +148,15 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
         ("export-fonts", bpo::value<bool>()->implicit_value(true)
             ->default_value(false), "Export Morrowind .fnt fonts to PNG image and XML file in current directory")
 
-        ("activate-dist", bpo::value <int> ()->default_value (-1), "activation distance override");
+        ("activate-dist", bpo::value <int> ()->default_value (-1), "activation distance override")
+
+        ("trace-start", bpo::value<unsigned int>()->default_value(0), "first frame to record with trace-frames")
+
+        ("trace-frames", bpo::value<unsigned int>()->default_value(0),
+            "number of frames to record in a Chrome trace event file (0 disables tracing)")
+
+        ("trace-file", bpo::value<Files::EscapeHashString>()->default_value("trace.json"),
+            "file to write the trace to (viewable in chrome://tracing or Perfetto)");
 
     bpo::parsed_options valid_opts = bpo::command_line_parser(argc, argv)
         .options(desc).allow_unregistered().run();
@@ -245,6 +253,8 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
     engine.setFallbackValues(variables["fallback"].as<FallbackMap>().mMap);
     engine.setActivationDistanceOverride (variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
+    engine.setTrace(variables["trace-start"].as<unsigned int>(), variables["trace-frames"].as<unsigned int>(),
+        variables["trace-file"].as<Files::EscapeHashString>().toStdString());
 
     return true;
 }
@@ -14,6 +14,7 @@ namespace ESM
 {
     class ESMReader;
     class ESMWriter;
+    struct Dialogue;
 }
 
 namespace MWWorld
@@ -21,6 +22,11 @@ namespace MWWorld
     class Ptr;
 }
 
+namespace MWDialogue
+{
+    class InfoIndex;
+}
+
 namespace MWBase
 {
     /// \brief Interface for dialogue manager (implemented in MWDialogue)
@@ -81,6 +87,9 @@ namespace MWBase
 
             /// Removes the last added topic response for the given actor from the journal
             virtual void clearInfoActor (const MWWorld::Ptr& actor) const = 0;
+
+            /// Return the index of the infos of \a dialogue, which is built on first use.
+            virtual const MWDialogue::InfoIndex& getInfoIndex (const ESM::Dialogue& dialogue) = 0;
     };
 }
 
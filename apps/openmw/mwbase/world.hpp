@@ -62,6 +62,7 @@ namespace MWWorld
     class TimeStamp;
     class ESMStore;
     class RefData;
+    class FallbackTable;
 
     typedef std::vector<std::pair<MWWorld::Ptr,MWMechanics::Movement> > PtrMovementList;
 }
@@ -125,6 +126,9 @@ namespace MWBase
 
             virtual const Fallback::Map *getFallback () const = 0;
 
+            virtual const MWWorld::FallbackTable& getFallbackTable() const = 0;
+            ///< Pre-parsed fallback values for use on hot paths.
+
             virtual MWWorld::Player& getPlayer() = 0;
             virtual MWWorld::Ptr getPlayerPtr() = 0;
 
@@ -75,7 +75,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Apparatus);
 
-        registerClass (typeid (ESM::Apparatus).name(), instance);
+        registerClass<ESM::Apparatus> (instance);
     }
 
     std::string Apparatus::getUpSoundId (const MWWorld::ConstPtr& ptr) const
@@ -126,7 +126,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Clothing);
 
-        registerClass (typeid (ESM::Clothing).name(), instance);
+        registerClass<ESM::Clothing> (instance);
     }
 
     std::string Clothing::getUpSoundId (const MWWorld::ConstPtr& ptr) const
@@ -26,6 +26,7 @@
 #include "../mwworld/containerstore.hpp"
 #include "../mwphysics/physicssystem.hpp"
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/esmstore.hpp"
 
 #include "../mwrender/renderinginterface.hpp"
 #include "../mwrender/objects.hpp"
@@ -227,7 +228,7 @@ namespace MWClass
     {
         MWWorld::LiveCellRef<ESM::Creature> *ref =
             ptr.get<ESM::Creature>();
-        const MWWorld::Store<ESM::GameSetting> &gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& gmst = MWBase::Environment::get().getWorld()->getStore().getGmsts();
         MWMechanics::CreatureStats &stats = getCreatureStats(ptr);
 
         if (stats.getDrawState() != MWMechanics::DrawState_Weapon)
@@ -245,7 +246,7 @@ namespace MWClass
 
         MWMechanics::applyFatigueLoss(ptr, weapon, attackStrength);
 
-        float dist = gmst.find("fCombatDistance")->getFloat();
+        float dist = gmst.getFloat(MWWorld::GMST::fCombatDistance);
         if (!weapon.isEmpty())
             dist *= weapon.get<ESM::Weapon>()->mBase->mData.mReach;
 
@@ -491,7 +492,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Creature);
 
-        registerClass (typeid (ESM::Creature).name(), instance);
+        registerClass<ESM::Creature> (instance);
     }
 
     float Creature::getSpeed(const MWWorld::Ptr &ptr) const
@@ -72,7 +72,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new CreatureLevList);
 
-        registerClass (typeid (ESM::CreatureLevList).name(), instance);
+        registerClass<ESM::CreatureLevList> (instance);
     }
 
     void CreatureLevList::getModelsToPreload(const MWWorld::Ptr &ptr, std::vector<std::string> &models) const
@@ -270,7 +270,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Door);
 
-        registerClass (typeid (ESM::Door).name(), instance);
+        registerClass<ESM::Door> (instance);
     }
 
     bool Door::hasToolTip (const MWWorld::ConstPtr& ptr) const
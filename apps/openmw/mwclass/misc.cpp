@@ -94,7 +94,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Miscellaneous);
 
-        registerClass (typeid (ESM::Miscellaneous).name(), instance);
+        registerClass<ESM::Miscellaneous> (instance);
     }
 
     std::string Miscellaneous::getUpSoundId (const MWWorld::ConstPtr& ptr) const
@@ -34,6 +34,7 @@
 #include "../mwworld/customdata.hpp"
 #include "../mwphysics/physicssystem.hpp"
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/esmstore.hpp"
 
 #include "../mwrender/objects.hpp"
 #include "../mwrender/renderinginterface.hpp"
@@ -550,7 +551,7 @@ namespace MWClass
     {
         MWBase::World *world = MWBase::Environment::get().getWorld();
 
-        const MWWorld::Store<ESM::GameSetting> &store = world->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& store = world->getStore().getGmsts();
 
         // Get the weapon used (if hand-to-hand, weapon = inv.end())
         MWWorld::InventoryStore &inv = getInventoryStore(ptr);
@@ -561,10 +562,10 @@ namespace MWClass
 
         MWMechanics::applyFatigueLoss(ptr, weapon, attackStrength);
 
-        const float fCombatDistance = store.find("fCombatDistance")->getFloat();
+        const float fCombatDistance = store.getFloat(MWWorld::GMST::fCombatDistance);
         float dist = fCombatDistance * (!weapon.isEmpty() ?
                                weapon.get<ESM::Weapon>()->mBase->mData.mReach :
-                               store.find("fHandToHandReach")->getFloat());
+                               store.getFloat(MWWorld::GMST::fHandToHandReach));
 
         // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit result.
         std::vector<MWWorld::Ptr> targetActors;
@@ -634,14 +635,14 @@ namespace MWClass
                     && !MWBase::Environment::get().getMechanicsManager()->awarenessCheck(ptr, victim);
             if(unaware)
             {
-                damage *= store.find("fCombatCriticalStrikeMult")->getFloat();
+                damage *= store.getFloat(MWWorld::GMST::fCombatCriticalStrikeMult);
                 MWBase::Environment::get().getWindowManager()->messageBox("#{sTargetCriticalStrike}");
                 MWBase::Environment::get().getSoundManager()->playSound3D(victim, "critical damage", 1.0f, 1.0f);
             }
         }
 
         if (othercls.getCreatureStats(victim).getKnockedDown())
-            damage *= store.find("fCombatKODamageMult")->getFloat();
+            damage *= store.getFloat(MWWorld::GMST::fCombatKODamageMult);
 
         // Apply "On hit" enchanted weapons
         MWMechanics::applyOnStrikeEnchantment(ptr, victim, weapon, hitPosition);
@@ -733,7 +734,7 @@ namespace MWClass
             const MWWorld::ESMStore &store = MWBase::Environment::get().getWorld()->getStore();
             const GMST& gmst = getGmst();
 
-            int chance = store.get<ESM::GameSetting>().find("iVoiceHitOdds")->getInt();
+            int chance = store.getGmsts().getInt(MWWorld::GMST::iVoiceHitOdds);
             if (Misc::Rng::roll0to99() < chance)
                 MWBase::Environment::get().getDialogueManager()->say(ptr, "hit");
 
@@ -1010,7 +1011,7 @@ namespace MWClass
     void Npc::registerSelf()
     {
         std::shared_ptr<Class> instance (new Npc);
-        registerClass (typeid (ESM::NPC).name(), instance);
+        registerClass<ESM::NPC> (instance);
     }
 
     bool Npc::hasToolTip(const MWWorld::ConstPtr& ptr) const
@@ -1084,13 +1085,13 @@ namespace MWClass
     float Npc::getArmorRating (const MWWorld::Ptr& ptr) const
     {
         const MWBase::World *world = MWBase::Environment::get().getWorld();
-        const MWWorld::Store<ESM::GameSetting> &store = world->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& store = world->getStore().getGmsts();
 
         MWMechanics::NpcStats &stats = getNpcStats(ptr);
         const MWWorld::InventoryStore &invStore = getInventoryStore(ptr);
 
-        float fUnarmoredBase1 = store.find("fUnarmoredBase1")->getFloat();
-        float fUnarmoredBase2 = store.find("fUnarmoredBase2")->getFloat();
+        float fUnarmoredBase1 = store.getFloat(MWWorld::GMST::fUnarmoredBase1);
+        float fUnarmoredBase2 = store.getFloat(MWWorld::GMST::fUnarmoredBase2);
         int unarmoredSkill = stats.getSkill(ESM::Skill::Unarmored).getModified();
 
         float ratings[MWWorld::InventoryStore::Slots];
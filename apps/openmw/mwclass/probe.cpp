@@ -85,7 +85,7 @@ namespace MWClass
     {
         std::shared_ptr<Class> instance (new Probe);
 
-        registerClass (typeid (ESM::Probe).name(), instance);
+        registerClass<ESM::Probe> (instance);
     }
 
     std::string Probe::getUpSoundId (const MWWorld::ConstPtr& ptr) const
@@ -68,6 +68,7 @@ namespace MWDialogue
         for (; it != dialogs.end(); ++it)
         {
             mDialogueMap[Misc::StringUtils::lowerCase(it->mId)] = *it;
+            mTopicKeywords.seed(Misc::StringUtils::lowerCase(it->mId), 0 /*unused*/);
         }
     }
 
@@ -86,7 +87,7 @@ namespace MWDialogue
 
     void DialogueManager::parseText (const std::string& text)
     {
-        std::vector<HyperTextParser::Token> hypertext = HyperTextParser::parseHyperText(text);
+        std::vector<HyperTextParser::Token> hypertext = HyperTextParser::parseHyperText(text, mTopicKeywords);
 
         for (std::vector<HyperTextParser::Token>::iterator tok = hypertext.begin(); tok != hypertext.end(); ++tok)
         {
@@ -753,4 +754,14 @@ namespace MWDialogue
                         mLastTopic, actor.getClass().getName(actor));
         }
     }
+
+    const InfoIndex& DialogueManager::getInfoIndex (const ESM::Dialogue& dialogue)
+    {
+        std::map<const ESM::Dialogue *, InfoIndex>::iterator iter = mInfoIndices.find (&dialogue);
+
+        if (iter==mInfoIndices.end())
+            iter = mInfoIndices.insert (std::make_pair (&dialogue, InfoIndex (dialogue))).first;
+
+        return iter->second;
+    }
 }
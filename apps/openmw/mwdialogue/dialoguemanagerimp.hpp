@@ -13,6 +13,9 @@
 
 #include "../mwscript/compilercontext.hpp"
 
+#include "infoindex.hpp"
+#include "hypertextparser.hpp"
+
 namespace ESM
 {
     struct Dialogue;
@@ -46,6 +49,13 @@ namespace MWDialogue
             float mTemporaryDispositionChange;
             float mPermanentDispositionChange;
 
+            // Dialogue records are only loaded before the dialogue manager is created and stay unchanged
+            // while it exists, so the indices stay valid as well.
+            std::map<const ESM::Dialogue *, InfoIndex> mInfoIndices;
+
+            // All topics, compiled once for finding them in the text of dialogue responses
+            HyperTextParser::TopicKeywords mTopicKeywords;
+
             void parseText (const std::string& text);
 
             void updateTopics();
@@ -103,6 +113,8 @@ namespace MWDialogue
 
             /// Removes the last added topic response for the given actor from the journal
             virtual void clearInfoActor (const MWWorld::Ptr& actor) const;
+
+            virtual const InfoIndex& getInfoIndex (const ESM::Dialogue& dialogue);
     };
 }
 
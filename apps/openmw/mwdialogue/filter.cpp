@@ -20,6 +20,7 @@
 #include "../mwmechanics/actorutil.hpp"
 
 #include "selectwrapper.hpp"
+#include "infoindex.hpp"
 
 bool MWDialogue::Filter::testActor (const ESM::DialInfo& info) const
 {
@@ -610,6 +611,23 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements (const MWWorld::Pt
     return stats.getFactionReputation (factionId)>=faction.mData.mRankData[rank].mFactReaction;
 }
 
+std::vector<const ESM::DialInfo *> MWDialogue::Filter::getCandidates (const ESM::Dialogue& dialogue) const
+{
+    InfoIndex::Speaker speaker;
+    speaker.mId = mActor.getCellRef().getRefId();
+    speaker.mIsNpc = mActor.getTypeName()==typeid (ESM::NPC).name();
+
+    if (speaker.mIsNpc)
+    {
+        const ESM::NPC *npc = mActor.get<ESM::NPC>()->mBase;
+        speaker.mRace = npc->mRace;
+        speaker.mClass = npc->mClass;
+        speaker.mFaction = mActor.getClass().getPrimaryFaction (mActor);
+    }
+
+    return MWBase::Environment::get().getDialogueManager()->getInfoIndex (dialogue).getCandidates (speaker);
+}
+
 MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
 : mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
 {}
@@ -626,11 +644,13 @@ const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue,
 
 std::vector<const ESM::DialInfo *> MWDialogue::Filter::listAll (const ESM::Dialogue& dialogue) const
 {
+    std::vector<const ESM::DialInfo *> candidates = getCandidates (dialogue);
+
     std::vector<const ESM::DialInfo *> infos;
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin(); iter!=candidates.end(); ++iter)
     {
-        if (testActor (*iter))
-            infos.push_back(&*iter);
+        if (testActor (**iter))
+            infos.push_back(*iter);
     }
     return infos;
 }
@@ -643,13 +663,15 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    std::vector<const ESM::DialInfo *> candidates = getCandidates (dialogue);
+
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+        iter!=candidates.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -668,10 +690,12 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        candidates = getCandidates (infoRefusalDialogue);
+
+        for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+            iter!=candidates.end(); ++iter)
+            if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter) && testDisposition(**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -682,10 +706,12 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
 bool MWDialogue::Filter::responseAvailable (const ESM::Dialogue& dialogue) const
 {
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    std::vector<const ESM::DialInfo *> candidates = getCandidates (dialogue);
+
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+        iter!=candidates.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter))
             return true;
     }
 
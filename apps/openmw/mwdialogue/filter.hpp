@@ -51,6 +51,9 @@ namespace MWDialogue
             bool hasFactionRankReputationRequirements (const MWWorld::Ptr& actor, const std::string& factionId,
                 int rank) const;
 
+            std::vector<const ESM::DialInfo *> getCandidates (const ESM::Dialogue& dialogue) const;
+            ///< Return the infos of \a dialogue that may pass testActor, in their original order.
+
         public:
 
             Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "keywordsearch.hpp"
+
 namespace MWDialogue
 {
     namespace HyperTextParser
@@ -25,10 +27,13 @@ namespace MWDialogue
             Type mType;
         };
 
+        /// Lower case IDs of the dialogue topics that are recognized as implicit keywords
+        typedef KeywordSearch<std::string, int /*unused*/> TopicKeywords;
+
         // In translations (at least Russian) the links are marked with @#, so
         // it should be a function to parse it
-        std::vector<Token> parseHyperText(const std::string & text);
-        void tokenizeKeywords(const std::string & text, std::vector<Token> & tokens);
+        std::vector<Token> parseHyperText(const std::string & text, TopicKeywords & keywords);
+        void tokenizeKeywords(const std::string & text, TopicKeywords & keywords, std::vector<Token> & tokens);
         size_t removePseudoAsterisks(std::string & phrase);
     }
 }
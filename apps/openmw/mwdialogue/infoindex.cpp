@@ -0,0 +1,83 @@
+#include "infoindex.hpp"
+
+#include <algorithm>
+
+#include <components/esm/loaddial.hpp>
+#include <components/misc/stringops.hpp>
+
+MWDialogue::InfoIndex::InfoIndex (const ESM::Dialogue& dialogue)
+{
+    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
+        iter!=dialogue.mInfo.end(); ++iter)
+    {
+        int position = static_cast<int> (mInfos.size());
+        mInfos.push_back (&*iter);
+
+        if (!iter->mActor.empty())
+        {
+            // Further speaker conditions are left to Filter::testActor
+            mBySpeaker[Misc::StringUtils::lowerCase (iter->mActor)].push_back (position);
+            continue;
+        }
+
+        GenericKey key (Misc::StringUtils::lowerCase (iter->mRace),
+            Misc::StringUtils::lowerCase (iter->mClass),
+            iter->mFactionLess ? std::string() : Misc::StringUtils::lowerCase (iter->mFaction),
+            iter->mFactionLess);
+
+        mGeneric[key].push_back (position);
+    }
+}
+
+void MWDialogue::InfoIndex::addGeneric (const GenericKey& key, std::vector<const Positions *>& found) const
+{
+    std::map<GenericKey, Positions>::const_iterator iter = mGeneric.find (key);
+
+    if (iter!=mGeneric.end())
+        found.push_back (&iter->second);
+}
+
+std::vector<const ESM::DialInfo *> MWDialogue::InfoIndex::getCandidates (const Speaker& speaker) const
+{
+    std::vector<const Positions *> found;
+
+    std::map<std::string, Positions>::const_iterator iter =
+        mBySpeaker.find (Misc::StringUtils::lowerCase (speaker.mId));
+
+    if (iter!=mBySpeaker.end())
+        found.push_back (&iter->second);
+
+    // Creatures must not have topics aside of those specific to their id
+    if (speaker.mIsNpc)
+    {
+        std::string races[] = { std::string(), Misc::StringUtils::lowerCase (speaker.mRace) };
+        std::string classes[] = { std::string(), Misc::StringUtils::lowerCase (speaker.mClass) };
+
+        // An info without faction condition always passes, a faction-less one only if the actor has no faction
+        std::string faction = Misc::StringUtils::lowerCase (speaker.mFaction);
+
+        for (int race=0; race<2; ++race)
+            for (int class_=0; class_<2; ++class_)
+            {
+                addGeneric (GenericKey (races[race], classes[class_], std::string(), false), found);
+                addGeneric (GenericKey (races[race], classes[class_], faction, faction.empty()), found);
+            }
+    }
+
+    Positions positions;
+    for (std::vector<const Positions *>::const_iterator iter = found.begin(); iter!=found.end(); ++iter)
+        positions.insert (positions.end(), (*iter)->begin(), (*iter)->end());
+
+    // Restore the original order, which decides the priority of infos. Keys may coincide (e.g. for an
+    // NPC without class), so also drop duplicates.
+    std::sort (positions.begin(), positions.end());
+    positions.erase (std::unique (positions.begin(), positions.end()), positions.end());
+
+    std::vector<const ESM::DialInfo *> infos;
+    infos.reserve (positions.size());
+
+    for (Positions::const_iterator iter = positions.begin(); iter!=positions.end(); ++iter)
+        infos.push_back (mInfos[*iter]);
+
+    return infos;
+}
@@ -0,0 +1,58 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// \brief Groups the infos of a topic by their speaker conditions (id, race, class and faction)
+    ///
+    /// These conditions only depend on the base record of the speaker, so for a given actor most infos
+    /// of a large topic can be skipped without running the full set of filters on them.
+    ///
+    /// \note The index refers to the infos of the dialogue, which must not be modified or destroyed afterwards.
+    class InfoIndex
+    {
+            typedef std::vector<int> Positions;
+
+            // race, class, faction, faction-less flag
+            typedef std::tuple<std::string, std::string, std::string, bool> GenericKey;
+
+            std::vector<const ESM::DialInfo *> mInfos;
+            std::map<std::string, Positions> mBySpeaker;
+            std::map<GenericKey, Positions> mGeneric;
+
+            void addGeneric (const GenericKey& key, std::vector<const Positions *>& found) const;
+
+        public:
+
+            /// The base record properties of an actor that speaker conditions test.
+            struct Speaker
+            {
+                std::string mId;
+                bool mIsNpc;
+                std::string mRace; ///< NPCs only
+                std::string mClass; ///< NPCs only
+                std::string mFaction; ///< NPCs only, primary faction of the actor
+
+                Speaker() : mIsNpc (false) {}
+            };
+
+            explicit InfoIndex (const ESM::Dialogue& dialogue);
+
+            std::vector<const ESM::DialInfo *> getCandidates (const Speaker& speaker) const;
+            ///< Return the infos that may be used by \a speaker, in their original order.
+            /// \note Candidates still need to be checked with Filter::testActor (e.g. for rank and gender).
+    };
+}
+
+#endif
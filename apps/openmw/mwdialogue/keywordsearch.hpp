@@ -5,13 +5,19 @@
 #include <cctype>
 #include <stdexcept>
 #include <vector>
-#include <algorithm>    // std::reverse
+#include <algorithm>    // std::sort, std::lower_bound
+#include <utility>
 
 #include <components/misc/stringops.hpp>
 
 namespace MWDialogue
 {
 
+/// \brief Finds keywords (e.g. topic names) in a text, ignoring case
+///
+/// Keywords are compiled into an Aho-Corasick automaton on first use after the keyword set changed,
+/// so a text is highlighted in a single pass regardless of the number of keywords. The automaton is
+/// kept until the next call to seed() or clear(), i.e. it is shared by all texts highlighted in between.
 template <typename string_t, typename value_t>
 class KeywordSearch
 {
@@ -26,46 +32,79 @@ public:
         value_t mValue;
     };
 
+    KeywordSearch() : mCompiled (false)
+    {
+        mNodes.push_back (Node());
+    }
+
     void seed (string_t keyword, value_t value)
     {
         if (keyword.empty())
             return;
-        seed_impl  (/*std::move*/ (keyword), /*std::move*/ (value), 0, mRoot);
+
+        int node = 0;
+
+        for (Point i = keyword.begin(); i != keyword.end(); ++i)
+        {
+            char_t ch = Misc::StringUtils::toLower (*i);
+
+            typename Node::Children::iterator child = mNodes[node].mChildren.find (ch);
+
+            if (child == mNodes[node].mChildren.end())
+            {
+                int next = static_cast<int> (mNodes.size());
+                mNodes[node].mChildren.insert (std::make_pair (ch, next));
+                mNodes.push_back (Node());
+                mNodes[next].mDepth = mNodes[node].mDepth + 1;
+                node = next;
+            }
+            else
+                node = child->second;
+        }
+
+        if (mNodes[node].mKeyword != -1)
+        {
+            // keywords that only differ in case share a node, the later one wins
+            if (mKeywords[mNodes[node].mKeyword].first == keyword)
+                throw std::runtime_error ("duplicate keyword inserted");
+
+            mKeywords[mNodes[node].mKeyword] = std::make_pair (keyword, value);
+        }
+        else
+        {
+            mNodes[node].mKeyword = static_cast<int> (mKeywords.size());
+            mKeywords.push_back (std::make_pair (keyword, value));
+        }
+
+        mCompiled = false;
     }
 
     void clear ()
     {
-        mRoot.mChildren.clear ();
-        mRoot.mKeyword.clear ();
+        mNodes.clear ();
+        mNodes.push_back (Node());
+        mKeywords.clear ();
+        mEdges.clear ();
+        mCompiled = false;
     }
 
     bool containsKeyword (string_t keyword, value_t& value)
     {
-        typename Entry::childen_t::iterator current;
-        typename Entry::childen_t::iterator next;
+        if (keyword.empty())
+            return false;
+
+        compile ();
+
+        int node = 0;
 
-        current = mRoot.mChildren.find (Misc::StringUtils::toLower (*keyword.begin()));
-        if (current == mRoot.mChildren.end())
+        for (Point i = keyword.begin(); i != keyword.end() && node != -1; ++i)
+            node = getChild (node, Misc::StringUtils::toLower (*i));
+
+        if (node == -1 || mNodes[node].mKeyword == -1)
             return false;
-        else if (current->second.mKeyword.size() && Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
-        {
-            value = current->second.mValue;
-            return true;
-        }
 
-        for (Point i = ++keyword.begin(); i != keyword.end(); ++i)
-        {
-            next = current->second.mChildren.find(Misc::StringUtils::toLower (*i));
-            if (next == current->second.mChildren.end())
-                return false;
-            if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
-            {
-                value = next->second.mValue;
-                return true;
-            }
-            current = next;
-        }
-        return false;
+        value = mKeywords[mNodes[node].mKeyword].second;
+        return true;
     }
 
     static bool sortMatches(const Match& left, const Match& right)
@@ -73,88 +112,65 @@ public:
         return left.mBeg < right.mBeg;
     }
 
+    /// Find the longest keyword starting at the beginning of each word of [beg, end). Overlapping matches are
+    /// resolved in favour of the longest one. The matches are appended to \a out, which is then sorted.
     void highlightKeywords (Point beg, Point end, std::vector<Match>& out)
     {
-        std::vector<Match> matches;
-        for (Point i = beg; i != end; ++i)
-        {
-            // check if previous character marked start of new word
-            if (i != beg)
-            {
-                Point prev = i;
-                --prev;
-                if(isalpha(*prev))
-                    continue;
-            }
+        compile ();
 
+        // node of the longest keyword found for each word start, indexed by the offset from beg
+        std::vector<int> longest (end - beg, -1);
 
-            // check first character
-            typename Entry::childen_t::iterator candidate = mRoot.mChildren.find (Misc::StringUtils::toLower (*i));
+        int state = 0;
 
-            // no match, on to next character
-            if (candidate == mRoot.mChildren.end ())
-                continue;
+        for (Point i = beg; i != end; ++i)
+        {
+            char_t ch = Misc::StringUtils::toLower (*i);
 
-            // see how far the match goes
-            Point j = i;
+            int next = getChild (state, ch);
 
-            // some keywords might be longer variations of other keywords, so we definitely need a list of candidates
-            // the first element in the pair is length of the match, i.e. depth from the first character on
-            std::vector< typename std::pair<int, typename Entry::childen_t::iterator> > candidates;
+            while (next == -1 && state != 0)
+            {
+                state = mNodes[state].mFail;
+                next = getChild (state, ch);
+            }
 
-            while ((j + 1) != end)
+            state = next == -1 ? 0 : next;
+
+            // visit every keyword ending here, longest first
+            for (int node = mNodes[state].mKeyword != -1 ? state : mNodes[state].mOutput; node != -1;
+                node = mNodes[node].mOutput)
             {
-                typename Entry::childen_t::iterator next = candidate->second.mChildren.find (Misc::StringUtils::toLower (*++j));
+                Point start = i + 1 - mNodes[node].mDepth;
 
-                if (next == candidate->second.mChildren.end ())
+                // check if previous character marked start of new word
+                if (start != beg)
                 {
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j-i), candidate));
-                    break;
+                    Point prev = start;
+                    --prev;
+                    if (isalpha(*prev))
+                        continue;
                 }
 
-                candidate = next;
-
-                if (candidate->second.mKeyword.size() > 0)
-                    candidates.push_back(std::make_pair((j-i), candidate));
+                // a keyword ending further into the text is a longer one
+                longest[start - beg] = node;
             }
+        }
 
-            if (candidates.empty())
-                continue; // didn't match enough to disambiguate, on to next character
-
-            // shorter candidates will be added to the vector first. however, we want to check against longer candidates first
-            std::reverse(candidates.begin(), candidates.end());
-
-            for (typename std::vector< std::pair<int, typename Entry::childen_t::iterator> >::iterator it = candidates.begin();
-                 it != candidates.end(); ++it)
-            {
-                candidate = it->second;
-                // try to match the rest of the keyword
-                Point k = i + it->first;
-                typename string_t::const_iterator t = candidate->second.mKeyword.begin () + (k - i);
-
+        std::vector<Match> matches;
 
-                while (k != end && t != candidate->second.mKeyword.end ())
-                {
-                    if (Misc::StringUtils::toLower (*k) != Misc::StringUtils::toLower (*t))
-                        break;
+        for (std::size_t i = 0; i < longest.size(); ++i)
+        {
+            if (longest[i] == -1)
+                continue;
 
-                    ++k, ++t;
-                }
+            const Node& node = mNodes[longest[i]];
 
-                // didn't match full keyword, try the next candidate
-                if (t != candidate->second.mKeyword.end ())
-                    continue;
-
-                // found a keyword, but there might still be longer keywords that start somewhere _within_ this keyword
-                // we will resolve these overlapping keywords later, choosing the longest one in case of conflict
-                Match match;
-                match.mValue = candidate->second.mValue;
-                match.mBeg = i;
-                match.mEnd = k;
-                matches.push_back(match);
-                break;
-            }
+            Match match;
+            match.mValue = mKeywords[node.mKeyword].second;
+            match.mBeg = beg + i;
+            match.mEnd = match.mBeg + node.mDepth;
+            matches.push_back (match);
         }
 
         // resolve overlapping keywords
@@ -201,54 +217,101 @@ public:
 
 private:
 
-    struct Entry
+    typedef typename string_t::value_type char_t;
+
+    struct Node
     {
-        typedef std::map <wchar_t, Entry> childen_t;
+        typedef std::map<char_t, int> Children;
 
-        string_t mKeyword;
-        value_t mValue;
-        childen_t mChildren;
+        Children mChildren;     ///< only used while seeding
+        int mKeyword;           ///< index into mKeywords, -1 if no keyword ends here
+        int mDepth;
+        int mFail;              ///< node of the longest proper suffix that is also in the trie
+        int mOutput;            ///< nearest node on the fail chain at which a keyword ends, -1 if none
+        int mFirstEdge;         ///< children in mEdges, sorted by character
+        int mEdgeCount;
+
+        Node() : mKeyword (-1), mDepth (0), mFail (0), mOutput (-1), mFirstEdge (0), mEdgeCount (0) {}
     };
 
-    void seed_impl (string_t keyword, value_t value, size_t depth, Entry  & entry)
+    typedef std::pair<char_t, int> Edge;
+
+    static bool compareEdge (const Edge& left, const Edge& right)
     {
-        int ch = Misc::StringUtils::toLower (keyword.at (depth));
+        return left.first < right.first;
+    }
 
-        typename Entry::childen_t::iterator j = entry.mChildren.find (ch);
+    int getChild (int node, char_t ch) const
+    {
+        typename std::vector<Edge>::const_iterator begin = mEdges.begin() + mNodes[node].mFirstEdge;
+        typename std::vector<Edge>::const_iterator end = begin + mNodes[node].mEdgeCount;
 
-        if (j == entry.mChildren.end ())
+        typename std::vector<Edge>::const_iterator edge =
+            std::lower_bound (begin, end, Edge (ch, 0), compareEdge);
+
+        if (edge == end || edge->first != ch)
+            return -1;
+
+        return edge->second;
+    }
+
+    /// Flatten the trie and add the fail and output links, in breadth-first order.
+    void compile ()
+    {
+        if (mCompiled)
+            return;
+
+        mEdges.clear ();
+
+        std::vector<int> queue (1, 0);
+
+        for (std::size_t i = 0; i < queue.size(); ++i)
         {
-            entry.mChildren [ch].mValue = /*std::move*/ (value);
-            entry.mChildren [ch].mKeyword = /*std::move*/ (keyword);
+            Node& node = mNodes[queue[i]];
+
+            node.mFirstEdge = static_cast<int> (mEdges.size());
+            node.mEdgeCount = static_cast<int> (node.mChildren.size());
+
+            for (typename Node::Children::const_iterator child = node.mChildren.begin();
+                child != node.mChildren.end(); ++child)
+            {
+                mEdges.push_back (*child);
+                queue.push_back (child->second);
+            }
         }
-        else
+
+        // fail links point to shallower nodes, which are already done when visiting in breadth-first order
+        for (std::size_t i = 0; i < queue.size(); ++i)
         {
-            if (j->second.mKeyword.size () > 0)
-            {
-                if (keyword == j->second.mKeyword)
-                    throw std::runtime_error ("duplicate keyword inserted");
+            const Node& node = mNodes[queue[i]];
 
-                value_t pushValue = /*std::move*/ (j->second.mValue);
-                string_t pushKeyword = /*std::move*/ (j->second.mKeyword);
+            for (typename Node::Children::const_iterator iter = node.mChildren.begin();
+                iter != node.mChildren.end(); ++iter)
+            {
+                Node& child = mNodes[iter->second];
 
-                if (depth >= pushKeyword.size ())
-                    throw std::runtime_error ("unexpected");
+                int fail = -1;
 
-                if (depth+1 < pushKeyword.size())
+                for (int state = queue[i]; state != 0 && fail == -1; )
                 {
-                    seed_impl (/*std::move*/ (pushKeyword), /*std::move*/ (pushValue), depth+1, j->second);
-                    j->second.mKeyword.clear ();
+                    state = mNodes[state].mFail;
+                    fail = getChild (state, iter->first);
                 }
+
+                child.mFail = fail == -1 ? 0 : fail;
+
+                const Node& failNode = mNodes[child.mFail];
+                child.mOutput = failNode.mKeyword != -1 ? child.mFail : failNode.mOutput;
             }
-            if (depth+1 == keyword.size())
-                j->second.mKeyword = value;
-            else // depth+1 < keyword.size()
-                seed_impl (/*std::move*/ (keyword), /*std::move*/ (value), depth+1, j->second);
         }
 
+        mCompiled = true;
     }
 
-    Entry mRoot;
+    std::vector<Node> mNodes;                               ///< mNodes[0] is the root
+    std::vector<Edge> mEdges;
+    std::vector<std::pair<string_t, value_t> > mKeywords;
+    bool mCompiled;
 };
 
 }
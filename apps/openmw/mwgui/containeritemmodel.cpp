@@ -11,7 +11,7 @@
 namespace
 {
 
-    bool stacks (const MWWorld::Ptr& left, const MWWorld::Ptr& right)
+    bool stacks (const MWWorld::ConstPtr& left, const MWWorld::ConstPtr& right)
     {
         if (left == right)
             return true;
@@ -38,15 +38,24 @@ namespace MWGui
 ContainerItemModel::ContainerItemModel(const std::vector<MWWorld::Ptr>& itemSources, const std::vector<MWWorld::Ptr>& worldItems)
     : mItemSources(itemSources)
     , mWorldItems(worldItems)
+    , mRebuilt(true)
 {
     assert (!mItemSources.empty());
 }
 
 ContainerItemModel::ContainerItemModel (const MWWorld::Ptr& source)
+    : mRebuilt(true)
 {
     mItemSources.push_back(source);
 }
 
+ContainerItemModel::~ContainerItemModel()
+{
+    for (std::vector<MWWorld::ContainerStore*>::iterator it = mStores.begin(); it != mStores.end(); ++it)
+        if (*it)
+            (*it)->removeContListener(this);
+}
+
 ItemStack ContainerItemModel::getItem (ModelIndex index)
 {
     if (index < 0)
@@ -63,12 +72,15 @@ size_t ContainerItemModel::getItemCount()
 
 ItemModel::ModelIndex ContainerItemModel::getIndex (ItemStack item)
 {
-    size_t i = 0;
-    for (std::vector<ItemStack>::iterator it = mItems.begin(); it != mItems.end(); ++it)
+    int index = mItems.find(item.mBase.getBase());
+    if (index != -1 && mItems[index] == item)
+        return index;
+
+    // The item may be from another source than the one listed for its stack
+    for (size_t i = 0; i < mItems.size(); ++i)
     {
-        if (*it == item)
+        if (mItems[i] == item)
             return i;
-        ++i;
     }
     return -1;
 }
@@ -108,6 +120,8 @@ void ContainerItemModel::removeItem (const ItemStack& item, size_t count)
                 MWBase::Environment::get().getWorld()->deleteObject(*source);
             else
                 source->getRefData().setCount(std::max(0, refCount - toRemove));
+            // World items have no store to report the change
+            mPendingItems.push_back(*source);
             toRemove -= refCount;
             if (toRemove <= 0)
                 return;
@@ -119,52 +133,142 @@ void ContainerItemModel::removeItem (const ItemStack& item, size_t count)
 
 void ContainerItemModel::update()
 {
-    mItems.clear();
+    bool changed = mStores.size() != mItemSources.size();
+    for (size_t i = 0; i < mItemSources.size() && !changed; ++i)
+    {
+        MWWorld::ContainerStore& store = mItemSources[i].getClass().getContainerStore(mItemSources[i]);
+        changed = &store != mStores[i] || store.getRevision() != mRevisions[i];
+    }
+
+    if (changed)
+    {
+        rebuild();
+        return;
+    }
+
+    mUpdatedItems.clear();
+    mRebuilt = false;
+
+    for (std::vector<MWWorld::ConstPtr>::const_iterator it = mPendingItems.begin(); it != mPendingItems.end(); ++it)
+        updateStack(*it);
+
+    mPendingItems.clear();
+}
+
+bool ContainerItemModel::getUpdatedItems(std::vector<MWWorld::Ptr> &items)
+{
+    if (mRebuilt)
+        return false;
+
+    items = mUpdatedItems;
+    return true;
+}
+
+void ContainerItemModel::rebuild()
+{
+    for (std::vector<MWWorld::ContainerStore*>::iterator it = mStores.begin(); it != mStores.end(); ++it)
+        if (*it)
+            (*it)->removeContListener(this);
+    mStores.clear();
+    mRevisions.clear();
+
+    std::vector<ItemStack> items;
     for (std::vector<MWWorld::Ptr>::iterator source = mItemSources.begin(); source != mItemSources.end(); ++source)
     {
         MWWorld::ContainerStore& store = source->getClass().getContainerStore(*source);
+        store.addContListener(this);
+        mStores.push_back(&store);
+        mRevisions.push_back(store.getRevision());
 
         for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
-        {
-            std::vector<ItemStack>::iterator itemStack = mItems.begin();
-            for (; itemStack != mItems.end(); ++itemStack)
-            {
-                if (stacks(*it, itemStack->mBase))
-                {
-                    // we already have an item stack of this kind, add to it
-                    itemStack->mCount += it->getRefData().getCount();
-                    break;
-                }
-            }
+            addToStack(items, *it);
+    }
+    for (std::vector<MWWorld::Ptr>::iterator source = mWorldItems.begin(); source != mWorldItems.end(); ++source)
+    {
+        // Taken world items are deleted by setting their count to 0
+        if (source->getRefData().getCount() != 0)
+            addToStack(items, *source);
+    }
 
-            if (itemStack == mItems.end())
-            {
-                // no stack yet, create one
-                ItemStack newItem (*it, this, it->getRefData().getCount());
-                mItems.push_back(newItem);
-            }
+    mItems.clear();
+    for (std::vector<ItemStack>::const_iterator it = items.begin(); it != items.end(); ++it)
+        mItems.set(it->mBase.getBase(), *it);
+
+    mPendingItems.clear();
+    mUpdatedItems.clear();
+    mRebuilt = true;
+}
+
+void ContainerItemModel::updateStack(const MWWorld::ConstPtr &item)
+{
+    // Forget the stack the item was counted in, it is listed under the first item of its kind
+    for (size_t i = 0; i < mItems.size(); ++i)
+    {
+        if (stacks(item, mItems[i].mBase))
+        {
+            MWWorld::Ptr base = mItems[i].mBase;
+            mItems.remove(base.getBase());
+            mUpdatedItems.push_back(base);
+            break;
         }
     }
-    for (std::vector<MWWorld::Ptr>::iterator source = mWorldItems.begin(); source != mWorldItems.end(); ++source)
+
+    // Count the stack again in the order rebuild() would
+    std::vector<ItemStack> items;
+    for (std::vector<MWWorld::Ptr>::iterator source = mItemSources.begin(); source != mItemSources.end(); ++source)
     {
-        std::vector<ItemStack>::iterator itemStack = mItems.begin();
-        for (; itemStack != mItems.end(); ++itemStack)
+        MWWorld::ContainerStore& store = source->getClass().getContainerStore(*source);
+
+        for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
         {
-            if (stacks(*source, itemStack->mBase))
-            {
-                // we already have an item stack of this kind, add to it
-                itemStack->mCount += source->getRefData().getCount();
-                break;
-            }
+            if (stacks(*it, item))
+                addToStack(items, *it);
         }
+    }
+    for (std::vector<MWWorld::Ptr>::iterator source = mWorldItems.begin(); source != mWorldItems.end(); ++source)
+    {
+        if (source->getRefData().getCount() != 0 && stacks(*source, item))
+            addToStack(items, *source);
+    }
 
-        if (itemStack == mItems.end())
+    for (std::vector<ItemStack>::const_iterator it = items.begin(); it != items.end(); ++it)
+    {
+        mItems.set(it->mBase.getBase(), *it);
+        mUpdatedItems.push_back(it->mBase);
+    }
+}
+
+void ContainerItemModel::addToStack(std::vector<ItemStack> &items, const MWWorld::Ptr &item)
+{
+    for (std::vector<ItemStack>::iterator itemStack = items.begin(); itemStack != items.end(); ++itemStack)
+    {
+        if (stacks(item, itemStack->mBase))
         {
-            // no stack yet, create one
-            ItemStack newItem (*source, this, source->getRefData().getCount());
-            mItems.push_back(newItem);
+            // we already have an item stack of this kind, add to it
+            itemStack->mCount += item.getRefData().getCount();
+            return;
         }
     }
+
+    // no stack yet, create one
+    items.push_back(ItemStack(item, this, item.getRefData().getCount()));
+}
+
+void ContainerItemModel::itemAdded(const MWWorld::ConstPtr &item, int count)
+{
+    mPendingItems.push_back(item);
+}
+
+void ContainerItemModel::itemRemoved(const MWWorld::ConstPtr &item, int count)
+{
+    mPendingItems.push_back(item);
+}
+
+void ContainerItemModel::storeDestroyed(const MWWorld::ContainerStore &store)
+{
+    for (std::vector<MWWorld::ContainerStore*>::iterator it = mStores.begin(); it != mStores.end(); ++it)
+        if (*it == &store)
+            *it = NULL;
 }
 
 }
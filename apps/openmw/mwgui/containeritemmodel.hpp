@@ -2,13 +2,19 @@
 #define MWGUI_CONTAINER_ITEM_MODEL_H
 
 #include "itemmodel.hpp"
+#include "stacklist.hpp"
+
+#include "../mwworld/containerstore.hpp"
 
 namespace MWGui
 {
 
     /// @brief The container item model supports multiple item sources, which are needed for
     /// making NPCs sell items from containers owned by them
-    class ContainerItemModel : public ItemModel
+    /// @par Like InventoryItemModel, it listens to the stores of its sources, so that update() only needs to recount
+    /// the stacks that items were added to or removed from. Since one stack can gather items from several sources,
+    /// recounting a stack still looks at all items of the sources.
+    class ContainerItemModel : public ItemModel, public MWWorld::ContainerStoreListener
     {
     public:
         ContainerItemModel (const std::vector<MWWorld::Ptr>& itemSources, const std::vector<MWWorld::Ptr>& worldItems);
@@ -17,6 +23,8 @@ namespace MWGui
 
         ContainerItemModel (const MWWorld::Ptr& source);
 
+        virtual ~ContainerItemModel();
+
         virtual ItemStack getItem (ModelIndex index);
         virtual ModelIndex getIndex (ItemStack item);
         virtual size_t getItemCount();
@@ -26,11 +34,32 @@ namespace MWGui
 
         virtual void update();
 
+        virtual bool getUpdatedItems (std::vector<MWWorld::Ptr>& items);
+
+        virtual void itemAdded (const MWWorld::ConstPtr& item, int count);
+        virtual void itemRemoved (const MWWorld::ConstPtr& item, int count);
+        virtual void storeDestroyed (const MWWorld::ContainerStore& store);
+
     private:
+        void rebuild();
+
+        /// Recount the stack that \a item belongs to from all sources. The stack is removed if no items are left.
+        void updateStack (const MWWorld::ConstPtr& item);
+
+        /// Add \a item to the stack it belongs to in \a items, or start a new stack.
+        void addToStack (std::vector<ItemStack>& items, const MWWorld::Ptr& item);
+
         std::vector<MWWorld::Ptr> mItemSources;
         std::vector<MWWorld::Ptr> mWorldItems;
 
-        std::vector<ItemStack> mItems;
+        StackList<const MWWorld::LiveCellRefBase*, ItemStack> mItems;
+
+        std::vector<MWWorld::ContainerStore*> mStores; ///< listened to, at the same index as the source
+        std::vector<unsigned int> mRevisions; ///< revisions of mStores that mItems reflects, apart from mPendingItems
+        std::vector<MWWorld::ConstPtr> mPendingItems; ///< changed since the last update()
+
+        std::vector<MWWorld::Ptr> mUpdatedItems;
+        bool mRebuilt;
     };
 
 }
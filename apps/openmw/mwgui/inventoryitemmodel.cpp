@@ -9,9 +9,18 @@ namespace MWGui
 
 InventoryItemModel::InventoryItemModel(const MWWorld::Ptr &actor)
     : mActor(actor)
+    , mStore(NULL)
+    , mRevision(0)
+    , mRebuilt(true)
 {
 }
 
+InventoryItemModel::~InventoryItemModel()
+{
+    if (mStore)
+        mStore->removeContListener(this);
+}
+
 ItemStack InventoryItemModel::getItem (ModelIndex index)
 {
     if (index < 0)
@@ -28,13 +37,9 @@ size_t InventoryItemModel::getItemCount()
 
 ItemModel::ModelIndex InventoryItemModel::getIndex (ItemStack item)
 {
-    size_t i = 0;
-    for (std::vector<ItemStack>::iterator it = mItems.begin(); it != mItems.end(); ++it)
-    {
-        if (*it == item)
-            return i;
-        ++i;
-    }
+    int index = mItems.find(item.mBase.getBase());
+    if (index != -1 && mItems[index] == item)
+        return index;
     return -1;
 }
 
@@ -72,7 +77,51 @@ void InventoryItemModel::update()
 {
     MWWorld::ContainerStore& store = mActor.getClass().getContainerStore(mActor);
 
+    if (&store != mStore || store.getRevision() != mRevision)
+    {
+        rebuild(store);
+        return;
+    }
+
+    mUpdatedItems.clear();
+    mRebuilt = false;
+
+    for (std::vector<const MWWorld::LiveCellRefBase*>::const_iterator it = mPendingItems.begin(); it != mPendingItems.end(); ++it)
+    {
+        // The listener only hands out ConstPtrs, but the items are ours to modify
+        MWWorld::Ptr item (const_cast<MWWorld::LiveCellRefBase*>(*it));
+        item.setContainerStore(mStore);
+
+        updateItem(item);
+        mUpdatedItems.push_back(item);
+    }
+
+    mPendingItems.clear();
+}
+
+bool InventoryItemModel::getUpdatedItems(std::vector<MWWorld::Ptr> &items)
+{
+    if (mRebuilt)
+        return false;
+
+    items = mUpdatedItems;
+    return true;
+}
+
+void InventoryItemModel::rebuild(MWWorld::ContainerStore& store)
+{
+    if (&store != mStore)
+    {
+        if (mStore)
+            mStore->removeContListener(this);
+        mStore = &store;
+        mStore->addContListener(this);
+    }
+
     mItems.clear();
+    mPendingItems.clear();
+    mUpdatedItems.clear();
+    mRebuilt = true;
 
     for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
     {
@@ -81,17 +130,49 @@ void InventoryItemModel::update()
         if (!item.getClass().showsInInventory(item))
             continue;
 
-        ItemStack newItem (item, this, item.getRefData().getCount());
+        mItems.set(item.getBase(), createStack(item));
+    }
+
+    mRevision = store.getRevision();
+}
+
+void InventoryItemModel::updateItem(const MWWorld::Ptr &item)
+{
+    // Removed items stay in the store with a count of 0 until it is cleaned up
+    if (item.getRefData().getCount() == 0 || !item.getClass().showsInInventory(item))
+        mItems.remove(item.getBase());
+    else
+        mItems.set(item.getBase(), createStack(item));
+}
 
-        if (mActor.getClass().hasInventoryStore(mActor))
-        {
-            MWWorld::InventoryStore& invStore = mActor.getClass().getInventoryStore(mActor);
-            if (invStore.isEquipped(newItem.mBase))
-                newItem.mType = ItemStack::Type_Equipped;
-        }
+ItemStack InventoryItemModel::createStack(const MWWorld::Ptr &item)
+{
+    ItemStack newItem (item, this, item.getRefData().getCount());
 
-        mItems.push_back(newItem);
+    if (mActor.getClass().hasInventoryStore(mActor))
+    {
+        MWWorld::InventoryStore& invStore = mActor.getClass().getInventoryStore(mActor);
+        if (invStore.isEquipped(newItem.mBase))
+            newItem.mType = ItemStack::Type_Equipped;
     }
+
+    return newItem;
+}
+
+void InventoryItemModel::itemAdded(const MWWorld::ConstPtr &item, int count)
+{
+    mPendingItems.push_back(item.getBase());
+}
+
+void InventoryItemModel::itemRemoved(const MWWorld::ConstPtr &item, int count)
+{
+    mPendingItems.push_back(item.getBase());
+}
+
+void InventoryItemModel::storeDestroyed(const MWWorld::ContainerStore &store)
+{
+    if (&store == mStore)
+        mStore = NULL;
 }
 
 }
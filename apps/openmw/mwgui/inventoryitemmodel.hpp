@@ -2,14 +2,21 @@
 #define MWGUI_INVENTORY_ITEM_MODEL_H
 
 #include "itemmodel.hpp"
+#include "stacklist.hpp"
+
+#include "../mwworld/containerstore.hpp"
 
 namespace MWGui
 {
 
-    class InventoryItemModel : public ItemModel
+    /// @brief Lists the items of an actor's or container's ContainerStore.
+    /// @par Items added to or removed from the store are tracked through ContainerStoreListener, so that update()
+    /// only needs to touch those stacks. The item list is only rebuilt when the store changed in other ways.
+    class InventoryItemModel : public ItemModel, public MWWorld::ContainerStoreListener
     {
     public:
         InventoryItemModel (const MWWorld::Ptr& actor);
+        virtual ~InventoryItemModel();
 
         virtual ItemStack getItem (ModelIndex index);
         virtual ModelIndex getIndex (ItemStack item);
@@ -23,10 +30,31 @@ namespace MWGui
 
         virtual void update();
 
+        virtual bool getUpdatedItems (std::vector<MWWorld::Ptr>& items);
+
+        virtual void itemAdded (const MWWorld::ConstPtr& item, int count);
+        virtual void itemRemoved (const MWWorld::ConstPtr& item, int count);
+        virtual void storeDestroyed (const MWWorld::ContainerStore& store);
+
     protected:
         MWWorld::Ptr mActor;
     private:
-        std::vector<ItemStack> mItems;
+        void rebuild (MWWorld::ContainerStore& store);
+
+        /// Add, replace or remove the stack of \a item to match its state in the store. Stacks that are
+        /// empty or hidden are removed.
+        void updateItem (const MWWorld::Ptr& item);
+
+        ItemStack createStack (const MWWorld::Ptr& item);
+
+        StackList<const MWWorld::LiveCellRefBase*, ItemStack> mItems;
+
+        MWWorld::ContainerStore* mStore;
+        unsigned int mRevision; ///< revision of mStore that mItems reflects, apart from mPendingItems
+        std::vector<const MWWorld::LiveCellRefBase*> mPendingItems; ///< changed since the last update()
+
+        std::vector<MWWorld::Ptr> mUpdatedItems;
+        bool mRebuilt;
     };
 
 }
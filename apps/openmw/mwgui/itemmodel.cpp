@@ -124,6 +124,11 @@ namespace MWGui
         return true;
     }
 
+    bool ItemModel::getUpdatedItems (std::vector<MWWorld::Ptr>& items)
+    {
+        return false;
+    }
+
 
     ProxyItemModel::ProxyItemModel()
         : mSourceModel(NULL)
@@ -1,6 +1,8 @@
 #ifndef MWGUI_ITEM_MODEL_H
 #define MWGUI_ITEM_MODEL_H
 
+#include <vector>
+
 #include "../mwworld/ptr.hpp"
 
 namespace MWGui
@@ -61,6 +63,11 @@ namespace MWGui
         /// Rebuild the item model, this will invalidate existing model indices
         virtual void update() = 0;
 
+        /// Get the items whose stacks may have been added, changed or removed by the last update(),
+        /// so that proxy models can follow the change without rebuilding.
+        /// @return false if that is unknown, i.e. any item may have changed (default)
+        virtual bool getUpdatedItems (std::vector<MWWorld::Ptr>& items);
+
         /// Move items from this model to \a otherModel.
         /// @note Derived implementations may return an empty Ptr if the move was unsuccessful.
         virtual MWWorld::Ptr moveItem (const ItemStack& item, size_t count, ItemModel* otherModel);
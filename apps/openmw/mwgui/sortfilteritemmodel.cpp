@@ -1,5 +1,7 @@
 #include "sortfilteritemmodel.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 #include <components/misc/stringops.hpp>
@@ -27,58 +29,70 @@
 
 namespace
 {
-    bool compareType(const std::string& type1, const std::string& type2)
-    {
-        // this defines the sorting order of types. types that are first in the vector appear before other types.
-        std::vector<std::string> mapping;
-        mapping.push_back( typeid(ESM::Weapon).name() );
-        mapping.push_back( typeid(ESM::Armor).name() );
-        mapping.push_back( typeid(ESM::Clothing).name() );
-        mapping.push_back( typeid(ESM::Potion).name() );
-        mapping.push_back( typeid(ESM::Ingredient).name() );
-        mapping.push_back( typeid(ESM::Apparatus).name() );
-        mapping.push_back( typeid(ESM::Book).name() );
-        mapping.push_back( typeid(ESM::Light).name() );
-        mapping.push_back( typeid(ESM::Miscellaneous).name() );
-        mapping.push_back( typeid(ESM::Lockpick).name() );
-        mapping.push_back( typeid(ESM::Repair).name() );
-        mapping.push_back( typeid(ESM::Probe).name() );
-
-        assert( std::find(mapping.begin(), mapping.end(), type1) != mapping.end() );
-        assert( std::find(mapping.begin(), mapping.end(), type2) != mapping.end() );
-
-        return std::find(mapping.begin(), mapping.end(), type1) < std::find(mapping.begin(), mapping.end(), type2);
+    int getTypeRank(const std::string& type)
+    {
+        // this defines the sorting order of types. types that are first in the list appear before other types.
+        static const char* mapping[] =
+        {
+            typeid(ESM::Weapon).name(),
+            typeid(ESM::Armor).name(),
+            typeid(ESM::Clothing).name(),
+            typeid(ESM::Potion).name(),
+            typeid(ESM::Ingredient).name(),
+            typeid(ESM::Apparatus).name(),
+            typeid(ESM::Book).name(),
+            typeid(ESM::Light).name(),
+            typeid(ESM::Miscellaneous).name(),
+            typeid(ESM::Lockpick).name(),
+            typeid(ESM::Repair).name(),
+            typeid(ESM::Probe).name()
+        };
+
+        static const int count = sizeof(mapping) / sizeof(mapping[0]);
+
+        for (int i = 0; i < count; ++i)
+            if (type == mapping[i])
+                return i;
+
+        assert(false);
+        return count;
     }
+}
+
+namespace MWGui
+{
 
-    struct Compare
+    struct SortFilterItemModel::Compare
     {
-        bool mSortByType;
-        Compare() : mSortByType(true) {}
-        bool operator() (const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        SortFilterItemModel* mModel;
+
+        Compare(SortFilterItemModel* model) : mModel(model) {}
+
+        bool operator() (const ItemStack& left, const ItemStack& right)
         {
-            if (mSortByType && left.mType != right.mType)
+            if (mModel->mSortByType && left.mType != right.mType)
                 return left.mType < right.mType;
 
-            if (left.mBase.getTypeName() == right.mBase.getTypeName())
-            {
-                std::string leftName = Misc::StringUtils::lowerCase(left.mBase.getClass().getName(left.mBase));
-                std::string rightName = Misc::StringUtils::lowerCase(right.mBase.getClass().getName(right.mBase));
+            const SortKey& leftKey = mModel->getSortKey(left.mBase);
+            const SortKey& rightKey = mModel->getSortKey(right.mBase);
 
-                return leftName.compare(rightName) < 0;
-            }
-            else
-                return compareType(left.mBase.getTypeName(), right.mBase.getTypeName());
+            if (leftKey.mTypeRank != rightKey.mTypeRank)
+                return leftKey.mTypeRank < rightKey.mTypeRank;
+
+            int compare = leftKey.mName.compare(rightKey.mName);
+            if (compare != 0)
+                return compare < 0;
+
+            // Items with the same name still need a strict order, so that they can be found by a binary search
+            return left.mBase.getBase() < right.mBase.getBase();
         }
     };
-}
-
-namespace MWGui
-{
 
     SortFilterItemModel::SortFilterItemModel(ItemModel *sourceModel)
         : mCategory(Category_All)
         , mFilter(0)
         , mSortByType(true)
+        , mRebuild(true)
     {
         mSourceModel = sourceModel;
     }
@@ -86,13 +100,28 @@ namespace MWGui
     void SortFilterItemModel::addDragItem (const MWWorld::Ptr& dragItem, size_t count)
     {
         mDragItems.push_back(std::make_pair(dragItem, count));
+        mChangedDragItems.push_back(dragItem);
     }
 
     void SortFilterItemModel::clearDragItems()
     {
+        for (std::vector<std::pair<MWWorld::Ptr, size_t> >::iterator it = mDragItems.begin(); it != mDragItems.end(); ++it)
+            mChangedDragItems.push_back(it->first);
         mDragItems.clear();
     }
 
+    const SortFilterItemModel::SortKey& SortFilterItemModel::getSortKey (const MWWorld::Ptr& item)
+    {
+        std::map<const MWWorld::LiveCellRefBase*, SortKey>::iterator found = mSortKeys.find(item.getBase());
+        if (found != mSortKeys.end())
+            return found->second;
+
+        SortKey& key = mSortKeys[item.getBase()];
+        key.mTypeRank = getTypeRank(item.getTypeName());
+        key.mName = Misc::StringUtils::lowerCase(item.getClass().getName(item));
+        return key;
+    }
+
     bool SortFilterItemModel::filterAccepts (const ItemStack& item)
     {
         MWWorld::Ptr base = item.mBase;
@@ -193,17 +222,60 @@ namespace MWGui
     void SortFilterItemModel::setCategory (int category)
     {
         mCategory = category;
+        mRebuild = true;
     }
 
     void SortFilterItemModel::setFilter (int filter)
     {
         mFilter = filter;
+        mRebuild = true;
+    }
+
+    void SortFilterItemModel::setSortByType (bool sort)
+    {
+        mSortByType = sort;
+        mRebuild = true;
     }
 
     void SortFilterItemModel::update()
     {
         mSourceModel->update();
 
+        // Filters other than the category may depend on the state of an item (e.g. its health), which can change
+        // without the source model noticing
+        std::vector<MWWorld::Ptr> changedItems;
+        if (!mRebuild && mFilter == 0 && mSourceModel->getUpdatedItems(changedItems))
+        {
+            changedItems.insert(changedItems.end(), mChangedDragItems.begin(), mChangedDragItems.end());
+            updateItems(changedItems);
+        }
+        else
+            rebuild();
+
+        mChangedDragItems.clear();
+        mRebuild = false;
+    }
+
+    bool SortFilterItemModel::acceptStack (ItemStack& item)
+    {
+        for (std::vector<std::pair<MWWorld::Ptr, size_t> >::iterator it = mDragItems.begin(); it != mDragItems.end(); ++it)
+        {
+            if (item.mBase == it->first)
+            {
+                if (item.mCount < it->second)
+                    throw std::runtime_error("Dragging more than present in the model");
+                item.mCount -= it->second;
+            }
+        }
+
+        return item.mCount > 0 && filterAccepts(item);
+    }
+
+    void SortFilterItemModel::rebuild()
+    {
+        // The source model may have been rebuilt from different objects
+        mSortKeys.clear();
+
         size_t count = mSourceModel->getItemCount();
 
         mItems.clear();
@@ -211,23 +283,53 @@ namespace MWGui
         {
             ItemStack item = mSourceModel->getItem(i);
 
-            for (std::vector<std::pair<MWWorld::Ptr, size_t> >::iterator it = mDragItems.begin(); it != mDragItems.end(); ++it)
+            if (acceptStack(item))
+                mItems.push_back(item);
+        }
+
+        std::sort(mItems.begin(), mItems.end(), Compare(this));
+    }
+
+    void SortFilterItemModel::updateItems (const std::vector<MWWorld::Ptr>& changedItems)
+    {
+        if (changedItems.empty())
+            return;
+
+        Compare cmp(this);
+
+        std::vector<const MWWorld::LiveCellRefBase*> changed;
+        changed.reserve(changedItems.size());
+
+        for (std::vector<MWWorld::Ptr>::const_iterator it = changedItems.begin(); it != changedItems.end(); ++it)
+        {
+            changed.push_back(it->getBase());
+
+            // An item may be listed once per stack type
+            for (int type = ItemStack::Type_Barter; type <= ItemStack::Type_Normal; ++type)
             {
-                if (item.mBase == it->first)
-                {
-                    if (item.mCount < it->second)
-                        throw std::runtime_error("Dragging more than present in the model");
-                    item.mCount -= it->second;
-                }
-            }
+                ItemStack key (*it, NULL, 0);
+                key.mType = static_cast<ItemStack::Type>(type);
 
-            if (item.mCount > 0 && filterAccepts(item))
-                mItems.push_back(item);
+                std::vector<ItemStack>::iterator found = std::lower_bound(mItems.begin(), mItems.end(), key, cmp);
+                while (found != mItems.end() && found->mBase == *it)
+                    found = mItems.erase(found);
+            }
         }
 
-        Compare cmp;
-        cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+        size_t count = mSourceModel->getItemCount();
+        for (size_t i=0; i<count; ++i)
+        {
+            ItemStack item = mSourceModel->getItem(i);
+
+            if (!std::binary_search(changed.begin(), changed.end(), item.mBase.getBase()))
+                continue;
+
+            if (acceptStack(item))
+                mItems.insert(std::upper_bound(mItems.begin(), mItems.end(), item, cmp), item);
+        }
     }
 
 }
@@ -1,11 +1,16 @@
 #ifndef MWGUI_SORT_FILTER_ITEM_MODEL_H
 #define MWGUI_SORT_FILTER_ITEM_MODEL_H
 
+#include <map>
+
 #include "itemmodel.hpp"
 
 namespace MWGui
 {
 
+    /// @brief Sorts and filters the items of another model.
+    /// @par Sort keys are cached per item. If the source model can tell which items changed and no state-dependent
+    /// filter is active, update() only re-sorts those items instead of rebuilding the whole list.
     class SortFilterItemModel : public ProxyItemModel
     {
     public:
@@ -26,7 +31,7 @@ namespace MWGui
         void setFilter (int filter);
 
         /// Use ItemStack::Type for sorting?
-        void setSortByType(bool sort) { mSortByType = sort; }
+        void setSortByType(bool sort);
 
         static const int Category_Weapon = (1<<1);
         static const int Category_Apparel = (1<<2);
@@ -45,10 +50,33 @@ namespace MWGui
 
 
     private:
+        struct SortKey
+        {
+            int mTypeRank;
+            std::string mName;
+        };
+
+        struct Compare;
+
+        const SortKey& getSortKey (const MWWorld::Ptr& item);
+
+        /// Apply drag items and filters to a stack of the source model.
+        bool acceptStack (ItemStack& item);
+
+        void rebuild();
+
+        /// Re-sort the stacks of \a changedItems only.
+        void updateItems (const std::vector<MWWorld::Ptr>& changedItems);
+
         std::vector<ItemStack> mItems;
 
         std::vector<std::pair<MWWorld::Ptr, size_t> > mDragItems;
 
+        std::map<const MWWorld::LiveCellRefBase*, SortKey> mSortKeys;
+
+        std::vector<MWWorld::Ptr> mChangedDragItems; ///< drag items added or cleared since the last update()
+        bool mRebuild; ///< sorting or filtering changed since the last update()
+
         int mCategory;
         int mFilter;
         bool mSortByType;
@@ -0,0 +1,81 @@
+#ifndef MWGUI_STACK_LIST_H
+#define MWGUI_STACK_LIST_H
+
+#include <map>
+#include <vector>
+
+namespace MWGui
+{
+
+    /// @brief A list of stacks that can be updated one stack at a time, looking stacks up by a key.
+    /// @par Removing a stack moves the last stack into its place, so the order of the stacks is not kept.
+    template<typename Key, typename Stack>
+    class StackList
+    {
+    public:
+        size_t size() const
+        {
+            return mStacks.size();
+        }
+
+        const Stack& operator[] (size_t index) const
+        {
+            return mStacks[index];
+        }
+
+        /// @return The index of the stack of @a key, or -1 if there is none.
+        int find (const Key& key) const
+        {
+            typename std::map<Key, size_t>::const_iterator found = mIndices.find(key);
+            return found != mIndices.end() ? static_cast<int>(found->second) : -1;
+        }
+
+        /// Add the stack of @a key, or replace it if there already is one.
+        void set (const Key& key, const Stack& stack)
+        {
+            typename std::map<Key, size_t>::iterator found = mIndices.find(key);
+            if (found != mIndices.end())
+                mStacks[found->second] = stack;
+            else
+            {
+                mIndices[key] = mStacks.size();
+                mKeys.push_back(key);
+                mStacks.push_back(stack);
+            }
+        }
+
+        /// Remove the stack of @a key, if there is one.
+        void remove (const Key& key)
+        {
+            typename std::map<Key, size_t>::iterator found = mIndices.find(key);
+            if (found == mIndices.end())
+                return;
+
+            size_t index = found->second;
+            mIndices.erase(found);
+            if (index != mStacks.size()-1)
+            {
+                mStacks[index] = mStacks.back();
+                mKeys[index] = mKeys.back();
+                mIndices[mKeys[index]] = index;
+            }
+            mStacks.pop_back();
+            mKeys.pop_back();
+        }
+
+        void clear()
+        {
+            mStacks.clear();
+            mKeys.clear();
+            mIndices.clear();
+        }
+
+    private:
+        std::vector<Stack> mStacks;
+        std::vector<Key> mKeys; ///< key of the stack at the same index
+        std::map<Key, size_t> mIndices;
+    };
+
+}
+
+#endif
@@ -11,6 +11,8 @@ namespace MWGui
 
     TradeItemModel::TradeItemModel(ItemModel *sourceModel, const MWWorld::Ptr& merchant)
         : mMerchant(merchant)
+        , mBorrowingChanged(true)
+        , mRebuilt(true)
     {
         mSourceModel = sourceModel;
     }
@@ -31,6 +33,7 @@ namespace MWGui
 
     void TradeItemModel::borrowImpl(const ItemStack &item, std::vector<ItemStack> &out)
     {
+        mBorrowingChanged = true;
         std::vector<ItemStack>::iterator it = out.begin();
         bool found = false;
         for (; it != out.end(); ++it)
@@ -48,6 +51,7 @@ namespace MWGui
 
     void TradeItemModel::unborrowImpl(const ItemStack &item, size_t count, std::vector<ItemStack> &out)
     {
+        mBorrowingChanged = true;
         std::vector<ItemStack>::iterator it = out.begin();
         bool found = false;
         for (; it != out.end(); ++it)
@@ -112,6 +116,7 @@ namespace MWGui
     {
         mBorrowedFromUs.clear();
         mBorrowedToUs.clear();
+        mBorrowingChanged = true;
     }
 
     std::vector<ItemStack> TradeItemModel::getItemsBorrowedToUs()
@@ -143,12 +148,25 @@ namespace MWGui
         }
         mBorrowedToUs.clear();
         mBorrowedFromUs.clear();
+        mBorrowingChanged = true;
+    }
+
+    bool TradeItemModel::getUpdatedItems(std::vector<MWWorld::Ptr> &items)
+    {
+        // Borrowed items affect the counts of other items, and are listed themselves
+        if (mRebuilt)
+            return false;
+
+        return mSourceModel->getUpdatedItems(items);
     }
 
     void TradeItemModel::update()
     {
         mSourceModel->update();
 
+        mRebuilt = mBorrowingChanged;
+        mBorrowingChanged = false;
+
         int services = 0;
         if (!mMerchant.isEmpty())
             services = mMerchant.getClass().getServices(mMerchant);
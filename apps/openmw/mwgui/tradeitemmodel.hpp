@@ -20,6 +20,8 @@ namespace MWGui
 
         virtual void update();
 
+        virtual bool getUpdatedItems (std::vector<MWWorld::Ptr>& items);
+
         void borrowItemFromUs (ModelIndex itemIndex, size_t count);
 
         void borrowItemToUs (ModelIndex itemIndex, ItemModel* source, size_t count);
@@ -50,6 +52,9 @@ namespace MWGui
         std::vector<ItemStack> mBorrowedFromUs;
 
         MWWorld::Ptr mMerchant;
+
+        bool mBorrowingChanged; ///< since the last update()
+        bool mRebuilt; ///< the last update() may have changed any item
     };
 
 }
@@ -14,11 +14,15 @@ namespace MWMechanics
 {
     void ActiveSpells::update() const
     {
-        bool rebuild = false;
+        bool changed = false;
 
         MWWorld::TimeStamp now = MWBase::Environment::get().getWorld()->getTimeStamp();
 
-        // Erase no longer active spells and effects
+        // The end times of the effects depend on the time scale
+        if (MWBase::Environment::get().getWorld()->getTimeScaleFactor()!=mLastRebuildTimeScale)
+            mSpellsChanged = true;
+
+        // Erase no longer active spells and effects, and take them out of mEffects
         if (mLastUpdate!=now)
         {
             TContainer::iterator iter (mSpells.begin());
@@ -26,20 +30,23 @@ namespace MWMechanics
             {
                 if (!timeToExpire (iter))
                 {
+                    const std::vector<ActiveEffect>& effects = iter->second.mEffects;
+                    for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end(); ++effectIt)
+                        removeFromEffects(iter->second.mTimeStamp, *effectIt);
+
                     mSpells.erase (iter++);
-                    rebuild = true;
+                    changed = true;
                 }
                 else
                 {
                     std::vector<ActiveEffect>& effects = iter->second.mEffects;
                     for (std::vector<ActiveEffect>::iterator effectIt = effects.begin(); effectIt != effects.end();)
                     {
-                        MWWorld::TimeStamp start = iter->second.mTimeStamp;
-                        MWWorld::TimeStamp end = start + static_cast<double>(effectIt->mDuration)*MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
-                        if (end <= now)
+                        if (getEndTime(iter->second.mTimeStamp, *effectIt) <= now)
                         {
+                            removeFromEffects(iter->second.mTimeStamp, *effectIt);
                             effectIt = effects.erase(effectIt);
-                            rebuild = true;
+                            changed = true;
                         }
                         else
                             ++effectIt;
@@ -54,11 +61,12 @@ namespace MWMechanics
         if (mSpellsChanged)
         {
             mSpellsChanged = false;
-            rebuild = true;
+            rebuildEffects();
+            changed = true;
         }
 
-        if (rebuild)
-            rebuildEffects();
+        if (changed)
+            ++mRevision;
     }
 
     void ActiveSpells::rebuildEffects() const
@@ -66,6 +74,9 @@ namespace MWMechanics
         MWWorld::TimeStamp now = MWBase::Environment::get().getWorld()->getTimeStamp();
 
         mEffects = MagicEffects();
+        mEffectCounts.clear();
+        mLastRebuild = now;
+        mLastRebuildTimeScale = MWBase::Environment::get().getWorld()->getTimeScaleFactor();
 
         for (TIterator iter (begin()); iter!=end(); ++iter)
         {
@@ -75,20 +86,55 @@ namespace MWMechanics
 
             for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end(); ++effectIt)
             {
-                double duration = effectIt->mDuration;
-                MWWorld::TimeStamp end = start;
-                end += duration * 
-                    MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
-
-                if (end>now)
-                    mEffects.add(MWMechanics::EffectKey(effectIt->mEffectId, effectIt->mArg), MWMechanics::EffectParam(effectIt->mMagnitude));
+                if (getEndTime(start, *effectIt)>now)
+                    addToEffects(*effectIt);
             }
         }
     }
 
+    MWWorld::TimeStamp ActiveSpells::getEndTime (const MWWorld::TimeStamp& start, const ActiveEffect& effect)
+    {
+        double duration = effect.mDuration;
+        MWWorld::TimeStamp end = start;
+        end += duration *
+            MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
+        return end;
+    }
+
+    void ActiveSpells::addToEffects (const ActiveEffect& effect) const
+    {
+        EffectKey key (effect.mEffectId, effect.mArg);
+        mEffects.add(key, EffectParam(effect.mMagnitude));
+        ++mEffectCounts[key];
+    }
+
+    void ActiveSpells::removeFromEffects (const MWWorld::TimeStamp& start, const ActiveEffect& effect) const
+    {
+        // Effects that had already ended when mEffects was rebuilt are not part of it
+        if (getEndTime(start, effect)<=mLastRebuild)
+            return;
+
+        EffectKey key (effect.mEffectId, effect.mArg);
+        std::map<EffectKey, int>::iterator count = mEffectCounts.find(key);
+        if (count==mEffectCounts.end())
+            return;
+
+        if (--count->second>0)
+            mEffects.add(key, EffectParam(-effect.mMagnitude));
+        else
+        {
+            // Remove the entry, rather than leaving behind the rounding errors of the subtraction
+            mEffects.remove(key);
+            mEffectCounts.erase(count);
+        }
+    }
+
     ActiveSpells::ActiveSpells()
         : mSpellsChanged (false)
+        , mRevision (0)
         , mLastUpdate (MWBase::Environment::get().getWorld()->getTimeStamp())
+        , mLastRebuild (mLastUpdate)
+        , mLastRebuildTimeScale (MWBase::Environment::get().getWorld()->getTimeScaleFactor())
     {}
 
     const MagicEffects& ActiveSpells::getMagicEffects() const
@@ -97,6 +143,12 @@ namespace MWMechanics
         return mEffects;
     }
 
+    unsigned int ActiveSpells::getRevision() const
+    {
+        update();
+        return mRevision;
+    }
+
     ActiveSpells::TIterator ActiveSpells::begin() const
     {
         return mSpells.begin();
@@ -160,6 +212,20 @@ namespace MWMechanics
         if (it == end() || stack)
         {
             mSpells.insert(std::make_pair(id, params));
+
+            // Add the new effects to mEffects directly, unless some of them would not be part of a rebuilt mEffects
+            bool incremental = !mSpellsChanged && params.mTimeStamp >= mLastRebuild;
+            for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end() && incremental; ++effectIt)
+                if (getEndTime(params.mTimeStamp, *effectIt) <= params.mTimeStamp)
+                    incremental = false;
+
+            if (incremental)
+            {
+                for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end(); ++effectIt)
+                    addToEffects(*effectIt);
+                ++mRevision;
+                return;
+            }
         }
         else
         {
@@ -49,12 +49,28 @@ namespace MWMechanics
             mutable TContainer mSpells;
             mutable MagicEffects mEffects;
             mutable bool mSpellsChanged;
+            mutable unsigned int mRevision;
             mutable MWWorld::TimeStamp mLastUpdate;
 
+            /// Number of active effects that make up each entry in mEffects
+            mutable std::map<EffectKey, int> mEffectCounts;
+
+            /// Time and time scale of the last rebuildEffects(). Effects that ended before that were not added to mEffects.
+            mutable MWWorld::TimeStamp mLastRebuild;
+            mutable float mLastRebuildTimeScale;
+
             void update() const;
             
             void rebuildEffects() const;
 
+            /// \return Time at which \a effect of a spell cast at \a start ends.
+            static MWWorld::TimeStamp getEndTime (const MWWorld::TimeStamp& start, const ActiveEffect& effect);
+
+            void addToEffects (const ActiveEffect& effect) const;
+
+            /// Undo addToEffects() for an effect that has been removed.
+            void removeFromEffects (const MWWorld::TimeStamp& start, const ActiveEffect& effect) const;
+
             /// Add any effects that are in "from" and not in "addTo" to "addTo"
             void mergeEffects(std::vector<ActiveEffect>& addTo, const std::vector<ActiveEffect>& from);
 
@@ -102,6 +118,9 @@ namespace MWMechanics
 
             const MagicEffects& getMagicEffects() const;
 
+            unsigned int getRevision() const;
+            ///< Changes whenever the active effects change, including when they expire.
+
             void visitEffectSources (MWMechanics::EffectSourceVisitor& visitor) const;
 
     };
@@ -25,4 +25,9 @@ namespace MWMechanics
         return mAiState;
     }
 
+    AiSchedule& Actor::getAiSchedule()
+    {
+        return mAiSchedule;
+    }
+
 }
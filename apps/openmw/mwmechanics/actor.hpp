@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "aistate.hpp"
+#include "aischeduler.hpp"
 
 namespace MWRender
 {
@@ -31,10 +32,14 @@ namespace MWMechanics
 
         AiState& getAiState();
 
+        AiSchedule& getAiSchedule();
+
     private:
         std::unique_ptr<CharacterController> mCharacterController;
 
         AiState mAiState;
+
+        AiSchedule mAiSchedule;
     };
 
 }
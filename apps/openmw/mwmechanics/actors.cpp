@@ -2,11 +2,14 @@
 
 #include <typeinfo>
 #include <iostream>
+#include <cmath>
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/loadnpc.hpp>
 
+#include <components/misc/trace.hpp>
+
 #include <components/sceneutil/positionattitudetransform.hpp>
 
 #include <components/settings/settings.hpp>
@@ -122,7 +125,7 @@ void adjustCommandedActor (const MWWorld::Ptr& actor)
 void getRestorationPerHourOfSleep (const MWWorld::Ptr& ptr, float& health, float& magicka)
 {
     MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats (ptr);
-    const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+    const MWWorld::GmstTable& settings = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
     bool stunted = stats.getMagicEffects ().get(ESM::MagicEffect::StuntedMagicka).getMagnitude() > 0;
     int endurance = stats.getAttribute (ESM::Attribute::Endurance).getModified ();
@@ -132,7 +135,7 @@ void getRestorationPerHourOfSleep (const MWWorld::Ptr& ptr, float& health, float
     magicka = 0;
     if (!stunted)
     {
-        float fRestMagicMult = settings.find("fRestMagicMult")->getFloat ();
+        float fRestMagicMult = settings.getFloat(MWWorld::GMST::fRestMagicMult);
         magicka = fRestMagicMult * stats.getAttribute(ESM::Attribute::Intelligence).getModified();
     }
 }
@@ -241,10 +244,9 @@ namespace MWMechanics
     void Actors::updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
                                     MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance)
     {
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->getFloat();
+        const MWWorld::GmstTable& gmsts = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        const float fMaxHeadTrackDistance = gmsts.getFloat(MWWorld::GMST::fMaxHeadTrackDistance);
+        const float fInteriorHeadTrackMult = gmsts.getFloat(MWWorld::GMST::fInteriorHeadTrackMult);
         float maxDistance = fMaxHeadTrackDistance;
         const ESM::Cell* currentCell = actor.getCell()->getCell();
         if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
@@ -458,9 +460,9 @@ namespace MWMechanics
 
         float base = 1.f;
         if (ptr == getPlayer())
-            base = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fPCbaseMagickaMult")->getFloat();
+            base = MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fPCbaseMagickaMult);
         else
-            base = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fNPCbaseMagickaMult")->getFloat();
+            base = MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fNPCbaseMagickaMult);
 
         double magickaFactor = base +
             creatureStats.getMagicEffects().get (EffectKey (ESM::MagicEffect::FortifyMaximumMagicka)).getMagnitude() * 0.1;
@@ -479,7 +481,7 @@ namespace MWMechanics
             return;
 
         MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats (ptr);
-        const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& settings = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
         if (sleep)
         {
@@ -502,9 +504,9 @@ namespace MWMechanics
             normalizedEncumbrance = 1;
 
         // restore fatigue
-        float fFatigueReturnBase = settings.find("fFatigueReturnBase")->getFloat ();
-        float fFatigueReturnMult = settings.find("fFatigueReturnMult")->getFloat ();
-        float fEndFatigueMult = settings.find("fEndFatigueMult")->getFloat ();
+        float fFatigueReturnBase = settings.getFloat(MWWorld::GMST::fFatigueReturnBase);
+        float fFatigueReturnMult = settings.getFloat(MWWorld::GMST::fFatigueReturnMult);
+        float fEndFatigueMult = settings.getFloat(MWWorld::GMST::fEndFatigueMult);
 
         float x = fFatigueReturnBase + fFatigueReturnMult * (1 - normalizedEncumbrance);
         x *= fEndFatigueMult * endurance;
@@ -524,11 +526,9 @@ namespace MWMechanics
         int endurance = stats.getAttribute (ESM::Attribute::Endurance).getModified ();
 
         // restore fatigue
-        const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-        static const float fFatigueReturnBase = settings.find("fFatigueReturnBase")->getFloat ();
-        static const float fFatigueReturnMult = settings.find("fFatigueReturnMult")->getFloat ();
-
-        float x = fFatigueReturnBase + fFatigueReturnMult * endurance;
+        const MWWorld::GmstTable& settings = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        float x = settings.getFloat(MWWorld::GMST::fFatigueReturnBase)
+                + settings.getFloat(MWWorld::GMST::fFatigueReturnMult) * endurance;
 
         DynamicStat<float> fatigue = stats.getFatigue();
         fatigue.setCurrent (fatigue.getCurrent() + duration * x);
@@ -576,7 +576,7 @@ namespace MWMechanics
             ExpiryVisitor visitor(ptr, duration);
             creatureStats.getActiveSpells().visitEffectSources(visitor);
 
-            for (MagicEffects::Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+            for (MagicEffects::const_iterator it = effects.begin(); it != effects.end(); ++it)
             {
                 // tickable effects (i.e. effects having a lasting impact after expiry)
                 effectTick(creatureStats, ptr, it->first, it->second.getMagnitude() * duration);
@@ -773,7 +773,7 @@ namespace MWMechanics
         }
 
         bool hasSummonEffect = false;
-        for (MagicEffects::Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+        for (MagicEffects::const_iterator it = effects.begin(); it != effects.end(); ++it)
             if (isSummoningEffect(it->first.mId))
                 hasSummonEffect = true;
 
@@ -832,7 +832,7 @@ namespace MWMechanics
         NpcStats &stats = ptr.getClass().getNpcStats(ptr);
 
         // When npc stats are just initialized, mTimeToStartDrowning == -1 and we should get value from GMST
-        static const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fHoldBreathTime")->getFloat();
+        const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fHoldBreathTime);
         if (stats.getTimeToStartDrowning() == -1.f)
             stats.setTimeToStartDrowning(fHoldBreathTime);
 
@@ -1040,7 +1040,10 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() {}
+    Actors::Actors()
+        : mAiScheduler(Settings::Manager::getFloat("ai full rate distance", "Game"), 4)
+    {
+    }
 
     Actors::~Actors()
     {
@@ -1054,7 +1057,9 @@ namespace MWMechanics
         MWRender::Animation *anim = MWBase::Environment::get().getWorld()->getAnimation(ptr);
         if (!anim)
             return;
-        mActors.insert(std::make_pair(ptr, new Actor(ptr, anim)));
+        Actor* actor = new Actor(ptr, anim);
+        mAiScheduler.add(actor->getAiSchedule());
+        mActors.insert(std::make_pair(ptr, actor));
         if (updateImmediately)
             mActors[ptr]->getCharacterController()->update(0);
     }
@@ -1099,6 +1104,8 @@ namespace MWMechanics
 
     void Actors::update (float duration, bool paused)
     {
+        Misc::ScopedTrace trace("Actors::update");
+
         if(!paused)
         {
             static float timerUpdateAITargets = 0;
@@ -1119,6 +1126,8 @@ namespace MWMechanics
 
             std::map<const MWWorld::Ptr, const std::set<MWWorld::Ptr> > cachedAllies; // will be filled as engageCombat iterates
 
+            mAiScheduler.frame();
+
              // AI and magic effects update
             for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
             {
@@ -1126,8 +1135,8 @@ namespace MWMechanics
                 // (it only does some throttling for targets beyond the "AI distance", so doesn't give any guarantees as to whether AI will be enabled or not)
                 // This distance could be made configurable later, but the setting must be marked with a big warning:
                 // using higher values will make a quest in Bloodmoon harder or impossible to complete (bug #1876)
-                bool inProcessingRange = (player.getRefData().getPosition().asVec3() - iter->first.getRefData().getPosition().asVec3()).length2()
-                        <= sqrAiProcessingDistance;
+                float sqrDistance = (player.getRefData().getPosition().asVec3() - iter->first.getRefData().getPosition().asVec3()).length2();
+                bool inProcessingRange = sqrDistance <= sqrAiProcessingDistance;
 
                 iter->second->getCharacterController()->setActive(inProcessingRange);
 
@@ -1193,8 +1202,22 @@ namespace MWMechanics
                         if (iter->first != player)
                         {
                             CreatureStats &stats = iter->first.getClass().getCreatureStats(iter->first);
-                            if (isConscious(iter->first))
-                                stats.getAiSequence().execute(iter->first, *iter->second->getCharacterController(), iter->second->getAiState(), duration);
+                            // Fights and pursuits need quick reactions at any distance
+                            bool fullRate = stats.getAiSequence().isInCombat()
+                                    || stats.getAiSequence().hasPackage(AiPackage::TypeIdPursue);
+                            float aiDuration = 0.f;
+
+                            if (isConscious(iter->first)
+                                && mAiScheduler.update(iter->second->getAiSchedule(), std::sqrt(sqrDistance), fullRate, duration, aiDuration))
+                            {
+                                Misc::ScopedTrace aiTrace("AiSequence::execute");
+                                stats.getAiSequence().execute(iter->first, *iter->second->getCharacterController(), iter->second->getAiState(), aiDuration);
+
+                                // Keep a moving actor on full rate, or it would stand still in the skipped frames
+                                const Movement& movement = iter->first.getClass().getMovementSettings(iter->first);
+                                iter->second->getAiSchedule().mMoving = movement.mPosition[0] != 0 || movement.mPosition[1] != 0
+                                        || movement.mRotation[0] != 0 || movement.mRotation[2] != 0;
+                            }
 
                             if (stats.getAiSequence().isInCombat() && !stats.isDead()) hostilesCount++;
                         }
@@ -1291,9 +1314,9 @@ namespace MWMechanics
                 static float sneakSkillTimer = 0.f; // times sneak skill progress from "avoid notice"
 
                 const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
-                const int radius = esmStore.get<ESM::GameSetting>().find("fSneakUseDist")->getInt();
+                const int radius = esmStore.getGmsts().getInt(MWWorld::GMST::fSneakUseDist);
 
-                static float fSneakUseDelay = esmStore.get<ESM::GameSetting>().find("fSneakUseDelay")->getFloat();
+                const float fSneakUseDelay = esmStore.getGmsts().getFloat(MWWorld::GMST::fSneakUseDelay);
 
                 if (sneakTimer >= fSneakUseDelay)
                     sneakTimer = 0.f;
@@ -10,6 +10,7 @@
 #include "../mwbase/world.hpp"
 
 #include "movement.hpp"
+#include "aischeduler.hpp"
 
 namespace MWWorld
 {
@@ -154,6 +155,8 @@ namespace MWMechanics
     private:
         PtrActorMap mActors;
 
+        AiScheduler mAiScheduler;
+
     };
 }
 
@@ -19,7 +19,7 @@ MWMechanics::AiBreathe::AiBreathe()
 
 bool MWMechanics::AiBreathe::execute (const MWWorld::Ptr& actor, CharacterController& characterController, AiState& state, float duration)
 {
-    static const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fHoldBreathTime")->getFloat();
+    const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fHoldBreathTime);
 
     const MWWorld::Class& actorClass = actor.getClass();
     if (actorClass.isNpc())
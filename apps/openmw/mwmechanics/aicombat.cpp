@@ -579,13 +579,13 @@ namespace MWMechanics
 
                 const MWWorld::ESMStore &store = MWBase::Environment::get().getWorld()->getStore();
 
-                float baseDelay = store.get<ESM::GameSetting>().find("fCombatDelayCreature")->getFloat();
+                float baseDelay = store.getGmsts().getFloat(MWWorld::GMST::fCombatDelayCreature);
                 if (actor.getClass().isNpc())
                 {
-                    baseDelay = store.get<ESM::GameSetting>().find("fCombatDelayNPC")->getFloat();
+                    baseDelay = store.getGmsts().getFloat(MWWorld::GMST::fCombatDelayNPC);
 
                     //say a provoking combat phrase
-                    int chance = store.get<ESM::GameSetting>().find("iVoiceAttackOdds")->getInt();
+                    int chance = store.getGmsts().getInt(MWWorld::GMST::iVoiceAttackOdds);
                     if (Misc::Rng::roll0to99() < chance)
                     {
                         MWBase::Environment::get().getDialogueManager()->say(actor, "attack");
@@ -674,20 +674,18 @@ osg::Vec3f AimDirToMovingTarget(const MWWorld::Ptr& actor, const MWWorld::Ptr& t
     // get projectile speed (depending on weapon type)
     if (weapType == ESM::Weapon::MarksmanThrown)
     {
-        static float fThrownWeaponMinSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fThrownWeaponMinSpeed")->getFloat();
-        static float fThrownWeaponMaxSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fThrownWeaponMaxSpeed")->getFloat();
+        const MWWorld::GmstTable& gmsts = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        const float fThrownWeaponMinSpeed = gmsts.getFloat(MWWorld::GMST::fThrownWeaponMinSpeed);
+        const float fThrownWeaponMaxSpeed = gmsts.getFloat(MWWorld::GMST::fThrownWeaponMaxSpeed);
 
         projSpeed = 
             fThrownWeaponMinSpeed + (fThrownWeaponMaxSpeed - fThrownWeaponMinSpeed) * strength;
     }
     else
     {
-        static float fProjectileMinSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fProjectileMinSpeed")->getFloat();
-        static float fProjectileMaxSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fProjectileMaxSpeed")->getFloat();
+        const MWWorld::GmstTable& gmsts = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        const float fProjectileMinSpeed = gmsts.getFloat(MWWorld::GMST::fProjectileMinSpeed);
+        const float fProjectileMaxSpeed = gmsts.getFloat(MWWorld::GMST::fProjectileMaxSpeed);
 
         projSpeed = 
             fProjectileMinSpeed + (fProjectileMaxSpeed - fProjectileMinSpeed) * strength;
@@ -3,6 +3,8 @@
 #include <components/esm/loadench.hpp>
 #include <components/esm/loadmgef.hpp>
 
+#include <components/misc/trace.hpp>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include "../mwbase/mechanicsmanager.hpp"
@@ -14,6 +16,8 @@
 #include "../mwworld/cellstore.hpp"
 
 #include "npcstats.hpp"
+#include "aipackage.hpp"
+#include "aisequence.hpp"
 #include "spellcasting.hpp"
 #include "combat.hpp"
 #include "weaponpriority.hpp"
@@ -141,9 +145,147 @@ namespace MWMechanics
         return mWeapon.get<ESM::Weapon>()->mBase;
     }
 
+    ActionCache::RatingKey::RatingKey(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    {
+        CreatureStats& enemyStats = enemy.getClass().getCreatureStats(enemy);
+
+        mEnemyId = enemyStats.getActorId();
+        mActorEffects = actor.getClass().getCreatureStats(actor).getActiveSpells().getRevision();
+        mEnemyEffects = enemyStats.getActiveSpells().getRevision();
+        mEnemySpells = enemyStats.getSpells().getRevision();
+        mEnemyInventory = enemy.getClass().hasInventoryStore(enemy) ?
+            enemy.getClass().getInventoryStore(enemy).getModificationCount() : 0;
+    }
+
+    bool ActionCache::RatingKey::operator==(const RatingKey& key) const
+    {
+        return mEnemyId == key.mEnemyId && mActorEffects == key.mActorEffects && mEnemyEffects == key.mEnemyEffects
+            && mEnemySpells == key.mEnemySpells && mEnemyInventory == key.mEnemyInventory;
+    }
+
+    ActionCache::ActionCache()
+        : mStore(NULL), mStoreRevision(0), mSpellsRevision(0), mUpToDate(false)
+    {}
+
+    void ActionCache::updateCandidates(const MWWorld::Ptr& actor)
+    {
+        const Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
+
+        MWWorld::InventoryStore* store = NULL;
+        if (actor.getClass().hasInventoryStore(actor))
+            store = &actor.getClass().getInventoryStore(actor);
+
+        if (mUpToDate && store == mStore && (!store || store->getModificationCount() == mStoreRevision)
+                && spells.getRevision() == mSpellsRevision)
+            return;
+
+        mPotions.clear();
+        mMagicItems.clear();
+        mArrows.clear();
+        mBolts.clear();
+        mWeapons.clear();
+        mSpells.clear();
+        mRatings.clear();
+
+        if (store)
+        {
+            for (MWWorld::ContainerStoreIterator it = store->begin(); it != store->end(); ++it)
+            {
+                if (it->getTypeName() == typeid(ESM::Potion).name())
+                    mPotions.push_back(it);
+
+                if (!it->getClass().getEnchantment(*it).empty())
+                    mMagicItems.push_back(it);
+
+                if (it->getTypeName() != typeid(ESM::Weapon).name())
+                    continue;
+
+                int type = it->get<ESM::Weapon>()->mBase->mData.mType;
+                if (type == ESM::Weapon::Arrow)
+                    mArrows.push_back(it);
+                else if (type == ESM::Weapon::Bolt)
+                    mBolts.push_back(it);
+
+                std::vector<int> equipmentSlots = it->getClass().getEquipmentSlots(*it).first;
+                if (std::find(equipmentSlots.begin(), equipmentSlots.end(), (int)MWWorld::InventoryStore::Slot_CarriedRight)
+                        != equipmentSlots.end())
+                    mWeapons.push_back(it);
+            }
+
+            mStoreRevision = store->getModificationCount();
+        }
+
+        // rateSpell ignores everything else
+        for (Spells::TIterator it = spells.begin(); it != spells.end(); ++it)
+            if (it->first->mData.mType == ESM::Spell::ST_Spell)
+                mSpells.push_back(it->first);
+
+        mStore = store;
+        mSpellsRevision = spells.getRevision();
+        mUpToDate = true;
+    }
+
+    void ActionCache::update(float duration)
+    {
+        for (std::vector<Rating>::iterator it = mRatings.begin(); it != mRatings.end();)
+        {
+            it->mAge += duration;
+            if (it->mAge >= AI_REACTION_TIME)
+                it = mRatings.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    bool ActionCache::getRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, float& rating) const
+    {
+        if (mRatings.empty())
+            return false;
+
+        RatingKey key(actor, enemy);
+
+        for (std::vector<Rating>::const_iterator it = mRatings.begin(); it != mRatings.end(); ++it)
+        {
+            if (it->mKey == key)
+            {
+                rating = it->mRating;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ActionCache::setRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, float rating)
+    {
+        RatingKey key(actor, enemy);
+
+        // only the latest rating against an enemy can be valid
+        for (std::vector<Rating>::iterator it = mRatings.begin(); it != mRatings.end(); ++it)
+        {
+            if (it->mKey.mEnemyId == key.mEnemyId)
+            {
+                mRatings.erase(it);
+                break;
+            }
+        }
+
+        Rating entry = { key, rating, 0.f };
+        mRatings.push_back(entry);
+    }
+
+    namespace
+    {
+        /// Items that were used up since the candidates were collected may still be listed.
+        bool isAvailable(const MWWorld::ContainerStoreIterator& item)
+        {
+            return item->getRefData().getCount() > 0;
+        }
+    }
+
     std::shared_ptr<Action> prepareNextAction(const MWWorld::Ptr &actor, const MWWorld::Ptr &enemy)
     {
-        Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
+        Misc::ScopedTrace trace("prepareNextAction");
 
         float bestActionRating = 0.f;
         float antiFleeRating = 0.f;
@@ -155,84 +297,94 @@ namespace MWMechanics
             return bestAction;
         }
 
-        if (actor.getClass().hasInventoryStore(actor))
+        ActionCache& cache = actor.getClass().getCreatureStats(actor).getAiSequence().getActionCache();
+        cache.updateCandidates(actor);
+
+        typedef std::vector<MWWorld::ContainerStoreIterator>::const_iterator ItemIterator;
+
+        for (ItemIterator it = cache.mPotions.begin(); it != cache.mPotions.end(); ++it)
         {
-            MWWorld::InventoryStore& store = actor.getClass().getInventoryStore(actor);
+            if (!isAvailable(*it))
+                continue;
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = ratePotion(**it, actor);
+            if (rating > bestActionRating)
             {
-                float rating = ratePotion(*it, actor);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                    bestAction.reset(new ActionPotion(*it));
-                    antiFleeRating = std::numeric_limits<float>::max();
-                }
+                bestActionRating = rating;
+                bestAction.reset(new ActionPotion(**it));
+                antiFleeRating = std::numeric_limits<float>::max();
             }
+        }
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+        for (ItemIterator it = cache.mMagicItems.begin(); it != cache.mMagicItems.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
+
+            float rating = rateMagicItem(**it, actor, enemy);
+            if (rating > bestActionRating)
             {
-                float rating = rateMagicItem(*it, actor, enemy);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                    bestAction.reset(new ActionEnchantedItem(it));
-                    antiFleeRating = std::numeric_limits<float>::max();
-                }
+                bestActionRating = rating;
+                bestAction.reset(new ActionEnchantedItem(*it));
+                antiFleeRating = std::numeric_limits<float>::max();
             }
+        }
+
+        float bestArrowRating = 0;
+        MWWorld::Ptr bestArrow;
+        for (ItemIterator it = cache.mArrows.begin(); it != cache.mArrows.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-            float bestArrowRating = 0;
-            MWWorld::Ptr bestArrow;
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = rateWeapon(**it, actor, enemy, ESM::Weapon::Arrow);
+            if (rating > bestArrowRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, ESM::Weapon::Arrow);
-                if (rating > bestArrowRating)
-                {
-                    bestArrowRating = rating;
-                    bestArrow = *it;
-                }
+                bestArrowRating = rating;
+                bestArrow = **it;
             }
+        }
+
+        float bestBoltRating = 0;
+        MWWorld::Ptr bestBolt;
+        for (ItemIterator it = cache.mBolts.begin(); it != cache.mBolts.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-            float bestBoltRating = 0;
-            MWWorld::Ptr bestBolt;
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = rateWeapon(**it, actor, enemy, ESM::Weapon::Bolt);
+            if (rating > bestBoltRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, ESM::Weapon::Bolt);
-                if (rating > bestBoltRating)
-                {
-                    bestBoltRating = rating;
-                    bestBolt = *it;
-                }
+                bestBoltRating = rating;
+                bestBolt = **it;
             }
+        }
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
-            {
-                std::vector<int> equipmentSlots = it->getClass().getEquipmentSlots(*it).first;
-                if (std::find(equipmentSlots.begin(), equipmentSlots.end(), (int)MWWorld::InventoryStore::Slot_CarriedRight)
-                        == equipmentSlots.end())
-                    continue;
+        for (ItemIterator it = cache.mWeapons.begin(); it != cache.mWeapons.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-                float rating = rateWeapon(*it, actor, enemy, -1, bestArrowRating, bestBoltRating);
-                if (rating > bestActionRating)
-                {
-                    const ESM::Weapon* weapon = it->get<ESM::Weapon>()->mBase;
+            float rating = rateWeapon(**it, actor, enemy, -1, bestArrowRating, bestBoltRating);
+            if (rating > bestActionRating)
+            {
+                const ESM::Weapon* weapon = (*it)->get<ESM::Weapon>()->mBase;
 
-                    MWWorld::Ptr ammo;
-                    if (weapon->mData.mType == ESM::Weapon::MarksmanBow)
-                        ammo = bestArrow;
-                    else if (weapon->mData.mType == ESM::Weapon::MarksmanCrossbow)
-                        ammo = bestBolt;
+                MWWorld::Ptr ammo;
+                if (weapon->mData.mType == ESM::Weapon::MarksmanBow)
+                    ammo = bestArrow;
+                else if (weapon->mData.mType == ESM::Weapon::MarksmanCrossbow)
+                    ammo = bestBolt;
 
-                    bestActionRating = rating;
-                    bestAction.reset(new ActionWeapon(*it, ammo));
-                    antiFleeRating = vanillaRateWeaponAndAmmo(*it, ammo, actor, enemy);
-                }
+                bestActionRating = rating;
+                bestAction.reset(new ActionWeapon(**it, ammo));
+                antiFleeRating = vanillaRateWeaponAndAmmo(**it, ammo, actor, enemy);
             }
         }
 
-        for (Spells::TIterator it = spells.begin(); it != spells.end(); ++it)
+        for (std::vector<const ESM::Spell*>::const_iterator it = cache.mSpells.begin(); it != cache.mSpells.end(); ++it)
         {
-            const ESM::Spell* spell = it->first;
+            const ESM::Spell* spell = *it;
 
             float rating = rateSpell(spell, actor, enemy);
             if (rating > bestActionRating)
@@ -254,8 +406,6 @@ namespace MWMechanics
 
     float getBestActionRating(const MWWorld::Ptr &actor, const MWWorld::Ptr &enemy)
     {
-        Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
-
         float bestActionRating = 0.f;
         // Default to hand-to-hand combat
         if (actor.getClass().isNpc() && actor.getClass().getNpcStats(actor).isWerewolf())
@@ -263,65 +413,77 @@ namespace MWMechanics
             return bestActionRating;
         }
 
-        if (actor.getClass().hasInventoryStore(actor))
+        ActionCache& cache = actor.getClass().getCreatureStats(actor).getAiSequence().getActionCache();
+        cache.updateCandidates(actor);
+
+        if (cache.getRating(actor, enemy, bestActionRating))
+            return bestActionRating;
+
+        Misc::ScopedTrace trace("getBestActionRating");
+
+        typedef std::vector<MWWorld::ContainerStoreIterator>::const_iterator ItemIterator;
+
+        for (ItemIterator it = cache.mMagicItems.begin(); it != cache.mMagicItems.end(); ++it)
         {
-            MWWorld::InventoryStore& store = actor.getClass().getInventoryStore(actor);
+            if (!isAvailable(*it))
+                continue;
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = rateMagicItem(**it, actor, enemy);
+            if (rating > bestActionRating)
             {
-                float rating = rateMagicItem(*it, actor, enemy);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                }
+                bestActionRating = rating;
             }
+        }
+
+        float bestArrowRating = 0;
+        for (ItemIterator it = cache.mArrows.begin(); it != cache.mArrows.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-            float bestArrowRating = 0;
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = rateWeapon(**it, actor, enemy, ESM::Weapon::Arrow);
+            if (rating > bestArrowRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, ESM::Weapon::Arrow);
-                if (rating > bestArrowRating)
-                {
-                    bestArrowRating = rating;
-                }
+                bestArrowRating = rating;
             }
+        }
+
+        float bestBoltRating = 0;
+        for (ItemIterator it = cache.mBolts.begin(); it != cache.mBolts.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-            float bestBoltRating = 0;
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
+            float rating = rateWeapon(**it, actor, enemy, ESM::Weapon::Bolt);
+            if (rating > bestBoltRating)
             {
-                float rating = rateWeapon(*it, actor, enemy, ESM::Weapon::Bolt);
-                if (rating > bestBoltRating)
-                {
-                    bestBoltRating = rating;
-                }
+                bestBoltRating = rating;
             }
+        }
 
-            for (MWWorld::ContainerStoreIterator it = store.begin(); it != store.end(); ++it)
-            {
-                std::vector<int> equipmentSlots = it->getClass().getEquipmentSlots(*it).first;
-                if (std::find(equipmentSlots.begin(), equipmentSlots.end(), (int)MWWorld::InventoryStore::Slot_CarriedRight)
-                        == equipmentSlots.end())
-                    continue;
+        for (ItemIterator it = cache.mWeapons.begin(); it != cache.mWeapons.end(); ++it)
+        {
+            if (!isAvailable(*it))
+                continue;
 
-                float rating = rateWeapon(*it, actor, enemy, -1, bestArrowRating, bestBoltRating);
-                if (rating > bestActionRating)
-                {
-                    bestActionRating = rating;
-                }
+            float rating = rateWeapon(**it, actor, enemy, -1, bestArrowRating, bestBoltRating);
+            if (rating > bestActionRating)
+            {
+                bestActionRating = rating;
             }
         }
 
-        for (Spells::TIterator it = spells.begin(); it != spells.end(); ++it)
+        for (std::vector<const ESM::Spell*>::const_iterator it = cache.mSpells.begin(); it != cache.mSpells.end(); ++it)
         {
-            const ESM::Spell* spell = it->first;
-
-            float rating = rateSpell(spell, actor, enemy);
+            float rating = rateSpell(*it, actor, enemy);
             if (rating > bestActionRating)
             {
                 bestActionRating = rating;
             }
         }
 
+        cache.setRating(actor, enemy, bestActionRating);
+
         return bestActionRating;
     }
 
@@ -416,7 +578,8 @@ namespace MWMechanics
             const ESM::Weapon* esmWeap = activeWeapon.get<ESM::Weapon>()->mBase;
             if (esmWeap->mData.mType >= ESM::Weapon::MarksmanBow)
             {
-                static const float fTargetSpellMaxSpeed = gmst.find("fProjectileMaxSpeed")->getFloat();
+                const float fTargetSpellMaxSpeed = MWBase::Environment::get().getWorld()->getStore().getGmsts()
+                        .getFloat(MWWorld::GMST::fProjectileMaxSpeed);
                 dist = fTargetSpellMaxSpeed;
                 if (!activeAmmo.isEmpty())
                 {
@@ -2,6 +2,7 @@
 #define OPENMW_AICOMBAT_ACTION_H
 
 #include <memory>
+#include <vector>
 
 #include <components/esm/loadspel.hpp>
 
@@ -87,6 +88,68 @@ namespace MWMechanics
         virtual const ESM::Weapon* getWeapon() const;
     };
 
+    /// \brief Per-actor cache for choosing combat actions
+    ///
+    /// Only a few of the items and spells of an actor can ever be rated above zero. These candidates are
+    /// collected once and collected again only when the inventory or the spell list changes, instead of
+    /// walking both for every kind of action on every decision.
+    ///
+    /// The best rating against an enemy is also kept, until the enemy's or the actor's active effects,
+    /// spells or equipment change, or for at most one AI reaction time, which covers changes of health,
+    /// magicka and item charge.
+    class ActionCache
+    {
+    public:
+        ActionCache();
+
+        /// Collect the candidates of \a actor again, if needed.
+        void updateCandidates(const MWWorld::Ptr& actor);
+
+        /// Age cached ratings by \a duration seconds.
+        void update(float duration);
+
+        /// \return Is there a valid rating of \a actor against \a enemy?
+        bool getRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, float& rating) const;
+
+        void setRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, float rating);
+
+        std::vector<MWWorld::ContainerStoreIterator> mPotions;
+        std::vector<MWWorld::ContainerStoreIterator> mMagicItems;
+        std::vector<MWWorld::ContainerStoreIterator> mArrows;
+        std::vector<MWWorld::ContainerStoreIterator> mBolts;
+        std::vector<MWWorld::ContainerStoreIterator> mWeapons; ///< weapons that can be carried in the right hand
+        std::vector<const ESM::Spell*> mSpells;
+
+    private:
+        /// Revisions of everything a rating depends on, other than dynamic stats
+        struct RatingKey
+        {
+            int mEnemyId;
+            unsigned int mActorEffects;
+            unsigned int mEnemyEffects;
+            unsigned int mEnemySpells;
+            unsigned int mEnemyInventory;
+
+            RatingKey(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
+
+            bool operator==(const RatingKey& key) const;
+        };
+
+        struct Rating
+        {
+            RatingKey mKey;
+            float mRating;
+            float mAge;
+        };
+
+        const MWWorld::ContainerStore* mStore;
+        unsigned int mStoreRevision;
+        unsigned int mSpellsRevision;
+        bool mUpToDate;
+
+        std::vector<Rating> mRatings;
+    };
+
     std::shared_ptr<Action> prepareNextAction (const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
     float getBestActionRating(const MWWorld::Ptr &actor, const MWWorld::Ptr &enemy);
 
@@ -0,0 +1,59 @@
+#include "aischeduler.hpp"
+
+#include <algorithm>
+
+namespace MWMechanics
+{
+
+    AiScheduler::AiScheduler(float fullRateDistance, unsigned int maxInterval)
+        : mFullRateDistance(fullRateDistance)
+        , mMaxInterval(std::max(1u, maxInterval))
+        , mFrame(0)
+        , mNextPhase(0)
+    {
+    }
+
+    void AiScheduler::add(AiSchedule& schedule)
+    {
+        schedule.mPhase = mNextPhase++;
+        schedule.mElapsed = 0.f;
+        schedule.mMoving = false;
+    }
+
+    void AiScheduler::frame()
+    {
+        ++mFrame;
+    }
+
+    unsigned int AiScheduler::getInterval(float distance) const
+    {
+        if (mFullRateDistance <= 0.f || distance <= mFullRateDistance)
+            return 1;
+
+        // One more frame between updates for every further multiple of the full rate distance
+        float interval = 1.f + distance / mFullRateDistance;
+
+        if (interval >= static_cast<float>(mMaxInterval))
+            return mMaxInterval;
+
+        return static_cast<unsigned int>(interval);
+    }
+
+    bool AiScheduler::update(AiSchedule& schedule, float distance, bool fullRate, float duration, float& elapsed) const
+    {
+        schedule.mElapsed += duration;
+
+        if (!fullRate && !schedule.mMoving)
+        {
+            unsigned int interval = getInterval(distance);
+
+            if ((mFrame + schedule.mPhase) % interval != 0)
+                return false;
+        }
+
+        elapsed = schedule.mElapsed;
+        schedule.mElapsed = 0.f;
+        return true;
+    }
+
+}
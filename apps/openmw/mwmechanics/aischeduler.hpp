@@ -0,0 +1,59 @@
+#ifndef OPENMW_MECHANICS_AISCHEDULER_H
+#define OPENMW_MECHANICS_AISCHEDULER_H
+
+namespace MWMechanics
+{
+    /// @brief Scheduling state of a single actor, see AiScheduler
+    struct AiSchedule
+    {
+        unsigned int mPhase;
+
+        /// Time that passed since the AI of the actor last ran
+        float mElapsed;
+
+        /// Did the AI of the actor make it move or turn in its last update?
+        bool mMoving;
+
+        AiSchedule() : mPhase(0), mElapsed(0.f), mMoving(false) {}
+    };
+
+    /// @brief Decides in which frames the AI packages of an actor are run
+    ///
+    /// Actors within the full rate distance of the player, actors that have to react quickly (e.g. in combat) and
+    /// actors that are walking or turning run their AI every frame. The character controller resets the movement
+    /// of an actor every frame, so a walking actor whose AI is skipped would stand still in that frame. Beyond that distance, actors run their AI less often the farther away they are,
+    /// and are passed all the time that went by since their last update. Every actor gets its own phase, so that
+    /// the updates of distant actors are spread evenly over the frames.
+    class AiScheduler
+    {
+    public:
+        /// @param fullRateDistance Distance up to which actors are updated every frame, 0 updates all actors
+        /// every frame.
+        /// @param maxInterval Most frames between two updates of an actor.
+        AiScheduler(float fullRateDistance, unsigned int maxInterval);
+
+        /// Give a newly added actor its phase.
+        void add(AiSchedule& schedule);
+
+        /// Start the next frame.
+        void frame();
+
+        /// @return Frames between two updates of an actor at the given distance to the player.
+        unsigned int getInterval(float distance) const;
+
+        /// Account for @a duration seconds passing for an actor.
+        /// @param fullRate Does the actor need to be updated every frame regardless of its distance? Moving
+        /// actors always are.
+        /// @param elapsed Set to the time to pass to the AI, if it should run.
+        /// @return Should the AI of the actor run in this frame?
+        bool update(AiSchedule& schedule, float distance, bool fullRate, float duration, float& elapsed) const;
+
+    private:
+        float mFullRateDistance;
+        unsigned int mMaxInterval;
+        unsigned int mFrame;
+        unsigned int mNextPhase;
+    };
+}
+
+#endif
@@ -48,6 +48,7 @@ AiSequence& AiSequence::operator= (const AiSequence& sequence)
         copy (sequence);
         mDone = sequence.mDone;
         mLastAiPackage = sequence.mLastAiPackage;
+        mActionCache.reset();
     }
 
     return *this;
@@ -187,10 +188,21 @@ bool isActualAiPackage(int packageTypeId)
                    && packageTypeId != AiPackage::TypeIdBreathe);
 }
 
+ActionCache& AiSequence::getActionCache()
+{
+    if (!mActionCache)
+        mActionCache.reset(new ActionCache);
+
+    return *mActionCache;
+}
+
 void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& characterController, AiState& state, float duration)
 {
     if(actor != getPlayer())
     {
+        if (mActionCache)
+            mActionCache->update(duration);
+
         if (mPackages.empty())
         {
             mLastAiPackage = -1;
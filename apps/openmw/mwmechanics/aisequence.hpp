@@ -2,6 +2,7 @@
 #define GAME_MWMECHANICS_AISEQUENCE_H
 
 #include <list>
+#include <memory>
 
 #include <components/esm/loadnpc.hpp>
 
@@ -23,6 +24,7 @@ namespace ESM
 namespace MWMechanics
 {
     class AiPackage;
+    class ActionCache;
     class CharacterController;
     
     template< class Base > class DerivedClassStorage;
@@ -48,6 +50,9 @@ namespace MWMechanics
             /// The type of AI package that ran last
             int mLastAiPackage;
 
+            /// Created on first use, not copied along with the packages
+            std::shared_ptr<ActionCache> mActionCache;
+
         public:
             ///Default constructor
             AiSequence();
@@ -103,6 +108,9 @@ namespace MWMechanics
             /// Removes all pursue packages until first non-pursue or stack empty.
             void stopPursuit();
 
+            /// Candidates and ratings for combat actions of the actor that owns this AiSequence
+            ActionCache& getActionCache();
+
             /// Execute current package, switching if needed.
             void execute (const MWWorld::Ptr& actor, CharacterController& characterController, MWMechanics::AiState& state, float duration);
 
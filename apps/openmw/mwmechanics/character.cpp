@@ -22,6 +22,7 @@
 #include <iostream>
 
 #include <components/misc/rng.hpp>
+#include <components/misc/trace.hpp>
 
 #include <components/settings/settings.hpp>
 
@@ -120,18 +121,18 @@ MWMechanics::CharacterState runStateToWalkState (MWMechanics::CharacterState sta
 float getFallDamage(const MWWorld::Ptr& ptr, float fallHeight)
 {
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const MWWorld::Store<ESM::GameSetting> &store = world->getStore().get<ESM::GameSetting>();
+    const MWWorld::GmstTable& store = world->getStore().getGmsts();
 
-    const float fallDistanceMin = store.find("fFallDamageDistanceMin")->getFloat();
+    const float fallDistanceMin = store.getFloat(MWWorld::GMST::fFallDamageDistanceMin);
 
     if (fallHeight >= fallDistanceMin)
     {
         const float acrobaticsSkill = static_cast<float>(ptr.getClass().getSkill(ptr, ESM::Skill::Acrobatics));
         const float jumpSpellBonus = ptr.getClass().getCreatureStats(ptr).getMagicEffects().get(ESM::MagicEffect::Jump).getMagnitude();
-        const float fallAcroBase = store.find("fFallAcroBase")->getFloat();
-        const float fallAcroMult = store.find("fFallAcroMult")->getFloat();
-        const float fallDistanceBase = store.find("fFallDistanceBase")->getFloat();
-        const float fallDistanceMult = store.find("fFallDistanceMult")->getFloat();
+        const float fallAcroBase = store.getFloat(MWWorld::GMST::fFallAcroBase);
+        const float fallAcroMult = store.getFloat(MWWorld::GMST::fFallAcroMult);
+        const float fallDistanceBase = store.getFloat(MWWorld::GMST::fFallDistanceBase);
+        const float fallDistanceMult = store.getFloat(MWWorld::GMST::fFallDistanceMult);
 
         float x = fallHeight - fallDistanceMin;
         x -= (1.5f * acrobaticsSkill) + jumpSpellBonus;
@@ -1567,6 +1568,8 @@ void CharacterController::updateAnimQueue()
 
 void CharacterController::update(float duration)
 {
+    Misc::ScopedTrace trace("CharacterController::update");
+
     MWBase::World *world = MWBase::Environment::get().getWorld();
     const MWWorld::Class &cls = mPtr.getClass();
     osg::Vec3f movement(0.f, 0.f, 0.f);
@@ -1749,8 +1752,9 @@ void CharacterController::update(float duration)
                     cls.skillUsageSucceeded(mPtr, ESM::Skill::Acrobatics, 0);
 
                 // decrease fatigue
-                const float fatigueJumpBase = gmst.find("fFatigueJumpBase")->getFloat();
-                const float fatigueJumpMult = gmst.find("fFatigueJumpMult")->getFloat();
+                const MWWorld::GmstTable& gmsts = world->getStore().getGmsts();
+                const float fatigueJumpBase = gmsts.getFloat(MWWorld::GMST::fFatigueJumpBase);
+                const float fatigueJumpMult = gmsts.getFloat(MWWorld::GMST::fFatigueJumpMult);
                 float normalizedEncumbrance = mPtr.getClass().getNormalizedEncumbrance(mPtr);
                 if (normalizedEncumbrance > 1)
                     normalizedEncumbrance = 1;
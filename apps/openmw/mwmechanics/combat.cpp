@@ -80,10 +80,10 @@ namespace MWMechanics
                     blocker.getRefData().getBaseNode()->getAttitude() * osg::Vec3f(0,1,0),
                     osg::Vec3f(0,0,1)));
 
-        const MWWorld::Store<ESM::GameSetting>& gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-        if (angleDegrees < gmst.find("fCombatBlockLeftAngle")->getFloat())
+        const MWWorld::GmstTable& gmst = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        if (angleDegrees < gmst.getFloat(MWWorld::GMST::fCombatBlockLeftAngle))
             return false;
-        if (angleDegrees > gmst.find("fCombatBlockRightAngle")->getFloat())
+        if (angleDegrees > gmst.getFloat(MWWorld::GMST::fCombatBlockRightAngle))
             return false;
 
         MWMechanics::CreatureStats& attackerStats = attacker.getClass().getCreatureStats(attacker);
@@ -91,11 +91,11 @@ namespace MWMechanics
         float blockTerm = blocker.getClass().getSkill(blocker, ESM::Skill::Block) + 0.2f * blockerStats.getAttribute(ESM::Attribute::Agility).getModified()
             + 0.1f * blockerStats.getAttribute(ESM::Attribute::Luck).getModified();
         float enemySwing = attackStrength;
-        float swingTerm = enemySwing * gmst.find("fSwingBlockMult")->getFloat() + gmst.find("fSwingBlockBase")->getFloat();
+        float swingTerm = enemySwing * gmst.getFloat(MWWorld::GMST::fSwingBlockMult) + gmst.getFloat(MWWorld::GMST::fSwingBlockBase);
 
         float blockerTerm = blockTerm * swingTerm;
         if (blocker.getClass().getMovementSettings(blocker).mPosition[1] <= 0)
-            blockerTerm *= gmst.find("fBlockStillBonus")->getFloat();
+            blockerTerm *= gmst.getFloat(MWWorld::GMST::fBlockStillBonus);
         blockerTerm *= blockerStats.getFatigueTerm();
 
         int attackerSkill = 0;
@@ -108,8 +108,8 @@ namespace MWMechanics
         attackerTerm *= attackerStats.getFatigueTerm();
 
         int x = int(blockerTerm - attackerTerm);
-        int iBlockMaxChance = gmst.find("iBlockMaxChance")->getInt();
-        int iBlockMinChance = gmst.find("iBlockMinChance")->getInt();
+        int iBlockMaxChance = gmst.getInt(MWWorld::GMST::iBlockMaxChance);
+        int iBlockMinChance = gmst.getInt(MWWorld::GMST::iBlockMinChance);
         x = std::min(iBlockMaxChance, std::max(iBlockMinChance, x));
 
         if (Misc::Rng::roll0to99() < x)
@@ -123,9 +123,9 @@ namespace MWMechanics
                 inv.unequipItem(*shield, blocker);
 
             // Reduce blocker fatigue
-            const float fFatigueBlockBase = gmst.find("fFatigueBlockBase")->getFloat();
-            const float fFatigueBlockMult = gmst.find("fFatigueBlockMult")->getFloat();
-            const float fWeaponFatigueBlockMult = gmst.find("fWeaponFatigueBlockMult")->getFloat();
+            const float fFatigueBlockBase = gmst.getFloat(MWWorld::GMST::fFatigueBlockBase);
+            const float fFatigueBlockMult = gmst.getFloat(MWWorld::GMST::fFatigueBlockMult);
+            const float fWeaponFatigueBlockMult = gmst.getFloat(MWWorld::GMST::fWeaponFatigueBlockMult);
             MWMechanics::DynamicStat<float> fatigue = blockerStats.getFatigue();
             float normalizedEncumbrance = blocker.getClass().getNormalizedEncumbrance(blocker);
             normalizedEncumbrance = std::min(1.f, normalizedEncumbrance);
@@ -159,7 +159,7 @@ namespace MWMechanics
 
         if ((weapon.get<ESM::Weapon>()->mBase->mData.mFlags & ESM::Weapon::Silver)
                 && actor.getClass().isNpc() && actor.getClass().getNpcStats(actor).isWerewolf())
-            damage *= MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fWereWolfSilverWeaponDamageMult")->getFloat();
+            damage *= MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fWereWolfSilverWeaponDamageMult);
 
         if (damage == 0 && attacker == getPlayer())
             MWBase::Environment::get().getWindowManager()->messageBox("#{sMagicTargetResistsWeapons}");
@@ -169,7 +169,7 @@ namespace MWMechanics
                        const osg::Vec3f& hitPosition, float attackStrength)
     {
         MWBase::World *world = MWBase::Environment::get().getWorld();
-        const MWWorld::Store<ESM::GameSetting> &gmst = world->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& gmst = world->getStore().getGmsts();
 
         bool validVictim = !victim.isEmpty() && victim.getClass().isActor();
 
@@ -206,7 +206,7 @@ namespace MWMechanics
                 attacker.getClass().skillUsageSucceeded(attacker, weaponSkill, 0);
 
             if (victim.getClass().getCreatureStats(victim).getKnockedDown())
-                damage *= gmst.find("fCombatKODamageMult")->getFloat();
+                damage *= gmst.getFloat(MWWorld::GMST::fCombatKODamageMult);
         }
 
         reduceWeaponCondition(damage, validVictim, weapon, attacker);
@@ -221,7 +221,7 @@ namespace MWMechanics
             // Non-enchanted arrows shot at enemies have a chance to turn up in their inventory
             if (victim != getPlayer() && !appliedEnchantment)
             {
-                float fProjectileThrownStoreChance = gmst.find("fProjectileThrownStoreChance")->getFloat();
+                float fProjectileThrownStoreChance = gmst.getFloat(MWWorld::GMST::fProjectileThrownStoreChance);
                 if (Misc::Rng::rollProbability() < fProjectileThrownStoreChance / 100.f)
                     victim.getClass().getContainerStore(victim).add(projectile, 1, victim);
             }
@@ -236,7 +236,7 @@ namespace MWMechanics
         const MWMechanics::MagicEffects &mageffects = stats.getMagicEffects();
 
         MWBase::World *world = MWBase::Environment::get().getWorld();
-        const MWWorld::Store<ESM::GameSetting> &gmst = world->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& gmst = world->getStore().getGmsts();
 
         float defenseTerm = 0;
         MWMechanics::CreatureStats& victimStats = victim.getClass().getCreatureStats(victim);
@@ -253,10 +253,10 @@ namespace MWMechanics
                 defenseTerm = victimStats.getEvasion();
             }
             defenseTerm += std::min(100.f,
-                                    gmst.find("fCombatInvisoMult")->getFloat() *
+                                    gmst.getFloat(MWWorld::GMST::fCombatInvisoMult) *
                                     victimStats.getMagicEffects().get(ESM::MagicEffect::Chameleon).getMagnitude());
             defenseTerm += std::min(100.f,
-                                    gmst.find("fCombatInvisoMult")->getFloat() *
+                                    gmst.getFloat(MWWorld::GMST::fCombatInvisoMult) *
                                     victimStats.getMagicEffects().get(ESM::MagicEffect::Invisibility).getMagnitude());
         }
         float attackTerm = skillValue +
@@ -332,7 +332,7 @@ namespace MWMechanics
             // weapon condition does not degrade when godmode is on
             if (!godmode)
             {
-                const float fWeaponDamageMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fWeaponDamageMult")->getFloat();
+                const float fWeaponDamageMult = MWBase::Environment::get().getWorld()->getStore().getGmsts().getFloat(MWWorld::GMST::fWeaponDamageMult);
                 float x = std::max(1.f, fWeaponDamageMult * damage);
 
                 weaphealth -= std::min(int(x), weaphealth);
@@ -358,10 +358,9 @@ namespace MWMechanics
             damage *= (float(weaphealth) / weapmaxhealth);
         }
 
-        static const float fDamageStrengthBase = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fDamageStrengthBase")->getFloat();
-        static const float fDamageStrengthMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fDamageStrengthMult")->getFloat();
+        const MWWorld::GmstTable& gmsts = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        const float fDamageStrengthBase = gmsts.getFloat(MWWorld::GMST::fDamageStrengthBase);
+        const float fDamageStrengthMult = gmsts.getFloat(MWWorld::GMST::fDamageStrengthMult);
         damage *= fDamageStrengthBase +
                 (attacker.getClass().getCreatureStats(attacker).getAttribute(ESM::Attribute::Strength).getModified() * fDamageStrengthMult * 0.1f);
     }
@@ -372,8 +371,8 @@ namespace MWMechanics
         // calculations. Some mods recommend using it, so we may want to include an
         // option for it.
         const MWWorld::ESMStore& store = MWBase::Environment::get().getWorld()->getStore();
-        float minstrike = store.get<ESM::GameSetting>().find("fMinHandToHandMult")->getFloat();
-        float maxstrike = store.get<ESM::GameSetting>().find("fMaxHandToHandMult")->getFloat();
+        float minstrike = store.getGmsts().getFloat(MWWorld::GMST::fMinHandToHandMult);
+        float maxstrike = store.getGmsts().getFloat(MWWorld::GMST::fMaxHandToHandMult);
         damage  = static_cast<float>(attacker.getClass().getSkill(attacker, ESM::Skill::HandToHand));
         damage *= minstrike + ((maxstrike-minstrike)*attackStrength);
 
@@ -388,7 +387,7 @@ namespace MWMechanics
             damage *= MWBase::Environment::get().getWorld()->getGlobalFloat("werewolfclawmult");
         }
         if(healthdmg)
-            damage *= store.get<ESM::GameSetting>().find("fHandtoHandHealthPer")->getFloat();
+            damage *= store.getGmsts().getFloat(MWWorld::GMST::fHandtoHandHealthPer);
 
         MWBase::SoundManager *sndMgr = MWBase::Environment::get().getSoundManager();
         if(isWerewolf)
@@ -404,10 +403,10 @@ namespace MWMechanics
     void applyFatigueLoss(const MWWorld::Ptr &attacker, const MWWorld::Ptr &weapon, float attackStrength)
     {
         // somewhat of a guess, but using the weapon weight makes sense
-        const MWWorld::Store<ESM::GameSetting>& store = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-        const float fFatigueAttackBase = store.find("fFatigueAttackBase")->getFloat();
-        const float fFatigueAttackMult = store.find("fFatigueAttackMult")->getFloat();
-        const float fWeaponFatigueMult = store.find("fWeaponFatigueMult")->getFloat();
+        const MWWorld::GmstTable& store = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+        const float fFatigueAttackBase = store.getFloat(MWWorld::GMST::fFatigueAttackBase);
+        const float fFatigueAttackMult = store.getFloat(MWWorld::GMST::fFatigueAttackMult);
+        const float fWeaponFatigueMult = store.getFloat(MWWorld::GMST::fWeaponFatigueMult);
         CreatureStats& stats = attacker.getClass().getCreatureStats(attacker);
         MWMechanics::DynamicStat<float> fatigue = stats.getFatigue();
         const float normalizedEncumbrance = attacker.getClass().getNormalizedEncumbrance(attacker);
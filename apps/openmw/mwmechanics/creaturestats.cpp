@@ -15,6 +15,7 @@
 namespace MWMechanics
 {
     int CreatureStats::sActorId = 0;
+    unsigned int CreatureStats::sActorIdRevision = 0;
 
     CreatureStats::CreatureStats()
         : mDrawState (DrawState_Nothing), mDead (false), mDeathAnimationFinished(false), mDied (false), mMurdered(false), mFriendlyHits (0),
@@ -577,7 +578,11 @@ namespace MWMechanics
         mRecalcMagicka = state.mRecalcDynamicStats;
         mDrawState = DrawState_(state.mDrawState);
         mLevel = state.mLevel;
-        mActorId = state.mActorId;
+        if (mActorId!=state.mActorId)
+        {
+            mActorId = state.mActorId;
+            ++sActorIdRevision;
+        }
         mDeathAnimation = state.mDeathAnimation;
         mTimeOfDeath = MWWorld::TimeStamp(state.mTimeOfDeath);
         //mHitAttemptActorId = state.mHitAttemptActorId;
@@ -617,19 +622,33 @@ namespace MWMechanics
     int CreatureStats::getActorId()
     {
         if (mActorId==-1)
+        {
             mActorId = sActorId++;
+            ++sActorIdRevision;
+        }
 
         return mActorId;
     }
 
+    bool CreatureStats::hasActorId() const
+    {
+        return mActorId!=-1;
+    }
+
     bool CreatureStats::matchesActorId (int id) const
     {
         return mActorId!=-1 && id==mActorId;
     }
 
+    unsigned int CreatureStats::getActorIdRevision()
+    {
+        return sActorIdRevision;
+    }
+
     void CreatureStats::cleanup()
     {
         sActorId = 0;
+        ++sActorIdRevision;
     }
 
     void CreatureStats::writeActorIdCounter (ESM::ESMWriter& esm)
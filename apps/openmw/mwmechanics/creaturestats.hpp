@@ -25,6 +25,7 @@ namespace MWMechanics
     class CreatureStats
     {
         static int sActorId;
+        static unsigned int sActorIdRevision;
         DrawState_ mDrawState;
         AttributeValue mAttributes[8];
         DynamicStat<float> mDynamic[3]; // health, magicka, fatigue
@@ -274,10 +275,16 @@ namespace MWMechanics
         int getActorId();
         ///< Will generate an actor ID, if the actor does not have one yet.
 
+        bool hasActorId() const;
+        ///< Has an actor ID been assigned to *this yet?
+
         bool matchesActorId (int id) const;
         ///< Check if \a id matches the actor ID of *this (if the actor does not have an ID
         /// assigned this function will return false).
 
+        static unsigned int getActorIdRevision();
+        ///< Changes whenever an actor gets an actor ID or its actor ID is replaced by a loaded one.
+
         static void cleanup();
     };
 }
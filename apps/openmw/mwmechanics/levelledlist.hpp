@@ -61,7 +61,7 @@ namespace MWMechanics
         std::string item = candidates[Misc::Rng::rollDice(candidates.size())];
 
         // Vanilla doesn't fail on nonexistent items in levelled lists
-        if (!MWBase::Environment::get().getWorld()->getStore().find(Misc::StringUtils::lowerCase(item)))
+        if (!MWBase::Environment::get().getWorld()->getStore().find(item))
         {
             std::cerr << "Warning: ignoring nonexistent item '" << item << "' in levelled list '" << levItem->mId << "'" << std::endl;
             return std::string();
@@ -86,18 +86,111 @@ namespace MWMechanics
         return *this;
     }
 
+    bool MagicEffects::isIndexed (const EffectKey& key)
+    {
+        return key.mArg==-1 && key.mId>=0 && key.mId<ESM::MagicEffect::Length;
+    }
+
+    int MagicEffects::findIndexed (int index) const
+    {
+        while (index<ESM::MagicEffect::Length && !mPresent.test (index))
+            ++index;
+
+        return index;
+    }
+
+    const EffectParam *MagicEffects::find (const EffectKey& key) const
+    {
+        if (isIndexed (key))
+            return mPresent.test (key.mId) ? &mEffects[key.mId] : 0;
+
+        Collection::const_iterator iter = mArgEffects.find (key);
+
+        return iter!=mArgEffects.end() ? &iter->second : 0;
+    }
+
+    EffectParam& MagicEffects::insert (const EffectKey& key)
+    {
+        if (isIndexed (key))
+        {
+            mPresent.set (key.mId);
+            return mEffects[key.mId];
+        }
+
+        return mArgEffects[key];
+    }
+
+    bool MagicEffects::const_iterator::isIndexed() const
+    {
+        if (mIndex>=ESM::MagicEffect::Length)
+            return false;
+
+        return mArgIter==mEffects->mArgEffects.end() || EffectKey (mIndex) < mArgIter->first;
+    }
+
+    const std::pair<EffectKey, EffectParam>& MagicEffects::const_iterator::operator*() const
+    {
+        if (isIndexed())
+            mValue = std::make_pair (EffectKey (mIndex), mEffects->mEffects[mIndex]);
+        else
+            mValue = *mArgIter;
+
+        return mValue;
+    }
+
+    MagicEffects::const_iterator& MagicEffects::const_iterator::operator++()
+    {
+        if (isIndexed())
+            mIndex = mEffects->findIndexed (mIndex+1);
+        else
+            ++mArgIter;
+
+        return *this;
+    }
+
+    MagicEffects::const_iterator MagicEffects::const_iterator::operator++ (int)
+    {
+        const_iterator iter (*this);
+        ++*this;
+        return iter;
+    }
+
+    MagicEffects::const_iterator MagicEffects::begin() const
+    {
+        return const_iterator (this, findIndexed (0), mArgEffects.begin());
+    }
+
+    MagicEffects::const_iterator MagicEffects::end() const
+    {
+        return const_iterator (this, ESM::MagicEffect::Length, mArgEffects.end());
+    }
+
     void MagicEffects::remove(const EffectKey &key)
     {
-        mCollection.erase(key);
+        if (isIndexed (key))
+        {
+            mPresent.reset (key.mId);
+            mEffects[key.mId] = EffectParam();
+        }
+        else
+            mArgEffects.erase(key);
     }
 
     void MagicEffects::add (const EffectKey& key, const EffectParam& param)
     {
-        Collection::iterator iter = mCollection.find (key);
+        if (isIndexed (key))
+        {
+            // Effects that are not present are zero
+            mPresent.set (key.mId);
+            mEffects[key.mId] += param;
+            return;
+        }
 
-        if (iter==mCollection.end())
+        Collection::iterator iter = mArgEffects.find (key);
+
+        if (iter==mArgEffects.end())
         {
-            mCollection.insert (std::make_pair (key, param));
+            mArgEffects.insert (std::make_pair (key, param));
         }
         else
         {
@@ -107,19 +200,25 @@ namespace MWMechanics
 
     void MagicEffects::modifyBase(const EffectKey &key, int diff)
     {
-        mCollection[key].modifyBase(diff);
+        insert (key).modifyBase(diff);
     }
 
     void MagicEffects::setModifiers(const MagicEffects &effects)
     {
-        for (Collection::iterator it = mCollection.begin(); it != mCollection.end(); ++it)
+        for (int i=0; i<ESM::MagicEffect::Length; ++i)
+            if (mPresent.test (i) || effects.mPresent.test (i))
+                mEffects[i].setModifier(effects.mEffects[i].getModifier());
+
+        mPresent |= effects.mPresent;
+
+        for (Collection::iterator it = mArgEffects.begin(); it != mArgEffects.end(); ++it)
         {
             it->second.setModifier(effects.get(it->first).getModifier());
         }
 
-        for (Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+        for (Collection::const_iterator it = effects.mArgEffects.begin(); it != effects.mArgEffects.end(); ++it)
         {
-            mCollection[it->first].setModifier(it->second.getModifier());
+            mArgEffects[it->first].setModifier(it->second.getModifier());
         }
     }
 
@@ -132,14 +231,20 @@ namespace MWMechanics
             return *this;
         }
 
-        for (Collection::const_iterator iter (effects.begin()); iter!=effects.end(); ++iter)
+        for (int i=0; i<ESM::MagicEffect::Length; ++i)
+            if (effects.mPresent.test (i))
+                mEffects[i] += effects.mEffects[i];
+
+        mPresent |= effects.mPresent;
+
+        for (Collection::const_iterator iter (effects.mArgEffects.begin()); iter!=effects.mArgEffects.end(); ++iter)
         {
-            Collection::iterator result = mCollection.find (iter->first);
+            Collection::iterator result = mArgEffects.find (iter->first);
 
-            if (result!=mCollection.end())
+            if (result!=mArgEffects.end())
                 result->second += iter->second;
             else
-                mCollection.insert (*iter);
+                mArgEffects.insert (*iter);
         }
 
         return *this;
@@ -147,9 +252,12 @@ namespace MWMechanics
 
     EffectParam MagicEffects::get (const EffectKey& key) const
     {
-        Collection::const_iterator iter = mCollection.find (key);
+        if (isIndexed (key))
+            return mEffects[key.mId];
+
+        Collection::const_iterator iter = mArgEffects.find (key);
 
-        if (iter==mCollection.end())
+        if (iter==mArgEffects.end())
         {
             return EffectParam();
         }
@@ -164,11 +272,11 @@ namespace MWMechanics
         MagicEffects result;
 
         // adding/changing
-        for (Collection::const_iterator iter (now.begin()); iter!=now.end(); ++iter)
+        for (const_iterator iter (now.begin()); iter!=now.end(); ++iter)
         {
-            Collection::const_iterator other = prev.mCollection.find (iter->first);
+            const EffectParam *other = prev.find (iter->first);
 
-            if (other==prev.end())
+            if (!other)
             {
                 // adding
                 result.add (iter->first, iter->second);
@@ -176,15 +284,14 @@ namespace MWMechanics
             else
             {
                 // changing
-                result.add (iter->first, iter->second - other->second);
+                result.add (iter->first, iter->second - *other);
             }
         }
 
         // removing
-        for (Collection::const_iterator iter (prev.begin()); iter!=prev.end(); ++iter)
+        for (const_iterator iter (prev.begin()); iter!=prev.end(); ++iter)
         {
-            Collection::const_iterator other = now.mCollection.find (iter->first);
-            if (other==now.end())
+            if (!now.find (iter->first))
             {
                 result.add (iter->first, EffectParam() - iter->second);
             }
@@ -196,7 +303,7 @@ namespace MWMechanics
     void MagicEffects::writeState(ESM::MagicEffects &state) const
     {
         // Don't need to save Modifiers, they are recalculated every frame anyway.
-        for (Collection::const_iterator iter (begin()); iter!=end(); ++iter)
+        for (const_iterator iter (begin()); iter!=end(); ++iter)
         {
             if (iter->second.getBase() != 0)
             {
@@ -210,7 +317,7 @@ namespace MWMechanics
     {
         for (std::map<int, int>::const_iterator it = state.mEffects.begin(); it != state.mEffects.end(); ++it)
         {
-            mCollection[EffectKey(it->first)].setBase(it->second);
+            insert (EffectKey(it->first)).setBase(it->second);
         }
     }
 }
@@ -1,8 +1,13 @@
 #ifndef GAME_MWMECHANICS_MAGICEFFECTS_H
 #define GAME_MWMECHANICS_MAGICEFFECTS_H
 
+#include <bitset>
+#include <iterator>
 #include <map>
 #include <string>
+#include <utility>
+
+#include <components/esm/loadmgef.hpp>
 
 namespace ESM
 {
@@ -80,21 +85,63 @@ namespace MWMechanics
     };
 
     /// \brief Effects currently affecting a NPC or creature
+    ///
+    /// Effects without a skill or attribute argument are stored in an array indexed by the effect ID, so that get()
+    /// does not need to search for them. The few effects with an argument are kept in a map.
     class MagicEffects
     {
-        public:
-
             typedef std::map<EffectKey, EffectParam> Collection;
 
-        private:
+            EffectParam mEffects[ESM::MagicEffect::Length];
+            std::bitset<ESM::MagicEffect::Length> mPresent;
+
+            /// Effects with an argument, or with an ID outside of mEffects
+            Collection mArgEffects;
+
+            static bool isIndexed (const EffectKey& key);
 
-            Collection mCollection;
+            /// \return Index of the first effect in mEffects at or after \a index, or ESM::MagicEffect::Length.
+            int findIndexed (int index) const;
+
+            const EffectParam *find (const EffectKey& key) const;
+
+            EffectParam& insert (const EffectKey& key);
 
         public:
 
-            Collection::const_iterator begin() const { return mCollection.begin(); }
+            /// Iterates over the effects in the order of their keys.
+            /// \note Removing the effect an iterator points to only invalidates that iterator.
+            class const_iterator : public std::iterator<std::forward_iterator_tag, std::pair<EffectKey, EffectParam> >
+            {
+                    const MagicEffects *mEffects;
+                    int mIndex;
+                    Collection::const_iterator mArgIter;
+                    mutable std::pair<EffectKey, EffectParam> mValue;
+
+                    bool isIndexed() const;
+
+                public:
+
+                    const_iterator (const MagicEffects *effects, int index, Collection::const_iterator argIter)
+                        : mEffects (effects), mIndex (index), mArgIter (argIter) {}
+
+                    const std::pair<EffectKey, EffectParam>& operator*() const;
+
+                    const std::pair<EffectKey, EffectParam> *operator->() const { return &**this; }
+
+                    const_iterator& operator++();
+
+                    const_iterator operator++ (int);
+
+                    bool operator== (const const_iterator& other) const
+                    { return mIndex==other.mIndex && mArgIter==other.mArgIter; }
+
+                    bool operator!= (const const_iterator& other) const { return !(*this==other); }
+            };
+
+            const_iterator begin() const;
 
-            Collection::const_iterator end() const { return mCollection.end(); }
+            const_iterator end() const;
 
             void readState (const ESM::MagicEffects& state);
             void writeState (ESM::MagicEffects& state) const;
@@ -111,6 +158,7 @@ namespace MWMechanics
 
             EffectParam get (const EffectKey& key) const;
             ///< This function can safely be used for keys that are not present.
+            /// \note Constant time for effects without an argument.
 
             static MagicEffects diff (const MagicEffects& prev, const MagicEffects& now);
             ///< Return changes from \a prev to \a now.
@@ -39,14 +39,13 @@ namespace
 
     void getPersuasionRatings(const MWMechanics::NpcStats& stats, float& rating1, float& rating2, float& rating3, bool player)
     {
-        const MWWorld::Store<ESM::GameSetting> &gmst =
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& gmst = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
-        float persTerm = stats.getAttribute(ESM::Attribute::Personality).getModified() / gmst.find("fPersonalityMod")->getFloat();
-        float luckTerm = stats.getAttribute(ESM::Attribute::Luck).getModified() / gmst.find("fLuckMod")->getFloat();
-        float repTerm = stats.getReputation() * gmst.find("fReputationMod")->getFloat();
+        float persTerm = stats.getAttribute(ESM::Attribute::Personality).getModified() / gmst.getFloat(MWWorld::GMST::fPersonalityMod);
+        float luckTerm = stats.getAttribute(ESM::Attribute::Luck).getModified() / gmst.getFloat(MWWorld::GMST::fLuckMod);
+        float repTerm = stats.getReputation() * gmst.getFloat(MWWorld::GMST::fReputationMod);
         float fatigueTerm = stats.getFatigueTerm();
-        float levelTerm = stats.getLevel() * gmst.find("fLevelMod")->getFloat();
+        float levelTerm = stats.getLevel() * gmst.getFloat(MWWorld::GMST::fLevelMod);
 
         rating1 = (repTerm + luckTerm + persTerm + stats.getSkill(ESM::Skill::Speechcraft).getModified()) * fatigueTerm;
 
@@ -332,8 +331,8 @@ namespace MWMechanics
 
             if(timeToDrown != mWatchedTimeToStartDrowning)
             {
-                static const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                        .find("fHoldBreathTime")->getFloat();
+                const float fHoldBreathTime = MWBase::Environment::get().getWorld()->getStore().getGmsts()
+                        .getFloat(MWWorld::GMST::fHoldBreathTime);
 
                 mWatchedTimeToStartDrowning = timeToDrown;
 
@@ -1040,7 +1039,7 @@ namespace MWMechanics
 
         osg::Vec3f from (player.getRefData().getPosition().asVec3());
         const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
-        float radius = esmStore.get<ESM::GameSetting>().find("fAlarmRadius")->getFloat();
+        float radius = esmStore.getGmsts().getFloat(MWWorld::GMST::fAlarmRadius);
 
         mActors.getObjectsInRange(from, radius, neighbors);
 
@@ -1096,7 +1095,7 @@ namespace MWMechanics
 
     void MechanicsManager::reportCrime(const MWWorld::Ptr &player, const MWWorld::Ptr &victim, OffenseType type, int arg)
     {
-        const MWWorld::Store<ESM::GameSetting>& store = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GmstTable& store = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
         if (type == OT_Murder && !victim.isEmpty())
             victim.getClass().getCreatureStats(victim).notifyMurder();
@@ -1105,29 +1104,29 @@ namespace MWMechanics
         float disp = 0.f, dispVictim = 0.f;
         if (type == OT_Trespassing || type == OT_SleepingInOwnedBed)
         {
-            arg = store.find("iCrimeTresspass")->getInt();
-            disp = dispVictim = store.find("iDispTresspass")->getFloat();
+            arg = store.getInt(MWWorld::GMST::iCrimeTresspass);
+            disp = dispVictim = store.getFloat(MWWorld::GMST::iDispTresspass);
         }
         else if (type == OT_Pickpocket)
         {
-            arg = store.find("iCrimePickPocket")->getInt();
-            disp = dispVictim = store.find("fDispPickPocketMod")->getFloat();
+            arg = store.getInt(MWWorld::GMST::iCrimePickPocket);
+            disp = dispVictim = store.getFloat(MWWorld::GMST::fDispPickPocketMod);
         }
         else if (type == OT_Assault)
         {
-            arg = store.find("iCrimeAttack")->getInt();
-            disp = store.find("iDispAttackMod")->getFloat();
-            dispVictim = store.find("fDispAttacking")->getFloat();
+            arg = store.getInt(MWWorld::GMST::iCrimeAttack);
+            disp = store.getFloat(MWWorld::GMST::iDispAttackMod);
+            dispVictim = store.getFloat(MWWorld::GMST::fDispAttacking);
         }
         else if (type == OT_Murder)
         {
-            arg = store.find("iCrimeKilling")->getInt();
-            disp = dispVictim = store.find("iDispKilling")->getFloat();
+            arg = store.getInt(MWWorld::GMST::iCrimeKilling);
+            disp = dispVictim = store.getFloat(MWWorld::GMST::iDispKilling);
         }
         else if (type == OT_Theft)
         {
-            disp = dispVictim = store.find("fDispStealing")->getFloat() * arg;
-            arg = static_cast<int>(arg * store.find("fCrimeStealing")->getFloat());
+            disp = dispVictim = store.getFloat(MWWorld::GMST::fDispStealing) * arg;
+            arg = static_cast<int>(arg * store.getFloat(MWWorld::GMST::fCrimeStealing));
             arg = std::max(1, arg); // Minimum bounty of 1, in case items with zero value are stolen
         }
 
@@ -1137,7 +1136,7 @@ namespace MWMechanics
         const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
 
         osg::Vec3f from (player.getRefData().getPosition().asVec3());
-        float radius = esmStore.get<ESM::GameSetting>().find("fAlarmRadius")->getFloat();
+        float radius = esmStore.getGmsts().getFloat(MWWorld::GMST::fAlarmRadius);
 
         mActors.getObjectsInRange(from, radius, neighbors);
 
@@ -1151,21 +1150,21 @@ namespace MWMechanics
         // Controls whether witnesses will engage combat with the criminal.
         int fight = 0, fightVictim = 0;
         if (type == OT_Trespassing || type == OT_SleepingInOwnedBed)
-            fight = fightVictim = esmStore.get<ESM::GameSetting>().find("iFightTrespass")->getInt();
+            fight = fightVictim = esmStore.getGmsts().getInt(MWWorld::GMST::iFightTrespass);
         else if (type == OT_Pickpocket)
         {
-            fight = esmStore.get<ESM::GameSetting>().find("iFightPickpocket")->getInt();
-            fightVictim = esmStore.get<ESM::GameSetting>().find("iFightPickpocket")->getInt() * 4; // *4 according to research wiki
+            fight = esmStore.getGmsts().getInt(MWWorld::GMST::iFightPickpocket);
+            fightVictim = esmStore.getGmsts().getInt(MWWorld::GMST::iFightPickpocket) * 4; // *4 according to research wiki
         }
         else if (type == OT_Assault)
         {
-            fight = esmStore.get<ESM::GameSetting>().find("iFightAttacking")->getInt();
-            fightVictim = esmStore.get<ESM::GameSetting>().find("iFightAttack")->getInt();
+            fight = esmStore.getGmsts().getInt(MWWorld::GMST::iFightAttacking);
+            fightVictim = esmStore.getGmsts().getInt(MWWorld::GMST::iFightAttack);
         }
         else if (type == OT_Murder)
-            fight = fightVictim = esmStore.get<ESM::GameSetting>().find("iFightKilling")->getInt();
+            fight = fightVictim = esmStore.getGmsts().getInt(MWWorld::GMST::iFightKilling);
         else if (type == OT_Theft)
-            fight = fightVictim = esmStore.get<ESM::GameSetting>().find("fFightStealing")->getInt();
+            fight = fightVictim = esmStore.getGmsts().getInt(MWWorld::GMST::fFightStealing);
 
         bool reported = false;
 
@@ -1643,8 +1642,8 @@ namespace MWMechanics
 
             // Witnesses of the player's transformation will make them a globally known werewolf
             std::vector<MWWorld::Ptr> closeActors;
-            const MWWorld::Store<ESM::GameSetting>& gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-            getActorsInRange(actor.getRefData().getPosition().asVec3(), gmst.find("fAlarmRadius")->getFloat(), closeActors);
+            const MWWorld::GmstTable& gmst = MWBase::Environment::get().getWorld()->getStore().getGmsts();
+            getActorsInRange(actor.getRefData().getPosition().asVec3(), gmst.getFloat(MWWorld::GMST::fAlarmRadius), closeActors);
 
             bool detected = false, reported = false;
             for (std::vector<MWWorld::Ptr>::const_iterator it = closeActors.begin(); it != closeActors.end(); ++it)
@@ -1669,7 +1668,7 @@ namespace MWMechanics
                 if (reported)
                 {
                     npcStats.setBounty(npcStats.getBounty()+
-                                       gmst.find("iWereWolfBounty")->getInt());
+                                       MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("iWereWolfBounty")->getInt());
                     windowManager->messageBox("#{sCrimeMessage}");
                 }
             }
@@ -146,15 +146,14 @@ float MWMechanics::NpcStats::getSkillProgressRequirement (int skillIndex, const
 {
     float progressRequirement = static_cast<float>(1 + getSkill(skillIndex).getBase());
 
-    const MWWorld::Store<ESM::GameSetting> &gmst =
-        MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+    const MWWorld::GmstTable& gmst = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
-    float typeFactor = gmst.find ("fMiscSkillBonus")->getFloat();
+    float typeFactor = gmst.getFloat(MWWorld::GMST::fMiscSkillBonus);
 
     for (int i=0; i<5; ++i)
         if (class_.mData.mSkills[i][0]==skillIndex)
         {
-            typeFactor = gmst.find ("fMinorSkillBonus")->getFloat();
+            typeFactor = gmst.getFloat(MWWorld::GMST::fMinorSkillBonus);
 
             break;
         }
@@ -162,7 +161,7 @@ float MWMechanics::NpcStats::getSkillProgressRequirement (int skillIndex, const
     for (int i=0; i<5; ++i)
         if (class_.mData.mSkills[i][1]==skillIndex)
         {
-            typeFactor = gmst.find ("fMajorSkillBonus")->getFloat();
+            typeFactor = gmst.getFloat(MWWorld::GMST::fMajorSkillBonus);
 
             break;
         }
@@ -178,7 +177,7 @@ float MWMechanics::NpcStats::getSkillProgressRequirement (int skillIndex, const
         MWBase::Environment::get().getWorld()->getStore().get<ESM::Skill>().find (skillIndex);
     if (skill->mData.mSpecialization==class_.mData.mSpecialization)
     {
-        specialisationFactor = gmst.find ("fSpecialSkillBonus")->getFloat();
+        specialisationFactor = gmst.getFloat(MWWorld::GMST::fSpecialSkillBonus);
 
         if (specialisationFactor<=0)
             throw std::runtime_error ("invalid skill specialisation factor");
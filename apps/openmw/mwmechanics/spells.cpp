@@ -17,6 +17,7 @@ namespace MWMechanics
 {
     Spells::Spells()
         : mSpellsChanged(false)
+        , mRevision(0)
     {
     }
 
@@ -113,6 +114,7 @@ namespace MWMechanics
             params.mEffectRands = random;
             mSpells.insert (std::make_pair (spell, params));
             mSpellsChanged = true;
+            ++mRevision;
         }
     }
 
@@ -135,7 +137,7 @@ namespace MWMechanics
             if (mPermanentSpellEffects.find(spell) != mPermanentSpellEffects.end())
             {
                 MagicEffects & effects = mPermanentSpellEffects[spell];
-                for (MagicEffects::Collection::const_iterator effectIt = effects.begin(); effectIt != effects.end();)
+                for (MagicEffects::const_iterator effectIt = effects.begin(); effectIt != effects.end();)
                 {
                     const ESM::MagicEffect * magicEffect = MWBase::Environment::get().getWorld()->getStore().get<ESM::MagicEffect>().find(effectIt->first.mId);
                     if (magicEffect->mData.mFlags & ESM::MagicEffect::Harmful)
@@ -151,13 +153,14 @@ namespace MWMechanics
         {
             mSpells.erase (iter);
             mSpellsChanged = true;
+            ++mRevision;
         }
 
         if (spellId==mSelectedSpell)
             mSelectedSpell.clear();
     }
 
-    MagicEffects Spells::getMagicEffects() const
+    const MagicEffects& Spells::getMagicEffects() const
     {
         if (mSpellsChanged) {
             rebuildEffects();
@@ -166,10 +169,16 @@ namespace MWMechanics
         return mEffects;
     }
 
+    unsigned int Spells::getRevision() const
+    {
+        return mRevision;
+    }
+
     void Spells::clear()
     {
         mSpells.clear();
         mSpellsChanged = true;
+        ++mRevision;
     }
 
     void Spells::setSelectedSpell (const std::string& spellId)
@@ -228,6 +237,7 @@ namespace MWMechanics
             {
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -243,6 +253,7 @@ namespace MWMechanics
             {
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -258,6 +269,7 @@ namespace MWMechanics
             {
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -273,6 +285,7 @@ namespace MWMechanics
             {
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -290,7 +303,7 @@ namespace MWMechanics
              it != mSourcedEffects.end(); ++it)
         {
             const ESM::Spell * spell = it->first;
-            for (MagicEffects::Collection::const_iterator effectIt = it->second.begin();
+            for (MagicEffects::const_iterator effectIt = it->second.begin();
                  effectIt != it->second.end(); ++effectIt)
             {
                 visitor.visit(effectIt->first, spell->mName, spell->mId, -1, effectIt->second.getMagnitude());
@@ -319,6 +332,7 @@ namespace MWMechanics
                 magnitude *= std::max(1, mCorprusSpells[spell].mWorsenings);
                 mPermanentSpellEffects[spell].add(MWMechanics::EffectKey(*effectIt), MWMechanics::EffectParam(magnitude));
                 mSpellsChanged = true;
+                ++mRevision;
             }
         }
     }
@@ -351,6 +365,7 @@ namespace MWMechanics
                 {
                     spellIt->second.mPurgedEffects.insert(i);
                     mSpellsChanged = true;
+                    ++mRevision;
                 }
                 ++i;
             }
@@ -371,6 +386,7 @@ namespace MWMechanics
             {
                 spellIt->second.mPurgedEffects.insert(i);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             ++i;
         }
@@ -439,6 +455,8 @@ namespace MWMechanics
         }
 
         mSpellsChanged = true;
+
+        ++mRevision;
     }
 
     void Spells::writeState(ESM::SpellState &state) const
@@ -459,7 +477,7 @@ namespace MWMechanics
         for (std::map<SpellKey, MagicEffects>::const_iterator it = mPermanentSpellEffects.begin(); it != mPermanentSpellEffects.end(); ++it)
         {
             std::vector<ESM::SpellState::PermanentSpellEffectInfo> effectList;
-            for (MagicEffects::Collection::const_iterator effectIt = it->second.begin(); effectIt != it->second.end(); ++effectIt)
+            for (MagicEffects::const_iterator effectIt = it->second.begin(); effectIt != it->second.end(); ++effectIt)
             {
                 ESM::SpellState::PermanentSpellEffectInfo info;
                 info.mId = effectIt->first.mId;
@@ -63,6 +63,7 @@ namespace MWMechanics
             std::map<SpellKey, CorprusStats> mCorprusSpells;
 
             mutable bool mSpellsChanged;
+            unsigned int mRevision;
             mutable MagicEffects mEffects;
             mutable std::map<SpellKey, MagicEffects> mSourcedEffects;
             void rebuildEffects() const;
@@ -105,9 +106,12 @@ namespace MWMechanics
             ///< If the spell to be removed is the selected spell, the selected spell will be changed to
             /// no spell (empty string).
 
-            MagicEffects getMagicEffects() const;
+            const MagicEffects& getMagicEffects() const;
             ///< Return sum of magic effects resulting from abilities, blights, deseases and curses.
 
+            unsigned int getRevision() const;
+            ///< Changes whenever spells are added or removed, or their effects change.
+
             void clear();
             ///< Remove all spells of al types.
 
@@ -509,12 +509,12 @@ namespace MWPhysics
     class HeightField
     {
     public:
-        HeightField(const float* heights, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject)
+        HeightField(const void* heights, PHY_ScalarType heightType, float heightScale, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject)
         {
             mShape = new btHeightfieldTerrainShape(
-                sqrtVerts, sqrtVerts, heights, 1,
+                sqrtVerts, sqrtVerts, heights, heightScale,
                 minH, maxH, 2,
-                PHY_FLOAT, false
+                heightType, false
             );
             mShape->setUseDiamondSubdivision(true);
             mShape->setLocalScaling(btVector3(triSize, triSize, 1));
@@ -1128,7 +1128,16 @@ namespace MWPhysics
 
     void PhysicsSystem::addHeightField (const float* heights, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject)
     {
-        HeightField *heightfield = new HeightField(heights, x, y, triSize, sqrtVerts, minH, maxH, holdObject);
+        HeightField *heightfield = new HeightField(heights, PHY_FLOAT, 1, x, y, triSize, sqrtVerts, minH, maxH, holdObject);
+        mHeightFields[std::make_pair(x,y)] = heightfield;
+
+        mCollisionWorld->addCollisionObject(heightfield->getCollisionObject(), CollisionType_HeightMap,
+            CollisionType_Actor|CollisionType_Projectile);
+    }
+
+    void PhysicsSystem::addHeightField (const short* heights, float heightScale, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject)
+    {
+        HeightField *heightfield = new HeightField(heights, PHY_SHORT, heightScale, x, y, triSize, sqrtVerts, minH, maxH, holdObject);
         mHeightFields[std::make_pair(x,y)] = heightfield;
 
         mCollisionWorld->addCollisionObject(heightfield->getCollisionObject(), CollisionType_HeightMap,
@@ -83,6 +83,9 @@ namespace MWPhysics
 
             void addHeightField (const float* heights, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject);
 
+            /// Add a heightfield from 16 bit heights, which are multiplied by \a heightScale.
+            void addHeightField (const short* heights, float heightScale, int x, int y, float triSize, float sqrtVerts, float minH, float maxH, const osg::Object* holdObject);
+
             void removeHeightField (int x, int y);
 
             bool toggleCollisionMode();
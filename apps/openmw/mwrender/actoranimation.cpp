@@ -12,11 +12,10 @@
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/lightutil.hpp>
 
-#include <components/fallback/fallback.hpp>
-
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include "../mwworld/ptr.hpp"
+#include "../mwworld/gmsttable.hpp"
 #include "../mwworld/class.hpp"
 #include "../mwworld/cellstore.hpp"
 #include "../mwmechanics/actorutil.hpp"
@@ -82,14 +81,14 @@ void ActorAnimation::addHiddenItemLight(const MWWorld::ConstPtr& item, const ESM
     if (mItemLights.find(item) != mItemLights.end())
         return;
 
-    const Fallback::Map* fallback = MWBase::Environment::get().getWorld()->getFallback();
-    static bool outQuadInLin = fallback->getFallbackBool("LightAttenuation_OutQuadInLin");
-    static bool useQuadratic = fallback->getFallbackBool("LightAttenuation_UseQuadratic");
-    static float quadraticValue = fallback->getFallbackFloat("LightAttenuation_QuadraticValue");
-    static float quadraticRadiusMult = fallback->getFallbackFloat("LightAttenuation_QuadraticRadiusMult");
-    static bool useLinear = fallback->getFallbackBool("LightAttenuation_UseLinear");
-    static float linearRadiusMult = fallback->getFallbackFloat("LightAttenuation_LinearRadiusMult");
-    static float linearValue = fallback->getFallbackFloat("LightAttenuation_LinearValue");
+    const MWWorld::FallbackTable& fallback = MWBase::Environment::get().getWorld()->getFallbackTable();
+    bool outQuadInLin = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_OutQuadInLin);
+    bool useQuadratic = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_UseQuadratic);
+    float quadraticValue = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_QuadraticValue);
+    float quadraticRadiusMult = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_QuadraticRadiusMult);
+    bool useLinear = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_UseLinear);
+    float linearRadiusMult = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_LinearRadiusMult);
+    float linearValue = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_LinearValue);
     bool exterior = mPtr.isInCell() && mPtr.getCell()->getCell()->isExterior();
 
     osg::Vec4f ambient(1,1,1,1);
@@ -14,6 +14,8 @@
 
 #include <components/nifosg/nifloader.hpp>
 
+#include <components/misc/trace.hpp>
+
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/keyframemanager.hpp>
@@ -31,11 +33,10 @@
 #include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 
-#include <components/fallback/fallback.hpp>
-
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include "../mwworld/esmstore.hpp"
+#include "../mwworld/gmsttable.hpp"
 #include "../mwworld/class.hpp"
 #include "../mwworld/cellstore.hpp"
 
@@ -106,56 +107,47 @@ namespace
         NodeMap& mMap;
     };
 
-    NifOsg::TextKeyMap::const_iterator findGroupStart(const NifOsg::TextKeyMap &keys, const std::string &groupname)
+    /// @return The first key with the given tag that comes after the key at @a startIndex and is not later than @a time.
+    const NifOsg::TextKeyGroup::Key* findFirstPassedKey(const NifOsg::TextKeyGroup& group, const std::string& tag, std::size_t startIndex, float time)
     {
-        NifOsg::TextKeyMap::const_iterator iter(keys.begin());
-        for(;iter != keys.end();++iter)
+        typedef NifOsg::TextKeyGroup::KeyMap::const_iterator Iterator;
+        std::pair<Iterator, Iterator> range = group.mKeys.equal_range(tag);
+        for (Iterator it = range.first; it != range.second; ++it)
         {
-            if(iter->second.compare(0, groupname.size(), groupname) == 0 &&
-               iter->second.compare(groupname.size(), 2, ": ") == 0)
-                break;
+            if (it->second.mIndex > startIndex && it->second.mIter->first <= time)
+                return &it->second;
         }
-        return iter;
+        return NULL;
     }
 
-    float calcAnimVelocity(const std::multimap<float, std::string>& keys,
-                                      NifOsg::KeyframeController *nonaccumctrl, const osg::Vec3f& accum, const std::string &groupname)
+    float calcAnimVelocity(const NifOsg::TextKeyGroup* group,
+                                      NifOsg::KeyframeController *nonaccumctrl, const osg::Vec3f& accum)
     {
-        const std::string start = groupname+": start";
-        const std::string loopstart = groupname+": loop start";
-        const std::string loopstop = groupname+": loop stop";
-        const std::string stop = groupname+": stop";
         float starttime = std::numeric_limits<float>::max();
         float stoptime = 0.0f;
 
+        if (!group)
+            return 0.0f;
+
         // Pick the last Loop Stop key and the last Loop Start key.
         // This is required because of broken text keys in AshVampire.nif.
         // It has *two* WalkForward: Loop Stop keys at different times, the first one is used for stopping playback
         // but the animation velocity calculation uses the second one.
         // As result the animation velocity calculation is not correct, and this incorrect velocity must be replicated,
         // because otherwise the Creature's Speed (dagoth uthol) would not be sufficient to move fast enough.
-        NifOsg::TextKeyMap::const_reverse_iterator keyiter(keys.rbegin());
-        while(keyiter != keys.rend())
-        {
-            if(keyiter->second == start || keyiter->second == loopstart)
-            {
-                starttime = keyiter->first;
-                break;
-            }
-            ++keyiter;
-        }
-        keyiter = keys.rbegin();
-        while(keyiter != keys.rend())
-        {
-            if (keyiter->second == stop)
-                stoptime = keyiter->first;
-            else if (keyiter->second == loopstop)
-            {
-                stoptime = keyiter->first;
-                break;
-            }
-            ++keyiter;
-        }
+        const NifOsg::TextKeyGroup::Key* startkey = group->findLast("start");
+        const NifOsg::TextKeyGroup::Key* loopstartkey = group->findLast("loop start");
+        if (loopstartkey && (!startkey || loopstartkey->mIndex > startkey->mIndex))
+            startkey = loopstartkey;
+        if (startkey)
+            starttime = startkey->mIter->first;
+
+        // Without a Loop Stop key, the first Stop key is used
+        const NifOsg::TextKeyGroup::Key* stopkey = group->findLast("loop stop");
+        if (!stopkey)
+            stopkey = group->findFirst("stop");
+        if (stopkey)
+            stoptime = stopkey->mIter->first;
 
         if(stoptime > starttime)
         {
@@ -417,6 +409,8 @@ namespace MWRender
         ControllerMap mControllerMap[Animation::sNumBlendMasks];
 
         const std::multimap<float, std::string>& getTextKeys() const;
+
+        const NifOsg::TextKeyIndex& getTextKeyIndex() const;
     };
 
     class ResetAccumRootCallback : public osg::NodeCallback
@@ -458,6 +452,8 @@ namespace MWRender
         , mHeadYawRadians(0.f)
         , mHeadPitchRadians(0.f)
         , mAlpha(1.f)
+        , mUpdateLodDistance(0.f)
+        , mUpdateLodInterval(1)
     {
         for(size_t i = 0;i < sNumBlendMasks;i++)
             mAnimationTimePtr[i].reset(new AnimationTime);
@@ -489,6 +485,15 @@ namespace MWRender
             mSkeleton->setActive(active);
     }
 
+    void Animation::setUpdateLod(float fullRateDistance, unsigned int maxInterval)
+    {
+        mUpdateLodDistance = fullRateDistance;
+        mUpdateLodInterval = maxInterval;
+
+        if (mSkeleton)
+            mSkeleton->setUpdateLod(fullRateDistance, maxInterval);
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr &ptr)
     {
         mPtr = ptr;
@@ -533,6 +538,11 @@ namespace MWRender
         return mKeyframes->mTextKeys;
     }
 
+    const NifOsg::TextKeyIndex &Animation::AnimSource::getTextKeyIndex() const
+    {
+        return mKeyframes->mTextKeyIndex;
+    }
+
     void Animation::addAnimSource(const std::string &model)
     {
         std::string kfname = model;
@@ -612,8 +622,7 @@ namespace MWRender
         AnimSourceList::const_iterator iter(mAnimSources.begin());
         for(;iter != mAnimSources.end();++iter)
         {
-            const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
-            if(findGroupStart(keys, anim) != keys.end())
+            if((*iter)->getTextKeyIndex().find(anim))
                 return true;
         }
 
@@ -624,17 +633,36 @@ namespace MWRender
     {
         for(AnimSourceList::const_iterator iter(mAnimSources.begin()); iter != mAnimSources.end(); ++iter)
         {
-            const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
-
-            NifOsg::TextKeyMap::const_iterator found = findGroupStart(keys, groupname);
-            if(found != keys.end())
-                return found->first;
+            const NifOsg::TextKeyGroup* group = (*iter)->getTextKeyIndex().find(groupname);
+            if(group)
+                return group->mFirst.mIter->first;
         }
         return -1.f;
     }
 
     float Animation::getTextKeyTime(const std::string &textKey) const
     {
+        // Keys of the form "<group>: <tag>" can be found through the index
+        std::string::size_type separator = textKey.find(": ");
+        if (separator != std::string::npos)
+        {
+            const std::string groupname = textKey.substr(0, separator);
+            const std::string tag = textKey.substr(separator+2);
+
+            for(AnimSourceList::const_iterator iter(mAnimSources.begin()); iter != mAnimSources.end(); ++iter)
+            {
+                const NifOsg::TextKeyGroup* group = (*iter)->getTextKeyIndex().find(groupname);
+                if (!group)
+                    continue;
+
+                const NifOsg::TextKeyGroup::Key* key = group->findFirstStartingWith(tag);
+                if (key)
+                    return key->mIter->first;
+            }
+
+            return -1.f;
+        }
+
         for(AnimSourceList::const_iterator iter(mAnimSources.begin()); iter != mAnimSources.end(); ++iter)
         {
             const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
@@ -654,15 +682,11 @@ namespace MWRender
     {
         const std::string &evt = key->second;
 
-        size_t off = groupname.size()+2;
-        size_t len = evt.size() - off;
-
-        if(evt.compare(0, groupname.size(), groupname) == 0 &&
-           evt.compare(groupname.size(), 2, ": ") == 0)
+        if(state.mGroup)
         {
-            if(evt.compare(off, len, "loop start") == 0)
+            if(state.mGroup->isKey(key, "loop start"))
                 state.mLoopStartTime = key->first;
-            else if(evt.compare(off, len, "loop stop") == 0)
+            else if(state.mGroup->isKey(key, "loop stop"))
                 state.mLoopStopTime = key->first;
         }
 
@@ -714,7 +738,7 @@ namespace MWRender
         for(;iter != mAnimSources.rend();++iter)
         {
             const NifOsg::TextKeyMap &textkeys = (*iter)->getTextKeys();
-            if(reset(state, textkeys, groupname, start, stop, startpoint, loopfallback))
+            if(reset(state, (*iter)->getTextKeyIndex(), groupname, start, stop, startpoint, loopfallback))
             {
                 state.mSource = *iter;
                 state.mSpeedMult = speedmult;
@@ -760,77 +784,55 @@ namespace MWRender
         resetActiveGroups();
     }
 
-    bool Animation::reset(AnimState &state, const NifOsg::TextKeyMap &keys, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
+    bool Animation::reset(AnimState &state, const NifOsg::TextKeyIndex &index, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
     {
-        // Look for text keys in reverse. This normally wouldn't matter, but for some reason undeadwolf_2.nif has two
-        // separate walkforward keys, and the last one is supposed to be used.
-        NifOsg::TextKeyMap::const_reverse_iterator groupend(keys.rbegin());
-        for(;groupend != keys.rend();++groupend)
-        {
-            if(groupend->second.compare(0, groupname.size(), groupname) == 0 &&
-               groupend->second.compare(groupname.size(), 2, ": ") == 0)
-                break;
-        }
+        const NifOsg::TextKeyGroup* group = index.find(groupname);
+        if(!group)
+            return false;
 
-        std::string starttag = groupname+": "+start;
-        NifOsg::TextKeyMap::const_reverse_iterator startkey(groupend);
-        while(startkey != keys.rend() && startkey->second != starttag)
-            ++startkey;
-        if(startkey == keys.rend() && start == "loop start")
-        {
-            starttag = groupname+": start";
-            startkey = groupend;
-            while(startkey != keys.rend() && startkey->second != starttag)
-                ++startkey;
-        }
-        if(startkey == keys.rend())
+        // Use the last matching text keys. This normally wouldn't matter, but for some reason undeadwolf_2.nif has two
+        // separate walkforward keys, and the last one is supposed to be used.
+        const NifOsg::TextKeyGroup::Key* startkey = group->findLast(start);
+        if(!startkey && start == "loop start")
+            startkey = group->findLast("start");
+        if(!startkey)
             return false;
 
-        const std::string stoptag = groupname+": "+stop;
-        NifOsg::TextKeyMap::const_reverse_iterator stopkey(groupend);
-        while(stopkey != keys.rend()
-              // We have to ignore extra garbage at the end.
-              // The Scrib's idle3 animation has "Idle3: Stop." instead of "Idle3: Stop".
-              // Why, just why? :(
-              && (stopkey->second.size() < stoptag.size() || stopkey->second.substr(0,stoptag.size()) != stoptag))
-            ++stopkey;
-        if(stopkey == keys.rend())
+        // We have to ignore extra garbage at the end.
+        // The Scrib's idle3 animation has "Idle3: Stop." instead of "Idle3: Stop".
+        // Why, just why? :(
+        const NifOsg::TextKeyGroup::Key* stopkey = group->findLastStartingWith(stop);
+        if(!stopkey)
             return false;
 
-        if(startkey->first > stopkey->first)
+        if(startkey->mIter->first > stopkey->mIter->first)
             return false;
 
-        state.mStartTime = startkey->first;
+        state.mGroup = group;
+        state.mStartTime = startkey->mIter->first;
         if (loopfallback)
         {
-            state.mLoopStartTime = startkey->first;
-            state.mLoopStopTime = stopkey->first;
+            state.mLoopStartTime = startkey->mIter->first;
+            state.mLoopStopTime = stopkey->mIter->first;
         }
         else
         {
-            state.mLoopStartTime = startkey->first;
+            state.mLoopStartTime = startkey->mIter->first;
             state.mLoopStopTime = std::numeric_limits<float>::max();
         }
-        state.mStopTime = stopkey->first;
+        state.mStopTime = stopkey->mIter->first;
 
         state.setTime(state.mStartTime + ((state.mStopTime - state.mStartTime) * startpoint));
 
         // mLoopStartTime and mLoopStopTime normally get assigned when encountering these keys while playing the animation
         // (see handleTextKey). But if startpoint is already past these keys, or start time is == stop time, we need to assign them now.
-        const std::string loopstarttag = groupname+": loop start";
-        const std::string loopstoptag = groupname+": loop stop";
-
-        NifOsg::TextKeyMap::const_reverse_iterator key(groupend);
-        for (; key != startkey && key != keys.rend(); ++key)
-        {
-            if (key->first > state.getTime())
-                continue;
-
-            if (key->second == loopstarttag)
-                state.mLoopStartTime = key->first;
-            else if (key->second == loopstoptag)
-                state.mLoopStopTime = key->first;
-        }
+        // Of the keys after the start key, the first one that was already passed is used.
+        const NifOsg::TextKeyGroup::Key* loopstartkey = findFirstPassedKey(*group, "loop start", startkey->mIndex, state.getTime());
+        if (loopstartkey)
+            state.mLoopStartTime = loopstartkey->mIter->first;
+        const NifOsg::TextKeyGroup::Key* loopstopkey = findFirstPassedKey(*group, "loop stop", startkey->mIndex, state.getTime());
+        if (loopstopkey)
+            state.mLoopStopTime = loopstopkey->mIter->first;
 
         return true;
     }
@@ -990,22 +992,21 @@ namespace MWRender
         AnimSourceList::const_reverse_iterator animsrc(mAnimSources.rbegin());
         for(;animsrc != mAnimSources.rend();++animsrc)
         {
-            const NifOsg::TextKeyMap &keys = (*animsrc)->getTextKeys();
-            if(findGroupStart(keys, groupname) != keys.end())
+            if((*animsrc)->getTextKeyIndex().find(groupname))
                 break;
         }
         if(animsrc == mAnimSources.rend())
             return 0.0f;
 
         float velocity = 0.0f;
-        const NifOsg::TextKeyMap &keys = (*animsrc)->getTextKeys();
+        const NifOsg::TextKeyGroup* group = (*animsrc)->getTextKeyIndex().find(groupname);
 
         const AnimSource::ControllerMap& ctrls = (*animsrc)->mControllerMap[0];
         for (AnimSource::ControllerMap::const_iterator it = ctrls.begin(); it != ctrls.end(); ++it)
         {
             if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
             {
-                velocity = calcAnimVelocity(keys, it->second, mAccumulate, groupname);
+                velocity = calcAnimVelocity(group, it->second, mAccumulate);
                 break;
             }
         }
@@ -1019,14 +1020,14 @@ namespace MWRender
 
             while(!(velocity > 1.0f) && ++animiter != mAnimSources.rend())
             {
-                const NifOsg::TextKeyMap &keys2 = (*animiter)->getTextKeys();
+                const NifOsg::TextKeyGroup* group2 = (*animiter)->getTextKeyIndex().find(groupname);
 
                 const AnimSource::ControllerMap& ctrls2 = (*animiter)->mControllerMap[0];
                 for (AnimSource::ControllerMap::const_iterator it = ctrls2.begin(); it != ctrls2.end(); ++it)
                 {
                     if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
                     {
-                        velocity = calcAnimVelocity(keys2, it->second, mAccumulate, groupname);
+                        velocity = calcAnimVelocity(group2, it->second, mAccumulate);
                         break;
                     }
                 }
@@ -1047,6 +1048,8 @@ namespace MWRender
 
     osg::Vec3f Animation::runAnimation(float duration)
     {
+        Misc::ScopedTrace trace("Animation::runAnimation");
+
         osg::Vec3f movement(0.f, 0.f, 0.f);
         AnimStateMap::iterator stateiter = mStates.begin();
         while(stateiter != mStates.end())
@@ -1203,6 +1206,7 @@ namespace MWRender
                 skel->addChild(created);
             }
             mSkeleton = skel.get();
+            mSkeleton->setUpdateLod(mUpdateLodDistance, mUpdateLodInterval);
             mObjectRoot = skel;
             mInsert->addChild(mObjectRoot);
         }
@@ -1348,14 +1352,14 @@ namespace MWRender
 
     void Animation::addExtraLight(osg::ref_ptr<osg::Group> parent, const ESM::Light *esmLight)
     {
-        const Fallback::Map* fallback = MWBase::Environment::get().getWorld()->getFallback();
-        static bool outQuadInLin = fallback->getFallbackBool("LightAttenuation_OutQuadInLin");
-        static bool useQuadratic = fallback->getFallbackBool("LightAttenuation_UseQuadratic");
-        static float quadraticValue = fallback->getFallbackFloat("LightAttenuation_QuadraticValue");
-        static float quadraticRadiusMult = fallback->getFallbackFloat("LightAttenuation_QuadraticRadiusMult");
-        static bool useLinear = fallback->getFallbackBool("LightAttenuation_UseLinear");
-        static float linearRadiusMult = fallback->getFallbackFloat("LightAttenuation_LinearRadiusMult");
-        static float linearValue = fallback->getFallbackFloat("LightAttenuation_LinearValue");
+        const MWWorld::FallbackTable& fallback = MWBase::Environment::get().getWorld()->getFallbackTable();
+        bool outQuadInLin = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_OutQuadInLin);
+        bool useQuadratic = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_UseQuadratic);
+        float quadraticValue = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_QuadraticValue);
+        float quadraticRadiusMult = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_QuadraticRadiusMult);
+        bool useLinear = fallback.getBool(MWWorld::FallbackValue::LightAttenuation_UseLinear);
+        float linearRadiusMult = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_LinearRadiusMult);
+        float linearValue = fallback.getFloat(MWWorld::FallbackValue::LightAttenuation_LinearValue);
         bool exterior = mPtr.isInCell() && mPtr.getCell()->getCell()->isExterior();
 
         SceneUtil::addLight(parent, esmLight, Mask_ParticleSystem, Mask_Lighting, exterior, outQuadInLin,
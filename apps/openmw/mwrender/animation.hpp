@@ -20,6 +20,8 @@ namespace NifOsg
 {
     class KeyframeHolder;
     class KeyframeController;
+    class TextKeyIndex;
+    struct TextKeyGroup;
 }
 
 namespace SceneUtil
@@ -171,6 +173,8 @@ protected:
 
     struct AnimState {
         std::shared_ptr<AnimSource> mSource;
+        /// Text keys of the group in mSource
+        const NifOsg::TextKeyGroup* mGroup;
         float mStartTime;
         float mLoopStartTime;
         float mLoopStopTime;
@@ -188,7 +192,7 @@ protected:
         int mBlendMask;
         bool mAutoDisable;
 
-        AnimState() : mStartTime(0.0f), mLoopStartTime(0.0f), mLoopStopTime(0.0f), mStopTime(0.0f),
+        AnimState() : mGroup(NULL), mStartTime(0.0f), mLoopStartTime(0.0f), mLoopStopTime(0.0f), mStopTime(0.0f),
                       mTime(new float), mSpeedMult(1.0f), mPlaying(false), mLoopingEnabled(true),
                       mLoopCount(0), mPriority(0), mBlendMask(0), mAutoDisable(true)
         {
@@ -271,6 +275,9 @@ protected:
 
     float mAlpha;
 
+    float mUpdateLodDistance;
+    unsigned int mUpdateLodInterval;
+
     mutable std::map<std::string, float> mAnimVelocities;
 
     osg::ref_ptr<SceneUtil::LightListCallback> mLightListCallback;
@@ -292,7 +299,7 @@ protected:
      * the marker is not found, or if the markers are the same, it returns
      * false.
      */
-    bool reset(AnimState &state, const std::multimap<float, std::string> &keys,
+    bool reset(AnimState &state, const NifOsg::TextKeyIndex &index,
                const std::string &groupname, const std::string &start, const std::string &stop,
                float startpoint, bool loopfallback);
 
@@ -348,6 +355,11 @@ public:
     /// @see SceneUtil::Skeleton::setActive
     void setActive(bool active);
 
+    /// Update the skeleton less often when it is far away or not visible. Root movement and text keys are
+    /// still processed every frame by runAnimation, also for skeletons created later.
+    /// @see SceneUtil::Skeleton::setUpdateLod
+    void setUpdateLod(float fullRateDistance, unsigned int maxInterval);
+
     osg::Group* getOrCreateObjectRoot();
 
     osg::Group* getObjectRoot();
@@ -1,11 +1,5 @@
 #include "landmanager.hpp"
 
-#include <osg/Stats>
-
-#include <sstream>
-
-#include <components/resource/objectcache.hpp>
-
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include "../mwworld/esmstore.hpp"
@@ -13,36 +7,14 @@
 namespace MWRender
 {
 
-LandManager::LandManager(int loadFlags)
-    : ResourceManager(NULL)
-    , mLoadFlags(loadFlags)
-{
-}
-
-osg::ref_ptr<ESMTerrain::LandObject> LandManager::getLand(int x, int y)
+LandManager::LandManager(int loadFlags, ESMTerrain::LandObject::DataMode dataMode)
+    : ESMTerrain::LandManager(loadFlags, dataMode)
 {
-    std::ostringstream id;
-    id << x << " " << y;
-    std::string idstr = id.str();
-
-    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(idstr);
-    if (obj)
-        return static_cast<ESMTerrain::LandObject*>(obj.get());
-    else
-    {
-        const ESM::Land* land = MWBase::Environment::get().getWorld()->getStore().get<ESM::Land>().search(x,y);
-        if (!land)
-            return NULL;
-        osg::ref_ptr<ESMTerrain::LandObject> landObj (new ESMTerrain::LandObject(land, mLoadFlags));
-        mCache->addEntryToObjectCache(idstr, landObj.get());
-        return landObj;
-    }
 }
 
-void LandManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
+const ESM::Land* LandManager::findLand(int x, int y)
 {
-    stats->setAttribute(frameNumber, "Land", mCache->getCacheSize());
+    return MWBase::Environment::get().getWorld()->getStore().get<ESM::Land>().search(x,y);
 }
 
-
 }
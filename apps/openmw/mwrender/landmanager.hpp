@@ -1,31 +1,19 @@
-#ifndef OPENMW_COMPONENTS_ESMTERRAIN_LANDMANAGER_H
-#define OPENMW_COMPONENTS_ESMTERRAIN_LANDMANAGER_H
+#ifndef OPENMW_MWRENDER_LANDMANAGER_H
+#define OPENMW_MWRENDER_LANDMANAGER_H
 
-#include <osg/Object>
-
-#include <components/resource/resourcemanager.hpp>
-#include <components/esmterrain/storage.hpp>
-
-namespace ESM
-{
-    struct Land;
-}
+#include <components/esmterrain/landmanager.hpp>
 
 namespace MWRender
 {
 
-    class LandManager : public Resource::ResourceManager
+    /// @brief Provides the lands of the game's ESMStore to the shared land cache.
+    class LandManager : public ESMTerrain::LandManager
     {
     public:
-        LandManager(int loadFlags);
-
-        /// @note Will return NULL if not found.
-        osg::ref_ptr<ESMTerrain::LandObject> getLand(int x, int y);
-
-        virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
+        LandManager(int loadFlags, ESMTerrain::LandObject::DataMode dataMode = ESMTerrain::LandObject::Data_Copy);
 
-    private:
-        int mLoadFlags;
+    protected:
+        virtual const ESM::Land* findLand(int x, int y);
     };
 
 }
@@ -8,6 +8,8 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
 
+#include <components/settings/settings.hpp>
+
 #include "../mwworld/ptr.hpp"
 #include "../mwworld/class.hpp"
 
@@ -16,6 +18,11 @@
 #include "creatureanimation.hpp"
 #include "vismask.hpp"
 
+namespace
+{
+    /// Most frames between two updates of the skeleton of an actor that is far away or not visible
+    const unsigned int sAnimationLodInterval = 5;
+}
 
 namespace MWRender
 {
@@ -24,6 +31,7 @@ Objects::Objects(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Gro
     : mRootNode(rootNode)
     , mResourceSystem(resourceSystem)
     , mUnrefQueue(unrefQueue)
+    , mAnimationLodDistance(Settings::Manager::getFloat("animation full rate distance", "Game"))
 {
 }
 
@@ -92,6 +100,8 @@ void Objects::insertCreature(const MWWorld::Ptr &ptr, const std::string &mesh, b
     else
         anim = new CreatureAnimation(ptr, mesh, mResourceSystem);
 
+    anim->setUpdateLod(mAnimationLodDistance, sAnimationLodInterval);
+
     if (mObjects.insert(std::make_pair(ptr, anim)).second)
         ptr.getClass().getContainerStore(ptr).setContListener(static_cast<ActorAnimation*>(anim.get()));
 }
@@ -102,6 +112,7 @@ void Objects::insertNPC(const MWWorld::Ptr &ptr)
     ptr.getRefData().getBaseNode()->setNodeMask(Mask_Actor);
 
     osg::ref_ptr<NpcAnimation> anim (new NpcAnimation(ptr, osg::ref_ptr<osg::Group>(ptr.getRefData().getBaseNode()), mResourceSystem));
+    anim->setUpdateLod(mAnimationLodDistance, sAnimationLodInterval);
 
     if (mObjects.insert(std::make_pair(ptr, anim)).second)
     {
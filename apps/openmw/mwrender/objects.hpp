@@ -67,6 +67,8 @@ class Objects{
 
     Resource::ResourceSystem* mResourceSystem;
 
+    float mAnimationLodDistance;
+
     osg::ref_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
 
     void insertBegin(const MWWorld::Ptr& ptr);
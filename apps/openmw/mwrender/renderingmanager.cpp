@@ -141,6 +141,8 @@ namespace MWRender
         {
         }
 
+        virtual const char* getName() const { return "PreloadCommonAssetsWorkItem"; }
+
         virtual void doWork()
         {
             try
@@ -216,10 +218,15 @@ namespace MWRender
         const bool distantTerrain = Settings::Manager::getBool("distant terrain", "Terrain");
         mTerrainStorage = new TerrainStorage(mResourceSystem, Settings::Manager::getString("normal map pattern", "Shaders"), Settings::Manager::getString("normal height map pattern", "Shaders"),
                                             Settings::Manager::getBool("auto use terrain normal maps", "Shaders"), Settings::Manager::getString("terrain specular map pattern", "Shaders"),
-                                             Settings::Manager::getBool("auto use terrain specular maps", "Shaders"));
+                                             Settings::Manager::getBool("auto use terrain specular maps", "Shaders"),
+                                             Settings::Manager::getBool("quantize land heights", "Terrain"));
 
         if (distantTerrain)
-            mTerrain.reset(new Terrain::QuadTreeWorld(sceneRoot, mRootNode, mResourceSystem, mTerrainStorage, Mask_Terrain, Mask_PreCompile));
+        {
+            Terrain::QuadTreeWorld* quadTreeWorld = new Terrain::QuadTreeWorld(sceneRoot, mRootNode, mResourceSystem, mTerrainStorage, Mask_Terrain, Mask_PreCompile);
+            quadTreeWorld->setWorkQueue(mWorkQueue.get());
+            mTerrain.reset(quadTreeWorld);
+        }
         else
             mTerrain.reset(new Terrain::TerrainGrid(sceneRoot, mRootNode, mResourceSystem, mTerrainStorage, Mask_Terrain, Mask_PreCompile));
         mTerrain->setDefaultViewer(mViewer->getCamera());
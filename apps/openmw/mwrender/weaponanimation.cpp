@@ -103,8 +103,7 @@ void WeaponAnimation::releaseArrow(MWWorld::Ptr actor, float attackStrength)
     osg::Quat orient = osg::Quat(actor.getRefData().getPosition().rot[0], osg::Vec3f(-1,0,0))
             * osg::Quat(actor.getRefData().getPosition().rot[2], osg::Vec3f(0,0,-1));
 
-    const MWWorld::Store<ESM::GameSetting> &gmst =
-        MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+    const MWWorld::GmstTable& gmsts = MWBase::Environment::get().getWorld()->getStore().getGmsts();
 
     MWMechanics::applyFatigueLoss(actor, *weapon, attackStrength);
 
@@ -119,8 +118,8 @@ void WeaponAnimation::releaseArrow(MWWorld::Ptr actor, float attackStrength)
             return;
         osg::Vec3f launchPos = osg::computeLocalToWorld(nodepaths[0]).getTrans();
 
-        float fThrownWeaponMinSpeed = gmst.find("fThrownWeaponMinSpeed")->getFloat();
-        float fThrownWeaponMaxSpeed = gmst.find("fThrownWeaponMaxSpeed")->getFloat();
+        float fThrownWeaponMinSpeed = gmsts.getFloat(MWWorld::GMST::fThrownWeaponMinSpeed);
+        float fThrownWeaponMaxSpeed = gmsts.getFloat(MWWorld::GMST::fThrownWeaponMaxSpeed);
         float speed = fThrownWeaponMinSpeed + (fThrownWeaponMaxSpeed - fThrownWeaponMinSpeed) * attackStrength;
 
         MWBase::Environment::get().getWorld()->launchProjectile(actor, *weapon, launchPos, orient, *weapon, speed, attackStrength);
@@ -145,8 +144,8 @@ void WeaponAnimation::releaseArrow(MWWorld::Ptr actor, float attackStrength)
             return;
         osg::Vec3f launchPos = osg::computeLocalToWorld(nodepaths[0]).getTrans();
 
-        float fProjectileMinSpeed = gmst.find("fProjectileMinSpeed")->getFloat();
-        float fProjectileMaxSpeed = gmst.find("fProjectileMaxSpeed")->getFloat();
+        float fProjectileMinSpeed = gmsts.getFloat(MWWorld::GMST::fProjectileMinSpeed);
+        float fProjectileMaxSpeed = gmsts.getFloat(MWWorld::GMST::fProjectileMaxSpeed);
         float speed = fProjectileMinSpeed + (fProjectileMaxSpeed - fProjectileMinSpeed) * attackStrength;
 
         MWBase::Environment::get().getWorld()->launchProjectile(actor, *ammo, launchPos, orient, *weapon, speed, attackStrength);
@@ -425,7 +425,7 @@ namespace MWScript
                         key = ESM::MagicEffect::effectStringToId(effect);
 
                     const MWMechanics::MagicEffects& effects = ptr.getClass().getCreatureStats(ptr).getMagicEffects();
-                    for (MWMechanics::MagicEffects::Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+                    for (MWMechanics::MagicEffects::const_iterator it = effects.begin(); it != effects.end(); ++it)
                     {
                         if (it->first.mId == key && it->second.getModifier() > 0)
                         {
@@ -0,0 +1,48 @@
+#include "actoridindex.hpp"
+
+namespace MWWorld
+{
+    ActorIdIndex::ActorIdIndex()
+        : mRevision (0), mValid (false)
+    {}
+
+    void ActorIdIndex::invalidate()
+    {
+        mValid = false;
+    }
+
+    int ActorIdIndex::search (int id, std::size_t size, unsigned int revision, const GetActorId& getActorId)
+    {
+        if (!mValid)
+            build (size, revision, getActorId);
+
+        std::unordered_map<int, std::size_t>::const_iterator found = mPositions.find (id);
+
+        if (found!=mPositions.end() && getActorId (found->second)==id)
+            return static_cast<int> (found->second);
+
+        // No actor ID has changed since the index was built, so the miss is genuine
+        if (found==mPositions.end() && revision==mRevision)
+            return -1;
+
+        build (size, revision, getActorId);
+
+        found = mPositions.find (id);
+        return found!=mPositions.end() ? static_cast<int> (found->second) : -1;
+    }
+
+    void ActorIdIndex::build (std::size_t size, unsigned int revision, const GetActorId& getActorId)
+    {
+        mPositions.clear();
+
+        for (std::size_t i = 0; i<size; ++i)
+        {
+            int id = getActorId (i);
+            if (id!=-1)
+                mPositions.insert (std::make_pair (id, i));
+        }
+
+        mRevision = revision;
+        mValid = true;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef OPENMW_MWWORLD_ACTORIDINDEX_H
+#define OPENMW_MWWORLD_ACTORIDINDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+namespace MWWorld
+{
+    /// \brief Lookup of the actors of a cell by actor ID
+    ///
+    /// Actor IDs are assigned lazily and replaced when an actor respawns or its state is loaded, without
+    /// the cell being told. The index therefore remembers the actor ID revision it was built for
+    /// (see MWMechanics::CreatureStats::getActorIdRevision) and is rebuilt when a search misses after
+    /// the revision has changed.
+    class ActorIdIndex
+    {
+        public:
+
+            /// Return the actor ID of the reference at the given position, or -1 if it is not an actor
+            /// or does not have an actor ID yet.
+            typedef std::function<int (std::size_t)> GetActorId;
+
+            ActorIdIndex();
+
+            /// Rebuild the index on the next search, e.g. because the references have changed.
+            void invalidate();
+
+            /// \param size Number of references.
+            /// \param revision Current actor ID revision.
+            /// \return Position of the actor with the given ID, or -1 if there is none.
+            int search (int id, std::size_t size, unsigned int revision, const GetActorId& getActorId);
+
+        private:
+
+            void build (std::size_t size, unsigned int revision, const GetActorId& getActorId);
+
+            std::unordered_map<int, std::size_t> mPositions;
+            unsigned int mRevision;
+            bool mValid;
+    };
+}
+
+#endif
@@ -87,6 +87,8 @@ namespace MWWorld
             mAbort = true;
         }
 
+        virtual const char* getName() const { return "PreloadItem"; }
+
         /// Preload work to be called from the worker thread.
         virtual void doWork()
         {
@@ -178,6 +180,8 @@ namespace MWWorld
         {
         }
 
+        virtual const char* getName() const { return "UpdateCacheItem"; }
+
         virtual void doWork()
         {
             mResourceSystem->updateCache(mReferenceTime);
@@ -378,6 +382,8 @@ namespace MWWorld
         {
         }
 
+        virtual const char* getName() const { return "TerrainPreloadItem"; }
+
         virtual void doWork()
         {
             for (unsigned int i=0; i<mTerrainViews.size() && i<mPreloadPositions.size() && !mAbort; ++i)
@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_CELLREF_H
 
 #include <components/esm/cellref.hpp>
+#include <components/misc/internedid.hpp>
 
 namespace ESM
 {
@@ -17,7 +18,7 @@ namespace MWWorld
     public:
 
         CellRef (const ESM::CellRef& ref)
-            : mCellRef(ref)
+            : mCellRef(ref), mRefId(ref.mRefID)
         {
             mChanged = false;
         }
@@ -34,6 +35,9 @@ namespace MWWorld
         // Id of object being referenced
         std::string getRefId() const;
 
+        // Same as getRefId, for comparisons that ignore case without allocating
+        const Misc::InternedId& getInternedRefId() const { return mRefId; }
+
         // For doors - true if this door teleports to somewhere else, false
         // if it should open through animation.
         bool getTeleport() const;
@@ -114,6 +118,7 @@ namespace MWWorld
     private:
         bool mChanged;
         ESM::CellRef mCellRef;
+        Misc::InternedId mRefId;
     };
 
 }
@@ -1,20 +1,48 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
+#include <cstddef>
+#include <unordered_map>
 
 #include "livecellref.hpp"
+#include "refpool.hpp"
 
 namespace MWWorld
 {
+    struct RefNumHash
+    {
+        std::size_t operator() (const ESM::RefNum& refNum) const
+        {
+            return std::hash<unsigned long long>() (
+                (static_cast<unsigned long long> (static_cast<unsigned int> (refNum.mContentFile)) << 32) | refNum.mIndex);
+        }
+    };
+
     /// \brief Collection of references of one type
+    ///
+    /// References are kept in a RefPool, so their addresses remain stable while the list grows.
+    /// References that came from a content file are additionally indexed by their RefNum.
     template <typename X>
     struct CellRefList
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        typedef RefPool<LiveRef> List;
         List mList;
 
+        CellRefList() : mMayHaveDuplicates (false) {}
+
+        CellRefList (const CellRefList& list) : mList (list.mList), mMayHaveDuplicates (false)
+        {
+            rebuildIndex();
+        }
+
+        CellRefList& operator= (const CellRefList& list)
+        {
+            mList = list.mList;
+            rebuildIndex();
+            return *this;
+        }
+
         /// Search for the given reference in the given reclist from
         /// ESMStore. Insert the reference into the list if a match is
         /// found. If not, throw an exception.
@@ -27,19 +55,94 @@ namespace MWWorld
         LiveRef &insert (const LiveRef &item)
         {
             mList.push_back(item);
-            return mList.back();
+            typename List::iterator iter = --mList.end();
+            addToIndex (iter);
+            return *iter;
+        }
+
+        /// Return the reference with the given content file RefNum, or a null pointer if there is none.
+        LiveRef *searchViaRefNum (const ESM::RefNum &refNum)
+        {
+            typename Index::iterator found = findInIndex (refNum);
+            return found!=mIndex.end() ? &*found->second : 0;
         }
 
         /// Remove all references with the given refNum from this list.
         void remove (const ESM::RefNum &refNum)
         {
+            if (refNum.hasContentFile() && !mMayHaveDuplicates)
+            {
+                typename Index::iterator found = findInIndex (refNum);
+                if (found!=mIndex.end())
+                {
+                    mList.erase (found->second);
+                    mIndex.erase (found);
+                }
+                return;
+            }
+
+            bool erased = false;
             for (typename List::iterator it = mList.begin(); it != mList.end();)
             {
                 if (*it == refNum)
-                    mList.erase(it++);
+                {
+                    it = mList.erase(it);
+                    erased = true;
+                }
                 else
                     ++it;
             }
+
+            // Also drops the entries of erased references whose RefNum changed after they were indexed
+            if (erased)
+                rebuildIndex();
+        }
+
+    private:
+
+        typedef std::unordered_map<ESM::RefNum, typename List::iterator, RefNumHash> Index;
+        Index mIndex;
+
+        /// Has a reference been added while another one with the same RefNum was indexed? Then remove() can not
+        /// rely on the index alone.
+        bool mMayHaveDuplicates;
+
+        void addToIndex (typename List::iterator iter)
+        {
+            const ESM::RefNum& refNum = iter->mRef.getRefNum();
+
+            if (!refNum.hasContentFile())
+                return;
+
+            // The first reference with a given RefNum wins, matching a linear search. Copies made by
+            // Class::copyToCell briefly share the RefNum of their original before it is unset.
+            if (findInIndex (refNum)==mIndex.end())
+                mIndex[refNum] = iter;
+            else
+                mMayHaveDuplicates = true;
+        }
+
+        /// \note Entries of references whose RefNum has since been unset are dropped here.
+        typename Index::iterator findInIndex (const ESM::RefNum &refNum)
+        {
+            typename Index::iterator found = mIndex.find (refNum);
+
+            if (found!=mIndex.end() && !(found->second->mRef.getRefNum()==refNum))
+            {
+                mIndex.erase (found);
+                return mIndex.end();
+            }
+
+            return found;
+        }
+
+        void rebuildIndex()
+        {
+            mIndex.clear();
+            mMayHaveDuplicates = false;
+
+            for (typename List::iterator iter (mList.begin()); iter!=mList.end(); ++iter)
+                addToIndex (iter);
         }
     };
 }
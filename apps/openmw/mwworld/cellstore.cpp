@@ -2,6 +2,8 @@
 
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <functional>
 
 #include <components/esm/cellstate.hpp>
 #include <components/esm/cellid.hpp>
@@ -27,6 +29,9 @@
 
 namespace
 {
+    // End of a chain in CellStore::mNextWithSameRefId
+    const std::size_t sNoNextRef = std::numeric_limits<std::size_t>::max();
+
     template<typename T>
     MWWorld::Ptr searchInContainerList (MWWorld::CellRefList<T>& containerList, const std::string& id)
     {
@@ -45,25 +50,6 @@ namespace
         return MWWorld::Ptr();
     }
 
-    template<typename T>
-    MWWorld::Ptr searchViaActorId (MWWorld::CellRefList<T>& actorList, int actorId,
-        MWWorld::CellStore *cell, const std::map<MWWorld::LiveCellRefBase*, MWWorld::CellStore*>& toIgnore)
-    {
-        for (typename MWWorld::CellRefList<T>::List::iterator iter (actorList.mList.begin());
-             iter!=actorList.mList.end(); ++iter)
-        {
-            MWWorld::Ptr actor (&*iter, cell);
-
-            if (toIgnore.find(&*iter) != toIgnore.end())
-                continue;
-
-            if (actor.getClass().getCreatureStats (actor).matchesActorId (actorId) && actor.getRefData().getCount() > 0)
-                return actor;
-        }
-
-        return MWWorld::Ptr();
-    }
-
     template<typename RecordType, typename T>
     void writeReferenceCollection (ESM::ESMWriter& writer,
         const MWWorld::CellRefList<T>& collection)
@@ -129,14 +115,12 @@ namespace
 
         if (state.mRef.mRefNum.hasContentFile())
         {
-            for (typename MWWorld::CellRefList<T>::List::iterator iter (collection.mList.begin());
-                iter!=collection.mList.end(); ++iter)
-                if (iter->mRef.getRefNum()==state.mRef.mRefNum)
-                {
-                    // overwrite existing reference
-                    iter->load (state);
-                    return;
-                }
+            if (MWWorld::LiveCellRef<T> *existing = collection.searchViaRefNum (state.mRef.mRefNum))
+            {
+                // overwrite existing reference
+                existing->load (state);
+                return;
+            }
 
             std::cerr << "Warning: Dropping reference to " << state.mRef.mRefID << " (invalid content file link)" << std::endl;
             return;
@@ -181,18 +165,17 @@ namespace MWWorld
 
         if (const X *ptr = store.search (ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter =
-                std::find(mList.begin(), mList.end(), ref.mRefNum);
+            LiveRef *existing = searchViaRefNum (ref.mRefNum);
 
             LiveRef liveCellRef (ref, ptr);
 
             if (deleted)
                 liveCellRef.mData.setDeletedByContentFile(true);
 
-            if (iter != mList.end())
-                *iter = liveCellRef;
+            if (existing)
+                *existing = liveCellRef;
             else
-                mList.push_back (liveCellRef);
+                insert (liveCellRef);
         }
         else
         {
@@ -326,10 +309,63 @@ namespace MWWorld
         MergeVisitor visitor(mMergedRefs, mMovedHere, mMovedToAnotherCell);
         forEachInternal(visitor);
         visitor.merge();
+
+        mRefIdIndexValid = false;
+        mActorIdIndex.invalidate();
+    }
+
+    void CellStore::buildRefIdIndex() const
+    {
+        mRefIdIndex.clear();
+        mNextWithSameRefId.assign (mMergedRefs.size(), sNoNextRef);
+
+        // Walk backwards, so that each chain ends up in mMergedRefs order
+        for (std::size_t i = mMergedRefs.size(); i>0; --i)
+        {
+            std::pair<RefIdIndex::iterator, bool> result =
+                mRefIdIndex.insert (std::make_pair (mMergedRefs[i-1]->mRef.getRefId(), i-1));
+
+            if (!result.second)
+            {
+                mNextWithSameRefId[i-1] = result.first->second;
+                result.first->second = i-1;
+            }
+        }
+
+        mRefIdIndexValid = true;
+    }
+
+    int CellStore::getMergedActorId (std::size_t position)
+    {
+        MWWorld::Ptr actor (mMergedRefs[position], this);
+
+        if (!actor.getClass().isActor())
+            return -1;
+
+        MWMechanics::CreatureStats& stats = actor.getClass().getCreatureStats (actor);
+        return stats.hasActorId() ? stats.getActorId() : -1;
+    }
+
+    LiveCellRefBase *CellStore::searchMergedRef (const std::string& id) const
+    {
+        if (!mRefIdIndexValid)
+            buildRefIdIndex();
+
+        RefIdIndex::const_iterator found = mRefIdIndex.find (id);
+
+        if (found==mRefIdIndex.end())
+            return 0;
+
+        for (std::size_t i = found->second; i!=sNoNextRef; i = mNextWithSameRefId[i])
+            if (isAccessible (mMergedRefs[i]->mData, mMergedRefs[i]->mRef))
+                return mMergedRefs[i];
+
+        return 0;
     }
 
     CellStore::CellStore (const ESM::Cell *cell, const MWWorld::ESMStore& esmStore, std::vector<ESM::ESMReader>& readerList)
         : mStore(esmStore), mReader(readerList), mCell (cell), mState (State_Unloaded), mHasState (false), mLastRespawn(0,0)
+        , mRefIdIndexValid (false)
     {
         mWaterLevel = cell->mWater;
     }
@@ -365,56 +401,40 @@ namespace MWWorld
         return searchConst (id).isEmpty();
     }
 
-    template <typename PtrType>
-    struct SearchVisitor
-    {
-        PtrType mFound;
-        std::string mIdToFind;
-        bool operator()(const PtrType& ptr)
-        {
-            if (ptr.getCellRef().getRefId() == mIdToFind)
-            {
-                mFound = ptr;
-                return false;
-            }
-            return true;
-        }
-    };
-
     Ptr CellStore::search (const std::string& id)
     {
-        SearchVisitor<MWWorld::Ptr> searchVisitor;
-        searchVisitor.mIdToFind = id;
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded || mMergedRefs.empty())
+            return Ptr();
+
+        mHasState = true;
+
+        if (LiveCellRefBase *ref = searchMergedRef (id))
+            return Ptr (ref, this);
+
+        return Ptr();
     }
 
     ConstPtr CellStore::searchConst (const std::string& id) const
     {
-        SearchVisitor<MWWorld::ConstPtr> searchVisitor;
-        searchVisitor.mIdToFind = id;
-        forEachConst(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded)
+            return ConstPtr();
+
+        if (const LiveCellRefBase *ref = searchMergedRef (id))
+            return ConstPtr (ref, this);
+
+        return ConstPtr();
     }
 
     Ptr CellStore::searchViaActorId (int id)
     {
-        if (Ptr ptr = ::searchViaActorId (mNpcs, id, this, mMovedToAnotherCell))
-            return ptr;
+        int position = mActorIdIndex.search (id, mMergedRefs.size(), MWMechanics::CreatureStats::getActorIdRevision(),
+            std::bind (&CellStore::getMergedActorId, this, std::placeholders::_1));
 
-        if (Ptr ptr = ::searchViaActorId (mCreatures, id, this, mMovedToAnotherCell))
-            return ptr;
+        if (position==-1)
+            return Ptr();
 
-        for (MovedRefTracker::const_iterator it = mMovedHere.begin(); it != mMovedHere.end(); ++it)
-        {
-            MWWorld::Ptr actor (it->first, this);
-            if (!actor.getClass().isActor())
-                continue;
-            if (actor.getClass().getCreatureStats (actor).matchesActorId (id) && actor.getRefData().getCount() > 0)
-                return actor;
-        }
-
-        return Ptr();
+        MWWorld::Ptr actor (mMergedRefs[position], this);
+        return actor.getRefData().getCount() > 0 ? actor : Ptr();
     }
 
     float CellStore::getWaterLevel() const
@@ -598,6 +618,38 @@ namespace MWWorld
         return Ptr();
     }
 
+    LiveCellRefBase *CellStore::searchViaRefNum (const ESM::RefNum& refNum)
+    {
+        if (!refNum.hasContentFile())
+            return 0;
+
+        LiveCellRefBase *ref = 0;
+
+        (ref = searchViaRefNumImp (mActivators, refNum)) ||
+        (ref = searchViaRefNumImp (mPotions, refNum)) ||
+        (ref = searchViaRefNumImp (mAppas, refNum)) ||
+        (ref = searchViaRefNumImp (mArmors, refNum)) ||
+        (ref = searchViaRefNumImp (mBooks, refNum)) ||
+        (ref = searchViaRefNumImp (mClothes, refNum)) ||
+        (ref = searchViaRefNumImp (mContainers, refNum)) ||
+        (ref = searchViaRefNumImp (mDoors, refNum)) ||
+        (ref = searchViaRefNumImp (mIngreds, refNum)) ||
+        (ref = searchViaRefNumImp (mItemLists, refNum)) ||
+        (ref = searchViaRefNumImp (mLights, refNum)) ||
+        (ref = searchViaRefNumImp (mLockpicks, refNum)) ||
+        (ref = searchViaRefNumImp (mMiscItems, refNum)) ||
+        (ref = searchViaRefNumImp (mProbes, refNum)) ||
+        (ref = searchViaRefNumImp (mRepairs, refNum)) ||
+        (ref = searchViaRefNumImp (mStatics, refNum)) ||
+        (ref = searchViaRefNumImp (mWeapons, refNum)) ||
+        (ref = searchViaRefNumImp (mBodyParts, refNum)) ||
+        (ref = searchViaRefNumImp (mCreatures, refNum)) ||
+        (ref = searchViaRefNumImp (mNpcs, refNum)) ||
+        (ref = searchViaRefNumImp (mCreatureLists, refNum));
+
+        return ref;
+    }
+
     void CellStore::loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, std::string>& refNumToID)
     {
         Misc::StringUtils::lowerCaseInPlace (ref.mRefID);
@@ -893,17 +945,14 @@ namespace MWWorld
             movedTo.load(reader);
 
             // Search for the reference. It might no longer exist if its content file was removed.
-            SearchByRefNumVisitor visitor(refnum);
-            forEachInternal(visitor);
+            MWWorld::LiveCellRefBase* movedRef = searchViaRefNum(refnum);
 
-            if (!visitor.mFound)
+            if (!movedRef)
             {
                 std::cerr << "Warning: Dropping moved ref tag for " << refnum.mIndex << " (moved object no longer exists)" << std::endl;
                 continue;
             }
 
-            MWWorld::LiveCellRefBase* movedRef = visitor.mFound;
-
             CellStore* otherCell = callback->getCellStore(movedTo);
 
             if (otherCell == NULL)
@@ -5,8 +5,10 @@
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
+#include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "livecellref.hpp"
 #include "cellreflist.hpp"
@@ -35,6 +37,7 @@
 #include "../mwmechanics/pathgrid.hpp"  // TODO: maybe belongs in mwworld
 
 #include "timestamp.hpp"
+#include "actoridindex.hpp"
 #include "ptr.hpp"
 
 namespace ESM
@@ -110,6 +113,17 @@ namespace MWWorld
             // Merged list of ref's currently in this cell - i.e. with added refs from mMovedHere, removed refs from mMovedToAnotherCell
             std::vector<LiveCellRefBase*> mMergedRefs;
 
+            // Lookup of mMergedRefs by refId, rebuilt on demand after mMergedRefs has changed.
+            // Maps a refId to the position of its first reference, further references with the same refId
+            // are chained through mNextWithSameRefId (in mMergedRefs order).
+            typedef std::unordered_map<std::string, std::size_t> RefIdIndex;
+            mutable RefIdIndex mRefIdIndex;
+            mutable std::vector<std::size_t> mNextWithSameRefId;
+            mutable bool mRefIdIndexValid;
+
+            // Lookup of actors in mMergedRefs by actor ID, rebuilt on demand after mMergedRefs or actor IDs have changed.
+            ActorIdIndex mActorIdIndex;
+
             // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
             Ptr getCurrentPtr(MWWorld::LiveCellRefBase* ref);
 
@@ -119,6 +133,14 @@ namespace MWWorld
             /// Repopulate mMergedRefs.
             void updateMergedRefs();
 
+            void buildRefIdIndex() const;
+
+            /// Return the actor ID of the reference at the given position in mMergedRefs, or -1 if it has none.
+            int getMergedActorId (std::size_t position);
+
+            /// Return the first accessible reference in mMergedRefs with the given refId, or a null pointer.
+            LiveCellRefBase *searchMergedRef (const std::string& id) const;
+
             // helper function for forEachInternal
             template<class Visitor, class List>
             bool forEachImp (Visitor& visitor, List& list)
@@ -162,6 +184,17 @@ namespace MWWorld
                     forEachImp (visitor, mCreatureLists);
             }
 
+            // helper function for searchViaRefNum
+            template<class List>
+            LiveCellRefBase *searchViaRefNumImp (List& list, const ESM::RefNum& refNum)
+            {
+                LiveCellRefBase *ref = list.searchViaRefNum (refNum);
+                return ref && isAccessible (ref->mData, ref->mRef) ? ref : 0;
+            }
+
+            // searching only objects owned by this cell, via the RefNum index of each list
+            LiveCellRefBase *searchViaRefNum (const ESM::RefNum& refNum);
+
             /// @note If you get a linker error here, this means the given type can not be stored in a cell. The supported types are
             /// defined at the bottom of this file.
             template <class T>
@@ -331,7 +364,7 @@ namespace MWWorld
                 for (MovedRefTracker::const_iterator it = mMovedHere.begin(); it != mMovedHere.end(); ++it)
                 {
                     LiveCellRefBase* base = it->first;
-                    if (dynamic_cast<LiveCellRef<T>*>(base))
+                    if (base->mType == T::sRecordId)
                         if (!visitor(MWWorld::Ptr(base, this)))
                             return false;
                 }
@@ -25,6 +25,7 @@
 namespace MWWorld
 {
     std::map<std::string, std::shared_ptr<Class> > Class::sClasses;
+    std::vector<const Class*> Class::sClassIndex;
 
     Class::Class() {}
 
@@ -241,15 +242,27 @@ namespace MWWorld
         return *iter->second;
     }
 
+    const Class& Class::get (unsigned int typeIndex)
+    {
+        if (typeIndex>=sClassIndex.size() || !sClassIndex[typeIndex])
+            throw std::logic_error ("Class::get(): no class registered for type index");
+
+        return *sClassIndex[typeIndex];
+    }
+
     bool Class::isPersistent(const ConstPtr &ptr) const
     {
         throw std::runtime_error ("class does not support persistence");
     }
 
-    void Class::registerClass(const std::string& key,  std::shared_ptr<Class> instance)
+    void Class::registerClass(const std::string& key, unsigned int typeIndex, std::shared_ptr<Class> instance)
     {
         instance->mTypeName = key;
         sClasses.insert(std::make_pair(key, instance));
+
+        if (typeIndex>=sClassIndex.size())
+            sClassIndex.resize(typeIndex+1, NULL);
+        sClassIndex[typeIndex] = instance.get();
     }
 
     std::string Class::getUpSoundId (const ConstPtr& ptr) const
@@ -51,6 +51,7 @@ namespace MWWorld
     class Class
     {
             static std::map<std::string, std::shared_ptr<Class> > sClasses;
+            static std::vector<const Class*> sClassIndex; // indexed by getRefTypeIndex()
 
             std::string mTypeName;
 
@@ -331,7 +332,17 @@ namespace MWWorld
             static const Class& get (const std::string& key);
             ///< If there is no class for this \a key, an exception is thrown.
 
-            static void registerClass (const std::string& key,  std::shared_ptr<Class> instance);
+            static const Class& get (unsigned int typeIndex);
+            ///< Look up a class by getRefTypeIndex(). If there is no class for this \a typeIndex,
+            /// an exception is thrown.
+
+            template <typename X>
+            static void registerClass (std::shared_ptr<Class> instance)
+            {
+                registerClass (typeid (X).name(), getRefTypeIndex<X>(), instance);
+            }
+
+            static void registerClass (const std::string& key, unsigned int typeIndex, std::shared_ptr<Class> instance);
 
             virtual int getBaseGold(const MWWorld::ConstPtr& ptr) const;
 
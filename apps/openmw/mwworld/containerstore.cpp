@@ -1,5 +1,6 @@
 #include "containerstore.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <typeinfo>
 #include <stdexcept>
@@ -113,9 +114,14 @@ void MWWorld::ContainerStore::storeStates (const CellRefList<T>& collection,
 
 const std::string MWWorld::ContainerStore::sGoldId = "gold_001";
 
-MWWorld::ContainerStore::ContainerStore() : mListener(NULL), mCachedWeight (0), mWeightUpToDate (false) {}
+MWWorld::ContainerStore::ContainerStore() : mListener(NULL), mRevision (0), mModificationCount (0), mCachedWeight (0), mWeightUpToDate (false) {}
 
-MWWorld::ContainerStore::~ContainerStore() {}
+MWWorld::ContainerStore::~ContainerStore()
+{
+    for (std::vector<ContainerStoreListener*>::const_iterator it = mListeners.mListeners.begin();
+         it != mListeners.mListeners.end(); ++it)
+        (*it)->storeDestroyed(*this);
+}
 
 MWWorld::ConstContainerStoreIterator MWWorld::ContainerStore::cbegin (int mask) const
 {
@@ -149,18 +155,27 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::end()
 
 int MWWorld::ContainerStore::count(const std::string &id)
 {
+    // no item can have an ID that has not been interned
+    Misc::InternedId key;
+    if (!Misc::InternedId::search(id, key))
+        return 0;
+
     int total=0;
     for (MWWorld::ContainerStoreIterator iter (begin()); iter!=end(); ++iter)
-        if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), id))
+        if (iter->getCellRef().getInternedRefId()==key)
             total += iter->getRefData().getCount();
     return total;
 }
 
 int MWWorld::ContainerStore::restockCount(const std::string &id)
 {
+    Misc::InternedId key;
+    if (!Misc::InternedId::search(id, key))
+        return 0;
+
     int total=0;
     for (MWWorld::ContainerStoreIterator iter (begin()); iter!=end(); ++iter)
-        if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), id))
+        if (iter->getCellRef().getInternedRefId()==key)
             if (iter->getCellRef().getSoul().empty())
                 total += iter->getRefData().getCount();
     return total;
@@ -177,6 +192,33 @@ void MWWorld::ContainerStore::setContListener(MWWorld::ContainerStoreListener* l
     mListener = listener;
 }
 
+void MWWorld::ContainerStore::addContListener(MWWorld::ContainerStoreListener* listener)
+{
+    mListeners.mListeners.push_back(listener);
+}
+
+void MWWorld::ContainerStore::removeContListener(MWWorld::ContainerStoreListener* listener)
+{
+    mListeners.mListeners.erase(std::remove(mListeners.mListeners.begin(), mListeners.mListeners.end(), listener),
+                                mListeners.mListeners.end());
+}
+
+unsigned int MWWorld::ContainerStore::getRevision() const
+{
+    return mRevision;
+}
+
+unsigned int MWWorld::ContainerStore::getModificationCount() const
+{
+    return mModificationCount;
+}
+
+void MWWorld::ContainerStore::flagContentsChanged()
+{
+    ++mRevision;
+    ++mModificationCount;
+}
+
 MWWorld::ContainerStoreIterator MWWorld::ContainerStore::unstack(const Ptr &ptr, const Ptr& container, int count)
 {
     if (ptr.getRefData().getCount() <= count)
@@ -212,6 +254,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
         {
             iter->getRefData().setCount(iter->getRefData().getCount() + item.getRefData().getCount());
             item.getRefData().setCount(0);
+            flagAsModified();
             retval = iter;
             break;
         }
@@ -224,7 +267,7 @@ bool MWWorld::ContainerStore::stacks(const ConstPtr& ptr1, const ConstPtr& ptr2)
     const MWWorld::Class& cls1 = ptr1.getClass();
     const MWWorld::Class& cls2 = ptr2.getClass();
 
-    if (!Misc::StringUtils::ciEqual(ptr1.getCellRef().getRefId(), ptr2.getCellRef().getRefId()))
+    if (ptr1.getCellRef().getInternedRefId() != ptr2.getCellRef().getInternedRefId())
         return false;
 
     // If it has an enchantment, don't stack when some of the charge is already used
@@ -267,6 +310,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::add (const Ptr& itemPtr
 {
     Ptr player = MWBase::Environment::get().getWorld ()->getPlayerPtr();
 
+    // The change is reported to the listeners below
+    unsigned int revision = mRevision;
+
     MWWorld::ContainerStoreIterator it = end();
 
     // HACK: Set owner on the original item, then reset it after we have copied it
@@ -333,9 +379,15 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::add (const Ptr& itemPtr
             item.getRefData().getLocals().setVarByInt(script, "onpcadd", 1);
     }
 
+    mRevision = revision;
+
     if (mListener)
         mListener->itemAdded(item, count);
 
+    for (std::vector<ContainerStoreListener*>::const_iterator iter = mListeners.mListeners.begin();
+         iter != mListeners.mListeners.end(); ++iter)
+        (*iter)->itemAdded(item, count);
+
     return it;
 }
 
@@ -412,11 +464,18 @@ int MWWorld::ContainerStore::remove(const std::string& itemId, int count, const
 {
     int toRemove = count;
 
+    // stays empty, i.e. does not match any item, if the ID is unknown
+    Misc::InternedId key;
+    Misc::InternedId::search(itemId, key);
+
     for (ContainerStoreIterator iter(begin()); iter != end() && toRemove > 0; ++iter)
-        if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), itemId))
+        if (iter->getCellRef().getInternedRefId() == key)
             toRemove -= remove(*iter, toRemove, actor, equipReplacement);
 
+    // Only flag the weight, the removals were reported individually
+    unsigned int revision = mRevision;
     flagAsModified();
+    mRevision = revision;
 
     // number of removed items
     return count - toRemove;
@@ -429,6 +488,9 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
     int toRemove = count;
     RefData& itemRef = item.getRefData();
 
+    // The change is reported to the listeners below
+    unsigned int revision = mRevision;
+
     if (itemRef.getCount() <= toRemove)
     {
         toRemove -= itemRef.getCount();
@@ -442,9 +504,15 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
 
     flagAsModified();
 
+    mRevision = revision;
+
     if (mListener)
         mListener->itemRemoved(item, count - toRemove);
 
+    for (std::vector<ContainerStoreListener*>::const_iterator iter = mListeners.mListeners.begin();
+         iter != mListeners.mListeners.end(); ++iter)
+        (*iter)->itemRemoved(item, count - toRemove);
+
     // number of removed items
     return count - toRemove;
 }
@@ -607,6 +675,8 @@ void MWWorld::ContainerStore::clear()
 void MWWorld::ContainerStore::flagAsModified()
 {
     mWeightUpToDate = false;
+    ++mRevision;
+    ++mModificationCount;
 }
 
 float MWWorld::ContainerStore::getWeight() const
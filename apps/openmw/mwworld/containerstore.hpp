@@ -2,6 +2,7 @@
 #define GAME_MWWORLD_CONTAINERSTORE_H
 
 #include <iterator>
+#include <vector>
 #include <map>
 #include <utility>
 
@@ -43,6 +44,9 @@ namespace MWWorld
         public:
             virtual void itemAdded(const ConstPtr& item, int count) {}
             virtual void itemRemoved(const ConstPtr& item, int count) {}
+
+            /// Called by a store this listener was added to with ContainerStore::addContListener when it is destroyed.
+            virtual void storeDestroyed(const ContainerStore& store) {}
     };
 
     class ContainerStore
@@ -89,6 +93,21 @@ namespace MWWorld
 
             ContainerStoreListener* mListener;
 
+            /// Listeners belong to the store they were added to, so copies of the store start without any.
+            struct ListenerList
+            {
+                std::vector<ContainerStoreListener*> mListeners;
+
+                ListenerList() {}
+                ListenerList(const ListenerList&) {}
+                ListenerList& operator= (const ListenerList&) { return *this; }
+            };
+
+            ListenerList mListeners;
+
+            unsigned int mRevision;
+            unsigned int mModificationCount;
+
             mutable float mCachedWeight;
             mutable bool mWeightUpToDate;
             ContainerStoreIterator addImp (const Ptr& ptr, int count);
@@ -172,7 +191,22 @@ namespace MWWorld
             ContainerStoreListener* getContListener() const;
             void setContListener(ContainerStoreListener* listener);
 
+            void addContListener(ContainerStoreListener* listener);
+            ///< Notify \a listener about added and removed items, in addition to the listener set with setContListener.
+
+            void removeContListener(ContainerStoreListener* listener);
+
+            unsigned int getRevision() const;
+            ///< Changes whenever the content of this store changes in a way that is not reported to the listeners
+            /// through itemAdded and itemRemoved, i.e. listeners that follow the store incrementally need to resync.
+
+            unsigned int getModificationCount() const;
+            ///< Changes whenever the content of this store changes, including the changes reported to the listeners.
+
         protected:
+            void flagContentsChanged();
+            ///< Record a change of the content that is not reported to the listeners, e.g. of the equipment.
+
             ContainerStoreIterator addNewStack (const ConstPtr& ptr, int count);
             ///< Add the item to this container (do not try to stack it onto existing items)
 
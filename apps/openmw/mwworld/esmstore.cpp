@@ -134,13 +134,15 @@ void ESMStore::setUp()
             storeIt->second->listIdentifier(identifiers);
 
             for (std::vector<std::string>::const_iterator record = identifiers.begin(); record != identifiers.end(); ++record)
-                mIds[*record] = storeIt->first;
+                mIds[Misc::InternedId(*record)] = storeIt->first;
         }
     }
     mSkills.setUp();
     mMagicEffects.setUp();
     mAttributes.setUp();
     mDialogs.setUp();
+
+    mGmstTable.setUp(mGameSettings);
 }
 
     int ESMStore::countSavedGameRecords() const
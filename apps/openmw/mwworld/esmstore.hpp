@@ -3,9 +3,11 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 
 #include <components/esm/records.hpp>
 #include "store.hpp"
+#include "gmsttable.hpp"
 
 namespace Loading
 {
@@ -67,11 +69,13 @@ namespace MWWorld
 
         // Lookup of all IDs. Makes looking up references faster. Just
         // maps the id name to the record type.
-        std::map<std::string, int> mIds;
+        std::unordered_map<Misc::InternedId, int> mIds;
         std::map<int, StoreBase *> mStores;
 
         ESM::NPC mPlayerTemplate;
 
+        GmstTable mGmstTable;
+
         unsigned int mDynamicCount;
 
     public:
@@ -87,10 +91,18 @@ namespace MWWorld
         }
 
         /// Look up the given ID in 'all'. Returns 0 if not found.
-        /// \note id must be in lower case.
         int find(const std::string &id) const
         {
-            std::map<std::string, int>::const_iterator it = mIds.find(id);
+            Misc::InternedId key;
+            if (!Misc::InternedId::search(id, key))
+                return 0;
+
+            return find(key);
+        }
+
+        int find(const Misc::InternedId &id) const
+        {
+            std::unordered_map<Misc::InternedId, int>::const_iterator it = mIds.find(id);
             if (it == mIds.end()) {
                 return 0;
             }
@@ -160,6 +172,11 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /// Precomputed values of frequently used GMSTs, refreshed by setUp().
+        const GmstTable &getGmsts() const {
+            return mGmstTable;
+        }
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -184,7 +201,7 @@ namespace MWWorld
             T *ptr = store.insert(record);
             for (iterator it = mStores.begin(); it != mStores.end(); ++it) {
                 if (it->second == &store) {
-                    mIds[ptr->mId] = it->first;
+                    mIds[Misc::InternedId(ptr->mId)] = it->first;
                 }
             }
             return ptr;
@@ -198,7 +215,7 @@ namespace MWWorld
             T *ptr = store.insert(x);
             for (iterator it = mStores.begin(); it != mStores.end(); ++it) {
                 if (it->second == &store) {
-                    mIds[ptr->mId] = it->first;
+                    mIds[Misc::InternedId(ptr->mId)] = it->first;
                 }
             }
             return ptr;
@@ -220,7 +237,7 @@ namespace MWWorld
             T *ptr = store.insertStatic(record);
             for (iterator it = mStores.begin(); it != mStores.end(); ++it) {
                 if (it->second == &store) {
-                    mIds[ptr->mId] = it->first;
+                    mIds[Misc::InternedId(ptr->mId)] = it->first;
                 }
             }
             return ptr;
@@ -260,7 +277,7 @@ namespace MWWorld
         record.mId = id.str();
 
         ESM::NPC *ptr = mNpcs.insert(record);
-        mIds[ptr->mId] = ESM::REC_NPC_;
+        mIds[Misc::InternedId(ptr->mId)] = ESM::REC_NPC_;
         return ptr;
     }
 
@@ -0,0 +1,208 @@
+#include "gmsttable.hpp"
+
+#include <stdexcept>
+#include <iostream>
+
+#include <components/fallback/fallback.hpp>
+
+#include "store.hpp"
+
+namespace
+{
+    const char* sGmstNames[] =
+    {
+        "fAlarmRadius",
+        "fBlockStillBonus",
+        "fCombatBlockLeftAngle",
+        "fCombatBlockRightAngle",
+        "fCombatCriticalStrikeMult",
+        "fCombatDelayCreature",
+        "fCombatDelayNPC",
+        "fCombatDistance",
+        "fCombatInvisoMult",
+        "fCombatKODamageMult",
+        "fCrimeStealing",
+        "fDamageStrengthBase",
+        "fDamageStrengthMult",
+        "fDispAttacking",
+        "fDispPickPocketMod",
+        "fDispStealing",
+        "fEndFatigueMult",
+        "fFallAcroBase",
+        "fFallAcroMult",
+        "fFallDamageDistanceMin",
+        "fFallDistanceBase",
+        "fFallDistanceMult",
+        "fFatigueAttackBase",
+        "fFatigueAttackMult",
+        "fFatigueBlockBase",
+        "fFatigueBlockMult",
+        "fFatigueJumpBase",
+        "fFatigueJumpMult",
+        "fFatigueReturnBase",
+        "fFatigueReturnMult",
+        "fFightStealing",
+        "fHandToHandReach",
+        "fHandtoHandHealthPer",
+        "fHoldBreathTime",
+        "fIdleChanceMultiplier",
+        "fInteriorHeadTrackMult",
+        "fLevelMod",
+        "fLuckMod",
+        "fMajorSkillBonus",
+        "fMaxHandToHandMult",
+        "fMaxHeadTrackDistance",
+        "fMinHandToHandMult",
+        "fMinorSkillBonus",
+        "fMiscSkillBonus",
+        "fNPCbaseMagickaMult",
+        "fPCbaseMagickaMult",
+        "fPersonalityMod",
+        "fProjectileMaxSpeed",
+        "fProjectileMinSpeed",
+        "fProjectileThrownStoreChance",
+        "fReputationMod",
+        "fRestMagicMult",
+        "fSneakUseDelay",
+        "fSneakUseDist",
+        "fSpecialSkillBonus",
+        "fSwingBlockBase",
+        "fSwingBlockMult",
+        "fThrownWeaponMaxSpeed",
+        "fThrownWeaponMinSpeed",
+        "fUnarmoredBase1",
+        "fUnarmoredBase2",
+        "fVoiceIdleOdds",
+        "fWeaponDamageMult",
+        "fWeaponFatigueBlockMult",
+        "fWeaponFatigueMult",
+        "fWereWolfSilverWeaponDamageMult",
+        "iBlockMaxChance",
+        "iBlockMinChance",
+        "iCrimeAttack",
+        "iCrimeKilling",
+        "iCrimePickPocket",
+        "iCrimeTresspass",
+        "iDispAttackMod",
+        "iDispKilling",
+        "iDispTresspass",
+        "iFightAttack",
+        "iFightAttacking",
+        "iFightKilling",
+        "iFightPickpocket",
+        "iFightTrespass",
+        "iGreetDistanceMultiplier",
+        "iVoiceAttackOdds",
+        "iVoiceHitOdds"
+    };
+
+    static_assert(sizeof(sGmstNames) / sizeof(sGmstNames[0]) == MWWorld::GMST::Count,
+                  "GMST name table does not match GMST::Id");
+
+    const char* sFallbackNames[] =
+    {
+        "General_Werewolf_FOV",
+        "LightAttenuation_LinearRadiusMult",
+        "LightAttenuation_LinearValue",
+        "LightAttenuation_OutQuadInLin",
+        "LightAttenuation_QuadraticRadiusMult",
+        "LightAttenuation_QuadraticValue",
+        "LightAttenuation_UseLinear",
+        "LightAttenuation_UseQuadratic"
+    };
+
+    static_assert(sizeof(sFallbackNames) / sizeof(sFallbackNames[0]) == MWWorld::FallbackValue::Count,
+                  "Fallback name table does not match FallbackValue::Id");
+
+    bool isNumeric(const ESM::Variant& value)
+    {
+        switch (value.getType())
+        {
+            case ESM::VT_Short:
+            case ESM::VT_Int:
+            case ESM::VT_Long:
+            case ESM::VT_Float:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+namespace MWWorld
+{
+    GmstTable::GmstTable()
+    {
+        for (int i = 0; i < GMST::Count; ++i)
+        {
+            mFloats[i] = 0.f;
+            mInts[i] = 0;
+            mNumeric[i] = false;
+            mRecords[i] = NULL;
+        }
+    }
+
+    void GmstTable::setUp(const Store<ESM::GameSetting>& store)
+    {
+#ifndef NDEBUG
+        // Nothing to check against before any content file is loaded
+        const bool check = store.getSize() > 0;
+#endif
+
+        for (int i = 0; i < GMST::Count; ++i)
+        {
+            const ESM::GameSetting* record = store.search(sGmstNames[i]);
+            mRecords[i] = record;
+            mNumeric[i] = record && isNumeric(record->mValue);
+            mFloats[i] = mNumeric[i] ? record->getFloat() : 0.f;
+            mInts[i] = mNumeric[i] ? record->getInt() : 0;
+
+#ifndef NDEBUG
+            if (check && !record)
+                std::cerr << "Warning: GMST handle '" << sGmstNames[i] << "' has no matching record" << std::endl;
+            else if (check && !mNumeric[i])
+                std::cerr << "Warning: GMST handle '" << sGmstNames[i] << "' is not numeric" << std::endl;
+#endif
+        }
+    }
+
+    const char* GmstTable::getName(GMST::Id id)
+    {
+        return sGmstNames[id];
+    }
+
+    const ESM::GameSetting& GmstTable::getSlow(GMST::Id id) const
+    {
+        if (!mRecords[id])
+            throw std::runtime_error(ESM::GameSetting::getRecordType() + " '" + sGmstNames[id] + "' not found");
+        return *mRecords[id];
+    }
+
+    std::string GmstTable::getString(GMST::Id id) const
+    {
+        return getSlow(id).getString();
+    }
+
+    FallbackTable::FallbackTable()
+    {
+        for (int i = 0; i < FallbackValue::Count; ++i)
+        {
+            mFloats[i] = 0.f;
+            mBools[i] = false;
+        }
+    }
+
+    void FallbackTable::setUp(const Fallback::Map& fallback)
+    {
+        for (int i = 0; i < FallbackValue::Count; ++i)
+        {
+            mFloats[i] = fallback.getFallbackFloat(sFallbackNames[i]);
+            mBools[i] = fallback.getFallbackBool(sFallbackNames[i]);
+        }
+    }
+
+    const char* FallbackTable::getName(FallbackValue::Id id)
+    {
+        return sFallbackNames[id];
+    }
+}
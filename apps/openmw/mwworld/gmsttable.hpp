@@ -0,0 +1,196 @@
+#ifndef GAME_MWWORLD_GMSTTABLE_H
+#define GAME_MWWORLD_GMSTTABLE_H
+
+#include <string>
+
+#include <components/esm/loadgmst.hpp>
+
+namespace Fallback
+{
+    class Map;
+}
+
+namespace MWWorld
+{
+    template <class T>
+    class Store;
+
+    /// Handles for game settings that are queried on hot paths (combat, AI, spellcasting, movement).
+    /// \note Keep in sync with the name table in gmsttable.cpp.
+    namespace GMST
+    {
+        enum Id
+        {
+            fAlarmRadius,
+            fBlockStillBonus,
+            fCombatBlockLeftAngle,
+            fCombatBlockRightAngle,
+            fCombatCriticalStrikeMult,
+            fCombatDelayCreature,
+            fCombatDelayNPC,
+            fCombatDistance,
+            fCombatInvisoMult,
+            fCombatKODamageMult,
+            fCrimeStealing,
+            fDamageStrengthBase,
+            fDamageStrengthMult,
+            fDispAttacking,
+            fDispPickPocketMod,
+            fDispStealing,
+            fEndFatigueMult,
+            fFallAcroBase,
+            fFallAcroMult,
+            fFallDamageDistanceMin,
+            fFallDistanceBase,
+            fFallDistanceMult,
+            fFatigueAttackBase,
+            fFatigueAttackMult,
+            fFatigueBlockBase,
+            fFatigueBlockMult,
+            fFatigueJumpBase,
+            fFatigueJumpMult,
+            fFatigueReturnBase,
+            fFatigueReturnMult,
+            fFightStealing,
+            fHandToHandReach,
+            fHandtoHandHealthPer,
+            fHoldBreathTime,
+            fIdleChanceMultiplier,
+            fInteriorHeadTrackMult,
+            fLevelMod,
+            fLuckMod,
+            fMajorSkillBonus,
+            fMaxHandToHandMult,
+            fMaxHeadTrackDistance,
+            fMinHandToHandMult,
+            fMinorSkillBonus,
+            fMiscSkillBonus,
+            fNPCbaseMagickaMult,
+            fPCbaseMagickaMult,
+            fPersonalityMod,
+            fProjectileMaxSpeed,
+            fProjectileMinSpeed,
+            fProjectileThrownStoreChance,
+            fReputationMod,
+            fRestMagicMult,
+            fSneakUseDelay,
+            fSneakUseDist,
+            fSpecialSkillBonus,
+            fSwingBlockBase,
+            fSwingBlockMult,
+            fThrownWeaponMaxSpeed,
+            fThrownWeaponMinSpeed,
+            fUnarmoredBase1,
+            fUnarmoredBase2,
+            fVoiceIdleOdds,
+            fWeaponDamageMult,
+            fWeaponFatigueBlockMult,
+            fWeaponFatigueMult,
+            fWereWolfSilverWeaponDamageMult,
+            iBlockMaxChance,
+            iBlockMinChance,
+            iCrimeAttack,
+            iCrimeKilling,
+            iCrimePickPocket,
+            iCrimeTresspass,
+            iDispAttackMod,
+            iDispKilling,
+            iDispTresspass,
+            iFightAttack,
+            iFightAttacking,
+            iFightKilling,
+            iFightPickpocket,
+            iFightTrespass,
+            iGreetDistanceMultiplier,
+            iVoiceAttackOdds,
+            iVoiceHitOdds,
+
+            Count
+        };
+    }
+
+    /// Handles for fallback values that are queried on hot paths.
+    /// \note Keep in sync with the name table in gmsttable.cpp.
+    namespace FallbackValue
+    {
+        enum Id
+        {
+            General_Werewolf_FOV,
+            LightAttenuation_LinearRadiusMult,
+            LightAttenuation_LinearValue,
+            LightAttenuation_OutQuadInLin,
+            LightAttenuation_QuadraticRadiusMult,
+            LightAttenuation_QuadraticValue,
+            LightAttenuation_UseLinear,
+            LightAttenuation_UseQuadratic,
+
+            Count
+        };
+    }
+
+    /// \brief Precomputed GMST values with O(1) typed access through GMST::Id handles.
+    ///
+    /// Avoids the string map lookup of Store<ESM::GameSetting>::find on frequently used settings.
+    /// Refreshed by ESMStore::setUp.
+    class GmstTable
+    {
+            float mFloats[GMST::Count];
+            int mInts[GMST::Count];
+            bool mNumeric[GMST::Count];
+            const ESM::GameSetting* mRecords[GMST::Count];
+
+            const ESM::GameSetting& getSlow(GMST::Id id) const;
+            ///< Throws an exception if the handle could not be resolved.
+
+        public:
+
+            GmstTable();
+
+            void setUp(const Store<ESM::GameSetting>& store);
+            ///< Resolve all handles. In debug builds, missing GMSTs are reported.
+
+            static const char* getName(GMST::Id id);
+
+            bool has(GMST::Id id) const { return mRecords[id] != 0; }
+
+            /// @note Throws an exception if the GMST is missing or not of type int or float.
+            float getFloat(GMST::Id id) const
+            {
+                if (!mNumeric[id])
+                    return getSlow(id).getFloat();
+                return mFloats[id];
+            }
+
+            /// @note Throws an exception if the GMST is missing or not of type int or float.
+            int getInt(GMST::Id id) const
+            {
+                if (!mNumeric[id])
+                    return getSlow(id).getInt();
+                return mInts[id];
+            }
+
+            /// @note Throws an exception if the GMST is missing or not of type string.
+            std::string getString(GMST::Id id) const;
+    };
+
+    /// \brief Parsed fallback values with O(1) typed access through FallbackValue::Id handles.
+    class FallbackTable
+    {
+            float mFloats[FallbackValue::Count];
+            bool mBools[FallbackValue::Count];
+
+        public:
+
+            FallbackTable();
+
+            void setUp(const Fallback::Map& fallback);
+
+            static const char* getName(FallbackValue::Id id);
+
+            float getFloat(FallbackValue::Id id) const { return mFloats[id]; }
+
+            bool getBool(FallbackValue::Id id) const { return mBools[id]; }
+    };
+}
+
+#endif
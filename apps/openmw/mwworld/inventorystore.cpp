@@ -768,6 +768,7 @@ MWWorld::ContainerStoreIterator MWWorld::InventoryStore::unequipItemQuantity(con
         {
             iter->getRefData().setCount(iter->getRefData().getCount() + count);
             item.getRefData().setCount(item.getRefData().getCount() - count);
+            flagAsModified();
             return iter;
         }
     }
@@ -788,6 +789,8 @@ void MWWorld::InventoryStore::setInvListener(InventoryStoreListener *listener, c
 
 void MWWorld::InventoryStore::fireEquipmentChangedEvent(const Ptr& actor)
 {
+    flagContentsChanged();
+
     if (!mUpdatesEnabled)
         return;
     if (mListener)
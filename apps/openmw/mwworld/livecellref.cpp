@@ -11,8 +11,14 @@
 #include "class.hpp"
 #include "esmstore.hpp"
 
-MWWorld::LiveCellRefBase::LiveCellRefBase(const std::string& type, const ESM::CellRef &cref)
-  : mClass(&Class::get(type)), mRef(cref), mData(cref)
+unsigned int MWWorld::allocateRefTypeIndex()
+{
+    static unsigned int sNextIndex = 0;
+    return sNextIndex++;
+}
+
+MWWorld::LiveCellRefBase::LiveCellRefBase(unsigned int type, unsigned int typeIndex, const ESM::CellRef &cref)
+  : mClass(&Class::get(typeIndex)), mType(type), mRef(cref), mData(cref)
 {
 }
 
@@ -18,11 +18,26 @@ namespace MWWorld
     class ESMStore;
     class Class;
 
+    unsigned int allocateRefTypeIndex();
+    ///< Only to be used through getRefTypeIndex().
+
+    /// Dense index of the referenceable record type \a X, used for array-indexed class lookup.
+    template <typename X>
+    unsigned int getRefTypeIndex()
+    {
+        static const unsigned int sIndex = allocateRefTypeIndex();
+        return sIndex;
+    }
+
     /// Used to create pointers to hold any type of LiveCellRef<> object.
     struct LiveCellRefBase
     {
         const Class *mClass;
 
+        /// Record type of the base object (X::sRecordId of LiveCellRef<X>). Allows Ptr::get<X>() to
+        /// check the type without a dynamic_cast.
+        unsigned int mType;
+
         /** Information about this instance, such as 3D location and rotation
          * and individual type-dependent data.
          */
@@ -31,7 +46,7 @@ namespace MWWorld
         /** runtime-data */
         RefData mData;
 
-        LiveCellRefBase(const std::string& type, const ESM::CellRef &cref=ESM::CellRef());
+        LiveCellRefBase(unsigned int type, unsigned int typeIndex, const ESM::CellRef &cref=ESM::CellRef());
         /* Need this for the class to be recognized as polymorphic */
         virtual ~LiveCellRefBase() { }
 
@@ -77,11 +92,11 @@ namespace MWWorld
     struct LiveCellRef : public LiveCellRefBase
     {
         LiveCellRef(const ESM::CellRef& cref, const X* b = NULL)
-            : LiveCellRefBase(typeid(X).name(), cref), mBase(b)
+            : LiveCellRefBase(X::sRecordId, getRefTypeIndex<X>(), cref), mBase(b)
         {}
 
         LiveCellRef(const X* b = NULL)
-            : LiveCellRefBase(typeid(X).name()), mBase(b)
+            : LiveCellRefBase(X::sRecordId, getRefTypeIndex<X>()), mBase(b)
         {}
 
         // The object that this instance is based on.
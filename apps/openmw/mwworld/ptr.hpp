@@ -47,8 +47,11 @@ namespace MWWorld
             template<typename T>
             MWWorld::LiveCellRef<T> *get() const
             {
-                MWWorld::LiveCellRef<T> *ref = dynamic_cast<MWWorld::LiveCellRef<T>*>(mRef);
-                if(ref) return ref;
+                if(mRef && mRef->mType == T::sRecordId)
+                {
+                    assert(dynamic_cast<MWWorld::LiveCellRef<T>*>(mRef));
+                    return static_cast<MWWorld::LiveCellRef<T>*>(mRef);
+                }
 
                 std::stringstream str;
                 str<< "Bad LiveCellRef cast to "<<typeid(T).name()<<" from ";
@@ -123,8 +126,11 @@ namespace MWWorld
         template<typename T>
         const MWWorld::LiveCellRef<T> *get() const
         {
-            const MWWorld::LiveCellRef<T> *ref = dynamic_cast<const MWWorld::LiveCellRef<T>*>(mRef);
-            if(ref) return ref;
+            if(mRef && mRef->mType == T::sRecordId)
+            {
+                assert(dynamic_cast<const MWWorld::LiveCellRef<T>*>(mRef));
+                return static_cast<const MWWorld::LiveCellRef<T>*>(mRef);
+            }
 
             std::stringstream str;
             str<< "Bad LiveCellRef cast to "<<typeid(T).name()<<" from ";
@@ -0,0 +1,312 @@
+#ifndef GAME_MWWORLD_REFPOOL_H
+#define GAME_MWWORLD_REFPOOL_H
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MWWorld
+{
+    /// \brief Append-only sequence that stores its elements in a small number of contiguous chunks.
+    ///
+    /// Elements are never moved once inserted, so pointers and references to them (and therefore
+    /// Ptrs) stay valid until the element is erased or the pool is cleared. Iteration follows
+    /// insertion order. Erasing an element leaves a hole that is skipped during iteration.
+    ///
+    /// \note Holes are never filled, as that would break the iteration order. Their memory is only
+    /// reclaimed by clear(), when the pool is copied, or when the pool is empty on push_back().
+    /// CellRefList only erases references that a content file or saved game deletes while the
+    /// cell is loaded, so the wasted memory is bounded by the references loaded into the cell.
+    template<typename T>
+    class RefPool
+    {
+            enum
+            {
+                FirstChunkCapacity = 4,
+                MaxChunkCapacity = 256
+            };
+
+            struct Chunk
+            {
+                T* mData;
+                std::vector<unsigned char> mAlive;
+                std::size_t mSize;
+
+                explicit Chunk (std::size_t capacity)
+                : mData (static_cast<T*> (::operator new (capacity * sizeof (T)))), mAlive (capacity, 0), mSize (0)
+                {}
+
+                ~Chunk()
+                {
+                    for (std::size_t i=0; i<mSize; ++i)
+                        if (mAlive[i])
+                            mData[i].~T();
+
+                    ::operator delete (mData);
+                }
+
+                std::size_t getCapacity() const { return mAlive.size(); }
+
+            private:
+                Chunk (const Chunk&);
+                Chunk& operator= (const Chunk&);
+            };
+
+            std::vector<Chunk*> mChunks;
+            std::size_t mCount;
+
+            bool isEnd (std::size_t chunk, std::size_t offset) const
+            {
+                return mChunks.empty() || (chunk+1==mChunks.size() && offset==mChunks[chunk]->mSize);
+            }
+
+            bool isAlive (std::size_t chunk, std::size_t offset) const
+            {
+                return mChunks[chunk]->mAlive[offset]!=0;
+            }
+
+            T *getElement (std::size_t chunk, std::size_t offset) const
+            {
+                return mChunks[chunk]->mData + offset;
+            }
+
+            /// Move to the next slot, then skip erased slots.
+            void increment (std::size_t& chunk, std::size_t& offset) const
+            {
+                do
+                {
+                    ++offset;
+
+                    if (offset==mChunks[chunk]->mSize && chunk+1<mChunks.size())
+                    {
+                        ++chunk;
+                        offset = 0;
+                    }
+                }
+                while (!isEnd (chunk, offset) && !isAlive (chunk, offset));
+            }
+
+            /// Move to the previous live slot.
+            void decrement (std::size_t& chunk, std::size_t& offset) const
+            {
+                do
+                {
+                    if (offset==0)
+                        offset = mChunks[--chunk]->mSize;
+
+                    --offset;
+                }
+                while (!isAlive (chunk, offset));
+            }
+
+        public:
+
+            template<typename Value>
+            class IteratorBase
+            {
+                    friend class RefPool;
+                    template<typename> friend class IteratorBase;
+
+                    const RefPool *mPool;
+                    std::size_t mChunk;
+                    std::size_t mOffset;
+
+                    IteratorBase (const RefPool *pool, std::size_t chunk, std::size_t offset)
+                    : mPool (pool), mChunk (chunk), mOffset (offset)
+                    {}
+
+                public:
+
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef Value value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef Value *pointer;
+                    typedef Value& reference;
+
+                    IteratorBase() : mPool (0), mChunk (0), mOffset (0) {}
+
+                    /// Also allows conversion from iterator to const_iterator.
+                    IteratorBase (const IteratorBase<typename std::remove_const<Value>::type>& iter)
+                    : mPool (iter.mPool), mChunk (iter.mChunk), mOffset (iter.mOffset)
+                    {}
+
+                    Value& operator*() const
+                    {
+                        return *mPool->getElement (mChunk, mOffset);
+                    }
+
+                    Value *operator->() const
+                    {
+                        return mPool->getElement (mChunk, mOffset);
+                    }
+
+                    IteratorBase& operator++()
+                    {
+                        mPool->increment (mChunk, mOffset);
+                        return *this;
+                    }
+
+                    IteratorBase operator++ (int)
+                    {
+                        IteratorBase iter (*this);
+                        ++*this;
+                        return iter;
+                    }
+
+                    IteratorBase& operator--()
+                    {
+                        mPool->decrement (mChunk, mOffset);
+                        return *this;
+                    }
+
+                    IteratorBase operator-- (int)
+                    {
+                        IteratorBase iter (*this);
+                        --*this;
+                        return iter;
+                    }
+
+                    template<typename Other>
+                    bool operator== (const IteratorBase<Other>& iter) const
+                    {
+                        return mPool==iter.mPool && mChunk==iter.mChunk && mOffset==iter.mOffset;
+                    }
+
+                    template<typename Other>
+                    bool operator!= (const IteratorBase<Other>& iter) const
+                    {
+                        return !(*this==iter);
+                    }
+            };
+
+            typedef T value_type;
+            typedef IteratorBase<T> iterator;
+            typedef IteratorBase<const T> const_iterator;
+
+            RefPool() : mCount (0) {}
+
+            RefPool (const RefPool& pool) : mCount (0)
+            {
+                try
+                {
+                    for (const_iterator iter (pool.begin()); iter!=pool.end(); ++iter)
+                        push_back (*iter);
+                }
+                catch (...)
+                {
+                    clear();
+                    throw;
+                }
+            }
+
+            RefPool& operator= (const RefPool& pool)
+            {
+                if (this!=&pool)
+                {
+                    RefPool copy (pool);
+                    mChunks.swap (copy.mChunks);
+                    std::swap (mCount, copy.mCount);
+                }
+
+                return *this;
+            }
+
+            ~RefPool()
+            {
+                clear();
+            }
+
+            iterator begin()
+            {
+                iterator iter (this, 0, 0);
+
+                if (!isEnd (0, 0) && !isAlive (0, 0))
+                    ++iter;
+
+                return iter;
+            }
+
+            const_iterator begin() const
+            {
+                return const_cast<RefPool *> (this)->begin();
+            }
+
+            iterator end()
+            {
+                if (mChunks.empty())
+                    return iterator (this, 0, 0);
+
+                return iterator (this, mChunks.size()-1, mChunks.back()->mSize);
+            }
+
+            const_iterator end() const
+            {
+                return const_cast<RefPool *> (this)->end();
+            }
+
+            bool empty() const { return mCount==0; }
+
+            std::size_t size() const { return mCount; }
+            ///< Number of live elements.
+
+            T& front() { return *begin(); }
+
+            const T& front() const { return *begin(); }
+
+            T& back() { return *--end(); }
+
+            const T& back() const { return *--end(); }
+
+            void push_back (const T& value)
+            {
+                // Nothing refers to the slots of an empty pool anymore
+                if (mCount==0 && !mChunks.empty())
+                    clear();
+
+                if (mChunks.empty() || mChunks.back()->mSize==mChunks.back()->getCapacity())
+                {
+                    std::size_t capacity = mChunks.empty() ? FirstChunkCapacity : 2 * mChunks.back()->getCapacity();
+
+                    if (capacity>MaxChunkCapacity)
+                        capacity = MaxChunkCapacity;
+
+                    mChunks.reserve (mChunks.size()+1);
+                    mChunks.push_back (new Chunk (capacity));
+                }
+
+                Chunk& chunk = *mChunks.back();
+                new (chunk.mData + chunk.mSize) T (value);
+                chunk.mAlive[chunk.mSize] = 1;
+                ++chunk.mSize;
+                ++mCount;
+            }
+
+            iterator erase (iterator iter)
+            {
+                iterator next (iter);
+                ++next;
+
+                Chunk& chunk = *mChunks[iter.mChunk];
+                chunk.mData[iter.mOffset].~T();
+                chunk.mAlive[iter.mOffset] = 0;
+                --mCount;
+
+                return next;
+            }
+            ///< Destroy the element at \a iter. Iterators to other elements remain valid.
+
+            void clear()
+            {
+                for (typename std::vector<Chunk*>::iterator iter (mChunks.begin()); iter!=mChunks.end(); ++iter)
+                    delete *iter;
+
+                mChunks.clear();
+                mCount = 0;
+            }
+    };
+}
+
+#endif
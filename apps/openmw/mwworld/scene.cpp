@@ -5,6 +5,7 @@
 
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/resourcehelpers.hpp>
+#include <components/misc/trace.hpp>
 #include <components/settings/settings.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -215,6 +216,8 @@ namespace MWWorld
 
     void Scene::update (float duration, bool paused)
     {
+        Misc::ScopedTrace trace("Scene::update");
+
         mPreloadTimer += duration;
         if (mPreloadTimer > 0.1f)
         {
@@ -229,6 +232,8 @@ namespace MWWorld
 
     void Scene::unloadCell (CellStoreCollection::iterator iter)
     {
+        Misc::ScopedTrace trace("Scene::unloadCell");
+
         std::cout << "Unloading cell\n";
         ListAndResetObjectsVisitor visitor;
 
@@ -259,10 +264,15 @@ namespace MWWorld
 
         MWBase::Environment::get().getSoundManager()->stopSound (*iter);
         mActiveCells.erase(*iter);
+
+        mRefIdCache.clear();
+        mActorIdCache.clear();
     }
 
     void Scene::loadCell (CellStore *cell, Loading::Listener* loadingListener, bool respawn)
     {
+        Misc::ScopedTrace trace("Scene::loadCell");
+
         std::pair<CellStoreCollection::iterator, bool> result = mActiveCells.insert(cell);
 
         if(result.second)
@@ -278,10 +288,14 @@ namespace MWWorld
                 int cellX = cell->getCell()->getGridX();
                 int cellY = cell->getCell()->getGridY();
                 osg::ref_ptr<const ESMTerrain::LandObject> land = mRendering.getLandManager()->getLand(cellX, cellY);
-                const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : 0;
-                if (data)
+                if (land && land->getQuantizedHeights())
                 {
-                    mPhysics->addHeightField (data->mHeights, cellX, cell->getCell()->getGridY(), worldsize / (verts-1), verts, data->mMinHeight, data->mMaxHeight, land.get());
+                    // The heightfield uses the shared land data directly, no need to convert back to floats
+                    mPhysics->addHeightField (land->getQuantizedHeights(), ESM::Land::HEIGHT_SCALE, cellX, cellY, worldsize / (verts-1), verts, land->getMinHeight(), land->getMaxHeight(), land.get());
+                }
+                else if (land && land->getHeights())
+                {
+                    mPhysics->addHeightField (land->getHeights(), cellX, cellY, worldsize / (verts-1), verts, land->getMinHeight(), land->getMaxHeight(), land.get());
                 }
                 else
                 {
@@ -354,6 +368,8 @@ namespace MWWorld
 
     void Scene::changeCellGrid (int X, int Y, bool changeEvent)
     {
+        Misc::ScopedTrace trace("Scene::changeCellGrid");
+
         Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         Loading::ScopedLoad load(loadingListener);
 
@@ -516,6 +532,8 @@ namespace MWWorld
 
     void Scene::changeToInteriorCell (const std::string& cellName, const ESM::Position& position, bool adjustPlayerPos, bool changeEvent)
     {
+        Misc::ScopedTrace trace("Scene::changeToInteriorCell");
+
         CellStore *cell = MWBase::Environment::get().getWorld()->getInterior(cellName);
         bool loadcell = (mCurrentCell == NULL);
         if(!loadcell)
@@ -642,12 +660,48 @@ namespace MWWorld
         return false;
     }
 
+    Ptr Scene::searchPtr (const std::string& name)
+    {
+        std::unordered_map<std::string, CellStore*>::iterator cached = mRefIdCache.find (name);
+        if (cached!=mRefIdCache.end())
+        {
+            if (mActiveCells.find (cached->second)!=mActiveCells.end())
+                if (Ptr ptr = cached->second->search (name))
+                    return ptr;
+
+            mRefIdCache.erase (cached);
+        }
+
+        for (CellStoreCollection::const_iterator iter (mActiveCells.begin());
+            iter!=mActiveCells.end(); ++iter)
+            if (Ptr ptr = (*iter)->search (name))
+            {
+                mRefIdCache[name] = *iter;
+                return ptr;
+            }
+
+        return Ptr();
+    }
+
     Ptr Scene::searchPtrViaActorId (int actorId)
     {
+        std::unordered_map<int, CellStore*>::iterator cached = mActorIdCache.find (actorId);
+        if (cached!=mActorIdCache.end())
+        {
+            if (mActiveCells.find (cached->second)!=mActiveCells.end())
+                if (Ptr ptr = cached->second->searchViaActorId (actorId))
+                    return ptr;
+
+            mActorIdCache.erase (cached);
+        }
+
         for (CellStoreCollection::const_iterator iter (mActiveCells.begin());
             iter!=mActiveCells.end(); ++iter)
             if (Ptr ptr = (*iter)->searchViaActorId (actorId))
+            {
+                mActorIdCache[actorId] = *iter;
                 return ptr;
+            }
 
         return Ptr();
     }
@@ -660,6 +714,8 @@ namespace MWWorld
         {
         }
 
+        virtual const char* getName() const { return "PreloadMeshItem"; }
+
         virtual void doWork()
         {
             try
@@ -6,6 +6,8 @@
 
 #include <set>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace osg
 {
@@ -71,6 +73,11 @@ namespace MWWorld
 
             osg::Vec3f mLastPlayerPos;
 
+            // Active cell a reference was last found in, by lower case refId and by actor ID.
+            // Entries are verified on use and dropped when a cell is unloaded.
+            std::unordered_map<std::string, CellStore*> mRefIdCache;
+            std::unordered_map<int, CellStore*> mActorIdCache;
+
             void insertCell (CellStore &cell, bool rescale, Loading::Listener* loadingListener);
 
             // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
@@ -133,6 +140,10 @@ namespace MWWorld
 
             bool isCellActive(const CellStore &cell);
 
+            Ptr searchPtr (const std::string& name);
+            ///< Search active cells for an accessible reference with the given lower case refId.
+            /// Does not check references in containers.
+
             Ptr searchPtrViaActorId (int actorId);
 
             void preload(const std::string& mesh, bool useAnim=false);
@@ -6,6 +6,8 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
@@ -120,8 +122,34 @@ namespace MWWorld
 
     template<typename T>
     Store<T>::Store(const Store<T>& orig)
-        : mStatic(orig.mStatic)
     {
+        // copies the static records only
+        typename std::vector<T *>::const_iterator it = orig.mShared.begin();
+        typename std::vector<T *>::const_iterator end = it + std::min(orig.mShared.size(), orig.mStatic.size());
+        for (; it != end; ++it) {
+            insertStatic(**it);
+        }
+    }
+
+    template<typename T>
+    int Store<T>::addRecord(const T &record)
+    {
+        if (mFreeSlots.empty()) {
+            mRecords.push_back(record);
+            return static_cast<int>(mRecords.size()) - 1;
+        }
+
+        int slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        mRecords[slot] = record;
+        return slot;
+    }
+
+    template<typename T>
+    void Store<T>::freeRecord(int slot)
+    {
+        mRecords[slot] = T();
+        mFreeSlots.push_back(slot);
     }
 
     template<typename T>
@@ -130,32 +158,44 @@ namespace MWWorld
         // remove the dynamic part of mShared
         assert(mShared.size() >= mStatic.size());
         mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
+
+        std::vector<std::pair<Misc::InternedId, int> > dynamic;
+        mDynamic.list(dynamic);
+        for (std::vector<std::pair<Misc::InternedId, int> >::const_iterator it = dynamic.begin(); it != dynamic.end(); ++it) {
+            freeRecord(it->second);
+        }
         mDynamic.clear();
     }
 
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
+        // IDs that have not been interned do not belong to any record
+        Misc::InternedId key;
+        if (!Misc::InternedId::search(id, key))
+            return 0;
 
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end()) {
-            return &dit->second;
+        return search(key);
+    }
+    template<typename T>
+    const T *Store<T>::search(const Misc::InternedId &id) const
+    {
+        int slot = mDynamic.search(id);
+        if (slot == -1) {
+            slot = mStatic.search(id);
         }
 
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
-            return &(it->second);
+        if (slot == -1) {
+            return 0;
         }
 
-        return 0;
+        return &mRecords[slot];
     }
     template<typename T>
     bool Store<T>::isDynamic(const std::string &id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        return (dit != mDynamic.end());
+        Misc::InternedId key;
+        return Misc::InternedId::search(id, key) && mDynamic.search(key) != -1;
     }
     template<typename T>
     const T *Store<T>::searchRandom(const std::string &id) const
@@ -178,6 +218,17 @@ namespace MWWorld
         return ptr;
     }
     template<typename T>
+    const T *Store<T>::find(const Misc::InternedId &id) const
+    {
+        const T *ptr = search(id);
+        if (ptr == 0) {
+            std::ostringstream msg;
+            msg << T::getRecordType() << " '" << id.str() << "' not found";
+            throw std::runtime_error(msg.str());
+        }
+        return ptr;
+    }
+    template<typename T>
     const T *Store<T>::findRandom(const std::string &id) const
     {
         const T *ptr = searchRandom(id);
@@ -198,11 +249,15 @@ namespace MWWorld
         record.load(esm, isDeleted);
         Misc::StringUtils::lowerCaseInPlace(record.mId);
 
-        std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
-        if (inserted.second)
-            mShared.push_back(&inserted.first->second);
+        Misc::InternedId id(record.mId);
+        int slot = mStatic.search(id);
+        if (slot == -1) {
+            slot = addRecord(record);
+            mStatic.insert(id, slot);
+            mShared.push_back(&mRecords[slot]);
+        }
         else
-            inserted.first->second = record;
+            mRecords[slot] = record;
 
         return RecordId(record.mId, isDeleted);
     }
@@ -245,51 +300,54 @@ namespace MWWorld
     template<typename T>
     T *Store<T>::insert(const T &item)
     {
-        std::string id = Misc::StringUtils::lowerCase(item.mId);
-        std::pair<typename Dynamic::iterator, bool> result =
-            mDynamic.insert(std::pair<std::string, T>(id, item));
-        T *ptr = &result.first->second;
-        if (result.second) {
-            mShared.push_back(ptr);
+        Misc::InternedId id(item.mId);
+        int slot = mDynamic.search(id);
+        if (slot == -1) {
+            slot = addRecord(item);
+            mDynamic.insert(id, slot);
+            mShared.push_back(&mRecords[slot]);
         } else {
-            *ptr = item;
+            mRecords[slot] = item;
         }
-        return ptr;
+        return &mRecords[slot];
     }
     template<typename T>
     T *Store<T>::insertStatic(const T &item)
     {
-        std::string id = Misc::StringUtils::lowerCase(item.mId);
-        std::pair<typename Static::iterator, bool> result =
-            mStatic.insert(std::pair<std::string, T>(id, item));
-        T *ptr = &result.first->second;
-        if (result.second) {
-            mShared.push_back(ptr);
+        Misc::InternedId id(item.mId);
+        int slot = mStatic.search(id);
+        if (slot == -1) {
+            slot = addRecord(item);
+            mStatic.insert(id, slot);
+            mShared.push_back(&mRecords[slot]);
         } else {
-            *ptr = item;
+            mRecords[slot] = item;
         }
-        return ptr;
+        return &mRecords[slot];
     }
     template<typename T>
     bool Store<T>::eraseStatic(const std::string &id)
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
+        Misc::InternedId key;
+        if (!Misc::InternedId::search(id, key))
+            return true;
 
-        typename std::map<std::string, T>::iterator it = mStatic.find(idLower);
+        int slot = mStatic.search(key);
 
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
+        if (slot != -1) {
             // delete from the static part of mShared
             typename std::vector<T *>::iterator sharedIter = mShared.begin();
             typename std::vector<T *>::iterator end = sharedIter + mStatic.size();
 
             while (sharedIter != mShared.end() && sharedIter != end) {
-                if((*sharedIter)->mId == idLower) {
+                if(*sharedIter == &mRecords[slot]) {
                     mShared.erase(sharedIter);
                     break;
                 }
                 ++sharedIter;
             }
-            mStatic.erase(it);
+            mStatic.erase(key);
+            freeRecord(slot);
         }
 
         return true;
@@ -298,19 +356,24 @@ namespace MWWorld
     template<typename T>
     bool Store<T>::erase(const std::string &id)
     {
-        std::string key = Misc::StringUtils::lowerCase(id);
-        typename Dynamic::iterator it = mDynamic.find(key);
-        if (it == mDynamic.end()) {
+        Misc::InternedId key;
+        if (!Misc::InternedId::search(id, key))
+            return false;
+
+        int slot = mDynamic.erase(key);
+        if (slot == -1) {
             return false;
         }
-        mDynamic.erase(it);
 
-        // have to reinit the whole shared part
+        // delete from the dynamic part of mShared, keeping the order of the remaining records
         assert(mShared.size() >= mStatic.size());
-        mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
-        for (it = mDynamic.begin(); it != mDynamic.end(); ++it) {
-            mShared.push_back(&it->second);
+        typename std::vector<T *>::iterator sharedIter =
+            std::find(mShared.begin() + mStatic.size(), mShared.end(), &mRecords[slot]);
+        if (sharedIter != mShared.end()) {
+            mShared.erase(sharedIter);
         }
+
+        freeRecord(slot);
         return true;
     }
     template<typename T>
@@ -321,11 +384,13 @@ namespace MWWorld
     template<typename T>
     void Store<T>::write (ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
-        for (typename Dynamic::const_iterator iter (mDynamic.begin()); iter!=mDynamic.end();
+        // the dynamic records, in the order they were inserted in
+        assert(mShared.size() >= mStatic.size());
+        for (typename std::vector<T *>::const_iterator iter (mShared.begin() + mStatic.size()); iter!=mShared.end();
              ++iter)
         {
             writer.startRecord (T::sRecordId);
-            iter->second.save (writer);
+            (*iter)->save (writer);
             writer.endRecord (T::sRecordId);
         }
     }
@@ -1032,19 +1097,22 @@ namespace MWWorld
     template<>
     void Store<ESM::Dialogue>::setUp()
     {
+        std::vector<std::pair<Misc::InternedId, int> > dialogues;
+        mStatic.list(dialogues);
+
+        // ordered by ID, as in the original engine
+        std::sort(dialogues.begin(), dialogues.end());
+
         // DialInfos marked as deleted are kept during the loading phase, so that the linked list
         // structure is kept intact for inserting further INFOs. Delete them now that loading is done.
-        for (Static::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+        mShared.clear();
+        mShared.reserve(dialogues.size());
+        for (std::vector<std::pair<Misc::InternedId, int> >::const_iterator it = dialogues.begin(); it != dialogues.end(); ++it)
         {
-            ESM::Dialogue& dial = it->second;
+            ESM::Dialogue& dial = mRecords[it->second];
             dial.clearDeletedInfos();
-        }
 
-        mShared.clear();
-        mShared.reserve(mStatic.size());
-        std::map<std::string, ESM::Dialogue>::iterator it = mStatic.begin();
-        for (; it != mStatic.end(); ++it) {
-            mShared.push_back(&(it->second));
+            mShared.push_back(&dial);
         }
     }
 
@@ -1056,17 +1124,17 @@ namespace MWWorld
 
         dialogue.loadId(esm);
 
-        std::string idLower = Misc::StringUtils::lowerCase(dialogue.mId);
-        std::map<std::string, ESM::Dialogue>::iterator found = mStatic.find(idLower);
-        if (found == mStatic.end())
+        Misc::InternedId id(dialogue.mId);
+        int slot = mStatic.search(id);
+        if (slot == -1)
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+            mStatic.insert(id, addRecord(dialogue));
         }
         else
         {
-            found->second.loadData(esm, isDeleted);
-            dialogue = found->second;
+            mRecords[slot].loadData(esm, isDeleted);
+            dialogue = mRecords[slot];
         }
 
         return RecordId(dialogue.mId, isDeleted);
@@ -4,8 +4,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
+
+#include <components/misc/internedid.hpp>
 
 #include "recordcmp.hpp"
+#include "storeindex.hpp"
 
 namespace ESM
 {
@@ -138,17 +142,22 @@ namespace MWWorld
     template <class T>
     class Store : public StoreBase
     {
-        std::map<std::string, T>      mStatic;
+        std::deque<T>       mRecords; // Static and dynamic records, in blocks of contiguous memory. Records are
+                                      // never moved, so pointers to them stay valid until they are erased.
+        std::vector<int>    mFreeSlots; // Positions in mRecords of erased records, to be reused
+        StoreIndex          mStatic;
         std::vector<T *>    mShared; // Preserves the record order as it came from the content files (this
                                      // is relevant for the spell autocalc code and selection order
                                      // for heads/hairs in the character creation)
-        std::map<std::string, T> mDynamic;
-
-        typedef std::map<std::string, T> Dynamic;
-        typedef std::map<std::string, T> Static;
+        StoreIndex          mDynamic;
 
         friend class ESMStore;
 
+        /// \return Position of the record in mRecords
+        int addRecord(const T &record);
+
+        void freeRecord(int slot);
+
     public:
         Store();
         Store(const Store<T> &orig);
@@ -161,6 +170,9 @@ namespace MWWorld
 
         const T *search(const std::string &id) const;
 
+        /// Same as search(const std::string&), without having to fold the case of the ID.
+        const T *search(const Misc::InternedId &id) const;
+
         /**
          * Does the record with this ID come from the dynamic store?
          */
@@ -171,6 +183,8 @@ namespace MWWorld
 
         const T *find(const std::string &id) const;
 
+        const T *find(const Misc::InternedId &id) const;
+
         /** Returns a random record that starts with the named ID. An exception is thrown if none
          * are found. */
         const T *findRandom(const std::string &id) const;
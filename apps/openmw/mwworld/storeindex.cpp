@@ -0,0 +1,138 @@
+#include "storeindex.hpp"
+
+#include <stdint.h>
+
+namespace MWWorld
+{
+    std::size_t StoreIndex::getBucket(const Misc::InternedId& id) const
+    {
+        // the hash of an InternedId is an address, whose low bits are all the same
+        uint64_t hash = id.hash();
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+
+        return static_cast<std::size_t>(hash) & (mEntries.size() - 1);
+    }
+
+    void StoreIndex::rehash(std::size_t capacity)
+    {
+        std::vector<Entry> entries;
+        entries.swap(mEntries);
+
+        Entry empty;
+        empty.mSlot = Slot_Empty;
+        mEntries.resize(capacity, empty);
+        mUsed = mSize;
+
+        for (std::vector<Entry>::const_iterator iter = entries.begin(); iter != entries.end(); ++iter)
+        {
+            if (iter->mSlot < 0)
+                continue;
+
+            std::size_t bucket = getBucket(iter->mId);
+            while (mEntries[bucket].mSlot != Slot_Empty)
+                bucket = (bucket + 1) & (mEntries.size() - 1);
+
+            mEntries[bucket] = *iter;
+        }
+    }
+
+    StoreIndex::StoreIndex()
+        : mSize(0), mUsed(0)
+    {
+    }
+
+    int StoreIndex::search(const Misc::InternedId& id) const
+    {
+        if (mEntries.empty())
+            return -1;
+
+        for (std::size_t bucket = getBucket(id); ; bucket = (bucket + 1) & (mEntries.size() - 1))
+        {
+            const Entry& entry = mEntries[bucket];
+
+            if (entry.mSlot == Slot_Empty)
+                return -1;
+
+            if (entry.mSlot != Slot_Erased && entry.mId == id)
+                return entry.mSlot;
+        }
+    }
+
+    bool StoreIndex::insert(const Misc::InternedId& id, int slot)
+    {
+        if (search(id) != -1)
+            return false;
+
+        // keep at least half of the entries empty, so that probe sequences stay short
+        if ((mUsed + 1) * 2 > mEntries.size())
+        {
+            std::size_t capacity = 16;
+            while ((mSize + 1) * 4 > capacity)
+                capacity *= 2;
+
+            rehash(capacity);
+        }
+
+        std::size_t bucket = getBucket(id);
+        while (mEntries[bucket].mSlot >= 0)
+            bucket = (bucket + 1) & (mEntries.size() - 1);
+
+        if (mEntries[bucket].mSlot == Slot_Empty)
+            ++mUsed;
+
+        mEntries[bucket].mId = id;
+        mEntries[bucket].mSlot = slot;
+        ++mSize;
+
+        return true;
+    }
+
+    int StoreIndex::erase(const Misc::InternedId& id)
+    {
+        if (mEntries.empty())
+            return -1;
+
+        for (std::size_t bucket = getBucket(id); ; bucket = (bucket + 1) & (mEntries.size() - 1))
+        {
+            Entry& entry = mEntries[bucket];
+
+            if (entry.mSlot == Slot_Empty)
+                return -1;
+
+            if (entry.mSlot != Slot_Erased && entry.mId == id)
+            {
+                int slot = entry.mSlot;
+
+                // later entries of the probe sequence must still be found
+                entry.mSlot = Slot_Erased;
+                entry.mId = Misc::InternedId();
+                --mSize;
+
+                return slot;
+            }
+        }
+    }
+
+    std::size_t StoreIndex::size() const
+    {
+        return mSize;
+    }
+
+    void StoreIndex::clear()
+    {
+        mEntries.clear();
+        mSize = 0;
+        mUsed = 0;
+    }
+
+    void StoreIndex::list(std::vector<std::pair<Misc::InternedId, int> >& list) const
+    {
+        list.reserve(list.size() + mSize);
+
+        for (std::vector<Entry>::const_iterator iter = mEntries.begin(); iter != mEntries.end(); ++iter)
+            if (iter->mSlot >= 0)
+                list.push_back(std::make_pair(iter->mId, iter->mSlot));
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef OPENMW_MWWORLD_STOREINDEX_H
+#define OPENMW_MWWORLD_STOREINDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <components/misc/internedid.hpp>
+
+namespace MWWorld
+{
+    /// \brief Hash map from record IDs to the positions of the records in a Store
+    ///
+    /// Uses open addressing with linear probing, so that a lookup usually touches a single
+    /// cache line. Since the IDs are interned, comparing them does not look at the characters.
+    class StoreIndex
+    {
+            struct Entry
+            {
+                Misc::InternedId mId;
+                int mSlot; ///< Slot_Empty, Slot_Erased or the position of the record
+            };
+
+            enum
+            {
+                Slot_Empty = -1,
+                Slot_Erased = -2
+            };
+
+            std::vector<Entry> mEntries; ///< size is 0 or a power of 2
+            std::size_t mSize;
+            std::size_t mUsed; ///< entries that are not empty, including erased ones
+
+            std::size_t getBucket(const Misc::InternedId& id) const;
+
+            void rehash(std::size_t capacity);
+
+        public:
+
+            StoreIndex();
+
+            /// \return Position of the record, or -1 if there is none with this ID.
+            int search(const Misc::InternedId& id) const;
+
+            /// \return Has the ID been added? IDs that are already in the index are left unchanged.
+            bool insert(const Misc::InternedId& id, int slot);
+
+            /// \return Position of the removed record, or -1 if there is none with this ID.
+            int erase(const Misc::InternedId& id);
+
+            std::size_t size() const;
+
+            void clear();
+
+            /// Append all IDs with the positions of their records to \a list, in no particular order.
+            void list(std::vector<std::pair<Misc::InternedId, int> >& list) const;
+    };
+}
+
+#endif
@@ -9,10 +9,12 @@
 
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/trace.hpp>
 
 #include <components/files/collections.hpp>
 
 #include <components/resource/resourcesystem.hpp>
+#include <components/resource/bulletshapemanager.hpp>
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 
@@ -147,7 +149,7 @@ namespace MWWorld
         const std::vector<std::string>& contentFiles,
         ToUTF8::Utf8Encoder* encoder, const std::map<std::string,std::string>& fallbackMap,
         int activationDistanceOverride, const std::string& startCell, const std::string& startupScript,
-            const std::string& resourcePath, const std::string& userDataPath)
+            const std::string& resourcePath, const std::string& userDataPath, const std::string& cachePath)
     : mResourceSystem(resourceSystem), mFallback(fallbackMap), mPlayer (0), mLocalScripts (mStore),
       mSky (true), mCells (mStore, mEsm),
       mGodMode(false), mScriptsEnabled(true), mContentFiles (contentFiles), mUserDataPath(userDataPath),
@@ -155,7 +157,13 @@ namespace MWWorld
       mStartCell (startCell), mDistanceToFacedObject(-1), mTeleportEnabled(true),
       mLevitationEnabled(true), mGoToJail(false), mDaysInPrison(0), mSpellPreloadTimer(0.f)
     {
+        mFallbackTable.setUp(mFallback);
+
         mPhysics = new MWPhysics::PhysicsSystem(resourceSystem, rootNode);
+
+        int shapeCacheSize = std::max(0, Settings::Manager::getInt("shape cache size", "Cells"));
+        mPhysics->getShapeManager()->setFileCache(cachePath + "/shapes", static_cast<std::uint64_t>(shapeCacheSize) * 1024 * 1024);
+
         mRendering = new MWRender::RenderingManager(viewer, rootNode, resourceSystem, workQueue, &mFallback, resourcePath);
         mProjectileManager.reset(new ProjectileManager(mRendering->getLightRoot(), resourceSystem, mRendering, mPhysics));
 
@@ -526,6 +534,11 @@ namespace MWWorld
         return &mFallback;
     }
 
+    const FallbackTable& World::getFallbackTable() const
+    {
+        return mFallbackTable;
+    }
+
     CellStore *World::getExterior (int x, int y)
     {
         return mCells.getExterior (x, y);
@@ -649,16 +662,9 @@ namespace MWWorld
 
         std::string lowerCaseName = Misc::StringUtils::lowerCase(name);
 
-        for (Scene::CellStoreCollection::const_iterator iter (mWorldScene->getActiveCells().begin());
-            iter!=mWorldScene->getActiveCells().end(); ++iter)
-        {
-            // TODO: caching still doesn't work efficiently here (only works for the one CellStore that the reference is in)
-            CellStore* cellstore = *iter;
-            Ptr ptr = mCells.getPtr (lowerCaseName, *cellstore, false);
-
-            if (!ptr.isEmpty())
-                return ptr;
-        }
+        ret = mWorldScene->searchPtr (lowerCaseName);
+        if (!ret.isEmpty())
+            return ret;
 
         if (!activeOnly)
         {
@@ -1435,6 +1441,8 @@ namespace MWWorld
 
     void World::doPhysics(float duration)
     {
+        Misc::ScopedTrace trace("World::doPhysics");
+
         mPhysics->stepSimulation(duration);
         processDoors(duration);
 
@@ -1660,7 +1668,7 @@ namespace MWWorld
         bool isFirstPerson = mRendering->getCamera()->isFirstPerson();
         if (isWerewolf && isFirstPerson)
         {
-            float werewolfFov = mFallback.getFallbackFloat("General_Werewolf_FOV");
+            float werewolfFov = mFallbackTable.getFloat(FallbackValue::General_Werewolf_FOV);
             if (werewolfFov != 0)
                 mRendering->overrideFieldOfView(werewolfFov);
             MWBase::Environment::get().getWindowManager()->setWerewolfOverlay(true);
@@ -2787,7 +2795,7 @@ namespace MWWorld
 
         if (!target.isEmpty() && target.getClass().isActor() && target.getClass().getCreatureStats (target).getAiSequence().isInCombat()) 
         {
-            distance = std::min (distance, getStore().get<ESM::GameSetting>().find("fCombatDistance")->getFloat());
+            distance = std::min (distance, getStore().getGmsts().getFloat(GMST::fCombatDistance));
             if (distance < dist1)
                 target = NULL;
         }
@@ -3003,6 +3011,8 @@ namespace MWWorld
 
     void World::updateWeather(float duration, bool paused)
     {
+        Misc::ScopedTrace trace("World::updateWeather");
+
         if (mPlayer->wasTeleported())
         {
             mPlayer->setTeleported(false);
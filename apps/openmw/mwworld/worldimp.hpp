@@ -74,6 +74,7 @@ namespace MWWorld
             Resource::ResourceSystem* mResourceSystem;
 
             Fallback::Map mFallback;
+            FallbackTable mFallbackTable;
             MWRender::RenderingManager* mRendering;
 
             MWWorld::WeatherManager* mWeatherManager;
@@ -187,7 +188,8 @@ namespace MWWorld
                 const Files::Collections& fileCollections,
                 const std::vector<std::string>& contentFiles,
                 ToUTF8::Utf8Encoder* encoder, const std::map<std::string,std::string>& fallbackMap,
-                int activationDistanceOverride, const std::string& startCell, const std::string& startupScript, const std::string& resourcePath, const std::string& userDataPath);
+                int activationDistanceOverride, const std::string& startCell, const std::string& startupScript, const std::string& resourcePath, const std::string& userDataPath,
+                const std::string& cachePath);
 
             virtual ~World();
 
@@ -222,6 +224,8 @@ namespace MWWorld
 
             virtual const Fallback::Map *getFallback() const;
 
+            virtual const FallbackTable& getFallbackTable() const;
+
             virtual Player& getPlayer();
             virtual MWWorld::Ptr getPlayerPtr();
 
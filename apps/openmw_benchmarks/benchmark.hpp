@@ -0,0 +1,35 @@
+#ifndef OPENMW_BENCHMARKS_BENCHMARK_H
+#define OPENMW_BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace Benchmark
+{
+    /// @brief Prints the time that passed during its lifetime
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const std::string& name)
+            : mName(name), mBegin(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - mBegin;
+            std::cout << mName << ": " << duration.count() << " ms" << std::endl;
+        }
+
+    private:
+        std::string mName;
+        std::chrono::steady_clock::time_point mBegin;
+    };
+
+    /// @return Did the benchmark get the expected results?
+    bool storeSearch();
+    bool keywordSearch();
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include <set>
+#include <string>
+#include <vector>
+
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwdialogue/keywordsearch.hpp"
+
+#include "../benchmark.hpp"
+
+namespace
+{
+    /// Random words over a small alphabet, so that keywords often overlap and share prefixes and suffixes
+    std::string randomWords(unsigned int& seed, std::size_t words)
+    {
+        static const char alphabet[] = "abcAB";
+        std::string result;
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if (i > 0)
+                result += (seed % 7 == 0) ? "-" : " ";
+            std::size_t length = 1 + seed % 4;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                seed = seed * 1103515245 + 12345;
+                result += alphabet[(seed >> 16) % 5];
+            }
+            seed = seed * 1103515245 + 12345;
+        }
+        return result;
+    }
+}
+
+namespace Benchmark
+{
+    /// A few thousand topics, as known in a late game, highlighted in a text of journal size.
+    bool keywordSearch()
+    {
+        typedef MWDialogue::KeywordSearch<std::string, int> KeywordSearchT;
+
+        unsigned int seed = 7;
+
+        KeywordSearchT search;
+        std::set<std::string> keywords;
+        for (std::size_t i = 0; keywords.size() < 3000 && i < 30000; ++i)
+        {
+            std::string keyword = Misc::StringUtils::lowerCase(randomWords(seed, 1 + (seed >> 8) % 4));
+            if (keywords.insert(keyword).second)
+                search.seed(keyword, static_cast<int>(keywords.size()));
+        }
+
+        std::string text = randomWords(seed, 2000);
+
+        const int repetitions = 50;
+        std::vector<KeywordSearchT::Match> matches;
+        std::vector<KeywordSearchT::Match> firstMatches;
+
+        {
+            ScopedTimer timer("Keyword search, 50 texts of 2000 words against 3000 keywords");
+            for (int i = 0; i < repetitions; ++i)
+            {
+                matches.clear();
+                search.highlightKeywords(text.begin(), text.end(), matches);
+                if (i == 0)
+                    firstMatches = matches;
+            }
+        }
+
+        return !matches.empty() && matches.size() == firstMatches.size();
+    }
+}
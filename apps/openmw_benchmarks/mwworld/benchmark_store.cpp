@@ -0,0 +1,58 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <components/esm/loadstat.hpp>
+
+#include "apps/openmw/mwworld/store.hpp"
+
+#include "../benchmark.hpp"
+
+namespace Benchmark
+{
+    /// Lookups in a store of the size of the largest ones in Morrowind.esm.
+    bool storeSearch()
+    {
+        typedef ESM::Static RecordType;
+
+        MWWorld::Store<RecordType> store;
+
+        const int records = 3000;
+        std::vector<std::string> ids;
+
+        for (int i=0; i<records; ++i)
+        {
+            std::ostringstream id;
+            id << "Ex_Common_Record_" << i;
+            ids.push_back(id.str());
+
+            RecordType record;
+            record.blank();
+            record.mId = id.str();
+            store.insertStatic(record);
+        }
+
+        std::vector<Misc::InternedId> internedIds(ids.begin(), ids.end());
+
+        const int repetitions = 200;
+        int found = 0;
+
+        {
+            ScopedTimer timer("Store search by string, 600000 lookups");
+            for (int i=0; i<repetitions; ++i)
+                for (std::vector<std::string>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+                    if (store.search(*it))
+                        ++found;
+        }
+
+        {
+            ScopedTimer timer("Store search by interned ID, 600000 lookups");
+            for (int i=0; i<repetitions; ++i)
+                for (std::vector<Misc::InternedId>::const_iterator it = internedIds.begin(); it != internedIds.end(); ++it)
+                    if (store.search(*it))
+                        ++found;
+        }
+
+        return found == 2 * repetitions * records;
+    }
+}
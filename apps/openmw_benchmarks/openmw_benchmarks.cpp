@@ -0,0 +1,21 @@
+#include <iostream>
+
+#include "benchmark.hpp"
+
+/// Times hot code paths of the engine on synthetic data. The benchmarks are not part of the unit tests, as
+/// their results depend on the machine they run on.
+int main()
+{
+    bool success = true;
+
+    success = Benchmark::storeSearch() && success;
+    success = Benchmark::keywordSearch() && success;
+
+    if (!success)
+    {
+        std::cerr << "Error: A benchmark got unexpected results" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+#include <osg/Image>
+
+#include "components/esm/loadland.hpp"
+#include "components/esm/loadltex.hpp"
+#include "components/esmterrain/storage.hpp"
+#include "components/misc/resourcehelpers.hpp"
+#include "components/vfs/manager.hpp"
+
+namespace
+{
+    typedef std::pair<short, short> TextureId;
+
+    /// Serves synthetic land: some cells have no land, and the cells come from different plugins.
+    class TestStorage : public ESMTerrain::Storage
+    {
+    public:
+        TestStorage(const VFS::Manager* vfs)
+            : ESMTerrain::Storage(vfs)
+        {
+        }
+
+        virtual osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY)
+        {
+            const ESM::Land* land = getLandRecord(cellX, cellY);
+            if (!land)
+                return NULL;
+            return new ESMTerrain::LandObject(land, ESM::Land::DATA_VTEX, ESMTerrain::LandObject::Data_Shared);
+        }
+
+        virtual const ESM::LandTexture* getLandTexture(int index, short plugin)
+        {
+            std::unique_ptr<ESM::LandTexture>& texture = mTextures[TextureId(index, plugin)];
+            if (!texture)
+            {
+                texture.reset(new ESM::LandTexture);
+                texture->mIndex = index;
+                std::ostringstream name;
+                name << "tx_" << index << "_" << plugin << ".dds";
+                texture->mTexture = name.str();
+            }
+            return texture.get();
+        }
+
+        virtual void getBounds(float& minX, float& maxX, float& minY, float& maxY)
+        {
+            minX = minY = -4;
+            maxX = maxY = 4;
+        }
+
+        const ESM::Land* getLandRecord(int cellX, int cellY)
+        {
+            if ((cellX + 2 * cellY) % 5 == 0)
+                return NULL;
+
+            std::unique_ptr<ESM::Land>& land = mLands[std::make_pair(cellX, cellY)];
+            if (!land)
+            {
+                land.reset(new ESM::Land);
+                land->mX = cellX;
+                land->mY = cellY;
+                land->mPlugin = (cellX & 1) + (cellY & 1);
+                // Creates the data storage, as nothing is available to load yet
+                land->loadData(ESM::Land::DATA_VTEX);
+                land->mDataTypes = ESM::Land::DATA_VTEX;
+
+                ESM::Land::LandData* data = land->getLandData();
+                for (int i = 0; i < ESM::Land::LAND_NUM_TEXTURES; ++i)
+                {
+                    int x = i % ESM::Land::LAND_TEXTURE_SIZE;
+                    int y = i / ESM::Land::LAND_TEXTURE_SIZE;
+                    // Patches of textures, including the base texture, that differ between the cells
+                    data->mTextures[i] = static_cast<uint16_t>(((x / 3 + y / 5 + cellX + cellY * 3) % 6 + 6) % 6);
+                }
+                data->mDataLoaded = ESM::Land::DATA_VTEX;
+            }
+            return land.get();
+        }
+
+    private:
+        std::map<std::pair<int, int>, std::unique_ptr<ESM::Land> > mLands;
+        std::map<TextureId, std::unique_ptr<ESM::LandTexture> > mTextures;
+    };
+
+    struct EsmTerrainStorageTest : public ::testing::Test
+    {
+        VFS::Manager mVFS;
+        TestStorage mStorage;
+
+        EsmTerrainStorageTest()
+            : mVFS(false)
+            , mStorage(&mVFS)
+        {
+        }
+
+        /// The texture of a blendmap texel, looked up on its own.
+        TextureId getExpectedTexture(int cellX, int cellY, int x, int y)
+        {
+            // Blendmaps are shifted by one texel, and the first column comes from the western neighbour
+            --x;
+            while (x < 0)
+            {
+                --cellX;
+                x += ESM::Land::LAND_TEXTURE_SIZE;
+            }
+            while (x >= ESM::Land::LAND_TEXTURE_SIZE)
+            {
+                ++cellX;
+                x -= ESM::Land::LAND_TEXTURE_SIZE;
+            }
+            while (y >= ESM::Land::LAND_TEXTURE_SIZE)
+            {
+                ++cellY;
+                y -= ESM::Land::LAND_TEXTURE_SIZE;
+            }
+
+            const ESM::Land* land = mStorage.getLandRecord(cellX, cellY);
+            if (!land)
+                return TextureId(0, 0);
+
+            int texture = land->getLandData()->mTextures[y * ESM::Land::LAND_TEXTURE_SIZE + x];
+            if (texture == 0)
+                return TextureId(0, 0);
+            return TextureId(texture, land->mPlugin);
+        }
+
+        std::string getTextureName(const TextureId& id)
+        {
+            if (id.first == 0)
+                return "textures\\_land_default.dds";
+            return Misc::ResourceHelpers::correctTexturePath(mStorage.getLandTexture(id.first - 1, id.second)->mTexture, &mVFS);
+        }
+
+        void checkBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, bool pack)
+        {
+            SCOPED_TRACE(testing::Message() << "size " << chunkSize << " center " << chunkCenter.x() << ","
+                         << chunkCenter.y() << (pack ? " packed" : " unpacked"));
+
+            ESMTerrain::Storage::ImageVector blendmaps;
+            std::vector<Terrain::LayerInfo> layers;
+            mStorage.getBlendmaps(chunkSize, chunkCenter, pack, blendmaps, layers);
+
+            osg::Vec2f origin = chunkCenter - osg::Vec2f(chunkSize / 2.f, chunkSize / 2.f);
+            int cellX = static_cast<int>(std::floor(origin.x()));
+            int cellY = static_cast<int>(std::floor(origin.y()));
+            int rowStart = static_cast<int>((origin.x() - cellX) * (ESM::Land::LAND_TEXTURE_SIZE + 1));
+            int colStart = static_cast<int>((origin.y() - cellY) * (ESM::Land::LAND_TEXTURE_SIZE + 1));
+            int size = static_cast<int>(ESM::Land::LAND_TEXTURE_SIZE * chunkSize + 1);
+
+            // The base texture always comes first, the others are sorted by ID
+            std::set<TextureId> textures;
+            textures.insert(TextureId(0, 0));
+            for (int y = 0; y < size; ++y)
+                for (int x = 0; x < size; ++x)
+                    textures.insert(getExpectedTexture(cellX, cellY, x + rowStart, y + colStart));
+
+            std::vector<TextureId> sorted(textures.begin(), textures.end());
+            ASSERT_EQ(sorted.size(), layers.size());
+            for (std::size_t i = 0; i < sorted.size(); ++i)
+                EXPECT_EQ(getTextureName(sorted[i]), layers[i].mDiffuseMap);
+
+            int channels = pack ? 4 : 1;
+            std::size_t numBlendmaps = pack ? (sorted.size() - 1 + 3) / 4 : sorted.size() - 1;
+            ASSERT_EQ(numBlendmaps, blendmaps.size());
+
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    TextureId id = getExpectedTexture(cellX, cellY, x + rowStart, y + colStart);
+                    int layer = static_cast<int>(std::lower_bound(sorted.begin(), sorted.end(), id) - sorted.begin());
+
+                    // Blendmaps are flipped vertically
+                    int offset = ((size - y - 1) * size + x) * channels;
+                    for (std::size_t blendmap = 0; blendmap < blendmaps.size(); ++blendmap)
+                    {
+                        for (int channel = 0; channel < channels; ++channel)
+                        {
+                            int blendLayer = static_cast<int>(blendmap) * channels + channel + 1;
+                            int expected = layer == blendLayer ? 255 : 0;
+                            ASSERT_EQ(expected, blendmaps[blendmap]->data()[offset + channel])
+                                << "texel " << x << "," << y << " blendmap " << blendmap << " channel " << channel;
+                        }
+                    }
+                }
+            }
+        }
+    };
+}
+
+TEST_F(EsmTerrainStorageTest, blendmaps_match_the_textures_of_their_texels)
+{
+    const float sizes[] = { 0.125f, 0.25f, 0.5f, 1.f };
+    for (int i = 0; i < 4; ++i)
+    {
+        const float size = sizes[i];
+        for (float x = -2; x < 2; x += size)
+            for (float y = -2; y < 2; y += size)
+            {
+                osg::Vec2f center(x + size / 2, y + size / 2);
+                checkBlendmaps(size, center, false);
+                checkBlendmaps(size, center, true);
+                if (HasFatalFailure())
+                    return;
+            }
+    }
+}
+
+TEST_F(EsmTerrainStorageTest, missing_land_uses_base_texture)
+{
+    ASSERT_TRUE(mStorage.getLandRecord(0, 0) == NULL);
+    ASSERT_TRUE(mStorage.getLandRecord(-1, 0) != NULL);
+
+    // A chunk inside of a cell without land
+    ESMTerrain::Storage::ImageVector blendmaps;
+    std::vector<Terrain::LayerInfo> layers;
+    mStorage.getBlendmaps(0.125f, osg::Vec2f(0.5f, 0.5f), true, blendmaps, layers);
+
+    ASSERT_EQ(1u, layers.size());
+    EXPECT_EQ("textures\\_land_default.dds", layers[0].mDiffuseMap);
+    EXPECT_TRUE(blendmaps.empty());
+}
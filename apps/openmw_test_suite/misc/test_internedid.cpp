@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "components/misc/internedid.hpp"
+
+TEST(InternedIdTest, ignores_case)
+{
+    Misc::InternedId id("Gold_001");
+
+    EXPECT_EQ("gold_001", id.str());
+    EXPECT_EQ(id, Misc::InternedId("GOLD_001"));
+    EXPECT_EQ(id.hash(), Misc::InternedId("gold_001").hash());
+    EXPECT_NE(id, Misc::InternedId("gold_005"));
+}
+
+TEST(InternedIdTest, empty)
+{
+    EXPECT_TRUE(Misc::InternedId().empty());
+    EXPECT_EQ(Misc::InternedId(), Misc::InternedId(""));
+    EXPECT_FALSE(Misc::InternedId("a").empty());
+}
+
+TEST(InternedIdTest, search_does_not_intern)
+{
+    Misc::InternedId result("unchanged");
+
+    EXPECT_FALSE(Misc::InternedId::search("interned_id_test_unknown", result));
+    EXPECT_EQ(Misc::InternedId("unchanged"), result);
+
+    // still unknown
+    EXPECT_FALSE(Misc::InternedId::search("Interned_Id_Test_Unknown", result));
+
+    Misc::InternedId id("Interned_Id_Test_Known");
+
+    EXPECT_TRUE(Misc::InternedId::search("interned_id_test_KNOWN", result));
+    EXPECT_EQ(id, result);
+}
+
+namespace
+{
+    std::vector<std::string> makeIds(const std::string& prefix, int count)
+    {
+        std::vector<std::string> ids;
+        for (int i = 0; i < count; ++i)
+        {
+            std::ostringstream id;
+            id << prefix << i;
+            ids.push_back(id.str());
+        }
+        return ids;
+    }
+}
+
+TEST(InternedIdTest, search_finds_ids_after_the_table_grew)
+{
+    const std::vector<std::string> ids = makeIds("Interned_Id_Test_Growth_", 5000);
+    std::vector<Misc::InternedId> interned(ids.begin(), ids.end());
+
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        Misc::InternedId result;
+        ASSERT_TRUE(Misc::InternedId::search(ids[i], result)) << ids[i];
+        ASSERT_EQ(interned[i], result);
+        ASSERT_EQ(interned[i], Misc::InternedId(ids[i]));
+    }
+}
+
+TEST(InternedIdTest, search_while_interning_on_another_thread)
+{
+    const std::vector<std::string> known = makeIds("Interned_Id_Test_Known_", 1000);
+    const std::vector<Misc::InternedId> interned(known.begin(), known.end());
+
+    // Makes the table grow while this thread searches it
+    std::thread interner([] ()
+    {
+        const std::vector<std::string> ids = makeIds("Interned_Id_Test_Concurrent_", 20000);
+        std::vector<Misc::InternedId> concurrent(ids.begin(), ids.end());
+    });
+
+    std::size_t mismatches = 0;
+    for (int repetition = 0; repetition < 20; ++repetition)
+        for (std::size_t i = 0; i < known.size(); ++i)
+        {
+            Misc::InternedId result;
+            if (!Misc::InternedId::search(known[i], result) || result != interned[i])
+                ++mismatches;
+        }
+
+    interner.join();
+
+    EXPECT_EQ(0u, mismatches);
+}
+
+TEST(InternedIdTest, orders_by_lower_case_string)
+{
+    EXPECT_TRUE(Misc::InternedId("b") < Misc::InternedId("C"));
+    EXPECT_TRUE(Misc::InternedId("B") < Misc::InternedId("c"));
+    EXPECT_FALSE(Misc::InternedId("c") < Misc::InternedId("C"));
+}
+
+TEST(InternedIdTest, hash_map_key)
+{
+    std::unordered_map<Misc::InternedId, int> map;
+    map[Misc::InternedId("Fargoth")] = 1;
+    map[Misc::InternedId("fargoth")] = 2;
+
+    ASSERT_EQ(1u, map.size());
+    EXPECT_EQ(2, map[Misc::InternedId("FARGOTH")]);
+}
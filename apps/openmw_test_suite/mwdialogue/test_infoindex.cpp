@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <components/esm/loaddial.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwdialogue/infoindex.hpp"
+
+namespace
+{
+    /// The speaker conditions of Filter::testActor, without rank and gender.
+    bool testSpeaker (const ESM::DialInfo& info, const MWDialogue::InfoIndex::Speaker& speaker)
+    {
+        if (!info.mActor.empty())
+        {
+            if (!Misc::StringUtils::ciEqual (info.mActor, speaker.mId))
+                return false;
+        }
+        else if (!speaker.mIsNpc)
+            return false;
+
+        if (!speaker.mIsNpc)
+            return true;
+
+        if (!info.mRace.empty() && !Misc::StringUtils::ciEqual (info.mRace, speaker.mRace))
+            return false;
+
+        if (!info.mClass.empty() && !Misc::StringUtils::ciEqual (info.mClass, speaker.mClass))
+            return false;
+
+        if (info.mFactionLess)
+            return speaker.mFaction.empty();
+
+        return info.mFaction.empty() || Misc::StringUtils::ciEqual (info.mFaction, speaker.mFaction);
+    }
+
+    std::vector<const ESM::DialInfo *> scan (const ESM::Dialogue& dialogue, const MWDialogue::InfoIndex::Speaker& speaker)
+    {
+        std::vector<const ESM::DialInfo *> infos;
+        for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
+            if (testSpeaker (*iter, speaker))
+                infos.push_back (&*iter);
+        return infos;
+    }
+
+    /// Filter the candidates of the index, as Filter does.
+    std::vector<const ESM::DialInfo *> filterCandidates (const MWDialogue::InfoIndex& index,
+        const MWDialogue::InfoIndex::Speaker& speaker)
+    {
+        std::vector<const ESM::DialInfo *> candidates = index.getCandidates (speaker);
+        std::vector<const ESM::DialInfo *> infos;
+        for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin(); iter!=candidates.end(); ++iter)
+            if (testSpeaker (**iter, speaker))
+                infos.push_back (*iter);
+        return infos;
+    }
+
+    MWDialogue::InfoIndex::Speaker makeSpeaker (const std::string& id, bool isNpc, const std::string& race = "",
+        const std::string& class_ = "", const std::string& faction = "")
+    {
+        MWDialogue::InfoIndex::Speaker speaker;
+        speaker.mId = id;
+        speaker.mIsNpc = isNpc;
+        speaker.mRace = race;
+        speaker.mClass = class_;
+        speaker.mFaction = faction;
+        return speaker;
+    }
+}
+
+TEST(InfoIndexTest, candidates_match_unfiltered_scan)
+{
+    const char* actors[] = { "", "fargoth", "Mudcrab" };
+    const char* races[] = { "", "Wood Elf", "dark elf" };
+    const char* classes[] = { "", "Commoner", "guard" };
+    const char* factions[] = { "", "Hlaalu", "redoran" };
+
+    // Every combination of speaker conditions, with and without the faction-less flag
+    ESM::Dialogue dialogue;
+    for (int actor = 0; actor < 3; ++actor)
+        for (int race = 0; race < 3; ++race)
+            for (int class_ = 0; class_ < 3; ++class_)
+                for (int faction = 0; faction < 4; ++faction)
+                {
+                    ESM::DialInfo info;
+                    info.mActor = actors[actor];
+                    info.mRace = races[race];
+                    info.mClass = classes[class_];
+                    info.mFactionLess = faction == 3;
+                    info.mFaction = faction < 3 ? factions[faction] : "";
+                    dialogue.mInfo.push_back (info);
+                }
+
+    MWDialogue::InfoIndex index (dialogue);
+
+    std::vector<MWDialogue::InfoIndex::Speaker> speakers;
+    speakers.push_back (makeSpeaker ("Fargoth", true, "wood elf", "commoner", "Hlaalu"));
+    speakers.push_back (makeSpeaker ("fargoth", true, "Wood Elf", "Commoner"));
+    speakers.push_back (makeSpeaker ("guard", true, "Dark Elf", "Guard", "Redoran"));
+    speakers.push_back (makeSpeaker ("nobody", true, "Breton", "", "Telvanni"));
+    speakers.push_back (makeSpeaker ("nobody", true));
+    speakers.push_back (makeSpeaker ("mudcrab", false));
+    speakers.push_back (makeSpeaker ("rat", false));
+
+    for (std::vector<MWDialogue::InfoIndex::Speaker>::const_iterator iter = speakers.begin(); iter!=speakers.end(); ++iter)
+        EXPECT_EQ (scan (dialogue, *iter), filterCandidates (index, *iter)) << "speaker " << iter->mId;
+}
+
+TEST(InfoIndexTest, candidates_keep_original_order)
+{
+    ESM::Dialogue dialogue;
+
+    ESM::DialInfo info;
+    info.mFactionLess = false;
+    info.mClass = "commoner";
+    dialogue.mInfo.push_back (info);
+    info.mClass.clear();
+    info.mActor = "fargoth";
+    dialogue.mInfo.push_back (info);
+    info.mActor.clear();
+    dialogue.mInfo.push_back (info);
+    info.mRace = "wood elf";
+    dialogue.mInfo.push_back (info);
+
+    MWDialogue::InfoIndex index (dialogue);
+
+    std::vector<const ESM::DialInfo *> candidates =
+        index.getCandidates (makeSpeaker ("fargoth", true, "Wood Elf", "Commoner"));
+
+    std::vector<const ESM::DialInfo *> expected;
+    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
+        expected.push_back (&*iter);
+
+    EXPECT_EQ (expected, candidates);
+}
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+
+#include <set>
+
 #include "apps/openmw/mwdialogue/keywordsearch.hpp"
 
 struct KeywordSearchTest : public ::testing::Test
@@ -65,3 +68,248 @@ TEST_F(KeywordSearchTest, keyword_test_conflict_resolution3)
     ASSERT_TRUE (matches.size() == 1);
     ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "bar lock");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_case_insensitive)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("Vivec", 1);
+
+    std::string text = "the city of VIVEC";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 1);
+    ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "VIVEC");
+    ASSERT_TRUE (matches.front().mValue == 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_word_start)
+{
+    // keywords must start at the beginning of a word, but may end inside one
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("bar", 0);
+    search.seed("foo", 1);
+
+    std::string text = "foobar foos";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 2);
+    ASSERT_TRUE (matches[0].mBeg - text.begin() == 0);
+    ASSERT_TRUE (matches[1].mBeg - text.begin() == 7);
+    ASSERT_TRUE (matches[1].mValue == 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_prefixes)
+{
+    // the longest keyword starting at a position is chosen, regardless of the seeding order
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("ab", 0);
+    search.seed("abcd", 1);
+    search.seed("a", 2);
+    search.seed("abc", 3);
+
+    std::string text = "abc abcde ab a";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 4);
+    ASSERT_TRUE (matches[0].mValue == 3);
+    ASSERT_TRUE (matches[1].mValue == 1);
+    ASSERT_TRUE (matches[2].mValue == 0);
+    ASSERT_TRUE (matches[3].mValue == 2);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_reseed)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("dwemer", 0);
+
+    std::string text = "dwemer ruins";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_TRUE (matches.size() == 1);
+
+    search.seed("dwemer ruins", 1);
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_TRUE (matches.size() == 1);
+    ASSERT_TRUE (matches.front().mValue == 1);
+
+    search.clear();
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_TRUE (matches.empty());
+}
+
+TEST_F(KeywordSearchTest, keyword_test_contains)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("foo bar", 1);
+    search.seed("foo", 2);
+
+    int value = 0;
+    ASSERT_TRUE (search.containsKeyword("Foo Bar", value));
+    ASSERT_TRUE (value == 1);
+    ASSERT_TRUE (search.containsKeyword("foo", value));
+    ASSERT_TRUE (value == 2);
+    ASSERT_FALSE (search.containsKeyword("foo ba", value));
+    ASSERT_FALSE (search.containsKeyword("foo bar baz", value));
+
+    ASSERT_THROW (search.seed("foo", 3), std::runtime_error);
+}
+
+namespace
+{
+    typedef MWDialogue::KeywordSearch<std::string, int> KeywordSearchT;
+    typedef std::vector<std::pair<std::string, int> > KeywordList;
+
+    /// Straightforward implementation of the search, trying every keyword at every word start
+    void highlightReference(const KeywordList& keywords, const std::string& text, std::vector<KeywordSearchT::Match>& out)
+    {
+        std::vector<KeywordSearchT::Match> matches;
+        for (std::string::const_iterator i = text.begin(); i != text.end(); ++i)
+        {
+            if (i != text.begin() && isalpha(*(i - 1)))
+                continue;
+
+            const std::pair<std::string, int>* longest = NULL;
+            for (KeywordList::const_iterator it = keywords.begin(); it != keywords.end(); ++it)
+            {
+                std::size_t offset = i - text.begin();
+                if (offset + it->first.size() <= text.size()
+                    && Misc::StringUtils::ciEqual(text.substr(offset, it->first.size()), it->first)
+                    && (!longest || it->first.size() > longest->first.size()))
+                    longest = &*it;
+            }
+
+            if (longest)
+            {
+                KeywordSearchT::Match match;
+                match.mBeg = i;
+                match.mEnd = i + longest->first.size();
+                match.mValue = longest->second;
+                matches.push_back(match);
+            }
+        }
+
+        // pick the longest keyword of the first group of overlapping keywords until none are left
+        while (!matches.empty())
+        {
+            std::size_t last = 0;
+            while (last + 1 < matches.size() && matches[last].mEnd > matches[last + 1].mBeg)
+                ++last;
+
+            std::size_t chosen = 0;
+            for (std::size_t i = 1; i <= last; ++i)
+                if (matches[i].mEnd - matches[i].mBeg > matches[chosen].mEnd - matches[chosen].mBeg)
+                    chosen = i;
+
+            KeywordSearchT::Match keyword = matches[chosen];
+            out.push_back(keyword);
+
+            std::vector<KeywordSearchT::Match> remaining;
+            for (std::size_t i = 0; i < matches.size(); ++i)
+                if (i != chosen && !(matches[i].mBeg < keyword.mEnd && matches[i].mEnd > keyword.mBeg))
+                    remaining.push_back(matches[i]);
+            matches.swap(remaining);
+        }
+
+        std::sort(out.begin(), out.end(), KeywordSearchT::sortMatches);
+    }
+
+    /// Random words over a small alphabet, so that keywords often overlap and share prefixes and suffixes
+    std::string randomWords(unsigned int& seed, std::size_t words)
+    {
+        static const char alphabet[] = "abcAB";
+        std::string result;
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if (i > 0)
+                result += (seed % 7 == 0) ? "-" : " ";
+            std::size_t length = 1 + seed % 4;
+            for (std::size_t j = 0; j < length; ++j)
+            {
+                seed = seed * 1103515245 + 12345;
+                result += alphabet[(seed >> 16) % 5];
+            }
+            seed = seed * 1103515245 + 12345;
+        }
+        return result;
+    }
+
+    KeywordList randomKeywords(unsigned int& seed, std::size_t count, std::size_t maxWords)
+    {
+        KeywordList keywords;
+        std::set<std::string> used;
+        for (std::size_t i = 0; keywords.size() < count && i < count * 10; ++i)
+        {
+            std::string keyword = Misc::StringUtils::lowerCase(randomWords(seed, 1 + (seed >> 8) % maxWords));
+            if (used.insert(keyword).second)
+                keywords.push_back(std::make_pair(keyword, static_cast<int>(keywords.size())));
+        }
+        return keywords;
+    }
+
+    bool sameMatches(const std::vector<KeywordSearchT::Match>& left, const std::vector<KeywordSearchT::Match>& right)
+    {
+        if (left.size() != right.size())
+            return false;
+        for (std::size_t i = 0; i < left.size(); ++i)
+            if (left[i].mBeg != right[i].mBeg || left[i].mEnd != right[i].mEnd || left[i].mValue != right[i].mValue)
+                return false;
+        return true;
+    }
+}
+
+TEST_F(KeywordSearchTest, keyword_test_equivalence)
+{
+    unsigned int seed = 42;
+
+    for (int round = 0; round < 200; ++round)
+    {
+        KeywordList keywords = randomKeywords(seed, 1 + round % 20, 3);
+
+        KeywordSearchT search;
+        for (KeywordList::const_iterator it = keywords.begin(); it != keywords.end(); ++it)
+            search.seed(it->first, it->second);
+
+        for (int text = 0; text < 5; ++text)
+        {
+            std::string input = randomWords(seed, 30);
+
+            std::vector<KeywordSearchT::Match> expected;
+            highlightReference(keywords, input, expected);
+
+            std::vector<KeywordSearchT::Match> matches;
+            search.highlightKeywords(input.begin(), input.end(), matches);
+
+            ASSERT_TRUE (sameMatches(matches, expected)) << "text: " << input;
+        }
+    }
+}
+
+TEST_F(KeywordSearchTest, keyword_test_large_vocabulary)
+{
+    // a few thousand topics, as known in a late game, highlighted in a text of journal size
+    unsigned int seed = 7;
+    KeywordList keywords = randomKeywords(seed, 3000, 4);
+
+    KeywordSearchT search;
+    for (KeywordList::const_iterator it = keywords.begin(); it != keywords.end(); ++it)
+        search.seed(it->first, it->second);
+
+    std::string text = randomWords(seed, 2000);
+
+    std::vector<KeywordSearchT::Match> expected;
+    highlightReference(keywords, text, expected);
+
+    std::vector<KeywordSearchT::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (sameMatches(matches, expected));
+}
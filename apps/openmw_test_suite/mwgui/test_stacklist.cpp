@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "apps/openmw/mwgui/stacklist.hpp"
+
+namespace
+{
+    typedef MWGui::StackList<int, std::string> TestList;
+
+    /// Check that every stack is found at its index.
+    void expectConsistent(const TestList& list, const std::string* stacks, const int* keys, size_t size)
+    {
+        ASSERT_EQ(size, list.size());
+        for (size_t i = 0; i < size; ++i)
+        {
+            int index = list.find(keys[i]);
+            ASSERT_NE(-1, index);
+            EXPECT_EQ(stacks[i], list[index]);
+        }
+    }
+}
+
+TEST(StackListTest, add_stacks_in_order)
+{
+    TestList list;
+    list.set(1, "a");
+    list.set(2, "b");
+
+    ASSERT_EQ(2u, list.size());
+    EXPECT_EQ("a", list[0]);
+    EXPECT_EQ("b", list[1]);
+    EXPECT_EQ(-1, list.find(3));
+}
+
+TEST(StackListTest, set_replaces_existing_stack)
+{
+    TestList list;
+    list.set(1, "a");
+    list.set(2, "b");
+    list.set(1, "c");
+
+    ASSERT_EQ(2u, list.size());
+    EXPECT_EQ(0, list.find(1));
+    EXPECT_EQ("c", list[0]);
+}
+
+TEST(StackListTest, remove_moves_last_stack_into_gap)
+{
+    TestList list;
+    list.set(1, "a");
+    list.set(2, "b");
+    list.set(3, "c");
+    list.remove(1);
+
+    const int keys[] = { 2, 3 };
+    const std::string stacks[] = { "b", "c" };
+    expectConsistent(list, stacks, keys, 2);
+    EXPECT_EQ(-1, list.find(1));
+    EXPECT_EQ(0, list.find(3));
+}
+
+TEST(StackListTest, remove_last_and_unknown_stack)
+{
+    TestList list;
+    list.set(1, "a");
+    list.set(2, "b");
+    list.remove(2);
+    list.remove(5);
+
+    const int keys[] = { 1 };
+    const std::string stacks[] = { "a" };
+    expectConsistent(list, stacks, keys, 1);
+}
+
+TEST(StackListTest, incremental_updates_match_rebuild)
+{
+    TestList list;
+    std::map<int, std::string> expected;
+
+    // Random sets and removals, mirrored in a plain map
+    unsigned int seed = 42;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        int key = (seed >> 16) % 32;
+        if ((seed >> 8) % 3 == 0)
+        {
+            list.remove(key);
+            expected.erase(key);
+        }
+        else
+        {
+            std::string stack (1, 'a' + i % 26);
+            list.set(key, stack);
+            expected[key] = stack;
+        }
+    }
+
+    // Resync from scratch, as the model does when the store changed in other ways
+    TestList rebuilt;
+    for (std::map<int, std::string>::const_iterator it = expected.begin(); it != expected.end(); ++it)
+        rebuilt.set(it->first, it->second);
+
+    ASSERT_EQ(rebuilt.size(), list.size());
+
+    std::set<int> indices;
+    for (int key = 0; key < 32; ++key)
+    {
+        int index = list.find(key);
+        int rebuiltIndex = rebuilt.find(key);
+        ASSERT_EQ(rebuiltIndex == -1, index == -1) << "key " << key;
+        if (index == -1)
+            continue;
+
+        EXPECT_EQ(rebuilt[rebuiltIndex], list[index]) << "key " << key;
+        EXPECT_TRUE(indices.insert(index).second) << "key " << key;
+    }
+    EXPECT_EQ(list.size(), indices.size());
+}
+
+TEST(StackListTest, clear_removes_all_stacks)
+{
+    TestList list;
+    list.set(1, "a");
+    list.clear();
+
+    EXPECT_EQ(0u, list.size());
+    EXPECT_EQ(-1, list.find(1));
+
+    list.set(1, "b");
+    EXPECT_EQ(0, list.find(1));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "apps/openmw/mwmechanics/aischeduler.hpp"
+
+TEST(AiSchedulerTest, interval_grows_with_distance)
+{
+    MWMechanics::AiScheduler scheduler(1000.f, 4);
+
+    ASSERT_EQ(1u, scheduler.getInterval(0.f));
+    ASSERT_EQ(1u, scheduler.getInterval(1000.f));
+    ASSERT_EQ(2u, scheduler.getInterval(1500.f));
+    ASSERT_EQ(3u, scheduler.getInterval(2500.f));
+    ASSERT_EQ(4u, scheduler.getInterval(3500.f));
+    ASSERT_EQ(4u, scheduler.getInterval(100000.f));
+
+    // a distance of 0 disables the reduced rate
+    MWMechanics::AiScheduler fullRate(0.f, 4);
+    ASSERT_EQ(1u, fullRate.getInterval(100000.f));
+}
+
+TEST(AiSchedulerTest, distant_actors_get_accumulated_time)
+{
+    MWMechanics::AiScheduler scheduler(1000.f, 4);
+
+    MWMechanics::AiSchedule near;
+    MWMechanics::AiSchedule far;
+    MWMechanics::AiSchedule fighting;
+    scheduler.add(near);
+    scheduler.add(far);
+    scheduler.add(fighting);
+
+    int nearUpdates = 0;
+    int farUpdates = 0;
+    int fightingUpdates = 0;
+    float farTime = 0.f;
+
+    for (int i = 0; i < 40; ++i)
+    {
+        scheduler.frame();
+
+        float elapsed = 0.f;
+
+        if (scheduler.update(near, 500.f, false, 0.01f, elapsed))
+        {
+            ASSERT_FLOAT_EQ(0.01f, elapsed);
+            ++nearUpdates;
+        }
+
+        if (scheduler.update(far, 5000.f, false, 0.01f, elapsed))
+        {
+            ASSERT_GT(0.0401f, elapsed);
+            farTime += elapsed;
+            ++farUpdates;
+        }
+
+        if (scheduler.update(fighting, 5000.f, true, 0.01f, elapsed))
+            ++fightingUpdates;
+    }
+
+    ASSERT_EQ(40, nearUpdates);
+    ASSERT_EQ(10, farUpdates);
+    ASSERT_EQ(40, fightingUpdates);
+    // no time is lost, the rest is passed on with the next update
+    ASSERT_NEAR(0.4f, farTime + far.mElapsed, 0.001f);
+}
+
+TEST(AiSchedulerTest, updates_are_spread_over_frames)
+{
+    MWMechanics::AiScheduler scheduler(1000.f, 4);
+
+    std::vector<MWMechanics::AiSchedule> schedules(100);
+    for (std::size_t i = 0; i < schedules.size(); ++i)
+        scheduler.add(schedules[i]);
+
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        scheduler.frame();
+
+        int updates = 0;
+        for (std::size_t i = 0; i < schedules.size(); ++i)
+        {
+            float elapsed = 0.f;
+            if (scheduler.update(schedules[i], 5000.f, false, 0.01f, elapsed))
+                ++updates;
+        }
+
+        ASSERT_EQ(25, updates);
+    }
+}
+
+TEST(AiSchedulerTest, moving_actors_run_every_frame)
+{
+    MWMechanics::AiScheduler scheduler(1000.f, 4);
+
+    MWMechanics::AiSchedule walking;
+    scheduler.add(walking);
+
+    // a distant actor is skipped until its AI makes it walk
+    int updates = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        scheduler.frame();
+
+        float elapsed = 0.f;
+        if (scheduler.update(walking, 5000.f, false, 0.01f, elapsed))
+        {
+            walking.mMoving = true;
+            ++updates;
+        }
+    }
+    ASSERT_EQ(1, updates);
+
+    // then it keeps being updated, so that its movement is applied in every frame
+    for (int i = 0; i < 8; ++i)
+    {
+        scheduler.frame();
+
+        float elapsed = 0.f;
+        ASSERT_TRUE(scheduler.update(walking, 5000.f, false, 0.01f, elapsed));
+        ASSERT_FLOAT_EQ(0.01f, elapsed);
+    }
+
+    // until it stops
+    walking.mMoving = false;
+    updates = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        scheduler.frame();
+
+        float elapsed = 0.f;
+        if (scheduler.update(walking, 5000.f, false, 0.01f, elapsed))
+            ++updates;
+    }
+    ASSERT_EQ(2, updates);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <vector>
+
+#include <components/esm/loadmgef.hpp>
+#include <components/esm/loadskil.hpp>
+
+#include "apps/openmw/mwmechanics/magiceffects.hpp"
+
+using MWMechanics::EffectKey;
+using MWMechanics::EffectParam;
+using MWMechanics::MagicEffects;
+
+TEST(MagicEffectsTest, get_and_remove)
+{
+    MagicEffects effects;
+
+    ASSERT_EQ(0.f, effects.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_TRUE(effects.begin() == effects.end());
+
+    effects.add(ESM::MagicEffect::Shield, EffectParam(10.f));
+    effects.add(ESM::MagicEffect::Shield, EffectParam(5.f));
+    effects.add(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy), EffectParam(3.f));
+    effects.modifyBase(ESM::MagicEffect::Levitate, 2);
+
+    ASSERT_EQ(15.f, effects.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(3.f, effects.get(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy)).getMagnitude());
+    ASSERT_EQ(0.f, effects.get(ESM::MagicEffect::FortifySkill).getMagnitude());
+    ASSERT_EQ(2.f, effects.get(ESM::MagicEffect::Levitate).getMagnitude());
+    ASSERT_EQ(2, effects.get(ESM::MagicEffect::Levitate).getBase());
+
+    effects.remove(ESM::MagicEffect::Shield);
+    effects.remove(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy));
+
+    ASSERT_EQ(0.f, effects.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(0.f, effects.get(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy)).getMagnitude());
+    ASSERT_EQ(1, std::distance(effects.begin(), effects.end()));
+}
+
+TEST(MagicEffectsTest, iterates_in_key_order)
+{
+    MagicEffects effects;
+
+    effects.add(ESM::MagicEffect::Paralyze, EffectParam(1.f));
+    effects.add(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Sneak), EffectParam(2.f));
+    effects.add(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy), EffectParam(3.f));
+    effects.add(ESM::MagicEffect::FortifySkill, EffectParam(4.f));
+    effects.add(ESM::MagicEffect::WaterBreathing, EffectParam(0.f));
+
+    std::vector<std::pair<EffectKey, EffectParam> > entries(effects.begin(), effects.end());
+
+    ASSERT_EQ(5u, entries.size());
+    for (std::size_t i = 1; i < entries.size(); ++i)
+        ASSERT_TRUE(entries[i-1].first < entries[i].first);
+
+    // effects with a magnitude of 0 are still listed
+    ASSERT_EQ(ESM::MagicEffect::WaterBreathing, entries[0].first.mId);
+    ASSERT_EQ(ESM::MagicEffect::Paralyze, entries[1].first.mId);
+    ASSERT_EQ(-1, entries[2].first.mArg);
+    ASSERT_EQ(4.f, entries[2].second.getMagnitude());
+    ASSERT_EQ(ESM::Skill::Alchemy, entries[3].first.mArg);
+    ASSERT_EQ(ESM::Skill::Sneak, entries[4].first.mArg);
+}
+
+TEST(MagicEffectsTest, remove_while_iterating)
+{
+    MagicEffects effects;
+
+    effects.add(ESM::MagicEffect::Shield, EffectParam(1.f));
+    effects.add(ESM::MagicEffect::FireShield, EffectParam(2.f));
+    effects.add(EffectKey(ESM::MagicEffect::DrainAttribute, 2), EffectParam(3.f));
+    effects.add(ESM::MagicEffect::Paralyze, EffectParam(4.f));
+
+    for (MagicEffects::const_iterator it = effects.begin(); it != effects.end();)
+    {
+        if (it->second.getMagnitude() > 1.f && it->second.getMagnitude() < 4.f)
+            effects.remove((it++)->first);
+        else
+            ++it;
+    }
+
+    ASSERT_EQ(2, std::distance(effects.begin(), effects.end()));
+    ASSERT_EQ(1.f, effects.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(4.f, effects.get(ESM::MagicEffect::Paralyze).getMagnitude());
+}
+
+TEST(MagicEffectsTest, sum_and_modifiers)
+{
+    MagicEffects first;
+    first.add(ESM::MagicEffect::Shield, EffectParam(10.f));
+    first.add(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy), EffectParam(3.f));
+
+    MagicEffects second;
+    second.add(ESM::MagicEffect::Shield, EffectParam(5.f));
+    second.add(ESM::MagicEffect::Light, EffectParam(20.f));
+
+    MagicEffects sum = first;
+    sum += second;
+    ASSERT_EQ(15.f, sum.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(20.f, sum.get(ESM::MagicEffect::Light).getMagnitude());
+    ASSERT_EQ(3.f, sum.get(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy)).getMagnitude());
+
+    sum += sum;
+    ASSERT_EQ(30.f, sum.get(ESM::MagicEffect::Shield).getMagnitude());
+
+    // modifiers are replaced, base values are kept
+    MagicEffects stats;
+    stats.modifyBase(ESM::MagicEffect::Shield, 1);
+    stats.add(ESM::MagicEffect::Paralyze, EffectParam(1.f));
+    stats.setModifiers(second);
+    ASSERT_EQ(6.f, stats.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(20.f, stats.get(ESM::MagicEffect::Light).getMagnitude());
+    ASSERT_EQ(0.f, stats.get(ESM::MagicEffect::Paralyze).getMagnitude());
+
+    MagicEffects diff = MagicEffects::diff(first, second);
+    ASSERT_EQ(-5.f, diff.get(ESM::MagicEffect::Shield).getMagnitude());
+    ASSERT_EQ(20.f, diff.get(ESM::MagicEffect::Light).getMagnitude());
+    ASSERT_EQ(-3.f, diff.get(EffectKey(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy)).getMagnitude());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "apps/openmw/mwworld/actoridindex.hpp"
+
+namespace
+{
+    struct ActorIdIndexTest : public ::testing::Test
+    {
+        MWWorld::ActorIdIndex mIndex;
+        std::vector<int> mActorIds;
+        unsigned int mRevision;
+        int mCalls;
+
+        ActorIdIndexTest() : mRevision(0), mCalls(0) {}
+
+        int search(int id)
+        {
+            return mIndex.search(id, mActorIds.size(), mRevision, [this] (std::size_t position)
+            {
+                ++mCalls;
+                return mActorIds[position];
+            });
+        }
+    };
+}
+
+TEST_F(ActorIdIndexTest, finds_actors_by_id)
+{
+    mActorIds = { 3, -1, 7 };
+
+    EXPECT_EQ(0, search(3));
+    EXPECT_EQ(2, search(7));
+    EXPECT_EQ(-1, search(5));
+}
+
+TEST_F(ActorIdIndexTest, miss_with_unchanged_revision_does_not_rebuild)
+{
+    mActorIds = { 3, -1, 7 };
+    search(3);
+
+    mCalls = 0;
+    EXPECT_EQ(-1, search(5));
+    EXPECT_EQ(0, mCalls);
+}
+
+TEST_F(ActorIdIndexTest, finds_actor_that_got_an_id_after_build)
+{
+    mActorIds = { 3, -1, 7 };
+    search(3);
+
+    mActorIds[1] = 8;
+    ++mRevision;
+    EXPECT_EQ(1, search(8));
+}
+
+TEST_F(ActorIdIndexTest, finds_actor_whose_id_changed_after_build)
+{
+    mActorIds = { 3, -1, 7 };
+    search(3);
+
+    // e.g. a respawned actor, or an actor whose state was loaded
+    mActorIds[0] = 9;
+    ++mRevision;
+    EXPECT_EQ(0, search(9));
+    EXPECT_EQ(-1, search(3));
+}
+
+TEST_F(ActorIdIndexTest, ids_swapped_between_actors)
+{
+    mActorIds = { 3, 7 };
+    search(3);
+
+    mActorIds[0] = 7;
+    mActorIds[1] = 3;
+    ++mRevision;
+    EXPECT_EQ(1, search(3));
+    EXPECT_EQ(0, search(7));
+}
+
+TEST_F(ActorIdIndexTest, invalidate_rebuilds_for_new_references)
+{
+    mActorIds = { 3 };
+    search(3);
+
+    mActorIds.push_back(4);
+    mIndex.invalidate();
+    EXPECT_EQ(1, search(4));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "apps/openmw/mwworld/gmsttable.hpp"
+#include "apps/openmw/mwworld/store.hpp"
+
+namespace
+{
+    ESM::GameSetting makeGameSetting(const std::string& id, ESM::VarType type)
+    {
+        ESM::GameSetting record;
+        record.blank();
+        record.mId = id;
+        record.mValue.setType(type);
+        return record;
+    }
+}
+
+struct GmstTableTest : public ::testing::Test
+{
+    MWWorld::Store<ESM::GameSetting> mStore;
+    MWWorld::GmstTable mTable;
+
+    void SetUp()
+    {
+        ESM::GameSetting floatSetting = makeGameSetting("fDamageStrengthBase", ESM::VT_Float);
+        floatSetting.mValue.setFloat(0.5f);
+        mStore.insertStatic(floatSetting);
+
+        ESM::GameSetting intSetting = makeGameSetting("iGreetDistanceMultiplier", ESM::VT_Int);
+        intSetting.mValue.setInteger(6);
+        mStore.insertStatic(intSetting);
+
+        // Lookups are case insensitive
+        ESM::GameSetting stringSetting = makeGameSetting("FVOICEIDLEODDS", ESM::VT_String);
+        stringSetting.mValue.setString("often");
+        mStore.insertStatic(stringSetting);
+
+        mTable.setUp(mStore);
+    }
+};
+
+TEST_F(GmstTableTest, handles_resolve_to_the_records_of_their_names)
+{
+    ASSERT_STREQ("fDamageStrengthBase", MWWorld::GmstTable::getName(MWWorld::GMST::fDamageStrengthBase));
+
+    ASSERT_TRUE(mTable.has(MWWorld::GMST::fDamageStrengthBase));
+    ASSERT_EQ(0.5f, mTable.getFloat(MWWorld::GMST::fDamageStrengthBase));
+    ASSERT_EQ(0, mTable.getInt(MWWorld::GMST::fDamageStrengthBase));
+
+    ASSERT_EQ(6, mTable.getInt(MWWorld::GMST::iGreetDistanceMultiplier));
+    ASSERT_EQ(6.f, mTable.getFloat(MWWorld::GMST::iGreetDistanceMultiplier));
+
+    ASSERT_TRUE(mTable.has(MWWorld::GMST::fVoiceIdleOdds));
+    ASSERT_EQ("often", mTable.getString(MWWorld::GMST::fVoiceIdleOdds));
+}
+
+TEST_F(GmstTableTest, values_follow_the_store_after_setup)
+{
+    ESM::GameSetting record = *mStore.search("fDamageStrengthBase");
+    record.mValue.setFloat(2.f);
+    mStore.insertStatic(record);
+
+    ASSERT_EQ(0.5f, mTable.getFloat(MWWorld::GMST::fDamageStrengthBase));
+
+    mTable.setUp(mStore);
+    ASSERT_EQ(2.f, mTable.getFloat(MWWorld::GMST::fDamageStrengthBase));
+}
+
+TEST_F(GmstTableTest, type_mismatch_throws)
+{
+    ASSERT_THROW(mTable.getFloat(MWWorld::GMST::fVoiceIdleOdds), std::exception);
+    ASSERT_THROW(mTable.getInt(MWWorld::GMST::fVoiceIdleOdds), std::exception);
+    ASSERT_THROW(mTable.getString(MWWorld::GMST::fDamageStrengthBase), std::exception);
+}
+
+TEST_F(GmstTableTest, missing_record_throws)
+{
+    ASSERT_FALSE(mTable.has(MWWorld::GMST::fHoldBreathTime));
+    ASSERT_THROW(mTable.getFloat(MWWorld::GMST::fHoldBreathTime), std::runtime_error);
+    ASSERT_THROW(mTable.getInt(MWWorld::GMST::fHoldBreathTime), std::runtime_error);
+    ASSERT_THROW(mTable.getString(MWWorld::GMST::fHoldBreathTime), std::runtime_error);
+}
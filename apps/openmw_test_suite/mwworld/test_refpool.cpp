@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "apps/openmw/mwworld/refpool.hpp"
+
+namespace
+{
+    /// Counts its live instances.
+    struct Counted
+    {
+        static int sInstances;
+
+        int mValue;
+
+        Counted (int value) : mValue (value) { ++sInstances; }
+        Counted (const Counted& other) : mValue (other.mValue) { ++sInstances; }
+        ~Counted() { --sInstances; }
+    };
+
+    int Counted::sInstances = 0;
+
+    typedef MWWorld::RefPool<Counted> Pool;
+
+    std::vector<int> getValues (const Pool& pool)
+    {
+        std::vector<int> values;
+        for (Pool::const_iterator it = pool.begin(); it != pool.end(); ++it)
+            values.push_back (it->mValue);
+        return values;
+    }
+
+    std::vector<int> makeRange (int begin, int end, int step = 1)
+    {
+        std::vector<int> values;
+        for (int i = begin; i < end; i += step)
+            values.push_back (i);
+        return values;
+    }
+}
+
+struct RefPoolTest : public ::testing::Test
+{
+    void TearDown()
+    {
+        ASSERT_EQ (0, Counted::sInstances);
+    }
+};
+
+TEST_F(RefPoolTest, elements_keep_their_address_while_the_pool_grows)
+{
+    Pool pool;
+    std::vector<const Counted*> addresses;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.push_back (Counted (i));
+        addresses.push_back (&pool.back());
+    }
+
+    ASSERT_EQ (1000u, pool.size());
+    ASSERT_EQ (makeRange (0, 1000), getValues (pool));
+
+    int index = 0;
+    for (Pool::iterator it = pool.begin(); it != pool.end(); ++it, ++index)
+        ASSERT_EQ (addresses[index], &*it);
+}
+
+TEST_F(RefPoolTest, erase_leaves_other_elements_in_place)
+{
+    Pool pool;
+    for (int i = 0; i < 100; ++i)
+        pool.push_back (Counted (i));
+
+    const Counted* last = &pool.back();
+
+    for (Pool::iterator it = pool.begin(); it != pool.end();)
+    {
+        if (it->mValue % 2 == 0)
+            it = pool.erase (it);
+        else
+            ++it;
+    }
+
+    ASSERT_EQ (50u, pool.size());
+    ASSERT_EQ (50, Counted::sInstances);
+    ASSERT_EQ (makeRange (1, 100, 2), getValues (pool));
+    ASSERT_EQ (1, pool.front().mValue);
+    ASSERT_EQ (last, &pool.back());
+
+    std::vector<int> reversed;
+    for (Pool::iterator it = pool.end(); it != pool.begin();)
+        reversed.push_back ((--it)->mValue);
+    ASSERT_EQ (makeRange (1, 100, 2), std::vector<int> (reversed.rbegin(), reversed.rend()));
+}
+
+TEST_F(RefPoolTest, erased_slots_are_not_reused)
+{
+    Pool pool;
+    for (int i = 0; i < 3; ++i)
+        pool.push_back (Counted (i));
+
+    const Counted* erased = &pool.front();
+    pool.erase (pool.begin());
+    pool.push_back (Counted (3));
+
+    // New elements always come last, even if there is a hole
+    ASSERT_EQ (makeRange (1, 4), getValues (pool));
+    ASSERT_NE (erased, &pool.back());
+}
+
+TEST_F(RefPoolTest, empty_pool_reclaims_its_slots)
+{
+    Pool pool;
+    for (int i = 0; i < 100; ++i)
+        pool.push_back (Counted (i));
+
+    for (Pool::iterator it = pool.begin(); it != pool.end();)
+        it = pool.erase (it);
+
+    ASSERT_TRUE (pool.empty());
+    ASSERT_TRUE (pool.begin() == pool.end());
+
+    pool.push_back (Counted (100));
+
+    ASSERT_EQ (1u, pool.size());
+    ASSERT_EQ (std::vector<int> (1, 100), getValues (pool));
+    ASSERT_EQ (&pool.front(), &pool.back());
+}
+
+TEST_F(RefPoolTest, copy_only_contains_live_elements)
+{
+    Pool pool;
+    for (int i = 0; i < 10; ++i)
+        pool.push_back (Counted (i));
+    pool.erase (pool.begin());
+    pool.erase (--pool.end());
+
+    Pool copy (pool);
+    ASSERT_EQ (8u, copy.size());
+    ASSERT_EQ (makeRange (1, 9), getValues (copy));
+
+    Pool assigned;
+    assigned.push_back (Counted (-1));
+    assigned = pool;
+    ASSERT_EQ (makeRange (1, 9), getValues (assigned));
+
+    ASSERT_EQ (24, Counted::sInstances);
+}
+
+TEST_F(RefPoolTest, clear_destroys_all_elements)
+{
+    Pool pool;
+    for (int i = 0; i < 10; ++i)
+        pool.push_back (Counted (i));
+    pool.erase (pool.begin());
+
+    pool.clear();
+
+    ASSERT_TRUE (pool.empty());
+    ASSERT_EQ (0, Counted::sInstances);
+    ASSERT_TRUE (pool.begin() == pool.end());
+}
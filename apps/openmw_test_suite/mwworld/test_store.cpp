@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 #include <boost/filesystem/fstream.hpp>
 
 #include <components/files/configurationmanager.hpp>
@@ -313,3 +315,88 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests the order of static and dynamic records, and lookups ignoring case.
+TEST_F(StoreTest, dynamic_records_test)
+{
+    typedef ESM::Static RecordType;
+
+    MWWorld::Store<RecordType> store;
+
+    const char* ids[] = { "Static_B", "static_a", "dynamic_c", "Dynamic_A", "dynamic_b" };
+
+    for (int i=0; i<5; ++i)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = ids[i];
+
+        if (i<2)
+            store.insertStatic(record);
+        else
+            store.insert(record);
+    }
+
+    ASSERT_TRUE (store.getSize() == 5);
+    ASSERT_TRUE (store.getDynamicSize() == 3);
+    ASSERT_TRUE (store.search("STATIC_A") != NULL);
+    ASSERT_TRUE (store.search(Misc::InternedId("dynamic_a")) == store.search("Dynamic_A"));
+    ASSERT_TRUE (store.search("unknown") == NULL);
+    ASSERT_TRUE (store.isDynamic("dynamic_a"));
+    ASSERT_FALSE (store.isDynamic("static_a"));
+
+    ASSERT_TRUE (store.erase("DYNAMIC_C"));
+    ASSERT_FALSE (store.erase("dynamic_c"));
+    ASSERT_TRUE (store.search("dynamic_c") == NULL);
+
+    // content file order, then the order the dynamic records were inserted in
+    const char* expected[] = { "Static_B", "static_a", "Dynamic_A", "dynamic_b" };
+
+    int index = 0;
+    for (MWWorld::Store<RecordType>::iterator it = store.begin(); it != store.end(); ++it, ++index)
+        ASSERT_EQ (expected[index], it->mId);
+
+    ASSERT_EQ (4, index);
+
+    store.clearDynamic();
+
+    ASSERT_TRUE (store.getSize() == 2);
+    ASSERT_TRUE (store.search("dynamic_a") == NULL);
+    ASSERT_TRUE (store.search("static_b") != NULL);
+}
+
+/// Lookups in a store of the size of the largest ones in Morrowind.esm.
+TEST_F(StoreTest, search_large_store_test)
+{
+    typedef ESM::Static RecordType;
+
+    MWWorld::Store<RecordType> store;
+
+    const int records = 3000;
+    std::vector<std::string> ids;
+
+    for (int i=0; i<records; ++i)
+    {
+        std::ostringstream id;
+        id << "Ex_Common_Record_" << i;
+        ids.push_back(id.str());
+
+        RecordType record;
+        record.blank();
+        record.mId = id.str();
+        store.insertStatic(record);
+    }
+
+    ASSERT_TRUE (store.getSize() == records);
+
+    for (std::vector<std::string>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+    {
+        const RecordType* record = store.search(*it);
+        ASSERT_TRUE (record != NULL);
+        ASSERT_EQ (*it, record->mId);
+        ASSERT_EQ (record, store.search(Misc::InternedId(*it)));
+    }
+
+    ASSERT_TRUE (store.search("Ex_Common_Record_3000") == NULL);
+    ASSERT_TRUE (store.search(Misc::InternedId("Ex_Common_Record_3000")) == NULL);
+}
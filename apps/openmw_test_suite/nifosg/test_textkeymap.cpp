@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "components/nifosg/textkeymap.hpp"
+
+namespace
+{
+    void addKey(NifOsg::TextKeyMap& keys, float time, const std::string& text)
+    {
+        keys.insert(std::make_pair(time, text));
+    }
+}
+
+struct TextKeyIndexTest : public ::testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        addKey(mKeys, 0.f, "idle: start");
+        addKey(mKeys, 1.f, "idle: loop start");
+        addKey(mKeys, 2.f, "idle: loop stop");
+        addKey(mKeys, 2.f, "idle: stop.");
+        addKey(mKeys, 3.f, "walkforward: start");
+        addKey(mKeys, 3.f, "sound: footstep");
+        addKey(mKeys, 4.f, "walkforward: stop");
+        addKey(mKeys, 5.f, "walkforward: start");
+        addKey(mKeys, 6.f, "walkforward: stop");
+        addKey(mKeys, 7.f, "no group");
+
+        mIndex.build(mKeys);
+    }
+
+    NifOsg::TextKeyMap mKeys;
+    NifOsg::TextKeyIndex mIndex;
+};
+
+TEST_F(TextKeyIndexTest, finds_groups)
+{
+    ASSERT_TRUE(mIndex.find("idle") != NULL);
+    ASSERT_TRUE(mIndex.find("walkforward") != NULL);
+    ASSERT_TRUE(mIndex.find("sound") != NULL);
+    ASSERT_TRUE(mIndex.find("walk") == NULL);
+    ASSERT_TRUE(mIndex.find("no group") == NULL);
+
+    const NifOsg::TextKeyGroup* group = mIndex.find("walkforward");
+    ASSERT_EQ(3.f, group->mFirst.mIter->first);
+    ASSERT_EQ("walkforward: start", group->mFirst.mIter->second);
+    ASSERT_EQ(6.f, group->mLast.mIter->first);
+    ASSERT_EQ(4u, group->mKeys.size());
+}
+
+TEST_F(TextKeyIndexTest, repeated_keys_keep_their_order)
+{
+    const NifOsg::TextKeyGroup* group = mIndex.find("walkforward");
+
+    ASSERT_EQ(3.f, group->findFirst("start")->mIter->first);
+    ASSERT_EQ(5.f, group->findLast("start")->mIter->first);
+    ASSERT_EQ(4.f, group->findFirst("stop")->mIter->first);
+    ASSERT_EQ(6.f, group->findLast("stop")->mIter->first);
+    ASSERT_LT(group->findFirst("start")->mIndex, group->findLast("start")->mIndex);
+    ASSERT_TRUE(group->findFirst("loop start") == NULL);
+    ASSERT_TRUE(group->findLast("loop start") == NULL);
+}
+
+TEST_F(TextKeyIndexTest, prefix_search)
+{
+    const NifOsg::TextKeyGroup* group = mIndex.find("idle");
+
+    ASSERT_TRUE(group->findLast("stop") == NULL);
+    ASSERT_EQ("idle: stop.", group->findLastStartingWith("stop")->mIter->second);
+    ASSERT_EQ("idle: loop start", group->findFirstStartingWith("loop")->mIter->second);
+    ASSERT_EQ("idle: loop stop", group->findLastStartingWith("loop")->mIter->second);
+    ASSERT_EQ("idle: start", group->findFirstStartingWith("")->mIter->second);
+    ASSERT_TRUE(group->findFirstStartingWith("walk") == NULL);
+}
+
+TEST_F(TextKeyIndexTest, identifies_keys)
+{
+    const NifOsg::TextKeyGroup* group = mIndex.find("idle");
+
+    NifOsg::TextKeyMap::const_iterator key = mKeys.find(1.f);
+    ASSERT_TRUE(group->isKey(key, "loop start"));
+    ASSERT_FALSE(group->isKey(key, "loop stop"));
+    ASSERT_FALSE(mIndex.find("walkforward")->isKey(key, "loop start"));
+}
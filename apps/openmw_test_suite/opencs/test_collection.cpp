@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <sstream>
+
+#include "apps/opencs/model/world/collection.hpp"
+
+namespace
+{
+    struct TestRecord
+    {
+        std::string mId;
+        int mValue;
+
+        void blank()
+        {
+            mValue = 0;
+        }
+    };
+
+    class TestCollection : public CSMWorld::Collection<TestRecord>
+    {
+        public:
+
+            virtual bool reorderRows (int baseIndex, const std::vector<int>& newOrder)
+            {
+                return reorderRowsImp (baseIndex, newOrder);
+            }
+
+            void insert (const std::string& id, int index, int value = 0)
+            {
+                TestRecord record;
+                record.mId = id;
+                record.mValue = value;
+
+                CSMWorld::Record<TestRecord> record2;
+                record2.mState = CSMWorld::RecordBase::State_ModifiedOnly;
+                record2.mModified = record;
+
+                insertRecord (record2, index);
+            }
+
+            void setState (const std::string& id, CSMWorld::RecordBase::State state)
+            {
+                int index = getIndex (id);
+                CSMWorld::Record<TestRecord> record = getRecord (index);
+                record.mState = state;
+                setRecord (index, record);
+            }
+
+            /// Check that every record can be found under its index
+            bool isConsistent() const
+            {
+                for (int i=0; i<getSize(); ++i)
+                    if (searchId (getId (i))!=i)
+                        return false;
+
+                return static_cast<int> (getIds().size())==getSize();
+            }
+    };
+}
+
+struct CollectionTest : public ::testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    TestCollection mCollection;
+};
+
+TEST_F(CollectionTest, append_keeps_order)
+{
+    mCollection.appendBlankRecord ("a");
+    mCollection.appendBlankRecord ("B");
+    mCollection.appendBlankRecord ("c");
+
+    ASSERT_EQ (3, mCollection.getSize());
+    ASSERT_EQ ("a", mCollection.getId (0));
+    ASSERT_EQ ("B", mCollection.getId (1));
+    ASSERT_EQ ("c", mCollection.getId (2));
+
+    // IDs are case insensitive
+    ASSERT_EQ (1, mCollection.searchId ("b"));
+    ASSERT_EQ (1, mCollection.searchId ("B"));
+    ASSERT_EQ (-1, mCollection.searchId ("d"));
+    ASSERT_TRUE (mCollection.isConsistent());
+}
+
+TEST_F(CollectionTest, insert_shifts_following_records)
+{
+    mCollection.insert ("a", 0);
+    mCollection.insert ("c", 1);
+    mCollection.insert ("b", 1);
+    mCollection.insert ("first", 0);
+
+    ASSERT_EQ (0, mCollection.searchId ("first"));
+    ASSERT_EQ (1, mCollection.searchId ("a"));
+    ASSERT_EQ (2, mCollection.searchId ("b"));
+    ASSERT_EQ (3, mCollection.searchId ("c"));
+    ASSERT_TRUE (mCollection.isConsistent());
+}
+
+TEST_F(CollectionTest, insert_between_lookups)
+{
+    // lookups in between modifications only update part of the index
+    for (int i=0; i<100; ++i)
+    {
+        std::ostringstream stream;
+        stream << "id" << i;
+        mCollection.insert (stream.str(), i%2 ? 0 : mCollection.getSize());
+
+        ASSERT_EQ (i%2 ? 0 : mCollection.getSize()-1, mCollection.searchId (stream.str()));
+    }
+
+    ASSERT_TRUE (mCollection.isConsistent());
+}
+
+TEST_F(CollectionTest, insert_rejects_invalid_records)
+{
+    mCollection.insert ("a", 0);
+
+    ASSERT_THROW (mCollection.insert ("A", 1), std::runtime_error);
+    ASSERT_THROW (mCollection.insert ("b", 2), std::runtime_error);
+    ASSERT_EQ (1, mCollection.getSize());
+    ASSERT_TRUE (mCollection.isConsistent());
+}
+
+TEST_F(CollectionTest, remove_rows)
+{
+    const char *ids[] = { "a", "b", "c", "d", "e" };
+
+    for (int i=0; i<5; ++i)
+        mCollection.appendBlankRecord (ids[i]);
+
+    mCollection.removeRows (1, 2);
+
+    ASSERT_EQ (3, mCollection.getSize());
+    ASSERT_EQ (-1, mCollection.searchId ("b"));
+    ASSERT_EQ (-1, mCollection.searchId ("c"));
+    ASSERT_EQ (0, mCollection.searchId ("a"));
+    ASSERT_EQ (1, mCollection.searchId ("d"));
+    ASSERT_EQ (2, mCollection.searchId ("e"));
+    ASSERT_TRUE (mCollection.isConsistent());
+
+    ASSERT_THROW (mCollection.removeRows (2, 2), std::runtime_error);
+
+    // a removed ID can be added again
+    mCollection.insert ("b", 1);
+    ASSERT_EQ (1, mCollection.searchId ("b"));
+    ASSERT_EQ (2, mCollection.searchId ("d"));
+    ASSERT_TRUE (mCollection.isConsistent());
+}
+
+TEST_F(CollectionTest, reorder_rows)
+{
+    const char *ids[] = { "a", "b", "c", "d", "e" };
+
+    for (int i=0; i<5; ++i)
+        mCollection.appendBlankRecord (ids[i]);
+
+    std::vector<int> newOrder;
+    newOrder.push_back (2);
+    newOrder.push_back (0);
+    newOrder.push_back (1);
+
+    // b moves to 3, c to 1, d to 2
+    ASSERT_TRUE (mCollection.reorderRows (1, newOrder));
+
+    ASSERT_EQ ("a", mCollection.getId (0));
+    ASSERT_EQ ("c", mCollection.getId (1));
+    ASSERT_EQ ("d", mCollection.getId (2));
+    ASSERT_EQ ("b", mCollection.getId (3));
+    ASSERT_EQ ("e", mCollection.getId (4));
+    ASSERT_EQ (3, mCollection.searchId ("b"));
+    ASSERT_TRUE (mCollection.isConsistent());
+
+    newOrder[0] = 0;
+    ASSERT_FALSE (mCollection.reorderRows (1, newOrder));
+}
+
+TEST_F(CollectionTest, merge_purges_deleted_records)
+{
+    const char *ids[] = { "a", "b", "c", "d", "e" };
+
+    for (int i=0; i<5; ++i)
+        mCollection.appendBlankRecord (ids[i]);
+
+    mCollection.merge();
+    mCollection.setState ("a", CSMWorld::RecordBase::State_Deleted);
+    mCollection.setState ("c", CSMWorld::RecordBase::State_Deleted);
+    mCollection.setState ("d", CSMWorld::RecordBase::State_Deleted);
+    mCollection.merge();
+
+    ASSERT_EQ (2, mCollection.getSize());
+    ASSERT_EQ ("b", mCollection.getId (0));
+    ASSERT_EQ ("e", mCollection.getId (1));
+    ASSERT_EQ (-1, mCollection.searchId ("a"));
+    ASSERT_TRUE (mCollection.isConsistent());
+
+    std::vector<std::string> sortedIds = mCollection.getIds();
+    ASSERT_EQ (2u, sortedIds.size());
+    ASSERT_EQ ("b", sortedIds[0]);
+    ASSERT_EQ ("e", sortedIds[1]);
+}
@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "apps/opencs/model/world/collection.hpp"
+#include "apps/opencs/model/world/columns.hpp"
+#include "apps/opencs/model/world/idtablebase.hpp"
+#include "apps/opencs/model/world/universalid.hpp"
+
+#include "apps/opencs/model/filter/andnode.hpp"
+#include "apps/opencs/model/filter/booleannode.hpp"
+#include "apps/opencs/model/filter/compiledfilter.hpp"
+#include "apps/opencs/model/filter/notnode.hpp"
+#include "apps/opencs/model/filter/ornode.hpp"
+#include "apps/opencs/model/filter/textnode.hpp"
+#include "apps/opencs/model/filter/valuenode.hpp"
+
+namespace
+{
+    struct TestRecord
+    {
+        std::string mId;
+        float mWeight;
+        bool mHasWeight;
+        int mValue;
+        int mType;
+        bool mAutoCalc;
+
+        void blank()
+        {
+            mWeight = 0;
+            mHasWeight = true;
+            mValue = 0;
+            mType = 0;
+            mAutoCalc = false;
+        }
+    };
+
+    QVariant idData (const TestRecord& record) { return QString::fromUtf8 (record.mId.c_str()); }
+    QVariant weightData (const TestRecord& record) { return record.mHasWeight ? QVariant (record.mWeight) : QVariant(); }
+    QVariant valueData (const TestRecord& record) { return record.mValue; }
+    QVariant typeData (const TestRecord& record) { return record.mType; }
+    QVariant autoCalcData (const TestRecord& record) { return record.mAutoCalc; }
+
+    class TestColumn : public CSMWorld::Column<TestRecord>
+    {
+            QVariant (*mGet) (const TestRecord&);
+
+        public:
+
+            TestColumn (CSMWorld::Columns::ColumnId id, Display display, QVariant (*get) (const TestRecord&))
+            : CSMWorld::Column<TestRecord> (id, display), mGet (get)
+            {}
+
+            virtual QVariant get (const CSMWorld::Record<TestRecord>& record) const
+            {
+                return mGet (record.get());
+            }
+
+            virtual bool isEditable() const
+            {
+                return false;
+            }
+    };
+
+    class TestCollection : public CSMWorld::Collection<TestRecord>
+    {
+        public:
+
+            TestCollection()
+            {
+                addColumn (new TestColumn (CSMWorld::Columns::ColumnId_Id,
+                    CSMWorld::ColumnBase::Display_Id, idData));
+                addColumn (new TestColumn (CSMWorld::Columns::ColumnId_Weight,
+                    CSMWorld::ColumnBase::Display_Float, weightData));
+                addColumn (new TestColumn (CSMWorld::Columns::ColumnId_Value,
+                    CSMWorld::ColumnBase::Display_Integer, valueData));
+                addColumn (new TestColumn (CSMWorld::Columns::ColumnId_ApparatusType,
+                    CSMWorld::ColumnBase::Display_ApparatusType, typeData));
+                addColumn (new TestColumn (CSMWorld::Columns::ColumnId_AutoCalc,
+                    CSMWorld::ColumnBase::Display_Boolean, autoCalcData));
+            }
+
+            virtual bool reorderRows (int baseIndex, const std::vector<int>& newOrder)
+            {
+                return reorderRowsImp (baseIndex, newOrder);
+            }
+
+            void add (const std::string& id, float weight, int value, int type, bool autoCalc,
+                bool hasWeight = true)
+            {
+                CSMWorld::Record<TestRecord> record;
+                record.mState = CSMWorld::RecordBase::State_ModifiedOnly;
+                record.mModified.mId = id;
+                record.mModified.mWeight = weight;
+                record.mModified.mHasWeight = hasWeight;
+                record.mModified.mValue = value;
+                record.mModified.mType = type;
+                record.mModified.mAutoCalc = autoCalc;
+
+                insertRecord (record, getSize());
+            }
+    };
+
+    /// Exposes the collection through the table interface, which the uncompiled filter uses
+    class TestTable : public CSMWorld::IdTableBase
+    {
+            const CSMWorld::CollectionBase& mCollection;
+
+        public:
+
+            TestTable (const CSMWorld::CollectionBase& collection)
+            : CSMWorld::IdTableBase (0), mCollection (collection)
+            {}
+
+            virtual QModelIndex index (int row, int column, const QModelIndex& parent = QModelIndex()) const
+            {
+                return createIndex (row, column);
+            }
+
+            virtual QModelIndex parent (const QModelIndex& index) const
+            {
+                return QModelIndex();
+            }
+
+            virtual int rowCount (const QModelIndex& parent = QModelIndex()) const
+            {
+                return mCollection.getSize();
+            }
+
+            virtual int columnCount (const QModelIndex& parent = QModelIndex()) const
+            {
+                return mCollection.getColumns();
+            }
+
+            virtual QVariant data (const QModelIndex& index, int role = Qt::DisplayRole) const
+            {
+                return mCollection.getData (index.row(), index.column());
+            }
+
+            virtual QModelIndex getModelIndex (const std::string& id, int column) const
+            {
+                return index (mCollection.getIndex (id), column);
+            }
+
+            virtual int searchColumnIndex (CSMWorld::Columns::ColumnId id) const
+            {
+                return mCollection.searchColumnIndex (id);
+            }
+
+            virtual int findColumnIndex (CSMWorld::Columns::ColumnId id) const
+            {
+                return mCollection.findColumnIndex (id);
+            }
+
+            virtual std::pair<CSMWorld::UniversalId, std::string> view (int row) const
+            {
+                return std::make_pair (CSMWorld::UniversalId::Type_None, "");
+            }
+
+            virtual bool isDeleted (const std::string& id) const
+            {
+                return false;
+            }
+
+            virtual int getColumnId (int column) const
+            {
+                return mCollection.getColumn (column).getId();
+            }
+    };
+
+    typedef std::shared_ptr<CSMFilter::Node> NodePtr;
+
+    NodePtr text (CSMWorld::Columns::ColumnId column, const std::string& text)
+    {
+        return NodePtr (new CSMFilter::TextNode (column, text));
+    }
+
+    NodePtr value (CSMWorld::Columns::ColumnId column, CSMFilter::ValueNode::Type lowerType, double lower,
+        double upper, CSMFilter::ValueNode::Type upperType)
+    {
+        return NodePtr (new CSMFilter::ValueNode (column, lowerType, upperType, lower, upper));
+    }
+
+    NodePtr and_ (NodePtr left, NodePtr right)
+    {
+        std::vector<NodePtr> nodes;
+        nodes.push_back (left);
+        nodes.push_back (right);
+        return NodePtr (new CSMFilter::AndNode (nodes));
+    }
+
+    NodePtr or_ (NodePtr left, NodePtr right)
+    {
+        std::vector<NodePtr> nodes;
+        nodes.push_back (left);
+        nodes.push_back (right);
+        return NodePtr (new CSMFilter::OrNode (nodes));
+    }
+
+    NodePtr not_ (NodePtr child)
+    {
+        return NodePtr (new CSMFilter::NotNode (child));
+    }
+
+    const CSMFilter::ValueNode::Type Closed = CSMFilter::ValueNode::Type_Closed;
+    const CSMFilter::ValueNode::Type Open = CSMFilter::ValueNode::Type_Open;
+    const CSMFilter::ValueNode::Type Infinite = CSMFilter::ValueNode::Type_Infinite;
+}
+
+struct CompiledFilterTest : public ::testing::Test
+{
+    TestCollection mCollection;
+    TestTable mTable;
+
+    CompiledFilterTest() : mTable (mCollection)
+    {
+        mCollection.add ("wood", 1, 5, 0, true);
+        mCollection.add ("Woodland", 1.5f, 10, 1, false);
+        mCollection.add ("iron", 2, 0, 2, true);
+        mCollection.add ("Iron.Ore", 0.5f, -3, 3, false);
+        mCollection.add ("glass", 3, 100, 4, true);
+        mCollection.add ("", 0, 1, -1, false);
+        mCollection.add ("weightless", 0, 2, 7, true, false);
+    }
+
+    /// Map the columns that the filter refers to, as IdTableProxyModel does
+    std::map<int, int> getColumns (const CSMFilter::Node& filter) const
+    {
+        std::map<int, int> columns;
+        std::vector<int> ids = filter.getReferencedColumns();
+        for (std::vector<int>::const_iterator iter (ids.begin()); iter!=ids.end(); ++iter)
+            columns.insert (std::make_pair (*iter,
+                mTable.searchColumnIndex (static_cast<CSMWorld::Columns::ColumnId> (*iter))));
+        return columns;
+    }
+
+    /// Check that the compiled filter accepts the same rows as the filter itself
+    void checkFilter (const NodePtr& filter)
+    {
+        SCOPED_TRACE (filter->toString (false));
+
+        std::map<int, int> columns = getColumns (*filter);
+        CSMFilter::CompiledFilter compiled (*filter, mCollection, columns);
+
+        std::vector<char> results;
+        compiled.test (results);
+        ASSERT_EQ (static_cast<std::size_t> (mCollection.getSize()), results.size());
+
+        for (int row=0; row<mCollection.getSize(); ++row)
+        {
+            bool expected = filter->test (mTable, row, columns);
+            EXPECT_EQ (expected, compiled.test (row)) << "row " << row << " (" << mCollection.getId (row) << ")";
+            EXPECT_EQ (expected, results[row]!=0) << "row " << row << " (" << mCollection.getId (row) << ")";
+        }
+    }
+};
+
+TEST_F(CompiledFilterTest, text_matches_like_uncompiled_filter)
+{
+    const char *patterns[] =
+    {
+        "wood", "WOOD", "wood.*", "w.*", ".*o.*", "iron.ore", "Iron\\.Ore", "[gi].*", "", "(", 0
+    };
+
+    for (int i=0; patterns[i]; ++i)
+        checkFilter (text (CSMWorld::Columns::ColumnId_Id, patterns[i]));
+
+    // enums, including values without a name
+    checkFilter (text (CSMWorld::Columns::ColumnId_ApparatusType, "Retort"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_ApparatusType, "retort"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_ApparatusType, "c.*"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_ApparatusType, ""));
+
+    // booleans
+    checkFilter (text (CSMWorld::Columns::ColumnId_AutoCalc, "true"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_AutoCalc, "false"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_AutoCalc, "t.*"));
+
+    // numbers without enums and missing data
+    checkFilter (text (CSMWorld::Columns::ColumnId_Value, "5"));
+    checkFilter (text (CSMWorld::Columns::ColumnId_Weight, ""));
+    checkFilter (text (CSMWorld::Columns::ColumnId_Weight, "1"));
+
+    // a column the table does not have
+    checkFilter (text (CSMWorld::Columns::ColumnId_Name, "wood"));
+}
+
+TEST_F(CompiledFilterTest, value_ranges_match_like_uncompiled_filter)
+{
+    const CSMFilter::ValueNode::Type types[] = { Closed, Open, Infinite };
+
+    for (int lower=0; lower<3; ++lower)
+        for (int upper=0; upper<3; ++upper)
+        {
+            checkFilter (value (CSMWorld::Columns::ColumnId_Weight, types[lower], 1, 2, types[upper]));
+            checkFilter (value (CSMWorld::Columns::ColumnId_Value, types[lower], 0, 10, types[upper]));
+        }
+
+    // single values
+    checkFilter (value (CSMWorld::Columns::ColumnId_Weight, Closed, 1.5, 1.5, Closed));
+    checkFilter (value (CSMWorld::Columns::ColumnId_Value, Closed, -3, -3, Closed));
+
+    // booleans are numbers as well, strings are not
+    checkFilter (value (CSMWorld::Columns::ColumnId_AutoCalc, Closed, 1, 1, Closed));
+    checkFilter (value (CSMWorld::Columns::ColumnId_Id, Infinite, 0, 0, Infinite));
+
+    checkFilter (value (CSMWorld::Columns::ColumnId_Name, Closed, 1, 2, Closed));
+}
+
+TEST_F(CompiledFilterTest, combinations_match_like_uncompiled_filter)
+{
+    NodePtr name = text (CSMWorld::Columns::ColumnId_Id, "w.*");
+    NodePtr weight = value (CSMWorld::Columns::ColumnId_Weight, Closed, 1, 2, Open);
+    NodePtr autoCalc = text (CSMWorld::Columns::ColumnId_AutoCalc, "true");
+
+    checkFilter (and_ (name, weight));
+    checkFilter (or_ (name, weight));
+    checkFilter (not_ (name));
+    checkFilter (not_ (and_ (name, weight)));
+    checkFilter (or_ (not_ (name), and_ (weight, autoCalc)));
+    checkFilter (and_ (or_ (name, autoCalc), not_ (weight)));
+    checkFilter (and_ (name, text (CSMWorld::Columns::ColumnId_Name, "x")));
+
+    // and/or without any children
+    checkFilter (NodePtr (new CSMFilter::AndNode (std::vector<NodePtr>())));
+    checkFilter (NodePtr (new CSMFilter::OrNode (std::vector<NodePtr>())));
+}
+
+TEST_F(CompiledFilterTest, empty_filter_accepts_everything)
+{
+    // an empty filter string is parsed as "true"
+    NodePtr empty (new CSMFilter::BooleanNode (true));
+    checkFilter (empty);
+
+    CSMFilter::CompiledFilter compiled (*empty, mCollection, getColumns (*empty));
+    for (int row=0; row<mCollection.getSize(); ++row)
+        ASSERT_TRUE (compiled.test (row));
+
+    checkFilter (NodePtr (new CSMFilter::BooleanNode (false)));
+}
+
+TEST_F(CompiledFilterTest, large_collections_match_like_uncompiled_filter)
+{
+    // enough rows to split the work between threads
+    for (int i=0; i<10000; ++i)
+    {
+        std::ostringstream id;
+        id << (i%3 ? "wood" : "iron") << i;
+        mCollection.add (id.str(), (i%40) / 10.f, i%17 - 5, i%6, i%2==0, i%11!=0);
+    }
+
+    checkFilter (or_ (and_ (text (CSMWorld::Columns::ColumnId_Id, "w.*1"),
+        value (CSMWorld::Columns::ColumnId_Weight, Open, 1, 3, Closed)),
+        not_ (text (CSMWorld::Columns::ColumnId_ApparatusType, "Albemic"))));
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+
+#include "components/resource/bulletshape.hpp"
+#include "components/resource/bulletshapefilecache.hpp"
+
+namespace
+{
+    const std::string sName = "meshes\\test.nif";
+    const std::uint64_t sHash = 0x0123456789abcdefull;
+
+    struct TriangleCollector : public btInternalTriangleIndexCallback
+    {
+        std::vector<btVector3> mVertices;
+
+        virtual void internalProcessTriangleIndex(btVector3* triangle, int, int)
+        {
+            mVertices.insert(mVertices.end(), triangle, triangle + 3);
+        }
+    };
+
+    std::vector<btVector3> getVertices(const btStridingMeshInterface& mesh)
+    {
+        TriangleCollector collector;
+        btVector3 aabbMax(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        mesh.InternalProcessAllTriangles(&collector, -aabbMax, aabbMax);
+        return collector.mVertices;
+    }
+
+    void expectEqualBvh(const btOptimizedBvh& expected, const btOptimizedBvh& actual)
+    {
+        // The accessors of btQuantizedBvh are not const
+        btOptimizedBvh& expectedBvh = const_cast<btOptimizedBvh&>(expected);
+        btOptimizedBvh& actualBvh = const_cast<btOptimizedBvh&>(actual);
+
+        ASSERT_EQ(expectedBvh.isQuantized(), actualBvh.isQuantized());
+
+        const QuantizedNodeArray& expectedNodes = expectedBvh.getQuantizedNodeArray();
+        const QuantizedNodeArray& actualNodes = actualBvh.getQuantizedNodeArray();
+        ASSERT_EQ(expectedNodes.size(), actualNodes.size());
+        for (int i = 0; i < expectedNodes.size(); ++i)
+        {
+            EXPECT_EQ(expectedNodes[i].m_escapeIndexOrTriangleIndex, actualNodes[i].m_escapeIndexOrTriangleIndex);
+            for (int j = 0; j < 3; ++j)
+            {
+                EXPECT_EQ(expectedNodes[i].m_quantizedAabbMin[j], actualNodes[i].m_quantizedAabbMin[j]);
+                EXPECT_EQ(expectedNodes[i].m_quantizedAabbMax[j], actualNodes[i].m_quantizedAabbMax[j]);
+            }
+        }
+
+        EXPECT_EQ(expectedBvh.getSubtreeInfoArray().size(), actualBvh.getSubtreeInfoArray().size());
+    }
+
+    struct BulletShapeFileCacheTest : public ::testing::Test
+    {
+        boost::filesystem::path mPath;
+        osg::ref_ptr<Resource::BulletShape> mShape;
+        Resource::TriangleMeshShape* mMeshShape;
+
+        BulletShapeFileCacheTest()
+            : mPath(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("openmw-test-%%%%-%%%%-%%%%"))
+            , mShape(new Resource::BulletShape)
+        {
+            btTriangleMesh* mesh = new btTriangleMesh;
+            mesh->addTriangle(btVector3(0, 0, 0), btVector3(1, 0, 0), btVector3(0, 1, 0));
+            mesh->addTriangle(btVector3(1, 0, 0), btVector3(1, 1, 0), btVector3(0, 1, 0));
+            mesh->addTriangle(btVector3(0, 0, 2), btVector3(3, 0, 2), btVector3(0, 4, 2));
+            mMeshShape = new Resource::TriangleMeshShape(mesh, true);
+
+            btCompoundShape* compound = new btCompoundShape;
+            compound->addChildShape(btTransform::getIdentity(), mMeshShape);
+            compound->addChildShape(btTransform(btQuaternion(0, 0, 1, 0), btVector3(1, 2, 3)), new btBoxShape(btVector3(4, 5, 6)));
+
+            mShape->mCollisionShape = compound;
+            mShape->mCollisionBoxHalfExtents = osg::Vec3f(1, 2, 3);
+            mShape->mCollisionBoxTranslate = osg::Vec3f(4, 5, 6);
+            mShape->mAnimatedShapes[7] = 1;
+        }
+
+        ~BulletShapeFileCacheTest()
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove_all(mPath, error);
+        }
+    };
+}
+
+TEST_F(BulletShapeFileCacheTest, read_returns_written_shape)
+{
+    Resource::BulletShapeFileCache cache(mPath.string(), 1024 * 1024);
+    cache.write(sName, sHash, *mShape);
+
+    osg::ref_ptr<Resource::BulletShape> shape = cache.read(sName, sHash);
+    ASSERT_TRUE(shape.valid());
+
+    EXPECT_EQ(mShape->mCollisionBoxHalfExtents, shape->mCollisionBoxHalfExtents);
+    EXPECT_EQ(mShape->mCollisionBoxTranslate, shape->mCollisionBoxTranslate);
+    EXPECT_EQ(mShape->mAnimatedShapes, shape->mAnimatedShapes);
+
+    ASSERT_TRUE(shape->mCollisionShape && shape->mCollisionShape->isCompound());
+    btCompoundShape* compound = static_cast<btCompoundShape*>(shape->mCollisionShape);
+    ASSERT_EQ(2, compound->getNumChildShapes());
+
+    Resource::TriangleMeshShape* meshShape = dynamic_cast<Resource::TriangleMeshShape*>(compound->getChildShape(0));
+    ASSERT_TRUE(meshShape);
+    EXPECT_EQ(getVertices(*mMeshShape->getMeshInterface()), getVertices(*meshShape->getMeshInterface()));
+    EXPECT_EQ(mMeshShape->usesQuantizedAabbCompression(), meshShape->usesQuantizedAabbCompression());
+    ASSERT_TRUE(meshShape->getOptimizedBvh());
+    expectEqualBvh(*mMeshShape->getOptimizedBvh(), *meshShape->getOptimizedBvh());
+
+    btBoxShape* box = dynamic_cast<btBoxShape*>(compound->getChildShape(1));
+    ASSERT_TRUE(box);
+    EXPECT_EQ(btVector3(4, 5, 6), box->getHalfExtentsWithMargin());
+    EXPECT_EQ(btVector3(1, 2, 3), compound->getChildTransform(1).getOrigin());
+}
+
+TEST_F(BulletShapeFileCacheTest, read_ignores_other_version_of_mesh)
+{
+    Resource::BulletShapeFileCache cache(mPath.string(), 1024 * 1024);
+    cache.write(sName, sHash, *mShape);
+
+    EXPECT_FALSE(cache.read(sName, sHash + 1).valid());
+    EXPECT_FALSE(cache.read("meshes\\other.nif", sHash).valid());
+}
+
+TEST_F(BulletShapeFileCacheTest, read_rejects_truncated_files)
+{
+    Resource::BulletShapeFileCache cache(mPath.string(), 1024 * 1024);
+    cache.write(sName, sHash, *mShape);
+
+    std::string fileName = Resource::FileCache(mPath.string(), ".bullet", 1024 * 1024).getFileName(sName);
+    std::string data;
+    {
+        std::ifstream stream (fileName.c_str(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    ASSERT_FALSE(data.empty());
+
+    for (std::size_t size = 0; size < data.size(); ++size)
+    {
+        {
+            std::ofstream stream (fileName.c_str(), std::ios::binary | std::ios::trunc);
+            stream.write(data.data(), size);
+        }
+        EXPECT_FALSE(cache.read(sName, sHash).valid()) << "size " << size;
+    }
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "components/resource/dxtcompressor.hpp"
+
+namespace
+{
+    void decodeRgb565(int value, int* color)
+    {
+        int r = (value >> 11) & 31;
+        int g = (value >> 5) & 63;
+        int b = value & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /// Decode a color block to 16 RGB pixels, as the hardware does.
+    void decodeColorBlock(const unsigned char* block, int pixels[16][3])
+    {
+        int endpoint0 = block[0] | (block[1] << 8);
+        int endpoint1 = block[2] | (block[3] << 8);
+
+        int palette[4][3];
+        decodeRgb565(endpoint0, palette[0]);
+        decodeRgb565(endpoint1, palette[1]);
+        for (int i = 0; i < 3; ++i)
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+
+        unsigned int indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<unsigned int>(block[7]) << 24);
+        for (int i = 0; i < 16; ++i)
+            for (int j = 0; j < 3; ++j)
+                pixels[i][j] = palette[(indices >> (i * 2)) & 3][j];
+    }
+
+    void decodeAlphaBlock(const unsigned char* block, int alphas[16])
+    {
+        int palette[8];
+        palette[0] = block[0];
+        palette[1] = block[1];
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7;
+
+        unsigned long long indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= static_cast<unsigned long long>(block[2 + i]) << (i * 8);
+        for (int i = 0; i < 16; ++i)
+            alphas[i] = palette[(indices >> (i * 3)) & 7];
+    }
+
+    void setPixel(unsigned char* pixels, int index, int r, int g, int b, int a)
+    {
+        pixels[index * 4] = r;
+        pixels[index * 4 + 1] = g;
+        pixels[index * 4 + 2] = b;
+        pixels[index * 4 + 3] = a;
+    }
+}
+
+TEST(DxtCompressorTest, single_color_block)
+{
+    unsigned char pixels[16 * 4];
+    for (int i = 0; i < 16; ++i)
+        setPixel(pixels, i, 255, 0, 0, 255);
+
+    unsigned char block[Resource::Dxt::sDxt1BlockSize];
+    Resource::Dxt::compressDxt1Block(pixels, block);
+
+    int decoded[16][3];
+    decodeColorBlock(block, decoded);
+    for (int i = 0; i < 16; ++i)
+    {
+        ASSERT_EQ(255, decoded[i][0]);
+        ASSERT_EQ(0, decoded[i][1]);
+        ASSERT_EQ(0, decoded[i][2]);
+    }
+}
+
+TEST(DxtCompressorTest, gradient_is_close_to_original)
+{
+    unsigned char pixels[16 * 4];
+    for (int i = 0; i < 16; ++i)
+        setPixel(pixels, i, i * 16, 255 - i * 16, 64, 255);
+
+    unsigned char block[Resource::Dxt::sDxt1BlockSize];
+    Resource::Dxt::compressDxt1Block(pixels, block);
+
+    // The block must use four colors, i.e. have no transparency
+    ASSERT_GT(block[0] | (block[1] << 8), block[2] | (block[3] << 8));
+
+    // Four colors spread over the range of the gradient are at most 40 apart from any of its pixels
+    int decoded[16][3];
+    decodeColorBlock(block, decoded);
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 3; ++j)
+            ASSERT_GE(40, std::abs(decoded[i][j] - pixels[i * 4 + j]));
+}
+
+TEST(DxtCompressorTest, two_colors_are_exact)
+{
+    unsigned char pixels[16 * 4];
+    for (int i = 0; i < 16; ++i)
+    {
+        if (i % 3 == 0)
+            setPixel(pixels, i, 0, 0, 0, 255);
+        else
+            setPixel(pixels, i, 255, 255, 255, 255);
+    }
+
+    unsigned char block[Resource::Dxt::sDxt1BlockSize];
+    Resource::Dxt::compressDxt1Block(pixels, block);
+
+    int decoded[16][3];
+    decodeColorBlock(block, decoded);
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 3; ++j)
+            ASSERT_EQ(pixels[i * 4 + j], decoded[i][j]);
+}
+
+TEST(DxtCompressorTest, dxt5_keeps_alpha)
+{
+    unsigned char pixels[16 * 4];
+    for (int i = 0; i < 16; ++i)
+        setPixel(pixels, i, 128, 128, 128, i < 8 ? 0 : 255);
+    setPixel(pixels, 15, 128, 128, 128, 128);
+
+    unsigned char block[Resource::Dxt::sDxt5BlockSize];
+    Resource::Dxt::compressDxt5Block(pixels, block);
+
+    int alphas[16];
+    decodeAlphaBlock(block, alphas);
+    for (int i = 0; i < 15; ++i)
+        ASSERT_EQ(pixels[i * 4 + 3], alphas[i]);
+    ASSERT_GE(19, std::abs(alphas[15] - 128));
+
+    int decoded[16][3];
+    decodeColorBlock(block + 8, decoded);
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 3; ++j)
+            ASSERT_GE(8, std::abs(decoded[i][j] - 128));
+}
@@ -0,0 +1,45 @@
+#include "landmanager.hpp"
+
+#include <osg/Stats>
+
+#include <sstream>
+
+#include <components/resource/objectcache.hpp>
+
+namespace ESMTerrain
+{
+
+LandManager::LandManager(int loadFlags, LandObject::DataMode dataMode)
+    : ResourceManager(NULL)
+    , mLoadFlags(loadFlags)
+    , mDataMode(dataMode)
+{
+}
+
+osg::ref_ptr<LandObject> LandManager::getLand(int x, int y)
+{
+    std::ostringstream id;
+    id << x << " " << y;
+    std::string idstr = id.str();
+
+    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(idstr);
+    if (obj)
+        return static_cast<LandObject*>(obj.get());
+    else
+    {
+        const ESM::Land* land = findLand(x, y);
+        if (!land)
+            return NULL;
+        osg::ref_ptr<LandObject> landObj (new LandObject(land, mLoadFlags, mDataMode));
+        mCache->addEntryToObjectCache(idstr, landObj.get());
+        return landObj;
+    }
+}
+
+void LandManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
+{
+    stats->setAttribute(frameNumber, "Land", mCache->getCacheSize());
+    stats->setAttribute(frameNumber, "Land Memory", LandObject::getTotalMemoryUsage() / 1024.0);
+}
+
+}
@@ -0,0 +1,36 @@
+#ifndef OPENMW_COMPONENTS_ESMTERRAIN_LANDMANAGER_H
+#define OPENMW_COMPONENTS_ESMTERRAIN_LANDMANAGER_H
+
+#include <components/resource/resourcemanager.hpp>
+
+#include "storage.hpp"
+
+namespace ESMTerrain
+{
+
+    /// @brief Caches LandObjects, so that all users of a land's data (terrain rendering, physics, preloading) share one copy of it.
+    class LandManager : public Resource::ResourceManager
+    {
+    public:
+        LandManager(int loadFlags, LandObject::DataMode dataMode = LandObject::Data_Copy);
+
+        /// @note Will return NULL if not found.
+        /// @note Thread safe.
+        osg::ref_ptr<LandObject> getLand(int x, int y);
+
+        /// Reports the number of cached lands and the memory used by all land data in kilobytes.
+        virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
+
+    protected:
+        /// @note May be called from background threads.
+        /// @return NULL if there is no land record for this cell.
+        virtual const ESM::Land* findLand(int x, int y) = 0;
+
+    private:
+        int mLoadFlags;
+        LandObject::DataMode mDataMode;
+    };
+
+}
+
+#endif
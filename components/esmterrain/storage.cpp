@@ -2,6 +2,10 @@
 
 #include <set>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
 
 #include <OpenThreads/ScopedLock>
 
@@ -23,30 +27,139 @@ namespace ESMTerrain
         Map mMap;
     };
 
+    namespace
+    {
+        OpenThreads::Mutex sMemoryUsageMutex;
+        size_t sMemoryUsage = 0;
+    }
+
     LandObject::LandObject()
+        : mLand(NULL)
+        , mLoadFlags(0)
+        , mMinHeight(0)
+        , mMaxHeight(0)
+        , mHeights(NULL)
+        , mQuantizedHeights(NULL)
+        , mNormals(NULL)
+        , mColours(NULL)
+        , mTextures(NULL)
     {
     }
 
-    LandObject::LandObject(const ESM::Land *land, int loadFlags)
+    LandObject::LandObject(const ESM::Land *land, int loadFlags, DataMode mode)
         : mLand(land)
-        , mLoadFlags(loadFlags)
+        , mLoadFlags(0)
+        , mMinHeight(0)
+        , mMaxHeight(0)
+        , mHeights(NULL)
+        , mQuantizedHeights(NULL)
+        , mNormals(NULL)
+        , mColours(NULL)
+        , mTextures(NULL)
     {
-        mLand->loadData(mLoadFlags, &mData);
+        if (mode == Data_Shared && mLand->isDataLoaded(loadFlags))
+        {
+            const ESM::Land::LandData* data = mLand->getLandData();
+            if (!data)
+                return;
+
+            mLoadFlags = data->mDataLoaded & loadFlags;
+            if (mLoadFlags & ESM::Land::DATA_VHGT)
+            {
+                mHeights = data->mHeights;
+                mMinHeight = data->mMinHeight;
+                mMaxHeight = data->mMaxHeight;
+            }
+            if (mLoadFlags & ESM::Land::DATA_VNML)
+                mNormals = data->mNormals;
+            if (mLoadFlags & ESM::Land::DATA_VCLR)
+                mColours = data->mColours;
+            if (mLoadFlags & ESM::Land::DATA_VTEX)
+                mTextures = data->mTextures;
+            return;
+        }
+
+        std::unique_ptr<ESM::Land::LandData> data (new ESM::Land::LandData);
+        mLand->loadData(loadFlags, data.get());
+        copyData(*data, mode == Data_Quantized);
+
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMemoryUsageMutex);
+        sMemoryUsage += getMemoryUsage();
     }
 
     LandObject::LandObject(const LandObject &copy, const osg::CopyOp &copyop)
+        : mLand(NULL)
+        , mLoadFlags(0)
+        , mMinHeight(0)
+        , mMaxHeight(0)
+        , mHeights(NULL)
+        , mQuantizedHeights(NULL)
+        , mNormals(NULL)
+        , mColours(NULL)
+        , mTextures(NULL)
     {
     }
 
     LandObject::~LandObject()
     {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMemoryUsageMutex);
+        sMemoryUsage -= getMemoryUsage();
     }
 
-    const ESM::Land::LandData *LandObject::getData(int flags) const
+    void LandObject::copyData(const ESM::Land::LandData &data, bool quantize)
     {
-        if ((mData.mDataLoaded & flags) != flags)
-            return NULL;
-        return &mData;
+        mLoadFlags = data.mDataLoaded;
+
+        if (mLoadFlags & ESM::Land::DATA_VHGT)
+        {
+            mMinHeight = data.mMinHeight;
+            mMaxHeight = data.mMaxHeight;
+
+            // Heights from content files are sums of 8 bit deltas, scaled by HEIGHT_SCALE, so they usually fit
+            if (quantize)
+            {
+                mQuantizedHeightStorage.resize(ESM::Land::LAND_NUM_VERTS);
+                for (int i=0; i<ESM::Land::LAND_NUM_VERTS; ++i)
+                {
+                    float value = data.mHeights[i] / ESM::Land::HEIGHT_SCALE;
+                    if (value != std::floor(value) || value < std::numeric_limits<short>::min()
+                            || value > std::numeric_limits<short>::max())
+                    {
+                        mQuantizedHeightStorage.clear();
+                        break;
+                    }
+                    mQuantizedHeightStorage[i] = static_cast<short>(value);
+                }
+            }
+
+            if (!mQuantizedHeightStorage.empty())
+                mQuantizedHeights = &mQuantizedHeightStorage[0];
+            else
+            {
+                mHeightStorage.assign(data.mHeights, data.mHeights + ESM::Land::LAND_NUM_VERTS);
+                mHeights = &mHeightStorage[0];
+            }
+        }
+        if (mLoadFlags & ESM::Land::DATA_VNML)
+        {
+            mNormalStorage.assign(data.mNormals, data.mNormals + ESM::Land::LAND_NUM_VERTS * 3);
+            mNormals = &mNormalStorage[0];
+        }
+        if (mLoadFlags & ESM::Land::DATA_VCLR)
+        {
+            mColourStorage.assign(data.mColours, data.mColours + ESM::Land::LAND_NUM_VERTS * 3);
+            mColours = &mColourStorage[0];
+        }
+        if (mLoadFlags & ESM::Land::DATA_VTEX)
+        {
+            mTextureStorage.assign(data.mTextures, data.mTextures + ESM::Land::LAND_NUM_TEXTURES);
+            mTextures = &mTextureStorage[0];
+        }
+    }
+
+    bool LandObject::hasData(int flags) const
+    {
+        return (mLoadFlags & flags) == flags;
     }
 
     int LandObject::getPlugin() const
@@ -54,6 +167,20 @@ namespace ESMTerrain
         return mLand->mPlugin;
     }
 
+    size_t LandObject::getMemoryUsage() const
+    {
+        return mHeightStorage.capacity() * sizeof(float)
+                + mQuantizedHeightStorage.capacity() * sizeof(short)
+                + mNormalStorage.capacity() * sizeof(ESM::Land::VNML)
+                + mColourStorage.capacity() * sizeof(unsigned char)
+                + mTextureStorage.capacity() * sizeof(uint16_t);
+    }
+
+    size_t LandObject::getTotalMemoryUsage()
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMemoryUsageMutex);
+        return sMemoryUsage;
+    }
 
     const float defaultHeight = ESM::Land::DEFAULT_HEIGHT;
 
@@ -83,8 +210,7 @@ namespace ESMTerrain
         int endColumn = startColumn + size * (ESM::Land::LAND_SIZE-1) + 1;
 
         osg::ref_ptr<const LandObject> land = getLand (cellX, cellY);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : 0;
-        if (data)
+        if (land && land->hasData(ESM::Land::DATA_VHGT))
         {
             min = std::numeric_limits<float>::max();
             max = -std::numeric_limits<float>::max();
@@ -92,7 +218,7 @@ namespace ESMTerrain
             {
                 for (int col=startColumn; col<endColumn; ++col)
                 {
-                    float h = data->mHeights[col*ESM::Land::LAND_SIZE+row];
+                    float h = land->getHeight(col*ESM::Land::LAND_SIZE+row);
                     if (h > max)
                         max = h;
                     if (h < min)
@@ -131,12 +257,12 @@ namespace ESMTerrain
         }
 
         const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : 0;
-        if (data)
+        const ESM::Land::VNML* normals = land ? land->getNormals() : 0;
+        if (normals)
         {
-            normal.x() = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3];
-            normal.y() = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+1];
-            normal.z() = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+2];
+            normal.x() = normals[col*ESM::Land::LAND_SIZE*3+row*3];
+            normal.y() = normals[col*ESM::Land::LAND_SIZE*3+row*3+1];
+            normal.z() = normals[col*ESM::Land::LAND_SIZE*3+row*3+2];
             normal.normalize();
         }
         else
@@ -168,12 +294,12 @@ namespace ESMTerrain
         }
 
         const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : 0;
-        if (data)
+        const unsigned char* colours = land ? land->getColours() : 0;
+        if (colours)
         {
-            color.r() = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3] / 255.f;
-            color.g() = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3+1] / 255.f;
-            color.b() = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3+2] / 255.f;
+            color.r() = colours[col*ESM::Land::LAND_SIZE*3+row*3] / 255.f;
+            color.g() = colours[col*ESM::Land::LAND_SIZE*3+row*3+1] / 255.f;
+            color.b() = colours[col*ESM::Land::LAND_SIZE*3+row*3+2] / 255.f;
         }
         else
         {
@@ -217,14 +343,14 @@ namespace ESMTerrain
             for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
             {
                 const LandObject* land = getLand(cellX, cellY, cache);
-                const ESM::Land::LandData *heightData = 0;
-                const ESM::Land::LandData *normalData = 0;
-                const ESM::Land::LandData *colourData = 0;
+                bool hasHeights = false;
+                const ESM::Land::VNML *normalData = 0;
+                const unsigned char *colourData = 0;
                 if (land)
                 {
-                    heightData = land->getData(ESM::Land::DATA_VHGT);
-                    normalData = land->getData(ESM::Land::DATA_VNML);
-                    colourData = land->getData(ESM::Land::DATA_VCLR);
+                    hasHeights = land->hasData(ESM::Land::DATA_VHGT);
+                    normalData = land->getNormals();
+                    colourData = land->getColours();
                 }
 
                 int rowStart = 0;
@@ -258,8 +384,8 @@ namespace ESMTerrain
                         assert (vertY < numVerts);
 
                         float height = defaultHeight;
-                        if (heightData)
-                            height = heightData->mHeights[col*ESM::Land::LAND_SIZE + row];
+                        if (hasHeights)
+                            height = land->getHeight(col*ESM::Land::LAND_SIZE + row);
 
                         (*positions)[static_cast<unsigned int>(vertX*numVerts + vertY)]
                             = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * 8192,
@@ -269,7 +395,7 @@ namespace ESMTerrain
                         if (normalData)
                         {
                             for (int i=0; i<3; ++i)
-                                normal[i] = normalData->mNormals[srcArrayIndex+i];
+                                normal[i] = normalData[srcArrayIndex+i];
 
                             normal.normalize();
                         }
@@ -291,7 +417,7 @@ namespace ESMTerrain
                         if (colourData)
                         {
                             for (int i=0; i<3; ++i)
-                                color[i] = colourData->mColours[srcArrayIndex+i] / 255.f;
+                                color[i] = colourData[srcArrayIndex+i] / 255.f;
                         }
                         else
                         {
@@ -321,42 +447,61 @@ namespace ESMTerrain
         assert(vertY_ == numVerts);  // Ensure we covered whole area
     }
 
-    Storage::UniqueTextureId Storage::getVtexIndexAt(int cellX, int cellY,
-                                           int x, int y, LandCache& cache)
+    void Storage::getVtexIndices(int cellX, int cellY, int rowStart, int colStart, int size,
+                                 std::vector<UniqueTextureId>& ids, LandCache& cache)
     {
-        // For the first/last row/column, we need to get the texture from the neighbour cell
-        // to get consistent blending at the borders
-        --x;
-        if (x < 0)
-        {
-            --cellX;
-            x += ESM::Land::LAND_TEXTURE_SIZE;
-        }
-        while (x >= ESM::Land::LAND_TEXTURE_SIZE)
-        {
-            ++cellX;
-            x -= ESM::Land::LAND_TEXTURE_SIZE;
-        }
-        while (y >= ESM::Land::LAND_TEXTURE_SIZE) // Y appears to be wrapped from the other side because why the hell not?
+        ids.resize(size*size);
+
+        for (int row=0; row<size; ++row)
         {
-            ++cellY;
-            y -= ESM::Land::LAND_TEXTURE_SIZE;
-        }
+            int y = row + colStart;
+            int landY = cellY;
+            while (y >= ESM::Land::LAND_TEXTURE_SIZE) // Y appears to be wrapped from the other side because why the hell not?
+            {
+                ++landY;
+                y -= ESM::Land::LAND_TEXTURE_SIZE;
+            }
 
-        assert(x<ESM::Land::LAND_TEXTURE_SIZE);
-        assert(y<ESM::Land::LAND_TEXTURE_SIZE);
+            // Handle the row in spans of texels from the same cell, so that each cell is only looked up once per row
+            for (int col=0; col<size; )
+            {
+                // For the first/last row/column, we need to get the texture from the neighbour cell
+                // to get consistent blending at the borders
+                int x = col + rowStart - 1;
+                int landX = cellX;
+                if (x < 0)
+                {
+                    --landX;
+                    x += ESM::Land::LAND_TEXTURE_SIZE;
+                }
+                while (x >= ESM::Land::LAND_TEXTURE_SIZE)
+                {
+                    ++landX;
+                    x -= ESM::Land::LAND_TEXTURE_SIZE;
+                }
 
-        const LandObject* land = getLand(cellX, cellY, cache);
+                int span = std::min(ESM::Land::LAND_TEXTURE_SIZE - x, size - col);
 
-        const ESM::Land::LandData *data = land ? land->getData(ESM::Land::DATA_VTEX) : 0;
-        if (data)
-        {
-            int tex = data->mTextures[y * ESM::Land::LAND_TEXTURE_SIZE + x];
-            if (tex == 0)
-                return std::make_pair(0,0); // vtex 0 is always the base texture, regardless of plugin
-            return std::make_pair(tex, land->getPlugin());
+                const LandObject* land = getLand(landX, landY, cache);
+                const uint16_t* data = land ? land->getTextures() : 0;
+
+                UniqueTextureId* out = &ids[row*size + col];
+                if (data)
+                {
+                    const uint16_t* textures = &data[y * ESM::Land::LAND_TEXTURE_SIZE + x];
+                    short plugin = land->getPlugin();
+                    for (int i=0; i<span; ++i)
+                    {
+                        // vtex 0 is always the base texture, regardless of plugin
+                        out[i] = textures[i] == 0 ? UniqueTextureId(0,0) : UniqueTextureId(textures[i], plugin);
+                    }
+                }
+                else
+                    std::fill(out, out + span, UniqueTextureId(0,0));
+
+                col += span;
+            }
         }
-        return std::make_pair(0,0);
     }
 
     std::string Storage::getTextureName(UniqueTextureId id)
@@ -390,8 +535,6 @@ namespace ESMTerrain
 
         int rowStart = (origin.x() - cellX) * realTextureSize;
         int colStart = (origin.y() - cellY) * realTextureSize;
-        int rowEnd = rowStart + chunkSize * (realTextureSize-1) + 1;
-        int colEnd = colStart + chunkSize * (realTextureSize-1) + 1;
 
         // Save the used texture indices so we know the total number of textures
         // and number of required blend maps
@@ -402,25 +545,26 @@ namespace ESMTerrain
         // So we're always adding _land_default.dds as the base layer here, even if it's not referenced in this cell.
         textureIndices.insert(std::make_pair(0,0));
 
+        const int blendmapSize = (realTextureSize-1) * chunkSize + 1;
+
+        // Decode the texture of every texel once, the blend maps are then filled from this grid
         LandCache cache;
+        std::vector<UniqueTextureId> ids;
+        getVtexIndices(cellX, cellY, rowStart, colStart, blendmapSize, ids, cache);
 
-        for (int y=colStart; y<colEnd; ++y)
-            for (int x=rowStart; x<rowEnd; ++x)
-            {
-                UniqueTextureId id = getVtexIndexAt(cellX, cellY, x, y, cache);
-                textureIndices.insert(id);
-            }
+        for (std::vector<UniqueTextureId>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        {
+            // neighbouring texels mostly share their texture
+            if (it == ids.begin() || *it != *(it-1))
+                textureIndices.insert(*it);
+        }
 
         // Makes sure the indices are sorted, or rather,
         // retrieved as sorted. This is important to keep the splatting order
         // consistent across cells.
-        std::map<UniqueTextureId, int> textureIndicesMap;
-        for (std::set<UniqueTextureId>::iterator it = textureIndices.begin(); it != textureIndices.end(); ++it)
-        {
-            int size = textureIndicesMap.size();
-            textureIndicesMap[*it] = size;
+        std::vector<UniqueTextureId> sortedIndices (textureIndices.begin(), textureIndices.end());
+        for (std::vector<UniqueTextureId>::const_iterator it = sortedIndices.begin(); it != sortedIndices.end(); ++it)
             layerList.push_back(getLayerInfo(getTextureName(*it)));
-        }
 
         int numTextures = textureIndices.size();
         // numTextures-1 since the base layer doesn't need blending
@@ -428,35 +572,43 @@ namespace ESMTerrain
 
         int channels = pack ? 4 : 1;
 
-        // Second iteration - create and fill in the blend maps
-        const int blendmapSize = (realTextureSize-1) * chunkSize + 1;
-
+        // Second iteration - create the blend maps, then fill them in with a single pass over the texels
+        std::vector<unsigned char*> blendmapData;
         for (int i=0; i<numBlendmaps; ++i)
         {
             GLenum format = pack ? GL_RGBA : GL_ALPHA;
 
             osg::ref_ptr<osg::Image> image (new osg::Image);
             image->allocateImage(blendmapSize, blendmapSize, 1, format, GL_UNSIGNED_BYTE);
-            unsigned char* pData = image->data();
+            std::memset(image->data(), 0, image->getTotalSizeInBytes());
 
-            for (int y=0; y<blendmapSize; ++y)
+            blendmapData.push_back(image->data());
+            blendmaps.push_back(image);
+        }
+
+        UniqueTextureId lastId (0,0);
+        int layerIndex = 0;
+
+        for (int y=0; y<blendmapSize; ++y)
+        {
+            for (int x=0; x<blendmapSize; ++x)
             {
-                for (int x=0; x<blendmapSize; ++x)
+                UniqueTextureId id = ids[y*blendmapSize + x];
+                if (id != lastId)
                 {
-                    UniqueTextureId id = getVtexIndexAt(cellX, cellY, x+rowStart, y+colStart, cache);
-                    assert(textureIndicesMap.find(id) != textureIndicesMap.end());
-                    int layerIndex = textureIndicesMap.find(id)->second;
-                    int blendIndex = (pack ? static_cast<int>(std::floor((layerIndex - 1) / 4.f)) : layerIndex - 1);
-                    int channel = pack ? std::max(0, (layerIndex-1) % 4) : 0;
-
-                    if (blendIndex == i)
-                        pData[(blendmapSize - y - 1)*blendmapSize*channels + x*channels + channel] = 255;
-                    else
-                        pData[(blendmapSize - y - 1)*blendmapSize*channels + x*channels + channel] = 0;
+                    layerIndex = std::lower_bound(sortedIndices.begin(), sortedIndices.end(), id) - sortedIndices.begin();
+                    lastId = id;
                 }
-            }
 
-            blendmaps.push_back(image);
+                // the base layer is not blended
+                if (layerIndex == 0)
+                    continue;
+
+                int blendIndex = pack ? (layerIndex - 1) / 4 : layerIndex - 1;
+                int channel = pack ? (layerIndex - 1) % 4 : 0;
+
+                blendmapData[blendIndex][(blendmapSize - y - 1)*blendmapSize*channels + x*channels + channel] = 255;
+            }
         }
     }
 
@@ -466,11 +618,7 @@ namespace ESMTerrain
         int cellY = static_cast<int>(std::floor(worldPos.y() / 8192.f));
 
         osg::ref_ptr<const LandObject> land = getLand(cellX, cellY);
-        if (!land)
-            return defaultHeight;
-
-        const ESM::Land::LandData* data = land->getData(ESM::Land::DATA_VHGT);
-        if (!data)
+        if (!land || !land->hasData(ESM::Land::DATA_VHGT))
             return defaultHeight;
 
         // Mostly lifted from Ogre::Terrain::getHeightAtTerrainPosition
@@ -509,10 +657,10 @@ namespace ESMTerrain
         */
 
         // Build all 4 positions in normalized cell space, using point-sampled height
-        osg::Vec3f v0 (startXTS, startYTS, getVertexHeight(data, startX, startY) / 8192.f);
-        osg::Vec3f v1 (endXTS, startYTS, getVertexHeight(data, endX, startY) / 8192.f);
-        osg::Vec3f v2 (endXTS, endYTS, getVertexHeight(data, endX, endY) / 8192.f);
-        osg::Vec3f v3 (startXTS, endYTS, getVertexHeight(data, startX, endY) / 8192.f);
+        osg::Vec3f v0 (startXTS, startYTS, getVertexHeight(land, startX, startY) / 8192.f);
+        osg::Vec3f v1 (endXTS, startYTS, getVertexHeight(land, endX, startY) / 8192.f);
+        osg::Vec3f v2 (endXTS, endYTS, getVertexHeight(land, endX, endY) / 8192.f);
+        osg::Vec3f v3 (startXTS, endYTS, getVertexHeight(land, startX, endY) / 8192.f);
         // define this plane in terrain space
         osg::Plane plane;
         // FIXME: deal with differing triangle alignment
@@ -544,11 +692,11 @@ namespace ESMTerrain
 
     }
 
-    float Storage::getVertexHeight(const ESM::Land::LandData* data, int x, int y)
+    float Storage::getVertexHeight(const LandObject* land, int x, int y)
     {
         assert(x < ESM::Land::LAND_SIZE);
         assert(y < ESM::Land::LAND_SIZE);
-        return data->mHeights[y * ESM::Land::LAND_SIZE + x];
+        return land->getHeight(y * ESM::Land::LAND_SIZE + x);
     }
 
     const LandObject* Storage::getLand(int cellX, int cellY, LandCache& cache)
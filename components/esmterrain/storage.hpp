@@ -1,6 +1,8 @@
 #ifndef COMPONENTS_ESM_TERRAIN_STORAGE_H
 #define COMPONENTS_ESM_TERRAIN_STORAGE_H
 
+#include <vector>
+
 #include <OpenThreads/Mutex>
 
 #include <components/terrain/storage.hpp>
@@ -19,24 +21,77 @@ namespace ESMTerrain
     class LandCache;
 
     /// @brief Wrapper around Land Data with reference counting. The wrapper needs to be held as long as the data is still in use
+    /// @par Only the requested data types are kept, in compact arrays rather than a full ESM::Land::LandData.
     class LandObject : public osg::Object
     {
     public:
+        enum DataMode
+        {
+            Data_Copy,          ///< Load a copy of the data from the content file
+            Data_Quantized,     ///< Like Data_Copy, but store heights as multiples of ESM::Land::HEIGHT_SCALE when that is lossless
+            Data_Shared         ///< Use the data already loaded into the ESM::Land, which must stay loaded as long as this object lives
+        };
+
         LandObject();
-        LandObject(const ESM::Land* land, int loadFlags);
+        LandObject(const ESM::Land* land, int loadFlags, DataMode mode = Data_Copy);
         LandObject(const LandObject& copy, const osg::CopyOp& copyop);
         virtual ~LandObject();
 
         META_Object(ESMTerrain, LandObject)
 
-        const ESM::Land::LandData* getData(int flags) const;
+        /// Check if all of the given ESM::Land::DATA_* types are available.
+        bool hasData(int flags) const;
+
+        /// @return NULL if heights are not loaded or stored quantized.
+        const float* getHeights() const { return mHeights; }
+        /// Heights divided by ESM::Land::HEIGHT_SCALE.
+        /// @return NULL if heights are not loaded or not stored quantized.
+        const short* getQuantizedHeights() const { return mQuantizedHeights; }
+
+        /// @note Requires DATA_VHGT.
+        float getHeight(int index) const
+        {
+            return mHeights ? mHeights[index] : static_cast<float>(mQuantizedHeights[index] * ESM::Land::HEIGHT_SCALE);
+        }
+        float getMinHeight() const { return mMinHeight; }
+        float getMaxHeight() const { return mMaxHeight; }
+
+        /// @return NULL if not loaded.
+        const ESM::Land::VNML* getNormals() const { return mNormals; }
+        /// @return NULL if not loaded.
+        const unsigned char* getColours() const { return mColours; }
+        /// @return NULL if not loaded.
+        const uint16_t* getTextures() const { return mTextures; }
+
         int getPlugin() const;
 
+        /// Size of the data owned by this object in bytes, i.e. 0 for Data_Shared.
+        size_t getMemoryUsage() const;
+
+        /// Memory used by the data of all existing LandObjects in bytes.
+        static size_t getTotalMemoryUsage();
+
     private:
         const ESM::Land* mLand;
         int mLoadFlags;
 
-        ESM::Land::LandData mData;
+        float mMinHeight;
+        float mMaxHeight;
+
+        const float* mHeights;
+        const short* mQuantizedHeights;
+        const ESM::Land::VNML* mNormals;
+        const unsigned char* mColours;
+        const uint16_t* mTextures;
+
+        // Owned data, the pointers above point either here or into the ESM::Land
+        std::vector<float> mHeightStorage;
+        std::vector<short> mQuantizedHeightStorage;
+        std::vector<ESM::Land::VNML> mNormalStorage;
+        std::vector<unsigned char> mColourStorage;
+        std::vector<uint16_t> mTextureStorage;
+
+        void copyData(const ESM::Land::LandData& data, bool quantize);
     };
 
     /// @brief Feeds data from ESM terrain records (ESM::Land, ESM::LandTexture)
@@ -111,7 +166,7 @@ namespace ESMTerrain
         void fixColour (osg::Vec4f& colour, int cellX, int cellY, int col, int row, LandCache& cache);
         void averageNormal (osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache);
 
-        float getVertexHeight (const ESM::Land::LandData* data, int x, int y);
+        float getVertexHeight (const LandObject* land, int x, int y);
 
         const LandObject* getLand(int cellX, int cellY, LandCache& cache);
 
@@ -120,8 +175,10 @@ namespace ESMTerrain
         // pair  <texture id, plugin id>
         typedef std::pair<short, short> UniqueTextureId;
 
-        UniqueTextureId getVtexIndexAt(int cellX, int cellY,
-                                               int x, int y, LandCache&);
+        /// Decode the textures of the \a size x \a size texels starting at (\a rowStart, \a colStart)
+        /// relative to the given cell into \a ids, in row-major order.
+        void getVtexIndices(int cellX, int cellY, int rowStart, int colStart, int size,
+                            std::vector<UniqueTextureId>& ids, LandCache& cache);
         std::string getTextureName (UniqueTextureId id);
 
         std::map<std::string, Terrain::LayerInfo> mLayerInfoMap;
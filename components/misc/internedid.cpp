@@ -0,0 +1,177 @@
+#include "internedid.hpp"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+#include "stringops.hpp"
+
+namespace
+{
+    /// @brief Open addressing hash table of the interned strings.
+    /// @par Slots are only ever filled, never cleared, so readers can probe it without a lock. When the table gets
+    /// too full, it is replaced by a larger copy. The old table is kept, because readers may still be probing it.
+    struct Table
+    {
+        explicit Table(std::size_t capacity)
+            : mMask(capacity - 1)
+            , mSize(0)
+            , mSlots(new std::atomic<const std::string*>[capacity])
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+                mSlots[i].store(NULL, std::memory_order_relaxed);
+        }
+
+        std::size_t mMask;
+        std::size_t mSize; ///< Only used by writers.
+        std::unique_ptr<std::atomic<const std::string*>[]> mSlots;
+    };
+
+    const std::size_t sInitialCapacity = 1024;
+
+    /// Hash of @a id folded to lower case, so that lookups do not need a lower case copy.
+    std::size_t hashLowerCase(const std::string& id)
+    {
+        // FNV-1a
+        std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+        for (std::string::const_iterator it = id.begin(); it != id.end(); ++it)
+        {
+            hash ^= static_cast<unsigned char>(Misc::StringUtils::toLower(*it));
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+
+    /// @param lowerCase A string in lower case.
+    bool equalsLowerCase(const std::string& lowerCase, const std::string& id)
+    {
+        if (lowerCase.size() != id.size())
+            return false;
+        for (std::size_t i = 0; i < id.size(); ++i)
+            if (lowerCase[i] != Misc::StringUtils::toLower(id[i]))
+                return false;
+        return true;
+    }
+
+    const std::string* find(const Table& table, const std::string& id, std::size_t hash)
+    {
+        for (std::size_t i = hash & table.mMask; ; i = (i + 1) & table.mMask)
+        {
+            const std::string* string = table.mSlots[i].load(std::memory_order_acquire);
+            if (!string || equalsLowerCase(*string, id))
+                return string;
+        }
+    }
+
+    /// @note Requires the writer mutex to be locked, and @a string to be missing from @a table.
+    void insert(Table& table, const std::string* string, std::size_t hash)
+    {
+        std::size_t i = hash & table.mMask;
+        while (table.mSlots[i].load(std::memory_order_relaxed))
+            i = (i + 1) & table.mMask;
+        table.mSlots[i].store(string, std::memory_order_release);
+        ++table.mSize;
+    }
+
+    // Function statics, so that InternedIds can be used during static initialisation.
+    std::atomic<Table*>& getTable()
+    {
+        static std::atomic<Table*> table(NULL);
+        return table;
+    }
+
+    struct Writer
+    {
+        OpenThreads::Mutex mMutex;
+        std::deque<std::string> mStrings; ///< Elements of a deque do not move when it grows at the end.
+        std::vector<std::unique_ptr<Table> > mTables; ///< The current table and the ones it replaced.
+    };
+
+    Writer& getWriter()
+    {
+        static Writer writer;
+        return writer;
+    }
+
+    const std::string* search(const std::string& id, std::size_t hash)
+    {
+        const Table* table = getTable().load(std::memory_order_acquire);
+        return table ? find(*table, id, hash) : NULL;
+    }
+
+    /// Not part of the table, so that the default constructor does not need to lock.
+    const std::string* getEmpty()
+    {
+        static const std::string empty;
+        return &empty;
+    }
+}
+
+namespace Misc
+{
+
+InternedId::InternedId()
+    : mString(getEmpty())
+{
+}
+
+InternedId::InternedId(const std::string& id)
+{
+    if (id.empty())
+    {
+        mString = getEmpty();
+        return;
+    }
+
+    const std::size_t hash = hashLowerCase(id);
+    mString = ::search(id, hash);
+    if (mString)
+        return;
+
+    Writer& writer = getWriter();
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(writer.mMutex);
+
+    // Another thread may have interned the ID in the meantime
+    mString = ::search(id, hash);
+    if (mString)
+        return;
+
+    Table* table = getTable().load(std::memory_order_relaxed);
+    // Keep the table at most half full, so that probe sequences stay short
+    if (!table || (table->mSize + 1) * 2 > table->mMask + 1)
+    {
+        std::unique_ptr<Table> grown(new Table(table ? (table->mMask + 1) * 2 : sInitialCapacity));
+        for (std::deque<std::string>::const_iterator it = writer.mStrings.begin(); it != writer.mStrings.end(); ++it)
+            insert(*grown, &*it, hashLowerCase(*it));
+
+        table = grown.get();
+        writer.mTables.push_back(std::move(grown));
+        getTable().store(table, std::memory_order_release);
+    }
+
+    writer.mStrings.push_back(StringUtils::lowerCase(id));
+    mString = &writer.mStrings.back();
+    insert(*table, mString, hash);
+}
+
+bool InternedId::search(const std::string& id, InternedId& result)
+{
+    if (id.empty())
+    {
+        result.mString = getEmpty();
+        return true;
+    }
+
+    const std::string* found = ::search(id, hashLowerCase(id));
+    if (!found)
+        return false;
+
+    result.mString = found;
+    return true;
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_MISC_INTERNEDID_H
+#define OPENMW_COMPONENTS_MISC_INTERNEDID_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Misc
+{
+
+/// @brief Case-folded record ID that is stored only once for the whole program.
+/// @par The ID is folded to lower case when it is interned. Afterwards, comparing two InternedIds for equality and
+/// hashing them only looks at a pointer, without allocating or touching the characters.
+/// @par Interned strings are never released, so only record IDs should be interned. Use search() to look up IDs
+/// that may not belong to any record, e.g. those coming from scripts or the console.
+/// @note Thread safe.
+class InternedId
+{
+public:
+    /// The empty ID.
+    InternedId();
+
+    /// Intern @a id, ignoring case.
+    explicit InternedId(const std::string& id);
+
+    /// Look up @a id, ignoring case, without interning it. Does not allocate or lock.
+    /// @return Has @a id been interned before? If not, @a result is not changed.
+    static bool search(const std::string& id, InternedId& result);
+
+    /// @return The ID in lower case.
+    const std::string& str() const { return *mString; }
+
+    bool empty() const { return mString->empty(); }
+
+    bool operator==(const InternedId& other) const { return mString == other.mString; }
+
+    bool operator!=(const InternedId& other) const { return mString != other.mString; }
+
+    /// Orders by the lower case ID, so that ordered containers do not depend on where the IDs are stored.
+    bool operator<(const InternedId& other) const { return mString != other.mString && *mString < *other.mString; }
+
+    std::size_t hash() const { return std::hash<const std::string*>()(mString); }
+
+private:
+    const std::string* mString;
+};
+
+}
+
+namespace std
+{
+    template<>
+    struct hash<Misc::InternedId>
+    {
+        size_t operator()(const Misc::InternedId& id) const
+        {
+            return id.hash();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,236 @@
+#include "trace.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+namespace
+{
+    struct Event
+    {
+        const char* mName;
+        osg::Timer_t mBegin;
+        osg::Timer_t mEnd;
+    };
+
+    /// Events recorded by one thread, so that threads do not contend for a lock while recording.
+    /// @note Every thread that records gets its own buffer, whether it was created by OpenThreads or not.
+    struct ThreadBuffer
+    {
+        /// Guarded by sMutex, empty if the thread was not named.
+        std::string mName;
+        /// Only contended while the trace is written.
+        OpenThreads::Mutex mMutex;
+        std::vector<Event> mEvents;
+    };
+
+    struct FrameEvent
+    {
+        unsigned int mFrameNumber;
+        osg::Timer_t mBegin;
+        osg::Timer_t mEnd;
+    };
+
+    OpenThreads::Mutex sMutex;
+
+    unsigned int sFirstFrame = 0;
+    unsigned int sFrameCount = 0;
+    std::string sFile;
+
+    osg::Timer_t sOrigin = 0;
+    osg::Timer_t sFrameBegin = 0;
+    unsigned int sFrameNumber = 0;
+
+    std::vector<std::unique_ptr<ThreadBuffer> > sBuffers;
+    std::vector<FrameEvent> sFrames;
+    /// The thread that calls Trace::frame.
+    const ThreadBuffer* sMainBuffer = NULL;
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        // Buffers are never deleted, so the pointer stays valid for the lifetime of the thread
+        static thread_local ThreadBuffer* buffer = NULL;
+        if (!buffer)
+        {
+            std::unique_ptr<ThreadBuffer> created(new ThreadBuffer);
+
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMutex);
+            buffer = created.get();
+            sBuffers.push_back(std::move(created));
+        }
+        return *buffer;
+    }
+
+    void writeEscaped(std::ostream& stream, const std::string& text)
+    {
+        stream << '"';
+        for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+        {
+            if (*it == '"' || *it == '\\')
+                stream << '\\';
+            if (static_cast<unsigned char>(*it) >= 0x20)
+                stream << *it;
+        }
+        stream << '"';
+    }
+
+    void writeDuration(std::ostream& stream, osg::Timer_t begin, osg::Timer_t end)
+    {
+        const osg::Timer* timer = osg::Timer::instance();
+        stream << "\"ts\":" << timer->delta_u(sOrigin, begin) << ",\"dur\":" << timer->delta_u(begin, end);
+    }
+
+    /// Write the recorded events and clear them, must be called with sMutex held.
+    void writeTrace()
+    {
+        // The main thread is always listed as tid 0, as the frames are put there
+        std::vector<const ThreadBuffer*> threads;
+        std::vector<std::vector<Event> > threadEvents;
+        threads.push_back(sMainBuffer);
+        threadEvents.push_back(std::vector<Event>());
+        for (std::vector<std::unique_ptr<ThreadBuffer> >::const_iterator it = sBuffers.begin(); it != sBuffers.end(); ++it)
+        {
+            std::vector<Event> events;
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock((*it)->mMutex);
+                events.swap((*it)->mEvents);
+            }
+
+            if (it->get() == sMainBuffer)
+                threadEvents[0].swap(events);
+            else if (!events.empty())
+            {
+                threads.push_back(it->get());
+                threadEvents.push_back(std::vector<Event>());
+                threadEvents.back().swap(events);
+            }
+        }
+
+        std::ofstream stream(sFile.c_str());
+        stream.precision(3);
+        stream.setf(std::ios::fixed, std::ios::floatfield);
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            std::ostringstream name;
+            if (threads[i] && !threads[i]->mName.empty())
+                name << threads[i]->mName;
+            else if (i == 0)
+                name << "Main";
+            else
+                name << "Thread " << i;
+
+            stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":";
+            writeEscaped(stream, name.str());
+            stream << "}},\n";
+        }
+
+        for (std::vector<FrameEvent>::const_iterator it = sFrames.begin(); it != sFrames.end(); ++it)
+        {
+            stream << "{\"ph\":\"X\",\"cat\":\"frame\",\"name\":\"Frame " << it->mFrameNumber << "\",\"pid\":0,\"tid\":0,";
+            writeDuration(stream, it->mBegin, it->mEnd);
+            stream << "},\n";
+        }
+
+        for (std::size_t i = 0; i < threadEvents.size(); ++i)
+        {
+            const std::vector<Event>& events = threadEvents[i];
+            for (std::vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it)
+            {
+                // The scope may have been entered before recording started
+                if (it->mBegin < sOrigin)
+                    continue;
+
+                stream << "{\"ph\":\"X\",\"cat\":\"openmw\",\"name\":";
+                writeEscaped(stream, it->mName);
+                stream << ",\"pid\":0,\"tid\":" << i << ",";
+                writeDuration(stream, it->mBegin, it->mEnd);
+                stream << "},\n";
+            }
+        }
+
+        // Closing metadata event, so that every other event can be followed by a comma
+        stream << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":0,\"args\":{\"name\":\"openmw\"}}\n]}\n";
+
+        if (stream.fail())
+            std::cerr << "Error: Failed to write trace to " << sFile << std::endl;
+        else
+            std::cout << "Wrote trace of " << sFrames.size() << " frames to " << sFile << std::endl;
+    }
+}
+
+namespace Misc
+{
+
+OpenThreads::Atomic Trace::sRecording;
+
+void Trace::setFrameRange(unsigned int firstFrame, unsigned int frameCount, const std::string& file)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMutex);
+    sFirstFrame = firstFrame;
+    sFrameCount = frameCount;
+    sFile = file;
+}
+
+void Trace::frame(unsigned int frameNumber)
+{
+    const ThreadBuffer& buffer = getThreadBuffer();
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMutex);
+
+    sMainBuffer = &buffer;
+
+    osg::Timer_t now = osg::Timer::instance()->tick();
+
+    if (isRecording())
+    {
+        FrameEvent frameEvent = { sFrameNumber, sFrameBegin, now };
+        sFrames.push_back(frameEvent);
+
+        if (frameNumber >= sFirstFrame + sFrameCount)
+        {
+            sRecording.exchange(0);
+            writeTrace();
+            sFrames.clear();
+            sFrameCount = 0;
+        }
+    }
+    else if (sFrameCount > 0 && frameNumber >= sFirstFrame)
+    {
+        sOrigin = now;
+        sRecording.exchange(1);
+    }
+
+    sFrameNumber = frameNumber;
+    sFrameBegin = now;
+}
+
+void Trace::setThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(sMutex);
+    buffer.mName = name;
+}
+
+void Trace::addEvent(const char* name, osg::Timer_t begin, osg::Timer_t end)
+{
+    // The scope may have been entered before recording stopped
+    if (!isRecording())
+        return;
+
+    ThreadBuffer& buffer = getThreadBuffer();
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(buffer.mMutex);
+
+    Event event = { name, begin, end };
+    buffer.mEvents.push_back(event);
+}
+
+}
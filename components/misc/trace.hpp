@@ -0,0 +1,65 @@
+#ifndef OPENMW_COMPONENTS_MISC_TRACE_H
+#define OPENMW_COMPONENTS_MISC_TRACE_H
+
+#include <string>
+
+#include <osg/Timer>
+
+#include <OpenThreads/Atomic>
+
+namespace Misc
+{
+
+/// @brief Records timed scopes from any thread and writes them out in the Chrome trace event format,
+/// which can be inspected with chrome://tracing or Perfetto.
+/// @par Recording is limited to a range of frames. Outside of that range a ScopedTrace only checks a flag.
+/// Every thread records into its own buffer, so that recording does not make the threads wait for each other.
+class Trace
+{
+public:
+    /// Record the frames [firstFrame, firstFrame+frameCount) and write them to @a file once done.
+    /// @param frameCount 0 disables tracing.
+    static void setFrameRange(unsigned int firstFrame, unsigned int frameCount, const std::string& file);
+
+    /// Notify about the start of a new frame, which starts or stops recording as needed. Main thread only.
+    static void frame(unsigned int frameNumber);
+
+    static bool isRecording() { return sRecording != 0; }
+
+    /// Name the calling thread in the trace output.
+    static void setThreadName(const std::string& name);
+
+    /// @param name must remain valid until the trace is written, i.e. usually a string literal.
+    static void addEvent(const char* name, osg::Timer_t begin, osg::Timer_t end);
+
+private:
+    static OpenThreads::Atomic sRecording;
+};
+
+/// @brief Adds an event covering its own lifetime to the trace, if recording.
+/// @param name must remain valid until the trace is written, i.e. usually a string literal.
+class ScopedTrace
+{
+public:
+    explicit ScopedTrace(const char* name)
+        : mName(name), mBegin(Trace::isRecording() ? osg::Timer::instance()->tick() : 0)
+    {
+    }
+
+    ~ScopedTrace()
+    {
+        if (mBegin)
+            Trace::addEvent(mName, mBegin, osg::Timer::instance()->tick());
+    }
+
+private:
+    ScopedTrace(const ScopedTrace&);
+    ScopedTrace& operator=(const ScopedTrace&);
+
+    const char* mName;
+    osg::Timer_t mBegin;
+};
+
+}
+
+#endif
@@ -31,6 +31,7 @@ namespace NifBullet
 
 /**
 *Load bulletShape from NIF files.
+*@note Shapes are cached on disk by Resource::BulletShapeFileCache. Increase its sVersion when changing the shapes made here.
 */
 class BulletNifLoader
 {
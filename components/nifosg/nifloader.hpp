@@ -7,6 +7,7 @@
 #include <osg/Referenced>
 
 #include "controller.hpp"
+#include "textkeymap.hpp"
 
 namespace osg
 {
@@ -20,8 +21,6 @@ namespace Resource
 
 namespace NifOsg
 {
-    typedef std::multimap<float,std::string> TextKeyMap;
-
     struct TextKeyMapHolder : public osg::Object
     {
     public:
@@ -45,10 +44,14 @@ namespace NifOsg
             : mTextKeys(copy.mTextKeys)
             , mKeyframeControllers(copy.mKeyframeControllers)
         {
+            mTextKeyIndex.build(mTextKeys);
         }
 
         TextKeyMap mTextKeys;
 
+        /// Index of mTextKeys, needs to be rebuilt when mTextKeys is changed.
+        TextKeyIndex mTextKeyIndex;
+
         META_Object(OpenMW, KeyframeHolder)
 
         typedef std::map<std::string, osg::ref_ptr<const KeyframeController> > KeyframeControllerMap;
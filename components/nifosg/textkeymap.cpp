@@ -0,0 +1,106 @@
+#include "textkeymap.hpp"
+
+namespace
+{
+    bool startsWith(const std::string& string, const std::string& prefix)
+    {
+        return string.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+namespace NifOsg
+{
+
+    const TextKeyGroup::Key* TextKeyGroup::findFirst(const std::string& tag) const
+    {
+        KeyMap::const_iterator found = mKeys.lower_bound(tag);
+        if (found == mKeys.end() || found->first != tag)
+            return NULL;
+        return &found->second;
+    }
+
+    const TextKeyGroup::Key* TextKeyGroup::findLast(const std::string& tag) const
+    {
+        KeyMap::const_iterator end = mKeys.upper_bound(tag);
+        if (end == mKeys.begin())
+            return NULL;
+        --end;
+        if (end->first != tag)
+            return NULL;
+        return &end->second;
+    }
+
+    const TextKeyGroup::Key* TextKeyGroup::findFirstStartingWith(const std::string& prefix) const
+    {
+        const Key* result = NULL;
+        for (KeyMap::const_iterator it = mKeys.lower_bound(prefix); it != mKeys.end() && startsWith(it->first, prefix); ++it)
+        {
+            if (!result || it->second.mIndex < result->mIndex)
+                result = &it->second;
+        }
+        return result;
+    }
+
+    const TextKeyGroup::Key* TextKeyGroup::findLastStartingWith(const std::string& prefix) const
+    {
+        const Key* result = NULL;
+        for (KeyMap::const_iterator it = mKeys.lower_bound(prefix); it != mKeys.end() && startsWith(it->first, prefix); ++it)
+        {
+            if (!result || it->second.mIndex > result->mIndex)
+                result = &it->second;
+        }
+        return result;
+    }
+
+    bool TextKeyGroup::isKey(TextKeyMap::const_iterator key, const std::string& tag) const
+    {
+        std::pair<KeyMap::const_iterator, KeyMap::const_iterator> range = mKeys.equal_range(tag);
+        for (KeyMap::const_iterator it = range.first; it != range.second; ++it)
+        {
+            if (it->second.mIter == key)
+                return true;
+        }
+        return false;
+    }
+
+    void TextKeyIndex::build(const TextKeyMap& keys)
+    {
+        mGroups.clear();
+
+        std::size_t index = 0;
+        for (TextKeyMap::const_iterator it = keys.begin(); it != keys.end(); ++it, ++index)
+        {
+            const std::string& text = it->second;
+            std::string::size_type separator = text.find(": ");
+            if (separator == std::string::npos)
+                continue;
+
+            TextKeyGroup::Key key;
+            key.mIter = it;
+            key.mIndex = index;
+
+            std::pair<GroupMap::iterator, bool> inserted = mGroups.insert(std::make_pair(text.substr(0, separator), TextKeyGroup()));
+            TextKeyGroup& group = inserted.first->second;
+            if (inserted.second)
+                group.mFirst = key;
+            group.mLast = key;
+
+            // Keys with equal tags are inserted after the existing ones, so they stay in the order of the TextKeyMap
+            group.mKeys.insert(std::make_pair(text.substr(separator+2), key));
+        }
+    }
+
+    void TextKeyIndex::clear()
+    {
+        mGroups.clear();
+    }
+
+    const TextKeyGroup* TextKeyIndex::find(const std::string& group) const
+    {
+        GroupMap::const_iterator found = mGroups.find(group);
+        if (found == mGroups.end())
+            return NULL;
+        return &found->second;
+    }
+
+}
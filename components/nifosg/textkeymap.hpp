@@ -0,0 +1,69 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_TEXTKEYMAP
+#define OPENMW_COMPONENTS_NIFOSG_TEXTKEYMAP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace NifOsg
+{
+    typedef std::multimap<float,std::string> TextKeyMap;
+
+    /// @brief The text keys of one animation group, i.e. the keys named "<group>: <tag>".
+    struct TextKeyGroup
+    {
+        struct Key
+        {
+            TextKeyMap::const_iterator mIter;
+
+            /// Position of the key in the TextKeyMap, keys at the same time are ordered by this.
+            std::size_t mIndex;
+        };
+
+        /// Keys by their tag, keys with the same tag are in the order of the TextKeyMap.
+        typedef std::multimap<std::string, Key> KeyMap;
+        KeyMap mKeys;
+
+        /// First and last key of the group in the TextKeyMap.
+        Key mFirst;
+        Key mLast;
+
+        /// @return The first key with the given tag, or NULL if there is none.
+        const Key* findFirst(const std::string& tag) const;
+
+        /// @return The last key with the given tag, or NULL if there is none.
+        const Key* findLast(const std::string& tag) const;
+
+        /// @return The first key whose tag starts with @a prefix, or NULL if there is none.
+        const Key* findFirstStartingWith(const std::string& prefix) const;
+
+        /// @return The last key whose tag starts with @a prefix, or NULL if there is none.
+        const Key* findLastStartingWith(const std::string& prefix) const;
+
+        /// @return Is @a key one of the keys with the given tag?
+        bool isKey(TextKeyMap::const_iterator key, const std::string& tag) const;
+    };
+
+    /// @brief Groups the text keys of an animation by their group name, so that the keys of a group can be found
+    /// without comparing the text of every key.
+    /// @note The index refers to the keys by iterator, so the TextKeyMap must not be changed or destroyed while
+    /// the index is used.
+    class TextKeyIndex
+    {
+    public:
+        /// Index the keys in @a keys, replacing the previous contents.
+        void build(const TextKeyMap& keys);
+
+        void clear();
+
+        /// @return The keys of the given group, or NULL if the animation does not have it.
+        const TextKeyGroup* find(const std::string& group) const;
+
+    private:
+        typedef std::unordered_map<std::string, TextKeyGroup> GroupMap;
+        GroupMap mGroups;
+    };
+}
+
+#endif
@@ -7,7 +7,9 @@
 #include <osg/ref_ptr>
 #include <osg/Vec3f>
 
+#include <LinearMath/btAlignedAllocator.h>
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
 
 class btCollisionShape;
 
@@ -66,14 +68,32 @@ namespace Resource
     {
         TriangleMeshShape(btStridingMeshInterface* meshInterface, bool useQuantizedAabbCompression, bool buildBvh = true)
             : btBvhTriangleMeshShape(meshInterface, useQuantizedAabbCompression, buildBvh)
+            , mBvhBuffer(NULL)
         {
         }
 
         virtual ~TriangleMeshShape()
         {
+            if (mBvhBuffer)
+            {
+                if (!m_ownsBvh)
+                    m_bvh->~btOptimizedBvh();
+                btAlignedFree(mBvhBuffer);
+            }
             delete getTriangleInfoMap();
             delete m_meshInterface;
         }
+
+        /// Use a bounding volume hierarchy that was deserialized in place, taking ownership of its buffer.
+        /// @param scaling The local scaling the hierarchy was built with.
+        void setSerializedBvh(btOptimizedBvh* bvh, void* buffer, const btVector3& scaling)
+        {
+            mBvhBuffer = buffer;
+            setOptimizedBvh(bvh, scaling);
+        }
+
+    private:
+        void* mBvhBuffer;
     };
 
 
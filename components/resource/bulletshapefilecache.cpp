@@ -0,0 +1,418 @@
+#include "bulletshapefilecache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <LinearMath/btScalar.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include "bulletshape.hpp"
+
+namespace
+{
+    const char sMagic[8] = { 'O', 'M', 'W', 'S', 'H', 'A', 'P', 'E' };
+
+    /// Increase whenever the file format changes, to invalidate existing files.
+    /// @note Also increase it whenever the shapes made for a mesh change, i.e. for changes of NifBullet::BulletNifLoader
+    /// or of the NodeToShapeVisitor in bulletshapemanager.cpp. Files only record the hash of the mesh, so shapes made by an
+    /// older loader would be used otherwise.
+    const std::uint32_t sVersion = 1;
+
+    /// Nesting limit for compound shapes, to guard against broken files.
+    const int sMaxDepth = 8;
+
+    enum ShapeType
+    {
+        Shape_None = 0,
+        Shape_Box = 1,
+        Shape_TriangleMesh = 2,
+        Shape_Compound = 3
+    };
+
+    template <class T>
+    void writeValue(std::ostream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    T readValue(std::istream& stream)
+    {
+        T value;
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!stream)
+            throw std::runtime_error("unexpected end of file");
+        return value;
+    }
+
+    /// @return The number of bytes left in @a stream.
+    std::uint64_t getRemaining(std::istream& stream)
+    {
+        std::istream::pos_type position = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        std::istream::pos_type end = stream.tellg();
+        stream.seekg(position);
+        if (!stream || position < 0 || end < position)
+            throw std::runtime_error("failed to get the size of the file");
+        return static_cast<std::uint64_t>(end - position);
+    }
+
+    /// Check that @a count items of at least @a itemSize bytes each may follow in @a stream, to guard against
+    /// allocating huge amounts of memory for broken files.
+    void checkCount(std::istream& stream, std::uint64_t count, std::uint64_t itemSize)
+    {
+        if (count > getRemaining(stream) / itemSize)
+            throw std::runtime_error("invalid number of elements");
+    }
+
+    void writeVector(std::ostream& stream, const btVector3& vector)
+    {
+        writeValue(stream, vector.x());
+        writeValue(stream, vector.y());
+        writeValue(stream, vector.z());
+    }
+
+    btVector3 readVector(std::istream& stream)
+    {
+        btScalar x = readValue<btScalar>(stream);
+        btScalar y = readValue<btScalar>(stream);
+        btScalar z = readValue<btScalar>(stream);
+        return btVector3(x, y, z);
+    }
+
+    void writeString(std::ostream& stream, const std::string& string)
+    {
+        writeValue(stream, static_cast<std::uint32_t>(string.size()));
+        stream.write(string.data(), string.size());
+    }
+
+    std::string readString(std::istream& stream)
+    {
+        std::uint32_t size = readValue<std::uint32_t>(stream);
+        if (size > 4096)
+            throw std::runtime_error("invalid string length");
+        std::string string(size, '\0');
+        stream.read(&string[0], size);
+        if (!stream)
+            throw std::runtime_error("unexpected end of file");
+        return string;
+    }
+
+    btVector3 getVertex(const unsigned char* vertexBase, int vertexStride, PHY_ScalarType vertexType, int index)
+    {
+        const unsigned char* vertex = vertexBase + index * vertexStride;
+        if (vertexType == PHY_DOUBLE)
+        {
+            const double* values = reinterpret_cast<const double*>(vertex);
+            return btVector3(static_cast<btScalar>(values[0]), static_cast<btScalar>(values[1]), static_cast<btScalar>(values[2]));
+        }
+        const float* values = reinterpret_cast<const float*>(vertex);
+        return btVector3(values[0], values[1], values[2]);
+    }
+
+    bool writeTriangles(std::ostream& stream, const btTriangleMesh& mesh)
+    {
+        if (mesh.getNumSubParts() != 1)
+            return false;
+
+        const unsigned char* vertexBase = NULL;
+        int numVertices = 0;
+        PHY_ScalarType vertexType;
+        int vertexStride = 0;
+        const unsigned char* indexBase = NULL;
+        int indexStride = 0;
+        int numTriangles = 0;
+        PHY_ScalarType indexType;
+        mesh.getLockedReadOnlyVertexIndexBase(&vertexBase, numVertices, vertexType, vertexStride,
+                                              &indexBase, indexStride, numTriangles, indexType);
+
+        bool supported = (vertexType == PHY_FLOAT || vertexType == PHY_DOUBLE) && (indexType == PHY_INTEGER || indexType == PHY_SHORT);
+        if (supported)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(numTriangles));
+
+            for (int i = 0; i < numTriangles; ++i)
+            {
+                const unsigned char* triangle = indexBase + i * indexStride;
+                for (int j = 0; j < 3; ++j)
+                {
+                    int index = indexType == PHY_SHORT ? reinterpret_cast<const unsigned short*>(triangle)[j]
+                                                       : reinterpret_cast<const int*>(triangle)[j];
+                    writeVector(stream, getVertex(vertexBase, vertexStride, vertexType, index));
+                }
+            }
+        }
+
+        mesh.unLockReadOnlyVertexBase(0);
+        return supported;
+    }
+
+    bool writeShape(std::ostream& stream, const btCollisionShape* shape)
+    {
+        if (!shape)
+        {
+            writeValue(stream, static_cast<std::uint8_t>(Shape_None));
+            return true;
+        }
+
+        if (shape->isCompound())
+        {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            writeValue(stream, static_cast<std::uint8_t>(Shape_Compound));
+            writeValue(stream, static_cast<std::uint32_t>(compound->getNumChildShapes()));
+
+            for (int i = 0; i < compound->getNumChildShapes(); ++i)
+            {
+                const btTransform& transform = compound->getChildTransform(i);
+                btQuaternion rotation = transform.getRotation();
+                writeVector(stream, transform.getOrigin());
+                writeValue(stream, rotation.x());
+                writeValue(stream, rotation.y());
+                writeValue(stream, rotation.z());
+                writeValue(stream, rotation.w());
+
+                if (!writeShape(stream, compound->getChildShape(i)))
+                    return false;
+            }
+            return true;
+        }
+
+        if (const btBoxShape* box = dynamic_cast<const btBoxShape*>(shape))
+        {
+            if (box->getLocalScaling() != btVector3(1.f, 1.f, 1.f))
+                return false;
+
+            writeValue(stream, static_cast<std::uint8_t>(Shape_Box));
+            writeVector(stream, box->getHalfExtentsWithMargin());
+            return true;
+        }
+
+        if (const Resource::TriangleMeshShape* meshShape = dynamic_cast<const Resource::TriangleMeshShape*>(shape))
+        {
+            const btTriangleMesh* mesh = dynamic_cast<const btTriangleMesh*>(meshShape->getMeshInterface());
+            const btOptimizedBvh* bvh = const_cast<Resource::TriangleMeshShape*>(meshShape)->getOptimizedBvh();
+            if (!mesh || !bvh)
+                return false;
+
+            writeValue(stream, static_cast<std::uint8_t>(Shape_TriangleMesh));
+            writeValue(stream, static_cast<std::uint8_t>(mesh->getUse32bitIndices()));
+            writeValue(stream, static_cast<std::uint8_t>(mesh->getUse4componentVertices()));
+            writeValue(stream, static_cast<std::uint8_t>(meshShape->usesQuantizedAabbCompression()));
+            writeVector(stream, meshShape->getLocalScaling());
+
+            if (!writeTriangles(stream, *mesh))
+                return false;
+
+            unsigned int size = bvh->calculateSerializeBufferSize();
+            void* buffer = btAlignedAlloc(size, 16);
+            bool serialized = bvh->serializeInPlace(buffer, size, false);
+            if (serialized)
+            {
+                writeValue(stream, static_cast<std::uint32_t>(size));
+                stream.write(static_cast<const char*>(buffer), size);
+            }
+            btAlignedFree(buffer);
+            return serialized;
+        }
+
+        return false;
+    }
+
+    void deleteShape(btCollisionShape* shape)
+    {
+        if (shape && shape->isCompound())
+        {
+            btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+            for (int i = 0; i < compound->getNumChildShapes(); ++i)
+                deleteShape(compound->getChildShape(i));
+        }
+        delete shape;
+    }
+
+    btCollisionShape* readShape(std::istream& stream, int depth)
+    {
+        switch (readValue<std::uint8_t>(stream))
+        {
+            case Shape_None:
+
+                return NULL;
+
+            case Shape_Compound:
+            {
+                if (depth >= sMaxDepth)
+                    throw std::runtime_error("compound shapes nested too deeply");
+
+                std::uint32_t numChildren = readValue<std::uint32_t>(stream);
+                // a transform and the type of the child shape
+                checkCount(stream, numChildren, 7 * sizeof(btScalar) + 1);
+
+                btCompoundShape* compound = new btCompoundShape;
+                try
+                {
+                    for (std::uint32_t i = 0; i < numChildren; ++i)
+                    {
+                        btVector3 origin = readVector(stream);
+                        btScalar x = readValue<btScalar>(stream);
+                        btScalar y = readValue<btScalar>(stream);
+                        btScalar z = readValue<btScalar>(stream);
+                        btScalar w = readValue<btScalar>(stream);
+
+                        btCollisionShape* child = readShape(stream, depth + 1);
+                        if (!child)
+                            throw std::runtime_error("empty child shape");
+                        compound->addChildShape(btTransform(btQuaternion(x, y, z, w), origin), child);
+                    }
+                }
+                catch (...)
+                {
+                    deleteShape(compound);
+                    throw;
+                }
+                return compound;
+            }
+
+            case Shape_Box:
+
+                return new btBoxShape(readVector(stream));
+
+            case Shape_TriangleMesh:
+            {
+                bool use32bitIndices = readValue<std::uint8_t>(stream) != 0;
+                bool use4componentVertices = readValue<std::uint8_t>(stream) != 0;
+                bool useQuantizedAabbCompression = readValue<std::uint8_t>(stream) != 0;
+                btVector3 scaling = readVector(stream);
+
+                std::unique_ptr<btTriangleMesh> mesh (new btTriangleMesh(use32bitIndices, use4componentVertices));
+                std::uint32_t numTriangles = readValue<std::uint32_t>(stream);
+                checkCount(stream, numTriangles, 9 * sizeof(btScalar));
+                for (std::uint32_t i = 0; i < numTriangles; ++i)
+                {
+                    btVector3 v1 = readVector(stream);
+                    btVector3 v2 = readVector(stream);
+                    btVector3 v3 = readVector(stream);
+                    mesh->addTriangle(v1, v2, v3);
+                }
+
+                std::uint32_t size = readValue<std::uint32_t>(stream);
+                // deSerializeInPlace reads the hierarchy object at the start of the buffer before checking its size
+                if (size < sizeof(btOptimizedBvh))
+                    throw std::runtime_error("invalid bounding volume hierarchy");
+                checkCount(stream, size, 1);
+                void* buffer = btAlignedAlloc(size, 16);
+                stream.read(static_cast<char*>(buffer), size);
+                btOptimizedBvh* bvh = stream ? btOptimizedBvh::deSerializeInPlace(buffer, size, false) : NULL;
+                if (!bvh)
+                {
+                    btAlignedFree(buffer);
+                    throw std::runtime_error("invalid bounding volume hierarchy");
+                }
+
+                Resource::TriangleMeshShape* shape = new Resource::TriangleMeshShape(mesh.release(), useQuantizedAabbCompression, false);
+                shape->setSerializedBvh(bvh, buffer, scaling);
+                return shape;
+            }
+
+            default:
+
+                throw std::runtime_error("unknown shape type");
+        }
+    }
+}
+
+namespace Resource
+{
+
+    BulletShapeFileCache::BulletShapeFileCache(const std::string& path, std::uint64_t maxSize)
+        : mFiles(path, ".bullet", maxSize)
+    {
+    }
+
+    osg::ref_ptr<BulletShape> BulletShapeFileCache::read(const std::string& name, std::uint64_t hash)
+    {
+        if (!mFiles.isEnabled())
+            return osg::ref_ptr<BulletShape>();
+
+        std::ifstream stream (mFiles.getFileName(name).c_str(), std::ios::binary);
+        if (!stream.is_open())
+            return osg::ref_ptr<BulletShape>();
+
+        try
+        {
+            char magic[sizeof(sMagic)];
+            stream.read(magic, sizeof(magic));
+
+            // Files for other versions of the format, or of the mesh, are outdated rather than broken
+            if (!stream || std::memcmp(magic, sMagic, sizeof(magic)) != 0
+                    || readValue<std::uint32_t>(stream) != sVersion
+                    || readValue<std::uint8_t>(stream) != sizeof(btScalar)
+                    || readValue<std::int32_t>(stream) != BT_BULLET_VERSION
+                    || readValue<std::uint64_t>(stream) != hash
+                    || readString(stream) != name)
+                return osg::ref_ptr<BulletShape>();
+
+            osg::ref_ptr<BulletShape> shape (new BulletShape);
+
+            for (int i = 0; i < 3; ++i)
+                shape->mCollisionBoxHalfExtents[i] = readValue<float>(stream);
+            for (int i = 0; i < 3; ++i)
+                shape->mCollisionBoxTranslate[i] = readValue<float>(stream);
+
+            std::uint32_t numAnimatedShapes = readValue<std::uint32_t>(stream);
+            checkCount(stream, numAnimatedShapes, 2 * sizeof(std::int32_t));
+            for (std::uint32_t i = 0; i < numAnimatedShapes; ++i)
+            {
+                std::int32_t recIndex = readValue<std::int32_t>(stream);
+                std::int32_t childIndex = readValue<std::int32_t>(stream);
+                shape->mAnimatedShapes[recIndex] = childIndex;
+            }
+
+            shape->mCollisionShape = readShape(stream, 0);
+            return shape;
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "Failed to read cached collision shape for " << name << ": " << e.what() << std::endl;
+            return osg::ref_ptr<BulletShape>();
+        }
+    }
+
+    void BulletShapeFileCache::write(const std::string& name, std::uint64_t hash, const BulletShape& shape)
+    {
+        if (!mFiles.isEnabled())
+            return;
+
+        std::ostringstream stream (std::ios::binary);
+        stream.write(sMagic, sizeof(sMagic));
+        writeValue(stream, sVersion);
+        writeValue(stream, static_cast<std::uint8_t>(sizeof(btScalar)));
+        writeValue(stream, static_cast<std::int32_t>(BT_BULLET_VERSION));
+        writeValue(stream, hash);
+        writeString(stream, name);
+
+        for (int i = 0; i < 3; ++i)
+            writeValue(stream, shape.mCollisionBoxHalfExtents[i]);
+        for (int i = 0; i < 3; ++i)
+            writeValue(stream, shape.mCollisionBoxTranslate[i]);
+
+        writeValue(stream, static_cast<std::uint32_t>(shape.mAnimatedShapes.size()));
+        for (std::map<int, int>::const_iterator it = shape.mAnimatedShapes.begin(); it != shape.mAnimatedShapes.end(); ++it)
+        {
+            writeValue(stream, static_cast<std::int32_t>(it->first));
+            writeValue(stream, static_cast<std::int32_t>(it->second));
+        }
+
+        if (!writeShape(stream, shape.mCollisionShape))
+            return;
+
+        mFiles.write(name, stream.str());
+    }
+
+}
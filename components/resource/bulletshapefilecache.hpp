@@ -0,0 +1,44 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPEFILECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPEFILECACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include "filecache.hpp"
+
+namespace Resource
+{
+
+    class BulletShape;
+
+    /// @brief Stores collision shapes in files, so that later loads of a shape do not have to parse the mesh and
+    /// build its bounding volume hierarchy again.
+    /// @par Every file records the hash of the mesh it was made from, and is ignored once the mesh changes. When the
+    /// files take more space than allowed, the least recently written ones are removed.
+    /// @par Only the shapes made by the NIF loader and BulletShapeManager are supported, i.e. boxes, triangle meshes and
+    /// compounds of these.
+    /// @note May be used from any thread.
+    class BulletShapeFileCache
+    {
+    public:
+        /// @param path Directory for the cache files, created if needed.
+        /// @param maxSize Most bytes the cache files may take up.
+        BulletShapeFileCache(const std::string& path, std::uint64_t maxSize);
+
+        /// @param name Normalized name of the mesh.
+        /// @param hash Hash of the contents of the mesh, see FileCache::hash().
+        /// @return The cached shape, or a null pointer if there is none for this version of the mesh.
+        osg::ref_ptr<BulletShape> read(const std::string& name, std::uint64_t hash);
+
+        /// Store @a shape for the given mesh, replacing an older version. Unsupported shapes are not stored.
+        void write(const std::string& name, std::uint64_t hash, const BulletShape& shape);
+
+    private:
+        FileCache mFiles;
+    };
+
+}
+
+#endif
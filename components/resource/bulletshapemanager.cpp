@@ -11,8 +11,10 @@
 #include <components/vfs/manager.hpp>
 
 #include <components/nifbullet/bulletnifloader.hpp>
+#include <components/misc/trace.hpp>
 
 #include "bulletshape.hpp"
+#include "bulletshapefilecache.hpp"
 #include "scenemanager.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
@@ -58,6 +60,7 @@ struct GetTriangleFunctor
 };
 
 /// Creates a BulletShape out of a Node hierarchy.
+/// @note Shapes are cached on disk by BulletShapeFileCache. Increase its sVersion when changing the shapes made here.
 class NodeToShapeVisitor : public osg::NodeVisitor
 {
 public:
@@ -121,30 +124,46 @@ osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(const std::string &
         shape = osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
     else
     {
-        size_t extPos = normalized.find_last_of('.');
-        std::string ext;
-        if (extPos != std::string::npos && extPos+1 < normalized.size())
-            ext = normalized.substr(extPos+1);
+        Misc::ScopedTrace trace("BulletShapeManager::loadShape");
 
-        if (ext == "nif")
+        std::uint64_t hash = 0;
+        if (mFileCache)
         {
-            NifBullet::BulletNifLoader loader;
-            shape = loader.load(mNifFileManager->get(normalized));
+            Files::IStreamPtr stream = mVFS->getNormalized(normalized);
+            hash = FileCache::hash(*stream);
+            shape = mFileCache->read(normalized, hash);
         }
-        else
+
+        if (!shape)
         {
-            // TODO: support .bullet shape files
-
-            osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
-            osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
-            NodeToShapeVisitor visitor;
-            node->accept(visitor);
-            shape = visitor.getShape();
-            if (!shape)
+            size_t extPos = normalized.find_last_of('.');
+            std::string ext;
+            if (extPos != std::string::npos && extPos+1 < normalized.size())
+                ext = normalized.substr(extPos+1);
+
+            if (ext == "nif")
             {
-                mCache->addEntryToObjectCache(normalized, NULL);
-                return osg::ref_ptr<BulletShape>();
+                NifBullet::BulletNifLoader loader;
+                shape = loader.load(mNifFileManager->get(normalized));
             }
+            else
+            {
+                // TODO: support .bullet shape files
+
+                osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
+                osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
+                NodeToShapeVisitor visitor;
+                node->accept(visitor);
+                shape = visitor.getShape();
+                if (!shape)
+                {
+                    mCache->addEntryToObjectCache(normalized, NULL);
+                    return osg::ref_ptr<BulletShape>();
+                }
+            }
+
+            if (mFileCache)
+                mFileCache->write(normalized, hash, *shape);
         }
 
         mCache->addEntryToObjectCache(normalized, shape);
@@ -183,6 +202,14 @@ osg::ref_ptr<BulletShapeInstance> BulletShapeManager::createInstance(const std::
         return osg::ref_ptr<BulletShapeInstance>();
 }
 
+void BulletShapeManager::setFileCache(const std::string &path, std::uint64_t maxSize)
+{
+    if (maxSize > 0)
+        mFileCache.reset(new BulletShapeFileCache(path, maxSize));
+    else
+        mFileCache.reset();
+}
+
 void BulletShapeManager::updateCache(double referenceTime)
 {
     ResourceManager::updateCache(referenceTime);
@@ -1,7 +1,9 @@
 #ifndef OPENMW_COMPONENTS_BULLETSHAPEMANAGER_H
 #define OPENMW_COMPONENTS_BULLETSHAPEMANAGER_H
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <osg/ref_ptr>
@@ -18,6 +20,7 @@ namespace Resource
     class BulletShapeInstance;
 
     class MultiObjectCache;
+    class BulletShapeFileCache;
 
     /// Handles loading, caching and "instancing" of bullet shapes.
     /// A shape 'instance' is a clone of another shape, with the goal of setting a different scale on this instance.
@@ -44,12 +47,18 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats *stats) const;
 
+        /// Keep the shapes loaded from meshes in files in @a path, so that they load faster in later sessions.
+        /// @param maxSize Most bytes the files may take up, 0 disables the file cache.
+        /// @note Not thread safe, call before shapes are requested from other threads.
+        void setFileCache(const std::string& path, std::uint64_t maxSize);
+
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(const std::string& name);
 
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
+        std::unique_ptr<BulletShapeFileCache> mFileCache;
     };
 
 }
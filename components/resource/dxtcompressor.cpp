@@ -0,0 +1,302 @@
+#include "dxtcompressor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    struct Color
+    {
+        float mValues[3];
+    };
+
+    unsigned short toRgb565(const Color& color)
+    {
+        int r = std::min(31, std::max(0, static_cast<int>(color.mValues[0] * 31.f / 255.f + 0.5f)));
+        int g = std::min(63, std::max(0, static_cast<int>(color.mValues[1] * 63.f / 255.f + 0.5f)));
+        int b = std::min(31, std::max(0, static_cast<int>(color.mValues[2] * 31.f / 255.f + 0.5f)));
+        return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+    }
+
+    Color fromRgb565(unsigned short value)
+    {
+        int r = (value >> 11) & 31;
+        int g = (value >> 5) & 63;
+        int b = value & 31;
+        Color color;
+        color.mValues[0] = static_cast<float>((r << 3) | (r >> 2));
+        color.mValues[1] = static_cast<float>((g << 2) | (g >> 4));
+        color.mValues[2] = static_cast<float>((b << 3) | (b >> 2));
+        return color;
+    }
+
+    Color interpolate(const Color& a, const Color& b, float weightA)
+    {
+        Color color;
+        for (int i = 0; i < 3; ++i)
+            color.mValues[i] = a.mValues[i] * weightA + b.mValues[i] * (1.f - weightA);
+        return color;
+    }
+
+    float distance2(const Color& a, const unsigned char* pixel)
+    {
+        float result = 0.f;
+        for (int i = 0; i < 3; ++i)
+        {
+            float difference = a.mValues[i] - pixel[i];
+            result += difference * difference;
+        }
+        return result;
+    }
+
+    /// Weight of the first endpoint in each of the four colors of a block.
+    const float sColorWeights[4] = { 1.f, 0.f, 2.f/3.f, 1.f/3.f };
+
+    /// Choose the closest of the four block colors for every pixel.
+    /// @return Total squared error of the block.
+    float findColorIndices(const unsigned char* pixels, unsigned short endpoint0, unsigned short endpoint1, unsigned int& indices)
+    {
+        Color palette[4];
+        palette[0] = fromRgb565(endpoint0);
+        palette[1] = fromRgb565(endpoint1);
+        palette[2] = interpolate(palette[0], palette[1], sColorWeights[2]);
+        palette[3] = interpolate(palette[0], palette[1], sColorWeights[3]);
+
+        float error = 0.f;
+        indices = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            const unsigned char* pixel = pixels + i * 4;
+            int best = 0;
+            float bestDistance = distance2(palette[0], pixel);
+            for (int j = 1; j < 4; ++j)
+            {
+                float distance = distance2(palette[j], pixel);
+                if (distance < bestDistance)
+                {
+                    best = j;
+                    bestDistance = distance;
+                }
+            }
+            indices |= static_cast<unsigned int>(best) << (i * 2);
+            error += bestDistance;
+        }
+        return error;
+    }
+
+    /// Find the endpoints that best fit the pixels for the given indices, by least squares.
+    /// @return False if the indices do not determine the endpoints.
+    bool fitEndpoints(const unsigned char* pixels, unsigned int indices, Color& endpoint0, Color& endpoint1)
+    {
+        float aa = 0.f, ab = 0.f, bb = 0.f;
+        float ax[3] = { 0.f, 0.f, 0.f };
+        float bx[3] = { 0.f, 0.f, 0.f };
+        for (int i = 0; i < 16; ++i)
+        {
+            float a = sColorWeights[(indices >> (i * 2)) & 3];
+            float b = 1.f - a;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int j = 0; j < 3; ++j)
+            {
+                ax[j] += a * pixels[i * 4 + j];
+                bx[j] += b * pixels[i * 4 + j];
+            }
+        }
+
+        float determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f)
+            return false;
+
+        for (int j = 0; j < 3; ++j)
+        {
+            endpoint0.mValues[j] = (ax[j] * bb - bx[j] * ab) / determinant;
+            endpoint1.mValues[j] = (bx[j] * aa - ax[j] * ab) / determinant;
+        }
+        return true;
+    }
+
+    /// @return The direction in which the colors of the pixels vary the most.
+    Color findPrincipalAxis(const unsigned char* pixels)
+    {
+        float mean[3] = { 0.f, 0.f, 0.f };
+        for (int i = 0; i < 16; ++i)
+            for (int j = 0; j < 3; ++j)
+                mean[j] += pixels[i * 4 + j] / 16.f;
+
+        float covariance[3][3] = { { 0.f } };
+        for (int i = 0; i < 16; ++i)
+        {
+            float difference[3];
+            for (int j = 0; j < 3; ++j)
+                difference[j] = pixels[i * 4 + j] - mean[j];
+            for (int j = 0; j < 3; ++j)
+                for (int k = 0; k < 3; ++k)
+                    covariance[j][k] += difference[j] * difference[k];
+        }
+
+        // Power iteration, starting from the channel that varies the most. Starting from a fixed direction would fail
+        // for directions orthogonal to it, e.g. a gradient from red to green.
+        int channel = 0;
+        for (int j = 1; j < 3; ++j)
+        {
+            if (covariance[j][j] > covariance[channel][channel])
+                channel = j;
+        }
+
+        Color axis;
+        for (int j = 0; j < 3; ++j)
+            axis.mValues[j] = covariance[j][channel];
+
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            Color next;
+            float length = 0.f;
+            for (int j = 0; j < 3; ++j)
+            {
+                next.mValues[j] = covariance[j][0] * axis.mValues[0] + covariance[j][1] * axis.mValues[1] + covariance[j][2] * axis.mValues[2];
+                length = std::max(length, std::abs(next.mValues[j]));
+            }
+            if (length == 0.f)
+                break;
+            for (int j = 0; j < 3; ++j)
+                axis.mValues[j] = next.mValues[j] / length;
+        }
+        return axis;
+    }
+
+    void writeColorBlock(unsigned short endpoint0, unsigned short endpoint1, unsigned int indices, unsigned char* block)
+    {
+        block[0] = endpoint0 & 0xff;
+        block[1] = endpoint0 >> 8;
+        block[2] = endpoint1 & 0xff;
+        block[3] = endpoint1 >> 8;
+        for (int i = 0; i < 4; ++i)
+            block[4 + i] = (indices >> (i * 8)) & 0xff;
+    }
+
+    /// @return The indices for swapped endpoints.
+    unsigned int swapColorIndices(unsigned int indices)
+    {
+        // 0 <-> 1 and 2 <-> 3, i.e. flip the low bit of every index
+        return indices ^ 0x55555555;
+    }
+
+    void compressAlpha(const unsigned char* pixels, unsigned char* block)
+    {
+        int minAlpha = 255;
+        int maxAlpha = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            minAlpha = std::min(minAlpha, static_cast<int>(pixels[i * 4 + 3]));
+            maxAlpha = std::max(maxAlpha, static_cast<int>(pixels[i * 4 + 3]));
+        }
+
+        block[0] = static_cast<unsigned char>(maxAlpha);
+        block[1] = static_cast<unsigned char>(minAlpha);
+
+        unsigned long long indices = 0;
+        if (maxAlpha > minAlpha)
+        {
+            // Eight alpha values, interpolated between the endpoints
+            int palette[8];
+            palette[0] = maxAlpha;
+            palette[1] = minAlpha;
+            for (int i = 2; i < 8; ++i)
+                palette[i] = ((8 - i) * maxAlpha + (i - 1) * minAlpha + 3) / 7;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                int alpha = pixels[i * 4 + 3];
+                int best = 0;
+                for (int j = 1; j < 8; ++j)
+                {
+                    if (std::abs(palette[j] - alpha) < std::abs(palette[best] - alpha))
+                        best = j;
+                }
+                indices |= static_cast<unsigned long long>(best) << (i * 3);
+            }
+        }
+
+        for (int i = 0; i < 6; ++i)
+            block[2 + i] = (indices >> (i * 8)) & 0xff;
+    }
+}
+
+namespace Resource
+{
+namespace Dxt
+{
+
+    void compressDxt1Block(const unsigned char* pixels, unsigned char* block)
+    {
+        // Use the pixels furthest apart along the principal axis as the initial endpoints
+        Color axis = findPrincipalAxis(pixels);
+        int minPixel = 0;
+        int maxPixel = 0;
+        float minProjection = 0.f;
+        float maxProjection = 0.f;
+        for (int i = 0; i < 16; ++i)
+        {
+            const unsigned char* pixel = pixels + i * 4;
+            float projection = pixel[0] * axis.mValues[0] + pixel[1] * axis.mValues[1] + pixel[2] * axis.mValues[2];
+            if (i == 0 || projection < minProjection)
+            {
+                minProjection = projection;
+                minPixel = i;
+            }
+            if (i == 0 || projection > maxProjection)
+            {
+                maxProjection = projection;
+                maxPixel = i;
+            }
+        }
+
+        Color endpoints[2];
+        for (int j = 0; j < 3; ++j)
+        {
+            endpoints[0].mValues[j] = pixels[maxPixel * 4 + j];
+            endpoints[1].mValues[j] = pixels[minPixel * 4 + j];
+        }
+
+        unsigned short endpoint0 = toRgb565(endpoints[0]);
+        unsigned short endpoint1 = toRgb565(endpoints[1]);
+        unsigned int indices = 0;
+        float error = findColorIndices(pixels, endpoint0, endpoint1, indices);
+
+        // Refine the endpoints once for the chosen indices
+        if (error > 0.f && fitEndpoints(pixels, indices, endpoints[0], endpoints[1]))
+        {
+            unsigned short refined0 = toRgb565(endpoints[0]);
+            unsigned short refined1 = toRgb565(endpoints[1]);
+            unsigned int refinedIndices = 0;
+            float refinedError = findColorIndices(pixels, refined0, refined1, refinedIndices);
+            if (refinedError < error)
+            {
+                endpoint0 = refined0;
+                endpoint1 = refined1;
+                indices = refinedIndices;
+            }
+        }
+
+        // The first endpoint must be the greater one, otherwise the block has three colors and transparency
+        if (endpoint0 == endpoint1)
+            indices = 0;
+        else if (endpoint0 < endpoint1)
+        {
+            std::swap(endpoint0, endpoint1);
+            indices = swapColorIndices(indices);
+        }
+
+        writeColorBlock(endpoint0, endpoint1, indices, block);
+    }
+
+    void compressDxt5Block(const unsigned char* pixels, unsigned char* block)
+    {
+        compressAlpha(pixels, block);
+        compressDxt1Block(pixels, block + 8);
+    }
+
+}
+}
@@ -0,0 +1,26 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_DXTCOMPRESSOR_H
+#define OPENMW_COMPONENTS_RESOURCE_DXTCOMPRESSOR_H
+
+namespace Resource
+{
+namespace Dxt
+{
+
+    /// Size in bytes of a compressed block of 4x4 pixels.
+    const int sDxt1BlockSize = 8;
+    const int sDxt5BlockSize = 16;
+
+    /// Compress a block of 4x4 pixels to a DXT1 block without transparency.
+    /// @param pixels 16 RGBA pixels in row order, the alpha is ignored.
+    /// @param block Receives sDxt1BlockSize bytes.
+    void compressDxt1Block(const unsigned char* pixels, unsigned char* block);
+
+    /// Compress a block of 4x4 pixels to a DXT5 block.
+    /// @param pixels 16 RGBA pixels in row order.
+    /// @param block Receives sDxt5BlockSize bytes.
+    void compressDxt5Block(const unsigned char* pixels, unsigned char* block);
+
+}
+}
+
+#endif
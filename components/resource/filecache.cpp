@@ -0,0 +1,167 @@
+#include "filecache.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <OpenThreads/ScopedLock>
+
+namespace
+{
+    const std::uint64_t sHashBasis = 14695981039346656037ULL;
+
+    // FNV-1a
+    std::uint64_t addToHash(std::uint64_t hash, const char* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    typedef std::vector<std::pair<std::time_t, boost::filesystem::path> > FileList;
+
+    /// @return Total size of the files with the given extension in @a path.
+    std::uint64_t listFiles(const boost::filesystem::path& path, const std::string& extension, FileList& files)
+    {
+        std::uint64_t size = 0;
+        for (boost::filesystem::directory_iterator it (path); it != boost::filesystem::directory_iterator(); ++it)
+        {
+            if (!boost::filesystem::is_regular_file(it->status()) || it->path().extension() != extension)
+                continue;
+
+            size += boost::filesystem::file_size(it->path());
+            files.push_back(std::make_pair(boost::filesystem::last_write_time(it->path()), it->path()));
+        }
+        return size;
+    }
+}
+
+namespace Resource
+{
+
+    FileCache::FileCache(const std::string& path, const std::string& extension, std::uint64_t maxSize)
+        : mPath(path)
+        , mExtension(extension)
+        , mMaxSize(maxSize)
+        , mSize(0)
+    {
+        if (!mMaxSize)
+            return;
+
+        try
+        {
+            boost::filesystem::create_directories(mPath);
+
+            // Left behind by interrupted writes
+            for (boost::filesystem::directory_iterator it (mPath); it != boost::filesystem::directory_iterator(); ++it)
+                if (it->path().extension() == ".tmp")
+                    boost::filesystem::remove(it->path());
+
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+            trim();
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "Failed to set up file cache in " << mPath << ": " << e.what() << std::endl;
+            mMaxSize = 0;
+        }
+    }
+
+    bool FileCache::isEnabled() const
+    {
+        return mMaxSize != 0;
+    }
+
+    std::string FileCache::getFileName(const std::string& name) const
+    {
+        std::ostringstream fileName;
+        fileName << std::hex << std::setw(16) << std::setfill('0') << hash(name.data(), name.size()) << mExtension;
+        return (boost::filesystem::path(mPath) / fileName.str()).string();
+    }
+
+    void FileCache::write(const std::string& name, const std::string& data)
+    {
+        if (!mMaxSize)
+            return;
+
+        const boost::filesystem::path path (getFileName(name));
+
+        // Write to a temporary file first, so that other threads never read a partially written file
+        const boost::filesystem::path tempPath = boost::filesystem::unique_path(boost::filesystem::path(mPath) / "%%%%-%%%%-%%%%-%%%%.tmp");
+
+        try
+        {
+            {
+                std::ofstream file (tempPath.string().c_str(), std::ios::binary);
+                file.write(data.data(), data.size());
+                if (!file)
+                    throw std::runtime_error("failed to write " + tempPath.string());
+            }
+
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+
+            std::uint64_t oldSize = 0;
+            if (boost::filesystem::exists(path))
+                oldSize = boost::filesystem::file_size(path);
+
+            boost::filesystem::rename(tempPath, path);
+
+            mSize = mSize - std::min(oldSize, mSize) + data.size();
+            if (mSize > mMaxSize)
+                trim();
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "Failed to write cache file for " << name << ": " << e.what() << std::endl;
+
+            boost::system::error_code error;
+            boost::filesystem::remove(tempPath, error);
+        }
+    }
+
+    std::uint64_t FileCache::hash(std::istream& stream)
+    {
+        std::uint64_t hash = sHashBasis;
+
+        char buffer[65536];
+        while (stream)
+        {
+            stream.read(buffer, sizeof(buffer));
+            hash = addToHash(hash, buffer, static_cast<std::size_t>(stream.gcount()));
+        }
+
+        return hash;
+    }
+
+    std::uint64_t FileCache::hash(const char* data, std::size_t size)
+    {
+        return addToHash(sHashBasis, data, size);
+    }
+
+    void FileCache::trim()
+    {
+        FileList files;
+        mSize = listFiles(mPath, mExtension, files);
+
+        std::sort(files.begin(), files.end());
+
+        for (FileList::const_iterator it = files.begin(); it != files.end() && mSize > mMaxSize; ++it)
+        {
+            std::uint64_t size = boost::filesystem::file_size(it->second);
+            boost::filesystem::remove(it->second);
+            mSize -= std::min(size, mSize);
+        }
+    }
+
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_FILECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_FILECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+
+#include <OpenThreads/Mutex>
+
+namespace Resource
+{
+
+    /// @brief A directory of files made from resources, e.g. processed meshes or textures, that are kept between
+    /// sessions. There is one file per resource name.
+    /// @par When the files take more space than allowed, the least recently written ones are removed.
+    /// @note May be used from any thread.
+    class FileCache
+    {
+    public:
+        /// @param path Directory for the files, created if needed.
+        /// @param extension Extension of the files, including the dot.
+        /// @param maxSize Most bytes the files may take up, 0 disables the cache.
+        FileCache(const std::string& path, const std::string& extension, std::uint64_t maxSize);
+
+        /// @return False if the cache was disabled, or its directory could not be used.
+        bool isEnabled() const;
+
+        /// @param name Normalized name of the resource the file is made from.
+        /// @return Path of the file for the resource, which may not exist.
+        std::string getFileName(const std::string& name) const;
+
+        /// Store @a data as the file for @a name, replacing the previous file.
+        /// @note Other threads never see partially written files.
+        void write(const std::string& name, const std::string& data);
+
+        /// @return Hash of the remaining contents of @a stream.
+        static std::uint64_t hash(std::istream& stream);
+
+        static std::uint64_t hash(const char* data, std::size_t size);
+
+    private:
+        /// Remove the oldest files until the cache is within its size limit.
+        /// @note Requires mMutex to be locked.
+        void trim();
+
+        std::string mPath;
+        std::string mExtension;
+        std::uint64_t mMaxSize;
+
+        OpenThreads::Mutex mMutex;
+        std::uint64_t mSize;
+    };
+
+}
+
+#endif
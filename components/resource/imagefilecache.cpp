@@ -0,0 +1,321 @@
+#include "imagefilecache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <osg/Image>
+
+#include <osgDB/Registry>
+
+#include "dxtcompressor.hpp"
+
+namespace
+{
+    std::uint32_t makeFourCC(char a, char b, char c, char d)
+    {
+        return static_cast<std::uint32_t>(static_cast<unsigned char>(a))
+                | (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8)
+                | (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16)
+                | (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+    }
+
+    /// The DDS header is 32 words, including the magic number.
+    const int sHeaderWords = 32;
+
+    // Words of the DDS header
+    enum
+    {
+        Header_Magic = 0,
+        Header_Size = 1,
+        Header_Flags = 2,
+        Header_Height = 3,
+        Header_Width = 4,
+        Header_LinearSize = 5,
+        Header_MipMapCount = 7,
+        Header_Reserved = 8, // 11 unused words, we store our own data in them
+        Header_PixelFormatSize = 19,
+        Header_PixelFormatFlags = 20,
+        Header_FourCC = 21,
+        Header_Caps = 27
+    };
+
+    enum
+    {
+        Flag_Caps = 0x1,
+        Flag_Height = 0x2,
+        Flag_Width = 0x4,
+        Flag_PixelFormat = 0x1000,
+        Flag_MipMapCount = 0x20000,
+        Flag_LinearSize = 0x80000,
+
+        PixelFormat_FourCC = 0x4,
+
+        Caps_Complex = 0x8,
+        Caps_Texture = 0x1000,
+        Caps_MipMap = 0x400000
+    };
+
+    // Our data in the reserved words
+    const std::uint32_t sMagic = makeFourCC('O', 'M', 'W', 'I');
+    /// Increase whenever the compression changes, to invalidate existing files.
+    const std::uint32_t sVersion = 1;
+
+    void writeHeader(const std::uint32_t* header, std::string& data)
+    {
+        for (int i = 0; i < sHeaderWords; ++i)
+            for (int j = 0; j < 4; ++j)
+                data += static_cast<char>((header[i] >> (j * 8)) & 0xff);
+    }
+
+    bool readHeader(std::istream& stream, std::uint32_t* header)
+    {
+        unsigned char bytes[sHeaderWords * 4];
+        stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+        if (!stream)
+            return false;
+
+        for (int i = 0; i < sHeaderWords; ++i)
+        {
+            header[i] = 0;
+            for (int j = 0; j < 4; ++j)
+                header[i] |= static_cast<std::uint32_t>(bytes[i * 4 + j]) << (j * 8);
+        }
+        return true;
+    }
+
+    /// Copy the pixels of @a image to @a pixels as RGBA, with the top row first as in DDS files.
+    /// @return False if the pixel format is not supported.
+    bool getPixels(const osg::Image& image, std::vector<unsigned char>& pixels, bool& hasAlpha)
+    {
+        if (image.getDataType() != GL_UNSIGNED_BYTE)
+            return false;
+
+        int numComponents = 0;
+        int offsets[4] = { 0, 0, 0, -1 };
+        switch (image.getPixelFormat())
+        {
+            case GL_RGB:
+                numComponents = 3;
+                offsets[1] = 1;
+                offsets[2] = 2;
+                break;
+            case GL_RGBA:
+                numComponents = 4;
+                offsets[1] = 1;
+                offsets[2] = 2;
+                offsets[3] = 3;
+                break;
+            case GL_BGR:
+                numComponents = 3;
+                offsets[0] = 2;
+                offsets[1] = 1;
+                break;
+            case GL_BGRA:
+                numComponents = 4;
+                offsets[0] = 2;
+                offsets[1] = 1;
+                offsets[3] = 3;
+                break;
+            case GL_LUMINANCE:
+                numComponents = 1;
+                break;
+            case GL_LUMINANCE_ALPHA:
+                numComponents = 2;
+                offsets[3] = 1;
+                break;
+            default:
+                return false;
+        }
+
+        const int width = image.s();
+        const int height = image.t();
+        pixels.resize(width * height * 4);
+        hasAlpha = false;
+
+        for (int y = 0; y < height; ++y)
+        {
+            // OSG images start with the bottom row
+            const unsigned char* source = image.data(0, height - 1 - y);
+            unsigned char* target = &pixels[y * width * 4];
+            for (int x = 0; x < width; ++x, source += numComponents, target += 4)
+            {
+                for (int i = 0; i < 3; ++i)
+                    target[i] = source[offsets[i]];
+                target[3] = offsets[3] >= 0 ? source[offsets[3]] : 255;
+                hasAlpha = hasAlpha || target[3] != 255;
+            }
+        }
+        return true;
+    }
+
+    /// Halve the size of an RGBA image by averaging blocks of 2x2 pixels.
+    void downsample(const std::vector<unsigned char>& pixels, int width, int height, std::vector<unsigned char>& result)
+    {
+        const int newWidth = std::max(1, width / 2);
+        const int newHeight = std::max(1, height / 2);
+        result.resize(newWidth * newHeight * 4);
+
+        for (int y = 0; y < newHeight; ++y)
+        {
+            const int y0 = std::min(y * 2, height - 1);
+            const int y1 = std::min(y * 2 + 1, height - 1);
+            for (int x = 0; x < newWidth; ++x)
+            {
+                const int x0 = std::min(x * 2, width - 1);
+                const int x1 = std::min(x * 2 + 1, width - 1);
+                for (int i = 0; i < 4; ++i)
+                {
+                    int sum = pixels[(y0 * width + x0) * 4 + i] + pixels[(y0 * width + x1) * 4 + i]
+                            + pixels[(y1 * width + x0) * 4 + i] + pixels[(y1 * width + x1) * 4 + i];
+                    result[(y * newWidth + x) * 4 + i] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    /// Compress an RGBA image block by block and append the blocks to @a data.
+    void compress(const std::vector<unsigned char>& pixels, int width, int height, bool hasAlpha, std::string& data)
+    {
+        unsigned char block[16 * 4];
+        unsigned char compressed[Resource::Dxt::sDxt5BlockSize];
+
+        for (int blockY = 0; blockY < height; blockY += 4)
+        {
+            for (int blockX = 0; blockX < width; blockX += 4)
+            {
+                // Blocks of the smallest mipmaps are padded by repeating the last row and column
+                for (int y = 0; y < 4; ++y)
+                {
+                    const int sourceY = std::min(blockY + y, height - 1);
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        const int sourceX = std::min(blockX + x, width - 1);
+                        std::copy(&pixels[(sourceY * width + sourceX) * 4], &pixels[(sourceY * width + sourceX) * 4] + 4, &block[(y * 4 + x) * 4]);
+                    }
+                }
+
+                if (hasAlpha)
+                {
+                    Resource::Dxt::compressDxt5Block(block, compressed);
+                    data.append(reinterpret_cast<const char*>(compressed), Resource::Dxt::sDxt5BlockSize);
+                }
+                else
+                {
+                    Resource::Dxt::compressDxt1Block(block, compressed);
+                    data.append(reinterpret_cast<const char*>(compressed), Resource::Dxt::sDxt1BlockSize);
+                }
+            }
+        }
+    }
+}
+
+namespace Resource
+{
+
+    ImageFileCache::ImageFileCache(const std::string& path, std::uint64_t maxSize, osgDB::Options* options)
+        : mFiles(path, ".dds", maxSize)
+        , mOptions(options)
+    {
+    }
+
+    ImageFileCache::~ImageFileCache()
+    {
+    }
+
+    osg::ref_ptr<osg::Image> ImageFileCache::read(const std::string& name, std::uint64_t hash)
+    {
+        if (!mFiles.isEnabled())
+            return osg::ref_ptr<osg::Image>();
+
+        std::ifstream stream (mFiles.getFileName(name).c_str(), std::ios::binary);
+        if (!stream.is_open())
+            return osg::ref_ptr<osg::Image>();
+
+        // Files for other versions of the compression, or of the image, are outdated rather than broken
+        std::uint32_t header[sHeaderWords];
+        if (!readHeader(stream, header)
+                || header[Header_Magic] != makeFourCC('D', 'D', 'S', ' ')
+                || header[Header_Reserved] != sMagic
+                || header[Header_Reserved + 1] != sVersion
+                || header[Header_Reserved + 2] != static_cast<std::uint32_t>(hash)
+                || header[Header_Reserved + 3] != static_cast<std::uint32_t>(hash >> 32))
+            return osg::ref_ptr<osg::Image>();
+
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!reader)
+            return osg::ref_ptr<osg::Image>();
+
+        stream.seekg(0);
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(stream, mOptions);
+        if (!result.success())
+        {
+            std::cerr << "Failed to read cached image for " << name << ": " << result.message() << " code " << result.status() << std::endl;
+            return osg::ref_ptr<osg::Image>();
+        }
+
+        return result.getImage();
+    }
+
+    void ImageFileCache::write(const std::string& name, std::uint64_t hash, const osg::Image& image)
+    {
+        if (!mFiles.isEnabled())
+            return;
+
+        if (image.r() != 1 || image.isMipmap() || image.isCompressed()
+                || image.s() <= 0 || image.t() <= 0 || image.s() % 4 != 0 || image.t() % 4 != 0)
+            return;
+
+        std::vector<unsigned char> pixels;
+        bool hasAlpha = false;
+        if (!getPixels(image, pixels, hasAlpha))
+            return;
+
+        std::string blocks;
+        std::vector<unsigned char> nextLevel;
+        int width = image.s();
+        int height = image.t();
+        std::uint32_t numLevels = 0;
+        while (true)
+        {
+            compress(pixels, width, height, hasAlpha, blocks);
+            ++numLevels;
+
+            if (width == 1 && height == 1)
+                break;
+
+            downsample(pixels, width, height, nextLevel);
+            pixels.swap(nextLevel);
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+
+        const int blockSize = hasAlpha ? Dxt::sDxt5BlockSize : Dxt::sDxt1BlockSize;
+
+        std::uint32_t header[sHeaderWords] = { 0 };
+        header[Header_Magic] = makeFourCC('D', 'D', 'S', ' ');
+        header[Header_Size] = 124;
+        header[Header_Flags] = Flag_Caps | Flag_Height | Flag_Width | Flag_PixelFormat | Flag_MipMapCount | Flag_LinearSize;
+        header[Header_Height] = image.t();
+        header[Header_Width] = image.s();
+        header[Header_LinearSize] = (image.s() / 4) * (image.t() / 4) * blockSize;
+        header[Header_MipMapCount] = numLevels;
+        header[Header_Reserved] = sMagic;
+        header[Header_Reserved + 1] = sVersion;
+        header[Header_Reserved + 2] = static_cast<std::uint32_t>(hash);
+        header[Header_Reserved + 3] = static_cast<std::uint32_t>(hash >> 32);
+        header[Header_PixelFormatSize] = 32;
+        header[Header_PixelFormatFlags] = PixelFormat_FourCC;
+        header[Header_FourCC] = hasAlpha ? makeFourCC('D', 'X', 'T', '5') : makeFourCC('D', 'X', 'T', '1');
+        header[Header_Caps] = Caps_Complex | Caps_Texture | Caps_MipMap;
+
+        std::string data;
+        data.reserve(sHeaderWords * 4 + blocks.size());
+        writeHeader(header, data);
+        data += blocks;
+
+        mFiles.write(name, data);
+    }
+
+}
@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_IMAGEFILECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_IMAGEFILECACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include "filecache.hpp"
+
+namespace osg
+{
+    class Image;
+}
+
+namespace osgDB
+{
+    class Options;
+}
+
+namespace Resource
+{
+
+    /// @brief Stores images as DXT compressed DDS files with mipmaps, so that later loads of an image do not have to
+    /// decode it and create its mipmaps again.
+    /// @par Every file records the hash of the image file it was made from, and is ignored once that file changes.
+    /// @par Only uncompressed 8 bit images without mipmaps, whose width and height are multiples of 4, are supported.
+    /// @note May be used from any thread.
+    class ImageFileCache
+    {
+    public:
+        /// @param path Directory for the cache files, created if needed.
+        /// @param maxSize Most bytes the cache files may take up.
+        /// @param options Options for reading the DDS files.
+        ImageFileCache(const std::string& path, std::uint64_t maxSize, osgDB::Options* options);
+        ~ImageFileCache();
+
+        /// @param name Normalized name of the image file.
+        /// @param hash Hash of the contents of the image file, see FileCache::hash().
+        /// @return The cached image, or a null pointer if there is none for this version of the image file.
+        osg::ref_ptr<osg::Image> read(const std::string& name, std::uint64_t hash);
+
+        /// Compress and store @a image for the given image file, replacing an older version. Unsupported images
+        /// are not stored.
+        void write(const std::string& name, std::uint64_t hash, const osg::Image& image);
+
+    private:
+        FileCache mFiles;
+        osg::ref_ptr<osgDB::Options> mOptions;
+    };
+
+}
+
+#endif
@@ -4,8 +4,12 @@
 #include <osgDB/Registry>
 
 #include <components/vfs/manager.hpp>
+#include <components/misc/trace.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "objectcache.hpp"
+#include "filecache.hpp"
+#include "imagefilecache.hpp"
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -38,6 +42,33 @@ namespace
         return warningImage;
     }
 
+    class WriteFileCacheWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        WriteFileCacheWorkItem(std::shared_ptr<Resource::ImageFileCache> fileCache, const std::string& name,
+                               std::uint64_t hash, const osg::Image* image)
+            : mFileCache(fileCache)
+            , mName(name)
+            , mHash(hash)
+            , mImage(image)
+        {
+        }
+
+        virtual const char* getName() const { return "WriteFileCacheWorkItem"; }
+
+        virtual void doWork()
+        {
+            mFileCache->write(mName, mHash, *mImage);
+        }
+
+    private:
+        std::shared_ptr<Resource::ImageFileCache> mFileCache;
+        std::string mName;
+        std::uint64_t mHash;
+        // Images in the object cache are not changed anymore, so reading it from the worker is safe
+        osg::ref_ptr<const osg::Image> mImage;
+    };
+
 }
 
 namespace Resource
@@ -47,6 +78,7 @@ namespace Resource
         : ResourceManager(vfs)
         , mWarningImage(createWarningImage())
         , mOptions(new osgDB::Options("dds_flip dds_dxt1_detect_rgba"))
+        , mWorkQueue(NULL)
     {
     }
 
@@ -91,6 +123,8 @@ namespace Resource
             return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
         else
         {
+            Misc::ScopedTrace trace("ImageManager::loadImage");
+
             Files::IStreamPtr stream;
             try
             {
@@ -115,6 +149,26 @@ namespace Resource
                 return mWarningImage;
             }
 
+            const bool useFileCache = mFileCache && ext != "dds";
+            std::uint64_t hash = 0;
+            if (useFileCache)
+            {
+                hash = FileCache::hash(*stream);
+
+                osg::ref_ptr<osg::Image> cached = mFileCache->read(normalized, hash);
+                if (cached)
+                {
+                    cached->setFileName(normalized);
+                    if (checkSupported(cached, filename))
+                    {
+                        mCache->addEntryToObjectCache(normalized, cached);
+                        return cached;
+                    }
+                }
+
+                stream = mVFS->get(normalized.c_str());
+            }
+
             osgDB::ReaderWriter::ReadResult result = reader->readImage(*stream, mOptions);
             if (!result.success())
             {
@@ -131,6 +185,14 @@ namespace Resource
                 return mWarningImage;
             }
 
+            if (useFileCache)
+            {
+                if (mWorkQueue)
+                    mWorkQueue->addWorkItem(new WriteFileCacheWorkItem(mFileCache, normalized, hash, image));
+                else
+                    mFileCache->write(normalized, hash, *image);
+            }
+
             mCache->addEntryToObjectCache(normalized, image);
             return image;
         }
@@ -141,6 +203,19 @@ namespace Resource
         return mWarningImage;
     }
 
+    void ImageManager::setFileCache(const std::string &path, std::uint64_t maxSize)
+    {
+        if (maxSize > 0)
+            mFileCache.reset(new ImageFileCache(path, maxSize, mOptions));
+        else
+            mFileCache.reset();
+    }
+
+    void ImageManager::setWorkQueue(SceneUtil::WorkQueue *workQueue)
+    {
+        mWorkQueue = workQueue;
+    }
+
     void ImageManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Image", mCache->getCacheSize());
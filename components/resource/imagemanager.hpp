@@ -1,8 +1,10 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 
+#include <cstdint>
 #include <string>
 #include <map>
+#include <memory>
 
 #include <osg/ref_ptr>
 #include <osg/Image>
@@ -15,9 +17,16 @@ namespace osgDB
     class Options;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
 
+    class ImageFileCache;
+
     /// @brief Handles loading/caching of Images.
     /// @note May be used from any thread.
     class ImageManager : public ResourceManager
@@ -34,9 +43,23 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
+        /// Keep DXT compressed copies of the images that are not in DDS format in files in @a path, so that they
+        /// load faster in later sessions.
+        /// @param maxSize Most bytes the files may take up, 0 disables the file cache.
+        /// @note Not thread safe, call before images are requested from other threads.
+        void setFileCache(const std::string& path, std::uint64_t maxSize);
+
+        /// Compress and write the images for the file cache on @a workQueue, rather than in getImage().
+        /// Without a work queue, getImage() writes them itself.
+        /// @note The work queue is not owned, unset it before it is destroyed.
+        /// @note Not thread safe, call before images are requested from other threads.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
     private:
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
+        std::shared_ptr<ImageFileCache> mFileCache;
+        SceneUtil::WorkQueue* mWorkQueue;
 
         ImageManager(const ImageManager&);
         void operator = (const ImageManager&);
@@ -1,6 +1,7 @@
 #include "keyframemanager.hpp"
 
 #include <components/vfs/manager.hpp>
+#include <components/misc/trace.hpp>
 
 #include "objectcache.hpp"
 
@@ -26,8 +27,11 @@ namespace Resource
             return osg::ref_ptr<const NifOsg::KeyframeHolder>(static_cast<NifOsg::KeyframeHolder*>(obj.get()));
         else
         {
+            Misc::ScopedTrace trace("KeyframeManager::loadKeyframes");
+
             osg::ref_ptr<NifOsg::KeyframeHolder> loaded (new NifOsg::KeyframeHolder);
             NifOsg::Loader::loadKf(Nif::NIFFilePtr(new Nif::NIFFile(mVFS->getNormalized(normalized), normalized)), *loaded.get());
+            loaded->mTextKeyIndex.build(loaded->mTextKeys);
 
             mCache->addEntryToObjectCache(normalized, loaded);
             return loaded;
@@ -4,6 +4,7 @@
 #include <osg/Stats>
 
 #include <components/vfs/manager.hpp>
+#include <components/misc/trace.hpp>
 
 #include "objectcache.hpp"
 
@@ -49,6 +50,8 @@ namespace Resource
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
         else
         {
+            Misc::ScopedTrace trace("NifFileManager::loadNif");
+
             Nif::NIFFilePtr file (new Nif::NIFFile(mVFS->get(name), name));
             obj = new NifFileHolder(file);
             mCache->addEntryToObjectCache(name, obj);
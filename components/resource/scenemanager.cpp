@@ -17,6 +17,7 @@
 #include <components/nif/niffile.hpp>
 
 #include <components/misc/stringops.hpp>
+#include <components/misc/trace.hpp>
 
 #include <components/vfs/manager.hpp>
 
@@ -476,6 +477,8 @@ namespace Resource
             return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
         else
         {
+            Misc::ScopedTrace trace("SceneManager::loadTemplate");
+
             osg::ref_ptr<osg::Node> loaded;
             try
             {
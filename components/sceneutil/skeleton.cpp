@@ -5,6 +5,7 @@
 
 #include <components/misc/stringops.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace SceneUtil
@@ -40,6 +41,12 @@ Skeleton::Skeleton()
     , mLastFrameNumber(0)
     , mTraversedEvenFrame(false)
     , mTraversedOddFrame(false)
+    , mLodDistance(0.f)
+    , mLodMaxInterval(1)
+    , mLastCullFrameNumber(0)
+    , mCullDistance(0.f)
+    , mUpdatedEvenFrame(false)
+    , mUpdatedOddFrame(false)
 {
 
 }
@@ -52,6 +59,12 @@ Skeleton::Skeleton(const Skeleton &copy, const osg::CopyOp &copyop)
     , mLastFrameNumber(0)
     , mTraversedEvenFrame(false)
     , mTraversedOddFrame(false)
+    , mLodDistance(copy.mLodDistance)
+    , mLodMaxInterval(copy.mLodMaxInterval)
+    , mLastCullFrameNumber(0)
+    , mCullDistance(0.f)
+    , mUpdatedEvenFrame(false)
+    , mUpdatedOddFrame(false)
 {
 
 }
@@ -142,21 +155,75 @@ bool Skeleton::getActive() const
     return mActive;
 }
 
+void Skeleton::setUpdateLod(float fullRateDistance, unsigned int maxInterval)
+{
+    mLodDistance = fullRateDistance;
+    // see skipUpdate
+    mLodMaxInterval = std::max(1u, maxInterval) | 1u;
+}
+
+bool Skeleton::skipUpdate(unsigned int frameNumber) const
+{
+    if (mLodDistance <= 0.f)
+        return false;
+
+    unsigned int interval = mLodMaxInterval;
+
+    // The update traversal comes before the cull traversal, so a visible skeleton was culled in the previous frame
+    if (mLastCullFrameNumber != 0 && mLastCullFrameNumber + 1 >= frameNumber)
+    {
+        if (mCullDistance <= mLodDistance)
+            return false;
+
+        interval = std::min(mLodMaxInterval, static_cast<unsigned int>(1.f + mCullDistance / mLodDistance));
+    }
+
+    // The RigGeometries are double-buffered by frame parity. Odd intervals make the updates alternate between
+    // even and odd frames, even intervals would never update the bounds of one of the two buffers again.
+    interval |= 1u;
+
+    // spread the updates of different skeletons over the frames
+    unsigned int phase = static_cast<unsigned int>(reinterpret_cast<std::size_t>(this) / sizeof(Skeleton));
+
+    return (frameNumber + phase) % interval != 0;
+}
+
 void Skeleton::markDirty()
 {
     mTraversedEvenFrame = false;
     mTraversedOddFrame = false;
+    mUpdatedEvenFrame = false;
+    mUpdatedOddFrame = false;
     mBoneCache.clear();
     mBoneCacheInit = false;
 }
 
 void Skeleton::traverse(osg::NodeVisitor& nv)
 {
-    if (!getActive() && nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR
-            // need to process at least 2 frames before shutting off update, since we need to have both frame-alternating RigGeometries initialized
-            // this would be more naturally handled if the double-buffering was implemented in RigGeometry itself rather than in a FrameSwitch decorator node
-            && mLastFrameNumber != 0 && mTraversedEvenFrame && mTraversedOddFrame)
-        return;
+    if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
+    {
+        if (!getActive()
+                // need to process at least 2 frames before shutting off update, since we need to have both frame-alternating RigGeometries initialized
+                // this would be more naturally handled if the double-buffering was implemented in RigGeometry itself rather than in a FrameSwitch decorator node
+                && mLastFrameNumber != 0 && mTraversedEvenFrame && mTraversedOddFrame)
+            return;
+
+        if (mUpdatedEvenFrame && mUpdatedOddFrame && skipUpdate(nv.getTraversalNumber()))
+            return;
+
+        if (nv.getTraversalNumber() % 2 == 0)
+            mUpdatedEvenFrame = true;
+        else
+            mUpdatedOddFrame = true;
+    }
+    else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
+    {
+        float distance = nv.getDistanceToViewPoint(getBound().center(), true);
+        if (nv.getTraversalNumber() != mLastCullFrameNumber || distance < mCullDistance)
+            mCullDistance = distance;
+        mLastCullFrameNumber = nv.getTraversalNumber();
+    }
+
     osg::Group::traverse(nv);
 }
 
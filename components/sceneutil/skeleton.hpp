@@ -53,6 +53,16 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Set up the update level of detail. The update traversal, which evaluates the animation controllers of the
+        /// bones, is then skipped in some frames if the skeleton is far away from the camera or was not visible in the
+        /// last frame. The controllers evaluate the animation at an absolute time, so nothing has to be caught up on
+        /// once the skeleton is traversed again.
+        /// @param fullRateDistance Distance from the camera up to which the skeleton is updated every frame,
+        /// 0 disables the level of detail.
+        /// @param maxInterval Most frames between two updates, used for skeletons that were not visible.
+        /// Intervals are always odd, an even one is rounded up.
+        void setUpdateLod(float fullRateDistance, unsigned int maxInterval);
+
         void traverse(osg::NodeVisitor& nv);
 
         void markDirty();
@@ -76,6 +86,17 @@ namespace SceneUtil
         unsigned int mLastFrameNumber;
         bool mTraversedEvenFrame;
         bool mTraversedOddFrame;
+
+        float mLodDistance;
+        unsigned int mLodMaxInterval;
+        unsigned int mLastCullFrameNumber;
+        float mCullDistance; ///< closest distance to a camera that culled the skeleton in mLastCullFrameNumber
+
+        // Rigs are initialized by the update traversal, every FrameSwitch child needs to be visited once
+        bool mUpdatedEvenFrame;
+        bool mUpdatedOddFrame;
+
+        bool skipUpdate(unsigned int frameNumber) const;
     };
 
 }
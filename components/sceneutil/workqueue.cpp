@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include <components/misc/trace.hpp>
+
 namespace SceneUtil
 {
 
@@ -117,6 +119,11 @@ unsigned int WorkQueue::getNumActiveThreads() const
     return count;
 }
 
+unsigned int WorkQueue::getNumThreads() const
+{
+    return mThreads.size();
+}
+
 WorkThread::WorkThread(WorkQueue *workQueue)
     : mWorkQueue(workQueue)
 {
@@ -124,13 +131,18 @@ WorkThread::WorkThread(WorkQueue *workQueue)
 
 void WorkThread::run()
 {
+    Misc::Trace::setThreadName("WorkThread");
+
     while (true)
     {
         osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
         if (!item)
             return;
         mActive = true;
-        item->doWork();
+        {
+            Misc::ScopedTrace trace(item->getName());
+            item->doWork();
+        }
         item->signalDone();
         mActive = false;
     }
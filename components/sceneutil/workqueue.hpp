@@ -23,6 +23,10 @@ namespace SceneUtil
         /// Override in a derived WorkItem to perform actual work.
         virtual void doWork() {}
 
+        /// Name of the work, used to profile it.
+        /// @note The returned string must remain valid until the program exits, i.e. usually a string literal.
+        virtual const char* getName() const { return "WorkItem"; }
+
         bool isDone() const;
 
         /// Wait until the work is completed. Usually called from the main thread.
@@ -65,6 +69,8 @@ namespace SceneUtil
 
         unsigned int getNumActiveThreads() const;
 
+        unsigned int getNumThreads() const;
+
     private:
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem> > mQueue;
@@ -1,8 +1,14 @@
 #include "chunkmanager.hpp"
 
+#include <algorithm>
 #include <sstream>
 
+#include <OpenThreads/Condition>
+#include <OpenThreads/ScopedLock>
+
+#include <osg/Stats>
 #include <osg/Texture2D>
+#include <osg/Timer>
 
 #include <osgUtil/IncrementalCompileOperation>
 
@@ -11,6 +17,7 @@
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "terraindrawable.hpp"
 #include "material.hpp"
@@ -33,11 +40,149 @@ ChunkManager::ChunkManager(Storage *storage, Resource::SceneManager *sceneMgr, T
 
 }
 
-osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f &center, int lod, unsigned int lodFlags)
+struct ChunkManager::ChunkData
+{
+    float mSize;
+    osg::Vec2f mCenter;
+    int mLod;
+    unsigned int mLodFlags;
+
+    osg::ref_ptr<osg::Vec3Array> mPositions;
+    osg::ref_ptr<osg::Vec3Array> mNormals;
+    osg::ref_ptr<osg::Vec4Array> mColors;
+
+    // Chunks of at least one cell use a composite map, smaller ones are rendered with their blendmap passes
+    osg::ref_ptr<CompositeMap> mCompositeMap;
+    std::vector<osg::ref_ptr<osg::StateSet> > mPasses;
+
+    // in seconds, kept separately since the stages may run concurrently
+    double mGeometryTime;
+    double mTexturesTime;
+
+    ChunkData(float size, const osg::Vec2f& center, int lod, unsigned int lodFlags)
+        : mSize(size), mCenter(center), mLod(lod), mLodFlags(lodFlags), mGeometryTime(0.0), mTexturesTime(0.0)
+    {
+    }
+};
+
+/// @brief Shares the stages of a batch of chunks between the threads calling run().
+/// @par The last stage to finish for a chunk assembles it and adds it to the cache.
+class ChunkManager::BuildJob : public osg::Referenced
+{
+public:
+    BuildJob(ChunkManager* manager)
+        : mManager(manager)
+        , mNextTask(0)
+        , mNumFinishedTasks(0)
+    {
+    }
+
+    void addChunk(const ChunkRequest& request, const std::string& id)
+    {
+        mChunks.push_back(ChunkData(request.mSize, request.mCenter, request.mLod, request.mLodFlags));
+        mIds.push_back(id);
+        mPendingStages.push_back(NumStages);
+    }
+
+    size_t getNumTasks() const
+    {
+        return mChunks.size() * NumStages;
+    }
+
+    /// Work on tasks until there are none left to start. Does not wait for tasks started by other threads.
+    void run()
+    {
+        while (true)
+        {
+            size_t task;
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+                if (mNextTask == getNumTasks())
+                    return;
+                task = mNextTask++;
+            }
+
+            size_t chunk = task / NumStages;
+            ChunkData& data = mChunks[chunk];
+
+            // Textures first, since composite maps are usually the more expensive stage
+            if (task % NumStages == 0)
+                mManager->buildTextures(data);
+            else
+                mManager->buildGeometry(data);
+
+            bool lastStage;
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+                lastStage = (--mPendingStages[chunk] == 0);
+            }
+
+            if (lastStage)
+            {
+                osg::ref_ptr<osg::Node> node = mManager->finishChunk(data);
+                mManager->mCache->addEntryToObjectCache(mIds[chunk], node.get());
+                data = ChunkData(data.mSize, data.mCenter, data.mLod, data.mLodFlags);
+            }
+
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+            if (++mNumFinishedTasks == getNumTasks())
+                mCondition.broadcast();
+        }
+    }
+
+    /// Wait until all tasks are finished. Only call after run() returned, so that no task is left unclaimed.
+    void waitTillDone()
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+        while (mNumFinishedTasks < getNumTasks())
+            mCondition.wait(&mMutex);
+    }
+
+private:
+    enum { NumStages = 2 };
+
+    ChunkManager* mManager;
+
+    std::vector<ChunkData> mChunks;
+    std::vector<std::string> mIds;
+    std::vector<int> mPendingStages;
+
+    size_t mNextTask;
+    size_t mNumFinishedTasks;
+    OpenThreads::Mutex mMutex;
+    OpenThreads::Condition mCondition;
+};
+
+/// Lets a work queue thread help with a BuildJob.
+class ChunkManager::BuildHelperItem : public SceneUtil::WorkItem
+{
+public:
+    BuildHelperItem(BuildJob* job)
+        : mJob(job)
+    {
+    }
+
+    virtual const char* getName() const { return "BuildHelperItem"; }
+
+    virtual void doWork()
+    {
+        mJob->run();
+    }
+
+private:
+    osg::ref_ptr<BuildJob> mJob;
+};
+
+std::string ChunkManager::getChunkId(float size, const osg::Vec2f &center, int lod, unsigned int lodFlags)
 {
     std::ostringstream stream;
     stream << size << " " << center.x() << " " << center.y() << " " << lod << " " << lodFlags;
-    std::string id = stream.str();
+    return stream.str();
+}
+
+osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f &center, int lod, unsigned int lodFlags)
+{
+    std::string id = getChunkId(size, center, lod, lodFlags);
 
     osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(id);
     if (obj)
@@ -50,9 +195,63 @@ osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f &cen
     }
 }
 
+void ChunkManager::buildChunks(const std::vector<ChunkRequest> &requests, SceneUtil::WorkQueue *workQueue)
+{
+    osg::ref_ptr<BuildJob> job (new BuildJob(this));
+
+    for (std::vector<ChunkRequest>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+    {
+        std::string id = getChunkId(it->mSize, it->mCenter, it->mLod, it->mLodFlags);
+        if (!mCache->getRefFromObjectCache(id))
+            job->addChunk(*it, id);
+    }
+
+    if (job->getNumTasks() == 0)
+        return;
+
+    if (workQueue)
+    {
+        // The calling thread takes part as well. Helpers that only get to run after all tasks
+        // have been claimed return immediately, so it does not matter if the queue is busy.
+        size_t numHelpers = std::min<size_t>(workQueue->getNumThreads(), job->getNumTasks() - 1);
+        for (size_t i=0; i<numHelpers; ++i)
+            workQueue->addWorkItem(new BuildHelperItem(job), true);
+    }
+
+    job->run();
+    job->waitTillDone();
+}
+
 void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
 {
     stats->setAttribute(frameNumber, "Terrain Chunk", mCache->getCacheSize());
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mLodStatsMutex);
+    for (unsigned int lod=0; lod<mLodStats.size(); ++lod)
+    {
+        const LodStats& lodStats = mLodStats[lod];
+        if (!lodStats.mNumBuilt)
+            continue;
+
+        std::ostringstream stream;
+        stream << "Terrain Build LOD" << lod;
+        stats->setAttribute(frameNumber, stream.str() + " Count", lodStats.mNumBuilt);
+        stats->setAttribute(frameNumber, stream.str() + " ms", lodStats.mBuildTime * 1000.0 / lodStats.mNumBuilt);
+    }
+}
+
+void ChunkManager::recordBuildTime(int lod, double time)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mLodStatsMutex);
+    if (lod < 0)
+        lod = 0;
+    if (mLodStats.size() <= static_cast<size_t>(lod))
+    {
+        LodStats empty = { 0, 0.0 };
+        mLodStats.resize(lod+1, empty);
+    }
+    ++mLodStats[lod].mNumBuilt;
+    mLodStats[lod].mBuildTime += time;
 }
 
 void ChunkManager::setCullingActive(bool active)
@@ -157,34 +356,74 @@ std::vector<osg::ref_ptr<osg::StateSet> > ChunkManager::createPasses(float chunk
 
 osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Vec2f &chunkCenter, int lod, unsigned int lodFlags)
 {
-    osg::Vec2f worldCenter = chunkCenter*mStorage->getCellWorldSize();
-    osg::ref_ptr<SceneUtil::PositionAttitudeTransform> transform (new SceneUtil::PositionAttitudeTransform);
-    transform->setPosition(osg::Vec3f(worldCenter.x(), worldCenter.y(), 0.f));
+    ChunkData data(chunkSize, chunkCenter, lod, lodFlags);
+    buildGeometry(data);
+    buildTextures(data);
+    return finishChunk(data);
+}
 
-    osg::ref_ptr<osg::Vec3Array> positions (new osg::Vec3Array);
-    osg::ref_ptr<osg::Vec3Array> normals (new osg::Vec3Array);
-    osg::ref_ptr<osg::Vec4Array> colors (new osg::Vec4Array);
+void ChunkManager::buildGeometry(ChunkData &data)
+{
+    const osg::Timer* timer = osg::Timer::instance();
+    osg::Timer_t start = timer->tick();
+
+    data.mPositions = new osg::Vec3Array;
+    data.mNormals = new osg::Vec3Array;
+    data.mColors = new osg::Vec4Array;
 
     osg::ref_ptr<osg::VertexBufferObject> vbo (new osg::VertexBufferObject);
-    positions->setVertexBufferObject(vbo);
-    normals->setVertexBufferObject(vbo);
-    colors->setVertexBufferObject(vbo);
+    data.mPositions->setVertexBufferObject(vbo);
+    data.mNormals->setVertexBufferObject(vbo);
+    data.mColors->setVertexBufferObject(vbo);
+
+    mStorage->fillVertexBuffers(data.mLod, data.mSize, data.mCenter, data.mPositions, data.mNormals, data.mColors);
+
+    data.mGeometryTime = timer->delta_s(start, timer->tick());
+}
+
+void ChunkManager::buildTextures(ChunkData &data)
+{
+    const osg::Timer* timer = osg::Timer::instance();
+    osg::Timer_t start = timer->tick();
+
+    bool useCompositeMap = data.mSize >= 1.f;
+    if (useCompositeMap)
+    {
+        data.mCompositeMap = new CompositeMap;
+        data.mCompositeMap->mTexture = createCompositeMapRTT();
+
+        createCompositeMapGeometry(data.mSize, data.mCenter, osg::Vec4f(0,0,1,1), *data.mCompositeMap);
+    }
+    else
+        data.mPasses = createPasses(data.mSize, data.mCenter, false);
+
+    data.mTexturesTime = timer->delta_s(start, timer->tick());
+}
 
-    mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, positions, normals, colors);
+osg::ref_ptr<osg::Node> ChunkManager::finishChunk(ChunkData &data)
+{
+    const osg::Timer* timer = osg::Timer::instance();
+    osg::Timer_t start = timer->tick();
+
+    float chunkSize = data.mSize;
+
+    osg::Vec2f worldCenter = data.mCenter*mStorage->getCellWorldSize();
+    osg::ref_ptr<SceneUtil::PositionAttitudeTransform> transform (new SceneUtil::PositionAttitudeTransform);
+    transform->setPosition(osg::Vec3f(worldCenter.x(), worldCenter.y(), 0.f));
 
     osg::ref_ptr<TerrainDrawable> geometry (new TerrainDrawable);
-    geometry->setVertexArray(positions);
-    geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
-    geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+    geometry->setVertexArray(data.mPositions);
+    geometry->setNormalArray(data.mNormals, osg::Array::BIND_PER_VERTEX);
+    geometry->setColorArray(data.mColors, osg::Array::BIND_PER_VERTEX);
     geometry->setUseDisplayList(false);
     geometry->setUseVertexBufferObjects(true);
 
     if (chunkSize <= 2.f)
         geometry->setLightListCallback(new SceneUtil::LightListCallback);
 
-    unsigned int numVerts = (mStorage->getCellVertices()-1) * chunkSize / (1 << lod) + 1;
+    unsigned int numVerts = (mStorage->getCellVertices()-1) * chunkSize / (1 << data.mLod) + 1;
 
-    geometry->addPrimitiveSet(mBufferCache.getIndexBuffer(numVerts, lodFlags));
+    geometry->addPrimitiveSet(mBufferCache.getIndexBuffer(numVerts, data.mLodFlags));
 
     bool useCompositeMap = chunkSize >= 1.f;
     unsigned int numUvSets = useCompositeMap ? 1 : 2;
@@ -194,10 +433,7 @@ osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Ve
 
     if (useCompositeMap)
     {
-        osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
-        compositeMap->mTexture = createCompositeMapRTT();
-
-        createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0,0,1,1), *compositeMap);
+        osg::ref_ptr<CompositeMap> compositeMap = data.mCompositeMap;
 
         mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
 
@@ -212,7 +448,7 @@ osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Ve
     }
     else
     {
-        geometry->setPasses(createPasses(chunkSize, chunkCenter, false));
+        geometry->setPasses(data.mPasses);
     }
 
     transform->addChild(geometry);
@@ -229,6 +465,9 @@ osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Ve
     {
         mSceneManager->getIncrementalCompileOperation()->add(geometry);
     }
+
+    recordBuildTime(data.mLod, data.mGeometryTime + data.mTexturesTime + timer->delta_s(start, timer->tick()));
+
     return transform;
 }
 
@@ -1,6 +1,10 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <vector>
+
+#include <OpenThreads/Mutex>
+
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
@@ -16,6 +20,11 @@ namespace Resource
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
 
@@ -32,13 +41,41 @@ namespace Terrain
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, int lod, unsigned int lodFlags);
 
+        struct ChunkRequest
+        {
+            float mSize;
+            osg::Vec2f mCenter;
+            int mLod;
+            unsigned int mLodFlags;
+        };
+
+        /// Build the requested chunks that are not cached yet and add them to the cache.
+        /// @par The geometry and the textures of each chunk are built as separate tasks, which are shared between
+        /// the calling thread and helpers on \a workQueue. Returns once all chunks are done.
+        /// @param workQueue may be NULL, in which case all work is done by the calling thread.
+        /// @note Thread safe.
+        void buildChunks(const std::vector<ChunkRequest>& requests, SceneUtil::WorkQueue* workQueue);
+
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
         void setCullingActive(bool active);
 
     private:
+        /// Intermediate results of building a chunk.
+        struct ChunkData;
+        class BuildJob;
+        class BuildHelperItem;
+
         osg::ref_ptr<osg::Node> createChunk(float size, const osg::Vec2f& center, int lod, unsigned int lodFlags);
 
+        void buildGeometry(ChunkData& data);
+        void buildTextures(ChunkData& data);
+        osg::ref_ptr<osg::Node> finishChunk(ChunkData& data);
+
+        void recordBuildTime(int lod, double time);
+
+        static std::string getChunkId(float size, const osg::Vec2f& center, int lod, unsigned int lodFlags);
+
         osg::ref_ptr<osg::Texture2D> createCompositeMapRTT();
 
         void createCompositeMapGeometry(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
@@ -54,6 +91,14 @@ namespace Terrain
         unsigned int mCompositeMapSize;
 
         bool mCullingActive;
+
+        struct LodStats
+        {
+            unsigned int mNumBuilt;
+            double mBuildTime; ///< in seconds, summed over all stages of the built chunks
+        };
+        std::vector<LodStats> mLodStats;
+        mutable OpenThreads::Mutex mLodStatsMutex;
     };
 
 }
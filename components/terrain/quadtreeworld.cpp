@@ -239,6 +239,7 @@ QuadTreeWorld::QuadTreeWorld(osg::Group *parent, osg::Group *compileRoot, Resour
     : World(parent, compileRoot, resourceSystem, storage, nodeMask, preCompileMask)
     , mViewDataMap(new ViewDataMap)
     , mQuadTreeBuilt(false)
+    , mWorkQueue(NULL)
 {
     // No need for culling on the Drawable / Transform level as the quad tree performs the culling already.
     mChunkManager->setCullingActive(false);
@@ -320,7 +321,7 @@ unsigned int getLodFlags(QuadTreeNode* node, int ourLod, ViewData* vd)
     return lodFlags;
 }
 
-void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, ChunkManager* chunkManager)
+void updateLodFlags(ViewData::Entry& entry, ViewData* vd)
 {
     if (vd->hasChanged())
     {
@@ -333,6 +334,11 @@ void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, ChunkManager* chunk
             entry.mLodFlags = lodFlags;
         }
     }
+}
+
+void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, ChunkManager* chunkManager)
+{
+    updateLodFlags(entry, vd);
 
     if (!entry.mRenderingNode)
     {
@@ -444,6 +450,25 @@ void QuadTreeWorld::preload(View *view, const osg::Vec3f &eyePoint)
     ViewData* vd = static_cast<ViewData*>(view);
     traverse(mRootNode.get(), vd, NULL, mRootNode->getLodCallback(), eyePoint, false);
 
+    // Build the missing chunks in parallel first, they are then picked up from the cache
+    std::vector<ChunkManager::ChunkRequest> requests;
+    for (unsigned int i=0; i<vd->getNumEntries(); ++i)
+    {
+        ViewData::Entry& entry = vd->getEntry(i);
+        updateLodFlags(entry, vd);
+        if (entry.mRenderingNode)
+            continue;
+
+        ChunkManager::ChunkRequest request;
+        request.mSize = entry.mNode->getSize();
+        request.mCenter = entry.mNode->getCenter();
+        request.mLod = Log2(int(entry.mNode->getSize()));
+        request.mLodFlags = entry.mLodFlags;
+        requests.push_back(request);
+    }
+
+    mChunkManager->buildChunks(requests, mWorkQueue);
+
     for (unsigned int i=0; i<vd->getNumEntries(); ++i)
     {
         ViewData::Entry& entry = vd->getEntry(i);
@@ -461,5 +486,10 @@ void QuadTreeWorld::setDefaultViewer(osg::Object *obj)
     mViewDataMap->setDefaultViewer(obj);
 }
 
+void QuadTreeWorld::setWorkQueue(SceneUtil::WorkQueue *workQueue)
+{
+    mWorkQueue = workQueue;
+}
+
 
 }
@@ -10,6 +10,11 @@ namespace osg
     class NodeVisitor;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
     class RootNode;
@@ -35,6 +40,10 @@ namespace Terrain
 
         virtual void setDefaultViewer(osg::Object* obj);
 
+        /// Set the work queue whose threads help building chunks during preload().
+        /// @note The work queue must outlive this object.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
     private:
         void ensureQuadTreeBuilt();
 
@@ -44,6 +53,8 @@ namespace Terrain
 
         OpenThreads::Mutex mQuadTreeMutex;
         bool mQuadTreeBuilt;
+
+        SceneUtil::WorkQueue* mWorkQueue;
     };
 
 }
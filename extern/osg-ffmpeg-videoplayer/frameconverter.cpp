@@ -0,0 +1,179 @@
+#include "frameconverter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <OpenThreads/Thread>
+#include <OpenThreads/ScopedLock>
+
+extern "C"
+{
+    #include <libavutil/frame.h>
+    #include <libavutil/pixdesc.h>
+    #include <libswscale/swscale.h>
+}
+
+namespace
+{
+    const int MAX_SLICES = 4;
+    // Smaller slices are not worth waking up a thread for
+    const int MIN_SLICE_HEIGHT = 64;
+    // Keeps slice boundaries on chroma rows and macroblocks
+    const int SLICE_ALIGNMENT = 16;
+}
+
+namespace Video
+{
+
+class FrameConverter::SliceThread : public OpenThreads::Thread
+{
+public:
+    SliceThread(FrameConverter* converter, int slice)
+        : mConverter(converter)
+        , mSlice(slice)
+    {
+        start();
+    }
+
+    virtual void run()
+    {
+        mConverter->runSliceThread(mSlice);
+    }
+
+private:
+    FrameConverter* mConverter;
+    int mSlice;
+};
+
+FrameConverter::FrameConverter(int width, int height, int format)
+    : mWidth(width)
+    , mHeight(height)
+    , mFormat(format)
+    , mChromaShift(0)
+    , mGeneration(0)
+    , mPendingSlices(0)
+    , mQuit(false)
+    , mFrame(NULL)
+    , mDst(NULL)
+    , mDstStride(0)
+{
+    int numSlices = std::min(MAX_SLICES, std::min(OpenThreads::GetNumberOfProcessors(), height / MIN_SLICE_HEIGHT));
+
+    // Slicing needs to offset the planes of the frame, which does not work for palettes or hardware frames
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(format));
+    int unsupportedFlags = AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_HWACCEL;
+#ifdef AV_PIX_FMT_FLAG_PSEUDOPAL
+    unsupportedFlags |= AV_PIX_FMT_FLAG_PSEUDOPAL;
+#endif
+    if (!desc || (desc->flags & unsupportedFlags))
+        numSlices = 1;
+    else
+        mChromaShift = desc->log2_chroma_h;
+    numSlices = std::max(1, numSlices);
+
+    int sliceHeight = (height / numSlices + SLICE_ALIGNMENT - 1) / SLICE_ALIGNMENT * SLICE_ALIGNMENT;
+
+    for (int y = 0; y < height; y += sliceHeight)
+    {
+        Slice slice;
+        slice.mY = y;
+        slice.mHeight = std::min(sliceHeight, height - y);
+        slice.mContext = sws_getContext(width, slice.mHeight, static_cast<AVPixelFormat>(format),
+                                        width, slice.mHeight, AV_PIX_FMT_RGBA, SWS_BICUBIC,
+                                        NULL, NULL, NULL);
+        if (slice.mContext == NULL)
+        {
+            for (std::vector<Slice>::iterator it = mSlices.begin(); it != mSlices.end(); ++it)
+                sws_freeContext(it->mContext);
+            throw std::runtime_error("Cannot initialize the conversion context!\n");
+        }
+        mSlices.push_back(slice);
+    }
+
+    for (std::size_t i = 1; i < mSlices.size(); ++i)
+        mThreads.push_back(std::unique_ptr<SliceThread>(new SliceThread(this, static_cast<int>(i))));
+}
+
+FrameConverter::~FrameConverter()
+{
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+        mQuit = true;
+        mStartCondition.broadcast();
+    }
+
+    for (std::size_t i = 0; i < mThreads.size(); ++i)
+        mThreads[i]->join();
+    mThreads.clear();
+
+    for (std::vector<Slice>::iterator it = mSlices.begin(); it != mSlices.end(); ++it)
+        sws_freeContext(it->mContext);
+}
+
+bool FrameConverter::isCompatible(int width, int height, int format) const
+{
+    return width == mWidth && height == mHeight && format == mFormat;
+}
+
+void FrameConverter::convert(const AVFrame *frame, uint8_t *dst, int dstStride)
+{
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+        mFrame = frame;
+        mDst = dst;
+        mDstStride = dstStride;
+        mPendingSlices = static_cast<int>(mThreads.size());
+        ++mGeneration;
+        mStartCondition.broadcast();
+    }
+
+    convertSlice(mSlices[0]);
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+    while (mPendingSlices > 0)
+        mDoneCondition.wait(&mMutex);
+}
+
+void FrameConverter::runSliceThread(int slice)
+{
+    unsigned int generation = 0;
+    while (true)
+    {
+        {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+            while (!mQuit && mGeneration == generation)
+                mStartCondition.wait(&mMutex);
+            if (mQuit)
+                return;
+            generation = mGeneration;
+        }
+
+        convertSlice(mSlices[slice]);
+
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+        if (--mPendingSlices == 0)
+            mDoneCondition.signal();
+    }
+}
+
+void FrameConverter::convertSlice(const Slice &slice)
+{
+    // Every slice has its own context, so each one starts at row 0 of the planes offset to the slice
+    const uint8_t* src[4] = { NULL, NULL, NULL, NULL };
+    int srcStride[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+        if (!mFrame->data[i])
+            continue;
+        int y = (i == 1 || i == 2) ? (slice.mY >> mChromaShift) : slice.mY;
+        src[i] = mFrame->data[i] + y * mFrame->linesize[i];
+        srcStride[i] = mFrame->linesize[i];
+    }
+
+    uint8_t* dst[4] = { mDst + slice.mY * mDstStride, NULL, NULL, NULL };
+    int dstStride[4] = { mDstStride, 0, 0, 0 };
+
+    sws_scale(slice.mContext, src, srcStride, 0, slice.mHeight, dst, dstStride);
+}
+
+}
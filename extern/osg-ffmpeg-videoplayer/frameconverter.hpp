@@ -0,0 +1,78 @@
+#ifndef VIDEOPLAYER_FRAMECONVERTER_H
+#define VIDEOPLAYER_FRAMECONVERTER_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+
+extern "C"
+{
+    struct SwsContext;
+    struct AVFrame;
+}
+
+namespace Video
+{
+
+/**
+ * @brief Converts decoded frames to RGBA.
+ * @par Large frames are split into horizontal slices, which are converted in parallel by worker threads.
+ */
+class FrameConverter
+{
+public:
+    /// @param format The AVPixelFormat of the frames.
+    FrameConverter(int width, int height, int format);
+    ~FrameConverter();
+
+    /// Return true if this converter can convert frames of the given size and format.
+    bool isCompatible(int width, int height, int format) const;
+
+    /// Convert @a frame and write the result to @a dst.
+    /// @param dstStride The number of bytes per row of @a dst.
+    void convert(const AVFrame* frame, uint8_t* dst, int dstStride);
+
+private:
+    struct Slice
+    {
+        SwsContext* mContext;
+        int mY;
+        int mHeight;
+    };
+
+    class SliceThread;
+
+    void runSliceThread(int slice);
+    void convertSlice(const Slice& slice);
+
+    int mWidth;
+    int mHeight;
+    int mFormat;
+    /// log2 of the vertical chroma subsampling
+    int mChromaShift;
+
+    std::vector<Slice> mSlices;
+    /// The thread for slice i+1, the first slice is converted by the calling thread.
+    std::vector<std::unique_ptr<SliceThread> > mThreads;
+
+    OpenThreads::Mutex mMutex;
+    OpenThreads::Condition mStartCondition;
+    OpenThreads::Condition mDoneCondition;
+    unsigned int mGeneration;
+    int mPendingSlices;
+    bool mQuit;
+
+    const AVFrame* mFrame;
+    uint8_t* mDst;
+    int mDstStride;
+
+    FrameConverter(const FrameConverter&);
+    FrameConverter& operator=(const FrameConverter&);
+};
+
+}
+
+#endif
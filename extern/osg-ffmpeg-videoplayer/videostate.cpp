@@ -5,12 +5,12 @@
 #include <iostream>
 
 #include <osg/Texture2D>
+#include <osg/Timer>
 
 extern "C"
 {
     #include <libavcodec/avcodec.h>
     #include <libavformat/avformat.h>
-    #include <libswscale/swscale.h>
 
     // From libavformat version 55.0.100 and onward the declaration of av_gettime() is
     // removed from libavformat/avformat.h and moved to libavutil/time.h
@@ -41,6 +41,7 @@ static FlushPacket flush_pkt;
 #include "videoplayer.hpp"
 #include "audiodecoder.hpp"
 #include "audiofactory.hpp"
+#include "frameconverter.hpp"
 
 namespace
 {
@@ -51,14 +52,32 @@ namespace
 namespace Video
 {
 
+VideoPicture::VideoPicture()
+    : frame(av_frame_alloc())
+    , pts(0.0)
+{
+    if (!frame)
+        throw std::bad_alloc();
+}
+
+VideoPicture::~VideoPicture()
+{
+    av_frame_free(&frame);
+}
+
 VideoState::VideoState()
     : mAudioFactory(NULL)
     , format_ctx(NULL)
     , av_sync_type(AV_SYNC_DEFAULT)
     , audio_st(NULL)
     , video_st(NULL), frame_last_pts(0.0)
-    , video_clock(0.0), sws_context(NULL), rgbaFrame(NULL), pictq_size(0)
+    , video_clock(0.0), pictq_size(0)
     , pictq_rindex(0), pictq_windex(0)
+    , mDisplayFrame(NULL)
+    , mImageIndex(0)
+    , mDisplayedFrames(0)
+    , mDroppedFrames(0)
+    , mConversionTime(0.0)
     , mSeekRequested(false)
     , mSeekPos(0)
     , mVideoEnded(false)
@@ -67,6 +86,10 @@ VideoState::VideoState()
 {
     mFlushPktData = flush_pkt.data;
 
+    mDisplayFrame = av_frame_alloc();
+    if (!mDisplayFrame)
+        throw std::bad_alloc();
+
     // Register all formats and codecs
     av_register_all();
 }
@@ -74,6 +97,8 @@ VideoState::VideoState()
 VideoState::~VideoState()
 {
     deinit();
+
+    av_frame_free(&mDisplayFrame);
 }
 
 void VideoState::setAudioFactory(MovieAudioFactory *factory)
@@ -209,9 +234,11 @@ int64_t VideoState::istream_seek(void *user_data, int64_t offset, int whence)
     return stream.tellg();
 }
 
-void VideoState::video_display(VideoPicture *vp)
+void VideoState::video_display(AVFrame *frame)
 {
-    if((*this->video_st)->codec->width != 0 && (*this->video_st)->codec->height != 0)
+    int width = (*this->video_st)->codec->width;
+    int height = (*this->video_st)->codec->height;
+    if(width != 0 && height != 0)
     {
         if (!mTexture.get())
         {
@@ -222,111 +249,102 @@ void VideoState::video_display(VideoPicture *vp)
             mTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
         }
 
-        osg::ref_ptr<osg::Image> image = new osg::Image;
+        if (!mFrameConverter.get() || !mFrameConverter->isCompatible(width, height, frame->format))
+            mFrameConverter.reset(new FrameConverter(width, height, frame->format));
+
+        osg::ref_ptr<osg::Image>& image = mImages[mImageIndex];
+        mImageIndex = (mImageIndex+1) % 2;
+        if (!image.get() || image->s() != width || image->t() != height)
+        {
+            image = new osg::Image;
+            image->allocateImage(width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        }
 
-        image->setImage((*this->video_st)->codec->width, (*this->video_st)->codec->height,
-                        1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, &vp->data[0], osg::Image::NO_DELETE);
+        osg::Timer_t start = osg::Timer::instance()->tick();
+        mFrameConverter->convert(frame, image->data(), image->getRowSizeInBytes());
+        mConversionTime += osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick());
+        mDisplayedFrames++;
 
+        image->dirty();
         mTexture->setImage(image);
     }
 }
 
 void VideoState::video_refresh()
 {
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(this->pictq_mutex);
-    if(this->pictq_size == 0)
-        return;
-
-    if (this->av_sync_type == AV_SYNC_VIDEO_MASTER)
     {
-        VideoPicture* vp = &this->pictq[this->pictq_rindex];
-        this->video_display(vp);
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(this->pictq_mutex);
+        if(this->pictq_size == 0)
+            return;
 
-        this->pictq_rindex = (pictq_rindex+1) % VIDEO_PICTURE_ARRAY_SIZE;
-        this->frame_last_pts = vp->pts;
-        this->pictq_size--;
-        this->pictq_cond.signal();
-    }
-    else
-    {
-        const float threshold = 0.03f;
-        if (this->pictq[pictq_rindex].pts > this->get_master_clock() + threshold)
-            return; // not ready yet to show this picture
-
-        // TODO: the conversion to RGBA is done in the decoding thread, so if a picture is skipped here, then it was
-        // unnecessarily converted. But we may want to replace the conversion by a pixel shader anyway (see comment in queue_picture)
-        int i=0;
-        for (; i<this->pictq_size-1; ++i)
+        if (this->av_sync_type != AV_SYNC_VIDEO_MASTER)
         {
-            if (this->pictq[pictq_rindex].pts + threshold <= this->get_master_clock())
-                this->pictq_rindex = (this->pictq_rindex+1) % VIDEO_PICTURE_ARRAY_SIZE; // not enough time to show this picture
-            else
-                break;
+            const float threshold = 0.03f;
+            if (this->pictq[pictq_rindex].pts > this->get_master_clock() + threshold)
+                return; // not ready yet to show this picture
+
+            // Skip the pictures we have no time to show. They are still in their native format, so no conversion is wasted on them
+            while (this->pictq_size > 1 && this->pictq[pictq_rindex].pts + threshold <= this->get_master_clock())
+            {
+                av_frame_unref(this->pictq[pictq_rindex].frame);
+                this->pictq_rindex = (this->pictq_rindex+1) % VIDEO_PICTURE_ARRAY_SIZE;
+                this->pictq_size--;
+                mDroppedFrames++;
+            }
         }
 
         assert (this->pictq_rindex < VIDEO_PICTURE_ARRAY_SIZE);
         VideoPicture* vp = &this->pictq[this->pictq_rindex];
 
-        this->video_display(vp);
-
+        av_frame_unref(mDisplayFrame);
+        av_frame_move_ref(mDisplayFrame, vp->frame);
         this->frame_last_pts = vp->pts;
 
-        this->pictq_size -= i;
         // update queue for next picture
         this->pictq_size--;
         this->pictq_rindex = (this->pictq_rindex+1) % VIDEO_PICTURE_ARRAY_SIZE;
         this->pictq_cond.signal();
     }
+
+    // Convert outside of the lock, so that the video thread can keep queuing pictures in the meantime
+    this->video_display(mDisplayFrame);
 }
 
 
 int VideoState::queue_picture(AVFrame *pFrame, double pts)
 {
-    VideoPicture *vp;
-
     /* wait until we have a new pic */
-    {
-        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(this->pictq_mutex);
-        while(this->pictq_size >= VIDEO_PICTURE_QUEUE_SIZE && !this->mQuit)
-            this->pictq_cond.wait(&this->pictq_mutex, 1);
-    }
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(this->pictq_mutex);
+    while(this->pictq_size >= VIDEO_PICTURE_QUEUE_SIZE && !this->mQuit)
+        this->pictq_cond.wait(&this->pictq_mutex, 1);
     if(this->mQuit)
         return -1;
 
-    this->pictq_mutex.lock();
-
     // windex is set to 0 initially
-    vp = &this->pictq[this->pictq_windex];
-
-    // Convert the image into RGBA format
-    // TODO: we could do this in a pixel shader instead, if the source format
-    // matches a commonly used format (ie YUV420P)
-    if(this->sws_context == NULL)
-    {
-        int w = (*this->video_st)->codec->width;
-        int h = (*this->video_st)->codec->height;
-        this->sws_context = sws_getContext(w, h, (*this->video_st)->codec->pix_fmt,
-                                           w, h, AV_PIX_FMT_RGBA, SWS_BICUBIC,
-                                           NULL, NULL, NULL);
-        if(this->sws_context == NULL)
-            throw std::runtime_error("Cannot initialize the conversion context!\n");
-    }
+    VideoPicture *vp = &this->pictq[this->pictq_windex];
 
+    // Keep the frame in its native format, only the frames that are displayed get converted to RGBA
+    av_frame_unref(vp->frame);
+    av_frame_move_ref(vp->frame, pFrame);
     vp->pts = pts;
-    vp->data.resize((*this->video_st)->codec->width * (*this->video_st)->codec->height * 4);
-
-    uint8_t *dst = &vp->data[0];
-    sws_scale(this->sws_context, pFrame->data, pFrame->linesize,
-              0, (*this->video_st)->codec->height, &dst, this->rgbaFrame->linesize);
 
     // now we inform our display thread that we have a pic ready
     this->pictq_windex = (this->pictq_windex+1) % VIDEO_PICTURE_ARRAY_SIZE;
     this->pictq_size++;
-    this->pictq_mutex.unlock();
 
     return 0;
 }
 
+void VideoState::pictq_clear()
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(this->pictq_mutex);
+    for (int i = 0; i < VIDEO_PICTURE_ARRAY_SIZE; ++i)
+        av_frame_unref(this->pictq[i].frame);
+    this->pictq_size = 0;
+    this->pictq_rindex = 0;
+    this->pictq_windex = 0;
+}
+
 double VideoState::synchronize_video(AVFrame *src_frame, double pts)
 {
     double frame_delay;
@@ -389,20 +407,13 @@ public:
 
         pFrame = av_frame_alloc();
 
-        self->rgbaFrame = av_frame_alloc();
-        avpicture_alloc((AVPicture*)self->rgbaFrame, AV_PIX_FMT_RGBA, (*self->video_st)->codec->width, (*self->video_st)->codec->height);
-
         while(self->videoq.get(packet, self) >= 0)
         {
             if(packet->data == flush_pkt.data)
             {
                 avcodec_flush_buffers((*self->video_st)->codec);
 
-                self->pictq_mutex.lock();
-                self->pictq_size = 0;
-                self->pictq_rindex = 0;
-                self->pictq_windex = 0;
-                self->pictq_mutex.unlock();
+                self->pictq_clear();
 
                 self->frame_last_pts = packet->pts * av_q2d((*self->video_st)->time_base);
                 global_video_pkt_pts = static_cast<int64_t>(self->frame_last_pts);
@@ -433,10 +444,7 @@ public:
             }
         }
 
-        av_free(pFrame);
-
-        avpicture_free((AVPicture*)self->rgbaFrame);
-        av_free(self->rgbaFrame);
+        av_frame_free(&pFrame);
     }
 
 private:
@@ -515,11 +523,7 @@ public:
                                 self->format_ctx->streams[videoStreamIndex]->time_base);
                             self->videoq.put(&flush_pkt);
                         }
-                        self->pictq_mutex.lock();
-                        self->pictq_size = 0;
-                        self->pictq_rindex = 0;
-                        self->pictq_windex = 0;
-                        self->pictq_mutex.unlock();
+                        self->pictq_clear();
                         self->mExternalClock.set(seek_target);
                     }
                     self->mSeekRequested = false;
@@ -580,6 +584,11 @@ int VideoState::stream_open(int stream_index, AVFormatContext *pFormatCtx)
 
     // Get a pointer to the codec context for the video stream
     codecCtx = pFormatCtx->streams[stream_index]->codec;
+
+    // Decoded video frames are kept in the picture queue, so they must not be reused by the decoder
+    if(codecCtx->codec_type == AVMEDIA_TYPE_VIDEO)
+        codecCtx->refcounted_frames = 1;
+
     codec = avcodec_find_decoder(codecCtx->codec_id);
     if(!codec || (avcodec_open2(codecCtx, codec, NULL) < 0))
     {
@@ -727,9 +736,17 @@ void VideoState::deinit()
         avcodec_close((*this->video_st)->codec);
     this->video_st = NULL;
 
-    if(this->sws_context)
-        sws_freeContext(this->sws_context);
-    this->sws_context = NULL;
+    if (mDisplayedFrames > 0)
+        std::cout << "Video: displayed " << mDisplayedFrames << " frames, dropped " << mDroppedFrames
+                  << ", average conversion time " << mConversionTime / mDisplayedFrames * 1000.0 << " ms" << std::endl;
+    // deinit() is called again by the destructor, which should not report the same video twice
+    mDisplayedFrames = 0;
+    mDroppedFrames = 0;
+    mConversionTime = 0.0;
+
+    mFrameConverter.reset();
+    pictq_clear();
+    av_frame_unref(mDisplayFrame);
 
     if(this->format_ctx)
     {
@@ -756,6 +773,8 @@ void VideoState::deinit()
         mTexture->setImage(NULL);
         mTexture = NULL;
     }
+    mImages[0] = NULL;
+    mImages[1] = NULL;
 }
 
 double VideoState::get_external_clock()
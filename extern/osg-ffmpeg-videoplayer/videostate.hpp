@@ -13,17 +13,16 @@
 namespace osg
 {
     class Texture2D;
+    class Image;
 }
 
 #include "videodefs.hpp"
 
 #define VIDEO_PICTURE_QUEUE_SIZE 50
-// allocate one extra to make sure we do not overwrite the osg::Image currently set on the texture
-#define VIDEO_PICTURE_ARRAY_SIZE (VIDEO_PICTURE_QUEUE_SIZE+1)
+#define VIDEO_PICTURE_ARRAY_SIZE VIDEO_PICTURE_QUEUE_SIZE
 
 extern "C"
 {
-    struct SwsContext;
     struct AVPacketList;
     struct AVPacket;
     struct AVFormatContext;
@@ -40,6 +39,7 @@ class MovieAudioFactory;
 class MovieAudioDecoder;
 class VideoThread;
 class ParseThread;
+class FrameConverter;
 
 struct ExternalClock
 {
@@ -79,11 +79,16 @@ struct PacketQueue {
 };
 
 struct VideoPicture {
-    VideoPicture() : pts(0.0)
-    { }
+    VideoPicture();
+    ~VideoPicture();
 
-    std::vector<uint8_t> data;
+    /// The decoded frame in its native format, it is only converted to RGBA when it is displayed.
+    AVFrame* frame;
     double pts;
+
+private:
+    VideoPicture(const VideoPicture&);
+    VideoPicture& operator=(const VideoPicture&);
 };
 
 struct VideoState {
@@ -107,10 +112,11 @@ struct VideoState {
     static void video_thread_loop(VideoState *is);
     static void decode_thread_loop(VideoState *is);
 
-    void video_display(VideoPicture* vp);
+    void video_display(AVFrame* frame);
     void video_refresh();
 
     int queue_picture(AVFrame *pFrame, double pts);
+    void pictq_clear();
     double synchronize_video(AVFrame *src_frame, double pts);
 
     double get_audio_clock();
@@ -143,13 +149,20 @@ struct VideoState {
     double      frame_last_pts;
     double      video_clock; ///<pts of last decoded frame / predicted pts of next decoded frame
     PacketQueue videoq;
-    SwsContext*  sws_context;
     VideoPicture pictq[VIDEO_PICTURE_ARRAY_SIZE];
-    AVFrame*     rgbaFrame; // used as buffer for the frame converted from its native format to RGBA
     int          pictq_size, pictq_rindex, pictq_windex;
     OpenThreads::Mutex pictq_mutex;
     OpenThreads::Condition pictq_cond;
 
+    std::unique_ptr<FrameConverter> mFrameConverter;
+    AVFrame* mDisplayFrame; ///< the frame taken from pictq for display
+    osg::ref_ptr<osg::Image> mImages[2]; ///< converted frames, alternating so that we never write the image set on the texture
+    int mImageIndex;
+
+    unsigned int mDisplayedFrames;
+    unsigned int mDroppedFrames; ///< decoded frames that were skipped because it was already time for the next one
+    double mConversionTime; ///< total time spent converting the displayed frames to RGBA, in seconds
+
     std::unique_ptr<ParseThread> parse_thread;
     std::unique_ptr<VideoThread> video_thread;
 